@@ -70,9 +70,9 @@
 #define RP1_PCIE_MSIX_CFG_N_IACK             (1U << 2U)
 
 static uintptr_t rpi_msix_cfg_base = (uintptr_t)MAP_FAILED;
-static uint32_t  rpi_msix_cfg_set_reg = 0U;
 
 void variant_intr_init(DEV_PL011 *dev) {
+	uint32_t rpi_msix_cfg_set_reg;
 
 	if (dev->intr == RP1_PCIE_MSIX_UART0_IRQ) {
 		rpi_msix_cfg_set_reg = RP1_PCIE_MSIX_IRQ_25_UART0_SET_REG;
@@ -97,7 +97,11 @@ void variant_intr_init(DEV_PL011 *dev) {
 	    rpi_msix_cfg_set_reg = 0U;
 	}
 
-	if (rpi_msix_cfg_set_reg != 0U) {
+	/*
+	 * The MSI-X config block is shared by all ports hosted in this process,
+	 * map it once and keep the IACK register per port.
+	 */
+	if ((rpi_msix_cfg_set_reg != 0U) && (rpi_msix_cfg_base == (uintptr_t)MAP_FAILED)) {
 	    rpi_msix_cfg_base = (uintptr_t)mmap_device_memory (NULL, RP1_PCIE_MSIX_SIZE,
 			   (PROT_READ | PROT_WRITE | PROT_NOCACHE), 0, RP1_PCIE_MSIX_ADDR);
 		if (rpi_msix_cfg_base == (uintptr_t)MAP_FAILED) {
@@ -105,6 +109,11 @@ void variant_intr_init(DEV_PL011 *dev) {
 		}
 	}
 
+	if (rpi_msix_cfg_set_reg != 0U) {
+	    dev->intr_ack_base = rpi_msix_cfg_base;
+	    dev->intr_ack_reg = rpi_msix_cfg_set_reg;
+	}
+
 	if (dev->is_debug_console != 0U) {
 	    const int32_t ret = fdt_debug_console_irq_fix(dev);
 	    /* Retrieve IRQ from runtime FDT for default debug console */
@@ -116,10 +125,10 @@ void variant_intr_init(DEV_PL011 *dev) {
 	return;
 }
 
-void variant_intr_unmask(void)
+void variant_intr_unmask(DEV_PL011 *dev)
 {
-	if ((rpi_msix_cfg_base != (uintptr_t)MAP_FAILED)) {
-	    out32(rpi_msix_cfg_base + rpi_msix_cfg_set_reg, RP1_PCIE_MSIX_CFG_N_IACK);
+	if ((dev->intr_ack_base != (uintptr_t)MAP_FAILED)) {
+	    out32(dev->intr_ack_base + dev->intr_ack_reg, RP1_PCIE_MSIX_CFG_N_IACK);
 	}
 }
 
@@ -59,6 +59,8 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <sys/neutrino.h>
 #include <sys/dispatch.h>
 #include <termios.h>
@@ -75,9 +77,30 @@
 #include <arm/pl011.h>
 #include <variant.h>
 #include <hw/dma.h>
+#include <hw/dcmd_serpl011.h>
 
 #define DEFAULT_PRIORITY	24
 
+#define FRAME_SLOTS			16
+
+/*
+ * Completed frames of the framed receive mode, filled from the interrupt
+ * handler and drained by DCMD_SERPL011_FRAME_READ.
+ */
+typedef struct pl011_frames {
+	pthread_mutex_t		mutex;
+	unsigned			head;
+	unsigned			tail;
+	unsigned			cnt;
+	unsigned			dropped;
+	serpl011_frame_t	cur;
+	int					notify_rcvid;
+	int					notify_scoid;
+	pid_t				notify_pid;
+	struct sigevent		notify_event;
+	serpl011_frame_t	slot[FRAME_SLOTS];
+} PL011_FRAMES;
+
 typedef struct dev_pl011 {
 	TTYDEV				tty;
 	struct dev_pl011	*next;
@@ -107,6 +130,14 @@ typedef struct dev_pl011 {
 	unsigned			chan_rx;
 	unsigned			chan_tx;
 	unsigned			is_debug_console;
+	unsigned			runmask;
+	unsigned			intr_thread;
+	pthread_t			intr_tid;
+	pthread_mutex_t		intr_lock;
+	uintptr_t			intr_ack_base;
+	unsigned			intr_ack_reg;
+	unsigned			frame_gap;
+	PL011_FRAMES		*frames;
 
 #ifdef USE_DMA
 	dma_addr_t			buf_rx[2];
@@ -119,6 +150,7 @@ typedef struct dev_pl011 {
 	int					tx_coid;
 	struct sigevent		event;
 	unsigned			buffer0;
+	unsigned			tx_byte_cnt;
 	void				*dma_chn_tx;
 	void				*dma_chn_rx;
 	dma_functions_t		dmafuncs;
@@ -139,6 +171,9 @@ typedef struct ttyinit_pl011 {
 	unsigned	chan_rx;
 	unsigned	chan_tx;
 	unsigned	is_debug_console;
+	unsigned	runmask;
+	unsigned	intr_thread;
+	unsigned	frame_gap;
 } TTYINIT_PL011;
 
 EXT TTYCTRL				ttyctrl;
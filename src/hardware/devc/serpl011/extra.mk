@@ -0,0 +1,2 @@
+EXTRA_INCVPATH += $(PROJECT_ROOT)/$(SECTION)/public
+PUBLIC_INCVPATH += $(wildcard $(PROJECT_ROOT)/$(SECTION)/public )
@@ -0,0 +1,343 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+
+/*
+ * $QNXLicenseC:
+ * Copyright 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+/*
+ * Framed receive mode.
+ *
+ * Received data is not passed to io-char but collected into frames. A frame
+ * ends when the line has been idle for the configured inter-character gap,
+ * which is programmed as the PL011 receive timeout so that RTMIS marks the
+ * frame boundary.  Completed frames are queued with their timestamps and
+ * read atomically with DCMD_SERPL011_FRAME_READ.
+ */
+
+#include "externs.h"
+#include <stddef.h>
+#include <time.h>
+
+#define	PL011_RX_ERROR (PL011_DR_OE | PL011_DR_BE | PL011_DR_PE | PL011_DR_FE)
+
+/* Receive FIFO trigger levels (IFLS RXIFLSEL) in eighths of the FIFO */
+static const unsigned rx_trigger_eighths[] = { 1, 2, 4, 6, 7 };
+
+static uint64_t frame_time(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return timespec2nsec(&ts);
+}
+
+int frame_init(DEV_PL011 *dev)
+{
+	PL011_FRAMES	*frames;
+
+	frames = calloc(1, sizeof(*frames));
+	if (frames == NULL) {
+		return ENOMEM;
+	}
+	pthread_mutex_init(&frames->mutex, NULL);
+	frames->notify_rcvid = -1;
+	SIGEV_NONE_INIT(&frames->notify_event);
+	dev->frames = frames;
+
+	return EOK;
+}
+
+/*
+ * Character time on the line in ns: start bit, data, parity and stop bits.
+ */
+static uint64_t frame_char_ns(DEV_PL011 *dev)
+{
+	unsigned	bits = 1;
+
+	switch (dev->tty.c_cflag & CSIZE) {
+		case CS5: bits += 5; break;
+		case CS6: bits += 6; break;
+		case CS7: bits += 7; break;
+		default:  bits += 8; break;
+	}
+	if (dev->tty.c_cflag & PARENB) {
+		bits++;
+	}
+	bits += (dev->tty.c_cflag & CSTOPB) ? 2 : 1;
+
+	return ((uint64_t)bits * 1000000000ULL) / dev->tty.baud;
+}
+
+/*
+ * Receive timeout, in bit periods, matching the inter-character gap.
+ */
+unsigned frame_timeout(DEV_PL011 *dev)
+{
+	uint64_t	bits;
+
+	bits = ((uint64_t)dev->frame_gap * dev->tty.baud + 999999ULL) / 1000000ULL;
+	if (bits < 1ULL) {
+		bits = 1ULL;
+	}
+	if (bits > 0x1ffULL) {
+		bits = 0x1ffULL;
+	}
+	return (unsigned)bits;
+}
+
+static void frame_getc(DEV_PL011 *dev, serpl011_frame_t *cur)
+{
+	unsigned	key, rsr;
+
+	key = read_pl011(dev, PL011_DR);
+	rsr = key & PL011_RX_ERROR;
+
+	if (rsr != 0) {
+		write_pl011(dev, PL011_ECR, 0);
+		if (rsr & PL011_DR_OE)
+			cur->flags |= SERPL011_FRAME_OVERRUN;
+		if (rsr & PL011_DR_BE)
+			cur->flags |= SERPL011_FRAME_BREAK;
+		if (rsr & PL011_DR_PE)
+			cur->flags |= SERPL011_FRAME_PARITY;
+		if (rsr & PL011_DR_FE)
+			cur->flags |= SERPL011_FRAME_FRAMING;
+	}
+
+	if (cur->len < SERPL011_FRAME_MAX) {
+		cur->data[cur->len++] = (uint8_t)key;
+	} else {
+		cur->flags |= SERPL011_FRAME_TRUNCATED;
+	}
+}
+
+/*
+ * io-char does not tell the driver when a client closes its descriptor, so
+ * check that the client that asked for the event still holds its connection
+ * and drop the registration otherwise.
+ */
+static void frame_deliver(PL011_FRAMES *frames)
+{
+	struct _client_info	info;
+
+	if (frames->notify_rcvid == -1) {
+		return;
+	}
+	if ((ConnectClientInfo(frames->notify_scoid, &info, 0) == -1) ||
+		(info.pid != frames->notify_pid) ||
+		(MsgDeliverEvent(frames->notify_rcvid, &frames->notify_event) == -1)) {
+		frames->notify_rcvid = -1;
+	}
+}
+
+static void frame_complete(DEV_PL011 *dev)
+{
+	PL011_FRAMES		*frames = dev->frames;
+	serpl011_frame_t	*cur = &frames->cur;
+
+	if (cur->len == 0 && cur->flags == 0) {
+		return;
+	}
+	cur->end = frame_time();
+
+	if (frames->cnt == FRAME_SLOTS) {
+		frames->dropped++;
+	} else {
+		serpl011_frame_t *slot = &frames->slot[frames->head];
+
+		memcpy(slot, cur, offsetof(serpl011_frame_t, data) + cur->len);
+		slot->dropped = frames->dropped;
+		frames->dropped = 0;
+		frames->head = (frames->head + 1) % FRAME_SLOTS;
+		frames->cnt++;
+
+		frame_deliver(frames);
+	}
+
+	cur->len = 0;
+	cur->flags = 0;
+}
+
+void frame_rx_interrupt(DEV_PL011 *dev, unsigned iir)
+{
+	PL011_FRAMES		*frames = dev->frames;
+	serpl011_frame_t	*cur = &frames->cur;
+	const uint64_t		now = frame_time();
+	unsigned			level, n;
+	int					starting;
+
+	pthread_mutex_lock(&frames->mutex);
+
+	/*
+	 * A frame only starts on the first character of an interrupt, the
+	 * previous one was closed by RTMIS with the FIFO drained.
+	 */
+	starting = (cur->len == 0) && (cur->flags == 0);
+
+	if (iir & PL011_MIS_RTMIS) {
+		/*
+		 * The line has been idle for the gap: drain the FIFO and close
+		 * the frame.
+		 */
+		n = 0;
+		while ((read_pl011(dev, PL011_FR) & PL011_FR_RXFE) == 0) {
+			frame_getc(dev, cur);
+			n++;
+		}
+		if (starting && (n != 0)) {
+			/* the last character came one receive timeout before now */
+			cur->start = now - ((uint64_t)frame_timeout(dev) * 1000000000ULL) / dev->tty.baud
+						- (n - 1) * frame_char_ns(dev);
+		}
+		frame_complete(dev);
+	} else {
+		/*
+		 * FIFO level interrupt: always leave at least one character in the
+		 * FIFO, the receive timeout only fires on a non-empty FIFO.
+		 */
+		n = (dev->fifo >> 3) & 0x7;
+		if (n >= (sizeof(rx_trigger_eighths) / sizeof(rx_trigger_eighths[0]))) {
+			n = 2;
+		}
+		level = (dev->fifosize * rx_trigger_eighths[n]) / 8;
+		for (n = 1; n < level; n++) {
+			if (read_pl011(dev, PL011_FR) & PL011_FR_RXFE) {
+				break;
+			}
+			frame_getc(dev, cur);
+		}
+		if (starting && (n > 1)) {
+			/* the character left in the FIFO arrived about now */
+			cur->start = now - (n - 1) * frame_char_ns(dev);
+		}
+	}
+
+	pthread_mutex_unlock(&frames->mutex);
+}
+
+static int frame_read(resmgr_context_t *ctp, io_devctl_t *msg, DEV_PL011 *dev)
+{
+	PL011_FRAMES		*frames = dev->frames;
+	serpl011_frame_t	frame;
+	iov_t				iov[2];
+	size_t				nbytes;
+
+	if (msg->i.nbytes < offsetof(serpl011_frame_t, data)) {
+		return EINVAL;
+	}
+
+	pthread_mutex_lock(&frames->mutex);
+	if (frames->cnt == 0) {
+		pthread_mutex_unlock(&frames->mutex);
+		return EAGAIN;
+	}
+	nbytes = offsetof(serpl011_frame_t, data) + frames->slot[frames->tail].len;
+	memcpy(&frame, &frames->slot[frames->tail], nbytes);
+	frames->tail = (frames->tail + 1) % FRAME_SLOTS;
+	frames->cnt--;
+	pthread_mutex_unlock(&frames->mutex);
+
+	if (nbytes > msg->i.nbytes) {
+		nbytes = msg->i.nbytes;
+		frame.flags |= SERPL011_FRAME_TRUNCATED;
+	}
+
+	memset(&msg->o, 0, sizeof(msg->o));
+	msg->o.nbytes = nbytes;
+	SETIOV(&iov[0], &msg->o, sizeof(msg->o));
+	SETIOV(&iov[1], &frame, nbytes);
+	(void)MsgReplyv(ctp->rcvid, EOK, iov, 2);
+
+	return _RESMGR_NOREPLY;
+}
+
+static int frame_notify(resmgr_context_t *ctp, io_devctl_t *msg, DEV_PL011 *dev)
+{
+	PL011_FRAMES	*frames = dev->frames;
+	struct sigevent	*event = _DEVCTL_DATA(msg->i);
+
+	if (msg->i.nbytes < sizeof(*event)) {
+		return EINVAL;
+	}
+
+	pthread_mutex_lock(&frames->mutex);
+	if (event->sigev_notify == SIGEV_NONE) {
+		frames->notify_rcvid = -1;
+	} else {
+		frames->notify_event = *event;
+		frames->notify_rcvid = ctp->rcvid;
+		frames->notify_scoid = ctp->info.scoid;
+		frames->notify_pid = ctp->info.pid;
+		/* Frames may already be pending */
+		if (frames->cnt != 0) {
+			frame_deliver(frames);
+		}
+	}
+	pthread_mutex_unlock(&frames->mutex);
+
+	return EOK;
+}
+
+/*
+ * Driver specific devctls, io-char handles everything else.
+ */
+int ser_devctl(resmgr_context_t *ctp, io_devctl_t *msg, iofunc_ocb_t *ocb)
+{
+	DEV_PL011	*dev = (DEV_PL011 *)ocb->attr;
+
+	switch (msg->i.dcmd) {
+		case DCMD_SERPL011_FRAME_READ:
+			if (dev->frames == NULL) {
+				return ENOTTY;
+			}
+			return frame_read(ctp, msg, dev);
+
+		case DCMD_SERPL011_FRAME_NOTIFY:
+			if (dev->frames == NULL) {
+				return ENOTTY;
+			}
+			return frame_notify(ctp, msg, dev);
+
+		default:
+			break;
+	}
+
+	return _RESMGR_DEFAULT;
+}
@@ -166,6 +166,10 @@ create_device(TTYINIT_PL011 *dip)
     dev->chan_tx = dip->chan_tx;
     dev->port_size = dip->tty.port_shift;
     dev->is_debug_console = dip->is_debug_console;
+    dev->runmask = dip->runmask;
+    dev->intr_thread = dip->intr_thread;
+    dev->intr_ack_base = (uintptr_t)MAP_FAILED;
+    dev->frame_gap = dip->frame_gap;
 
 #ifdef USE_DMA
     if(dev->dma_enable){
@@ -278,6 +282,20 @@ create_device(TTYINIT_PL011 *dip)
         }
     }
 #endif
+    if (dev->frame_gap != 0U) {
+#ifdef USE_DMA
+        if (dev->dma_enable & DMA_RX_ENABLE) {
+            printf("framed receive mode is not supported with RX DMA\n");
+            dev->frame_gap = 0;
+        }
+#endif
+        if ((dev->frame_gap != 0U) && (frame_init(dev) != EOK)) {
+            printf("%s(%d): Memory allocation failed\n", __func__, __LINE__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    dev->tty.io_devctlext = ser_devctl;
+
     /*
      * Map device registers
      */
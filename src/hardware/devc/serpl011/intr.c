@@ -322,11 +322,17 @@ static int do_interrupt(DEV_PL011 *dev)
 	write_pl011(dev, PL011_ICR, iir);
 #ifdef USE_DMA
 	if (!(dev->dma_enable & DMA_RX_ENABLE) && (iir & (PL011_MIS_RTMIS | PL011_MIS_RXMIS))){
-		status |= rx_interrupt(dev);
+		if (dev->frames != NULL)
+			frame_rx_interrupt(dev, iir);
+		else
+			status |= rx_interrupt(dev);
 	}
 #else
 	if (iir & (PL011_MIS_RTMIS | PL011_MIS_RXMIS)){
-		status |= rx_interrupt(dev);
+		if (dev->frames != NULL)
+			frame_rx_interrupt(dev, iir);
+		else
+			status |= rx_interrupt(dev);
 	}
 #endif
 	if (iir & (PL011_MIS_TXMIS|PL011_MIS_TXFES)){
@@ -352,13 +358,110 @@ static int interrupt_event_handler(message_context_t *msgctp, int code, unsigned
 		iochar_send_event(&dev->tty);
 	}
 
-	variant_intr_unmask();
+	variant_intr_unmask(dev);
 
 	InterruptUnmask(dev->intr, dev->iid);
 
 	return (EOK);
 }
 
+typedef struct {
+	DEV_PL011	*dev;
+	sem_t		attached;
+} PL011_INTR_START;
+
+/*
+ * Per-port interrupt service thread.  Used instead of the shared io-char
+ * pulse dispatch when a port has its own priority and/or runmask, so that
+ * a busy port cannot delay interrupt handling on the other ports.
+ * The interrupt is attached here (SIGEV_INTR is delivered to the attaching
+ * thread), ser_attach_intr_thread() waits until that is done.
+ */
+static void *intr_thread(void *data)
+{
+	PL011_INTR_START	*start = data;
+	DEV_PL011			*dev = start->dev;
+	struct sigevent		event;
+
+	if (dev->runmask != 0U) {
+		if (ThreadCtl(_NTO_TCTL_RUNMASK, (void *)(uintptr_t)dev->runmask) == -1) {
+			slogf(_SLOG_SETCODE(_SLOGC_CHAR, 0), _SLOG_WARNING,
+					"%s: Unable to set runmask 0x%x: %s", dev->tty.name, dev->runmask, strerror(errno));
+		}
+	}
+
+	SIGEV_INTR_INIT(&event);
+	dev->iid = InterruptAttachEvent(dev->intr, &event, _NTO_INTR_FLAGS_TRK_MSK);
+	if (dev->iid == -1) {
+		slogf(_SLOG_SETCODE(_SLOGC_CHAR, 0), _SLOG_ERROR,
+				"Unable to attach InterruptEvent: %s", strerror(errno));
+	}
+	sem_post(&start->attached);
+	if (dev->iid == -1) {
+		return NULL;
+	}
+
+	for (;;) {
+		int status;
+
+		if (InterruptWait(0, NULL) == -1)
+			continue;
+
+		/* serialise with the io-char threads calling into tto() */
+		pthread_mutex_lock(&dev->intr_lock);
+		status = do_interrupt(dev);
+		pthread_mutex_unlock(&dev->intr_lock);
+		if (status) {
+			iochar_send_event(&dev->tty);
+		}
+
+		variant_intr_unmask(dev);
+
+		InterruptUnmask(dev->intr, dev->iid);
+	}
+
+	return NULL;
+}
+
+static void ser_attach_intr_thread(DEV_PL011 *dev)
+{
+	pthread_attr_t		tattr;
+	pthread_mutexattr_t	mattr;
+	struct sched_param	param;
+	PL011_INTR_START	start;
+	int					err;
+
+	/* recursive, tx_interrupt() re-enters tto() with the lock held */
+	pthread_mutexattr_init(&mattr);
+	pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&dev->intr_lock, &mattr);
+	pthread_mutexattr_destroy(&mattr);
+
+	start.dev = dev;
+	sem_init(&start.attached, 0, 0);
+
+	pthread_attr_init(&tattr);
+	pthread_attr_setschedpolicy(&tattr, SCHED_RR);
+	param.sched_priority = (dev->prio != 0U) ? (int)dev->prio : DEFAULT_PRIORITY;
+	pthread_attr_setschedparam(&tattr, &param);
+	pthread_attr_setinheritsched(&tattr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setdetachstate(&tattr, PTHREAD_CREATE_DETACHED);
+
+	err = pthread_create(&dev->intr_tid, &tattr, intr_thread, &start);
+	if (err != EOK) {
+		slogf(_SLOG_SETCODE(_SLOGC_CHAR, 0), _SLOG_ERROR,
+				"%s: Unable to create interrupt thread: %s", dev->tty.name, strerror(err));
+		dev->iid = -1;
+	}
+	else {
+		/* the port must have its interrupt before it is attached to io-char */
+		while ((sem_wait(&start.attached) == -1) && (errno == EINTR))
+			;
+	}
+	pthread_attr_destroy(&tattr);
+	sem_destroy(&start.attached);
+}
+
 void
 ser_attach_intr(DEV_PL011 *dev)
 {
@@ -376,6 +479,12 @@ ser_attach_intr(DEV_PL011 *dev)
 	variant_intr_init(dev);
 
 	write_pl011(dev, PL011_ICR, 0x7FF);
+
+	if (dev->intr_thread) {
+		ser_attach_intr_thread(dev);
+		return;
+	}
+
 	/* Associate a pulse which will call the event handler. */
 	if((sigevcode = pulse_attach(ttyctrl.dpp,
 			MSG_FLAG_ALLOC_PULSE, 0, &interrupt_event_handler, dev)) == -1) {
@@ -403,6 +512,9 @@ ser_detach_intr(DEV_PL011 *dev)
 	write_pl011(dev, PL011_CR, 0);
 	write_pl011(dev, PL011_ICR, 0x7FF);
 
+	if (dev->intr_thread && (dev->iid != -1)) {
+		pthread_cancel(dev->intr_tid);
+	}
 	InterruptDetach(dev->iid);
 	dev->intr = _NTO_INTR_SPARE;
 }
@@ -89,6 +89,9 @@ options(int argc, char *argv[])
         .chan_rx = 0,
         .chan_tx = 0,
         .is_debug_console = 0,
+        .runmask = 0,
+        .intr_thread = 0,
+        .frame_gap = 0,
     };
 
     /*
@@ -100,7 +103,7 @@ options(int argc, char *argv[])
         /*
          * Process dash options.
          */
-        while ((opt = getopt(argc, argv, IO_CHAR_SERIAL_OPTIONS "t:T:D")) != -1) {
+        while ((opt = getopt(argc, argv, IO_CHAR_SERIAL_OPTIONS "t:T:DP:R:G:")) != -1) {
             switch (opt) {
                 case 't':
                     errno = EOK;
@@ -130,6 +133,38 @@ options(int argc, char *argv[])
                     devinit.is_debug_console = 1;
                     break;
 
+                case 'P':
+                    errno = EOK;
+                    val = strtoul(optarg, NULL, 0);
+                    if ((errno != EOK) || (val == 0ULL) || (val > 255ULL)) {
+                        (void)fprintf(stderr, "Invalid interrupt thread priority, errno: %d\n", errno);
+                        break;
+                    }
+                    devinit.prio = (unsigned)val;
+                    devinit.intr_thread = 1;
+                    break;
+
+                case 'R':
+                    errno = EOK;
+                    val = strtoul(optarg, NULL, 0);
+                    if (errno != EOK) {
+                        (void)fprintf(stderr, "Invalid interrupt thread runmask, errno: %d\n", errno);
+                        break;
+                    }
+                    devinit.runmask = (unsigned)val;
+                    devinit.intr_thread = 1;
+                    break;
+
+                case 'G':
+                    errno = EOK;
+                    val = strtoul(optarg, NULL, 0);
+                    if (errno != EOK) {
+                        (void)fprintf(stderr, "Invalid inter-character gap, errno: %d\n", errno);
+                        break;
+                    }
+                    devinit.frame_gap = (unsigned)val;
+                    break;
+
                 default:
                     /* the other options has parsed by ttc function */
                     (void)ttc(TTC_SET_OPTION, &devinit, opt);
@@ -172,6 +207,10 @@ options(int argc, char *argv[])
                 devinit.tty.intr = (unsigned)val;
             }
             create_device(&devinit);
+            /* -P and -R only apply to the port that follows them */
+            devinit.prio = 0;
+            devinit.runmask = 0;
+            devinit.intr_thread = 0;
             devinit.tty.unit++;
             ++numports;
             ++optind;
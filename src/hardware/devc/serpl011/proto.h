@@ -52,7 +52,11 @@ void *timer_thread (void *data);
 void *tx_dma_thread (void *data);
 void *query_default_device(TTYINIT_PL011 *dip, void *link);
 int options(int argc, char *argv[]);
+int frame_init(DEV_PL011 *dev);
+unsigned frame_timeout(DEV_PL011 *dev);
+void frame_rx_interrupt(DEV_PL011 *dev, unsigned iir);
+int ser_devctl(resmgr_context_t *ctp, io_devctl_t *msg, iofunc_ocb_t *ocb);
 
 void variant_intr_init(DEV_PL011 *dev);
-void variant_intr_unmask(void);
+void variant_intr_unmask(DEV_PL011 *dev);
 int enable_perms(void);
@@ -0,0 +1,84 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+
+/*
+ * $QNXLicenseC:
+ * Copyright 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+/*
+ *  dcmd_serpl011.h   Non-portable devctl definitions for devc-serpl011
+ *
+*/
+
+#ifndef __DCMD_SERPL011_H_INCLUDED
+#define __DCMD_SERPL011_H_INCLUDED
+
+#ifndef _DEVCTL_H_INCLUDED
+ #include <devctl.h>
+#endif
+
+#include <_pack64.h>
+
+#define SERPL011_FRAME_MAX			512
+
+/*
+ * One received frame, as delimited by an idle line of at least the
+ * configured inter-character gap (framed receive mode, -G option).
+ */
+typedef struct _serpl011_frame {
+	_Uint64t		start;			/* CLOCK_MONOTONIC (ns) first character of the frame was received,
+									   back-dated from the interrupt by the line rate */
+	_Uint64t		end;			/* CLOCK_MONOTONIC (ns) the idle line was detected */
+#define SERPL011_FRAME_TRUNCATED	0x01	/* frame longer than SERPL011_FRAME_MAX */
+#define SERPL011_FRAME_OVERRUN		0x02	/* receive FIFO overrun */
+#define SERPL011_FRAME_BREAK		0x04
+#define SERPL011_FRAME_PARITY		0x08
+#define SERPL011_FRAME_FRAMING		0x10
+	_Uint32t		flags;
+	_Uint32t		len;			/* number of valid bytes in data[] */
+	_Uint32t		dropped;		/* frames lost before this one (ring full) */
+	_Uint32t		rsvd;
+	_Uint8t			data[SERPL011_FRAME_MAX];
+} serpl011_frame_t;
+
+#define DCMD_SERPL011_FRAME_READ		(__DIOF(_DCMD_MISC, 0x01, struct _serpl011_frame))
+#define DCMD_SERPL011_FRAME_NOTIFY		(__DIOT(_DCMD_MISC, 0x02, struct sigevent))
+
+#include <_packpop.h>
+
+#endif
@@ -42,17 +42,14 @@
 
 #include "externs.h"
 
-int
-tto(TTYDEV *ttydev, int action, int arg1)
+static int
+tto_locked(TTYDEV *ttydev, int action, int arg1)
 {
 	TTYBUF			*bup = &ttydev->obuf;
 	DEV_PL011		*dev = (DEV_PL011 *)ttydev;
 	unsigned		reg=0, status = 0;
 	unsigned char	c;
 	int				bytes=0;
-#ifdef USE_DMA
-	static uint32_t byte_cnt = 0;
-#endif
 
 	switch (action) {
 		case TTO_STTY:
@@ -134,6 +131,7 @@ tto(TTYDEV *ttydev, int action, int arg1)
 #ifdef USE_DMA
 	if(dev->dma_enable & DMA_TX_ENABLE){
 		unsigned char *buf = (unsigned char *)dev->buf_tx.vaddr;
+		unsigned byte_cnt = dev->tx_byte_cnt;
 		/* DMA Transaction in progress, wait for ENDTX interrupt */
 		if (dev->dma_state & DMA_TX_ACTIVE){
 			dev->tty.un.s.tx_tmr = 3;		/* Timeout 3 */
@@ -201,7 +199,7 @@ tto(TTYDEV *ttydev, int action, int arg1)
 			/* Configure DMA buffer address and transfer size */
 			dev->dst_tx.len = dev->buf_tx.len = byte_cnt;
 			dev->tinfo_tx.xfer_bytes= byte_cnt;
-			byte_cnt = 0;
+			dev->tx_byte_cnt = 0;
 
 #ifdef MDEBUG
 			TraceEvent(_NTO_TRACE_INSERTSUSEREVENT, 230, dev->tinfo_tx.xfer_bytes, bup->cnt);
@@ -222,6 +220,7 @@ tto(TTYDEV *ttydev, int action, int arg1)
 			}
 #endif
 		}else{
+			dev->tx_byte_cnt = byte_cnt;
 			if (dev->imr & PL011_IMSC_TXIM) {
 				dev->imr &= ~PL011_IMSC_TXIM;
 				write_pl011(dev, PL011_IMSC, dev->imr);
@@ -293,6 +292,23 @@ tto(TTYDEV *ttydev, int action, int arg1)
 	return (tto_checkclients(&dev->tty));
 }
 
+int
+tto(TTYDEV *ttydev, int action, int arg1)
+{
+	DEV_PL011	*dev = (DEV_PL011 *)ttydev;
+	int			status;
+
+	/* A port with its own interrupt thread is not serialised by io-char */
+	if (dev->intr_thread) {
+		pthread_mutex_lock(&dev->intr_lock);
+		status = tto_locked(ttydev, action, arg1);
+		pthread_mutex_unlock(&dev->intr_lock);
+	} else {
+		status = tto_locked(ttydev, action, arg1);
+	}
+	return status;
+}
+
 void ser_stty(DEV_PL011 *dev)
 {
 	unsigned	lcr_h = PL011_LCR_H_FEN;
@@ -371,8 +387,9 @@ void ser_stty(DEV_PL011 *dev)
 
 	if(dev->fifosize && dev->fifo){
 		write_pl011(dev, PL011_IFLS, dev->fifo);	/* set fifo trigger level */
-		write_pl011(dev, PL011_TIMEOUT, 0x1ff);	/* set timeout */
 	}
+	/* set timeout, in framed mode it is the inter-character gap */
+	write_pl011(dev, PL011_TIMEOUT, (dev->frames != NULL) ? frame_timeout(dev) : 0x1ff);
 
 #ifdef USE_DMA
 	if(dev->dma_enable){
@@ -57,8 +57,19 @@ int32_t dwc_i2c_parseopts(dwc_dev_t *dev, const int32_t argc, char *argv[])
     dev->verbose    = _SLOG_ERROR;
     dev->irq        = -1;
     dev->iid        = -1;
+    dev->chid       = -1;
+    dev->coid       = -1;
     dev->sda_hold_time = 0;
     dev->fixed_scl  = 0;
+    dev->poll_thld  = 0;
+    dev->hs_master_code = HS_MASTER_CODE;
+    dev->sample_shm = NULL;
+    dev->scl_gpio   = DWC_NO_GPIO;
+    dev->sda_gpio   = DWC_NO_GPIO;
+    dev->gpio_fd    = -1;
+    dev->xbuf_size  = DWC_XBUF_SIZE;
+    dev->runmask    = 0;
+    dev->nbus       = 0;
 
     dev->fast.high  = FS_THD_HIGH;
     dev->fast.low   = FS_THD_LOW;
@@ -68,10 +79,24 @@ int32_t dwc_i2c_parseopts(dwc_dev_t *dev, const int32_t argc, char *argv[])
     dev->std.low    = SS_THD_LOW;
     dev->std.fall   = SS_SCL_FALL_TIME;
 
+    dev->fastplus.high = FP_THD_HIGH;
+    dev->fastplus.low  = FP_THD_LOW;
+    dev->fastplus.fall = FP_SCL_FALL_TIME;
+
+    dev->high.high  = HS_THD_HIGH;
+    dev->high.low   = HS_THD_LOW;
+    dev->high.fall  = HS_SCL_FALL_TIME;
+
     while ((done == 0) && (ret == 0)) {
         prev_optind = optind;
-        c = getopt(argc, argv, COMMON_OPTIONS_STRING "p:q:");
+        c = getopt(argc, argv, COMMON_OPTIONS_STRING "e:p:q:");
         switch (c) {
+        case (int32_t)'e':
+            if (dwc_i2c_parse_bus(dev, optarg) != 0) {
+                logerr("failed to parse bus %s.\n", optarg);
+                ret = -1;
+            }
+            break;
         case (int32_t)'p':
             errno = 0; /* CERT ERR30-C */
             dev->pbase = strtoul(optarg, NULL, 0);
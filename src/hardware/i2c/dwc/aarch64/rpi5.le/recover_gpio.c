@@ -0,0 +1,296 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include <time.h>
+#include <fcntl.h>
+#include <devctl.h>
+#include <hw/inout.h>
+#include <hw/dcmd_gpio_rp1.h>
+#include "proto.h"
+
+/*
+ * SCL toggle bus recovery through the RP1 GPIO block. The I2C pins are
+ * switched to SYS_RIO and driven open-drain: low through OE with OUT
+ * cleared, high by releasing OE to the bus pull-up. When gpio-rp1 is
+ * running, the pins are switched and claimed through it for the duration
+ * of the recovery, so its other clients are kept off them.
+ */
+
+#define RP1_GPIO_BASE               (0x1f000d0000UL)
+#define RP1_GPIO_SIZE               (0x30000U)
+#define RP1_IO_BANK_OFFSET(bank)    ((bank) * 0x4000U)
+#define RP1_SYS_RIO_BANK_OFFSET(bank) (0x10000U + ((bank) * 0x4000U))
+
+#define RP1_GPIO_IO_REG_CTRL_OFFSET(offset) ((((offset) * 2U) + 1U) * sizeof(uint32_t))
+#define RP1_GPIO_SYS_RIO_REG_OUT_OFFSET     (0x0U)
+#define RP1_GPIO_SYS_RIO_REG_OE_OFFSET      (0x4U)
+#define RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET (0x8U)
+
+#define RP1_SET_OFFSET              (0x2000U)
+#define RP1_CLR_OFFSET              (0x3000U)
+
+#define RP1_FSEL_SYS_RIO            (5U)
+#define RP1_FSEL_MASK               (0x1fU)
+
+/* Recovery is clocked at 100 kHz */
+#define RECOVERY_HALF_PERIOD_ns     (5000UL)
+#define RECOVERY_CLOCKS             (9U)
+
+static const uint32_t rp1_bank_base[] = { 0U, 28U, 34U };
+
+static void rp1_gpio_bank_offset(const uint32_t gpio, uint32_t *bank, uint32_t *offset)
+{
+    if (gpio < rp1_bank_base[1]) {
+        *bank = 0;
+    }
+    else if (gpio < rp1_bank_base[2]) {
+        *bank = 1;
+    }
+    else {
+        *bank = 2;
+    }
+
+    *offset = gpio - rp1_bank_base[*bank];
+}
+
+static uintptr_t rp1_ctrl_reg(const dwc_dev_t *dev, const uint32_t gpio)
+{
+    uint32_t bank, offset;
+
+    rp1_gpio_bank_offset(gpio, &bank, &offset);
+    return dev->gpio_vbase + RP1_IO_BANK_OFFSET(bank) + RP1_GPIO_IO_REG_CTRL_OFFSET(offset);
+}
+
+static uintptr_t rp1_rio_reg(const dwc_dev_t *dev, const uint32_t gpio, const uint32_t reg, uint32_t *bit)
+{
+    uint32_t bank, offset;
+
+    rp1_gpio_bank_offset(gpio, &bank, &offset);
+    *bit = 1U << offset;
+    return dev->gpio_vbase + RP1_SYS_RIO_BANK_OFFSET(bank) + reg;
+}
+
+/* Drive the line low (level 0) or release it (level 1) */
+static void rp1_gpio_drive(const dwc_dev_t *dev, const uint32_t gpio, const uint32_t level)
+{
+    uint32_t    bit;
+    uintptr_t   reg = rp1_rio_reg(dev, gpio, RP1_GPIO_SYS_RIO_REG_OE_OFFSET, &bit);
+
+    out32(reg + ((level == 0U) ? RP1_SET_OFFSET : RP1_CLR_OFFSET), bit);
+    nanospin_ns(RECOVERY_HALF_PERIOD_ns);
+}
+
+int32_t dwc_i2c_gpio_init(dwc_dev_t *dev)
+{
+    void    *ptr;
+
+    if ((dev->scl_gpio == DWC_NO_GPIO) || (dev->sda_gpio == DWC_NO_GPIO)) {
+        return 0;
+    }
+
+    if ((dev->scl_gpio >= RP1_GPIO_NUM) || (dev->sda_gpio >= RP1_GPIO_NUM)) {
+        logerr("%s: invalid recovery GPIO %u:%u", __func__, dev->scl_gpio, dev->sda_gpio);
+        return -1;
+    }
+
+    dev->gpio_fd = open(RP1_GPIO_DEV_NAME, O_RDWR);
+    if (dev->gpio_fd == -1) {
+        if (errno != ENOENT) {
+            logerr("%s: open %s: %s", __func__, RP1_GPIO_DEV_NAME, strerror(errno));
+            return -1;
+        }
+        logfyi("%s not running, recovery GPIOs are not claimed", RP1_GPIO_DEV_NAME);
+    }
+
+    ptr = mmap_device_memory(NULL, RP1_GPIO_SIZE, PROT_READ | PROT_WRITE | PROT_NOCACHE,
+                MAP_SHARED, RP1_GPIO_BASE);
+    if (ptr == MAP_FAILED) {
+        logerr("%s: mmap_device_memory failed", __func__);
+        dwc_i2c_gpio_fini(dev);
+        return -1;
+    }
+
+    dev->gpio_vbase = (uintptr_t)ptr;
+
+    return 0;
+}
+
+void dwc_i2c_gpio_fini(dwc_dev_t *dev)
+{
+    if (dev->gpio_vbase != 0U) {
+        (void)munmap_device_memory((void *)dev->gpio_vbase, RP1_GPIO_SIZE);
+        dev->gpio_vbase = 0;
+    }
+    if (dev->gpio_fd != -1) {
+        (void)close(dev->gpio_fd);
+        dev->gpio_fd = -1;
+    }
+}
+
+/*
+ * Switch the pins to GPIO inputs (released) and claim them from gpio-rp1.
+ * func receives their functions, for dwc_i2c_gpio_release().
+ */
+static int32_t dwc_i2c_gpio_claim(dwc_dev_t *dev, uint8_t func[2])
+{
+    const uint64_t      mask = (1ULL << dev->scl_gpio) | (1ULL << dev->sda_gpio);
+    rp1_gpio_get_t      get = { .mask = mask };
+    rp1_gpio_set_t      set = { .mask = mask, .func = RP1_GPIO_FUNC_IP,
+                                .pull = RP1_GPIO_UNSET, .drive = RP1_GPIO_UNSET };
+    rp1_gpio_claim_t    claim = { .mask = mask };
+    int                 ret;
+
+    ret = devctl(dev->gpio_fd, DCMD_GPIO_RP1_GET, &get, sizeof(get), NULL);
+    if (ret == EOK) {
+        func[0] = get.pin[dev->scl_gpio].func;
+        func[1] = get.pin[dev->sda_gpio].func;
+        ret = devctl(dev->gpio_fd, DCMD_GPIO_RP1_SET, &set, sizeof(set), NULL);
+    }
+    if (ret == EOK) {
+        ret = devctl(dev->gpio_fd, DCMD_GPIO_RP1_CLAIM, &claim, sizeof(claim), NULL);
+        if (ret != EOK) {
+            /* Claimed by another client between the two requests */
+            set.func = func[0];
+            set.mask = 1ULL << dev->scl_gpio;
+            (void)devctl(dev->gpio_fd, DCMD_GPIO_RP1_SET, &set, sizeof(set), NULL);
+            set.func = func[1];
+            set.mask = 1ULL << dev->sda_gpio;
+            (void)devctl(dev->gpio_fd, DCMD_GPIO_RP1_SET, &set, sizeof(set), NULL);
+        }
+    }
+    if (ret != EOK) {
+        logerr("%s: GPIO %u:%u: %s", __func__, dev->scl_gpio, dev->sda_gpio, strerror(ret));
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Hand the pins back to the I2C controller and drop the claim */
+static void dwc_i2c_gpio_release(dwc_dev_t *dev, const uint8_t func[2])
+{
+    rp1_gpio_set_t      set = { .pull = RP1_GPIO_UNSET, .drive = RP1_GPIO_UNSET };
+    rp1_gpio_claim_t    claim = { .mask = 0 };
+
+    set.func = func[0];
+    set.mask = 1ULL << dev->scl_gpio;
+    (void)devctl(dev->gpio_fd, DCMD_GPIO_RP1_SET, &set, sizeof(set), NULL);
+    set.func = func[1];
+    set.mask = 1ULL << dev->sda_gpio;
+    (void)devctl(dev->gpio_fd, DCMD_GPIO_RP1_SET, &set, sizeof(set), NULL);
+
+    (void)devctl(dev->gpio_fd, DCMD_GPIO_RP1_CLAIM, &claim, sizeof(claim), NULL);
+}
+
+/* Level of SDA, -1 if recovery GPIOs are not configured */
+int32_t dwc_i2c_gpio_sda_level(dwc_dev_t *dev)
+{
+    uint32_t    bit;
+    uintptr_t   reg;
+
+    if (dev->gpio_vbase == 0U) {
+        return -1;
+    }
+
+    reg = rp1_rio_reg(dev, dev->sda_gpio, RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET, &bit);
+
+    return ((in32(reg) & bit) != 0U) ? 1 : 0;
+}
+
+/*
+ * Clock SCL until the slave releases SDA (at most 9 times), then generate
+ * a STOP. The pins are handed back to the I2C controller afterwards.
+ */
+int32_t dwc_i2c_gpio_recover(dwc_dev_t *dev)
+{
+    uint32_t    scl_ctrl = 0, sda_ctrl = 0, bit, i;
+    uintptr_t   scl_reg, sda_reg;
+    uint8_t     func[2];
+
+    if (dev->gpio_vbase == 0U) {
+        return -1;
+    }
+
+    scl_reg = rp1_ctrl_reg(dev, dev->scl_gpio);
+    sda_reg = rp1_ctrl_reg(dev, dev->sda_gpio);
+
+    /* Released (OE off, OUT low) before switching the pins to SYS_RIO */
+    out32(rp1_rio_reg(dev, dev->scl_gpio, RP1_GPIO_SYS_RIO_REG_OE_OFFSET, &bit) + RP1_CLR_OFFSET, bit);
+    out32(rp1_rio_reg(dev, dev->scl_gpio, RP1_GPIO_SYS_RIO_REG_OUT_OFFSET, &bit) + RP1_CLR_OFFSET, bit);
+    out32(rp1_rio_reg(dev, dev->sda_gpio, RP1_GPIO_SYS_RIO_REG_OE_OFFSET, &bit) + RP1_CLR_OFFSET, bit);
+    out32(rp1_rio_reg(dev, dev->sda_gpio, RP1_GPIO_SYS_RIO_REG_OUT_OFFSET, &bit) + RP1_CLR_OFFSET, bit);
+    if (dev->gpio_fd != -1) {
+        if (dwc_i2c_gpio_claim(dev, func) != 0) {
+            return -1;
+        }
+    }
+    else {
+        scl_ctrl = in32(scl_reg);
+        sda_ctrl = in32(sda_reg);
+        out32(scl_reg, (scl_ctrl & ~RP1_FSEL_MASK) | RP1_FSEL_SYS_RIO);
+        out32(sda_reg, (sda_ctrl & ~RP1_FSEL_MASK) | RP1_FSEL_SYS_RIO);
+    }
+    nanospin_ns(RECOVERY_HALF_PERIOD_ns);
+
+    for (i = 0; (i < RECOVERY_CLOCKS) && (dwc_i2c_gpio_sda_level(dev) == 0); i++) {
+        rp1_gpio_drive(dev, dev->scl_gpio, 0);
+        rp1_gpio_drive(dev, dev->scl_gpio, 1);
+    }
+
+    /* STOP: SDA low to high while SCL is high */
+    rp1_gpio_drive(dev, dev->scl_gpio, 0);
+    rp1_gpio_drive(dev, dev->sda_gpio, 0);
+    rp1_gpio_drive(dev, dev->scl_gpio, 1);
+    rp1_gpio_drive(dev, dev->sda_gpio, 1);
+
+    if (dev->gpio_fd != -1) {
+        dwc_i2c_gpio_release(dev, func);
+    }
+    else {
+        out32(scl_reg, scl_ctrl);
+        out32(sda_reg, sda_ctrl);
+    }
+
+    logfyi("SCL toggle recovery after %u clocks, SDA %s", i,
+            (dwc_i2c_gpio_sda_level(dev) != 0) ? "released" : "still low");
+
+    return (dwc_i2c_gpio_sda_level(dev) != 0) ? 0 : -1;
+}
@@ -50,4 +50,14 @@
 #define FS_THD_LOW          4700    /* tLOW = 4.7 us */
 #define FS_SCL_FALL_TIME    100     /* scl_falling_time = 0.1 us */
 
+#define FP_THD_HIGH         260     /* tHD;STA = tHIGH  = 0.26 us */
+#define FP_THD_LOW          500     /* tLOW = 0.5 us */
+#define FP_SCL_FALL_TIME    120     /* scl_falling_time = 0.12 us */
+
+#define HS_THD_HIGH         60      /* tHIGH = 0.06 us */
+#define HS_THD_LOW          160     /* tLOW = 0.16 us */
+#define HS_SCL_FALL_TIME    10      /* scl_falling_time = 0.01 us */
+
+#define HS_MASTER_CODE      1       /* high-speed master code 00001xxx, xxx = 1 */
+
 #endif /* VARIANT_H__INCLUDED */
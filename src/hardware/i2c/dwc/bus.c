@@ -0,0 +1,490 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include "proto.h"
+#include <sys/dispatch.h>
+#include <sys/neutrino.h>
+#include <semaphore.h>
+
+/*
+ * Additional buses hosted by the process. The primary bus is served by the
+ * i2c-master library; every additional one gets a thread with its own
+ * resource manager, interrupt and transfer buffer. Its devctl handler serves
+ * the standard I2C requests through the driver functions the library calls
+ * for the primary bus, so the buses behave identically, except that periodic
+ * sampling and GPIO bus recovery are only set up for the primary bus.
+ */
+
+/* sendrecv.c */
+int _i2c_master_sendrecv(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb);
+
+typedef struct dwc_bus {
+    i2c_dev_t               i2c;            // resmgr attribute, as for the primary bus
+    dwc_dev_t               *dev;
+    const dwc_bus_cfg_t     *cfg;
+    pthread_t               tid;
+    sem_t                   ready;
+    int32_t                 status;         // thread start-up result
+    i2c_ocb_t               *lock_ocb;      // holder of DCMD_I2C_LOCK, NULL if unlocked
+    resmgr_connect_funcs_t  connect_funcs;
+    resmgr_io_funcs_t       io_funcs;
+    iofunc_funcs_t          ocb_funcs;
+    iofunc_mount_t          mount;
+} dwc_bus_t;
+
+static i2c_ocb_t *dwc_i2c_ocb_calloc(resmgr_context_t *ctp, i2c_dev_t *attr)
+{
+    i2c_ocb_t   *ocb;
+
+    (void)ctp;
+
+    ocb = calloc(1, sizeof(*ocb));
+    if (ocb != NULL) {
+        ocb->bus_speed = attr->default_bus_speed;
+        ocb->status    = I2C_STATUS_DONE;
+    }
+
+    return ocb;
+}
+
+static void dwc_i2c_ocb_free(i2c_ocb_t *ocb)
+{
+    dwc_bus_t   *bus = (dwc_bus_t *)ocb->hdr.attr;
+
+    if (bus->lock_ocb == ocb) {
+        bus->lock_ocb = NULL;
+    }
+    free(ocb);
+}
+
+/*
+ * Send or receive len bytes following a header of hdrlen bytes in the
+ * devctl data. Requests that do not fit the receive buffer use the transfer
+ * buffer, as in _i2c_master_sendrecv().
+ */
+static int dwc_i2c_bus_xfer(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb,
+                const uint32_t hdrlen, const uint32_t len, const uint32_t stop, const bool read)
+{
+    dwc_bus_t       *bus = (dwc_bus_t *)ocb->hdr.attr;
+    dwc_dev_t       *dev = bus->dev;
+    uint8_t         *buf = (uint8_t *)_IO_INPUT_PAYLOAD(msg) + hdrlen;
+    i2c_status_t    mstatus;
+    ssize_t         n;
+
+    if ((hdrlen + len) > msg->i.nbytes) {
+        return EINVAL;
+    }
+
+    if ((sizeof(*msg) + hdrlen + len) > ctp->msg_max_size) {
+        if (len > dev->xbuf_size) {
+            return EMSGSIZE;
+        }
+        if (!read) {
+            n = resmgr_msgread(ctp, dev->xbuf, len, sizeof(*msg) + hdrlen);
+            if (n < 0) {
+                return errno;
+            }
+            if ((uint32_t)n < len) {
+                return EFAULT;
+            }
+        }
+        buf = dev->xbuf;
+    }
+
+    if (bus->i2c.bus_speed != ocb->bus_speed) {
+        if (dwc_i2c_set_bus_speed(dev, ocb->bus_speed, NULL) == -1) {
+            return EIO;
+        }
+        bus->i2c.bus_speed = ocb->bus_speed;
+    }
+
+    if (len != 0U) {
+        mstatus = read ? dwc_i2c_recv(dev, buf, len, stop) : dwc_i2c_send(dev, buf, len, stop);
+        ocb->status = mstatus;
+        if (mstatus != I2C_STATUS_DONE) {
+            /* General error code, the status is available through a devctl */
+            return EIO;
+        }
+    }
+
+    (void)memset(&msg->o, 0, sizeof(msg->o));
+    if (!read) {
+        return _RESMGR_PTR(ctp, msg, sizeof(*msg));
+    }
+
+    msg->o.ret_val = (int32_t)len;
+    msg->o.nbytes  = hdrlen + len;
+    SETIOV(&ctp->iov[0], msg, sizeof(*msg) + hdrlen);
+    SETIOV(&ctp->iov[1], buf, len);
+    return _RESMGR_NPARTS(2);
+}
+
+/*
+ * Driver specific requests, as the library hands them to the ctl function.
+ * The handlers trust the length they are given, so data the receive buffer
+ * did not take is read into the transfer buffer first.
+ */
+static int dwc_i2c_bus_ctl(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb)
+{
+    dwc_bus_t       *bus = (dwc_bus_t *)ocb->hdr.attr;
+    dwc_dev_t       *dev = bus->dev;
+    void            *data = _IO_INPUT_PAYLOAD(msg);
+    const uint32_t  len = msg->i.nbytes;
+    int             status, nbytes = 0, info = 0;
+    ssize_t         n;
+
+    if ((sizeof(*msg) + len) > (size_t)ctp->info.msglen) {
+        if (len > dev->xbuf_size) {
+            return EMSGSIZE;
+        }
+        n = resmgr_msgread(ctp, dev->xbuf, len, sizeof(*msg));
+        if (n < 0) {
+            return errno;
+        }
+        if ((uint32_t)n < len) {
+            return EFAULT;
+        }
+        data = dev->xbuf;
+    }
+
+    dev->client = ctp->info.pid;
+    status = dwc_i2c_ctl(dev, (int)msg->i.dcmd, data, (int)len, &nbytes, &info);
+    dev->client = 0;
+    if (status != EOK) {
+        return status;
+    }
+
+    (void)memset(&msg->o, 0, sizeof(msg->o));
+    msg->o.ret_val = info;
+    msg->o.nbytes  = (uint32_t)nbytes;
+    if (data == _IO_INPUT_PAYLOAD(msg)) {
+        return _RESMGR_PTR(ctp, msg, sizeof(*msg) + (size_t)nbytes);
+    }
+    SETIOV(&ctp->iov[0], msg, sizeof(*msg));
+    SETIOV(&ctp->iov[1], data, (size_t)nbytes);
+    return _RESMGR_NPARTS(2);
+}
+
+static int dwc_i2c_bus_devctl(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb)
+{
+    dwc_bus_t           *bus = (dwc_bus_t *)ocb->hdr.attr;
+    dwc_dev_t           *dev = bus->dev;
+    void                *data = _IO_INPUT_PAYLOAD(msg);
+    i2c_masterhdr_t     *hdr = data;
+    i2c_addr_t          *addr = data;
+    int                 status, nbytes = 0, info = 0;
+
+    status = iofunc_devctl_default(ctp, msg, ocb);
+    if (status != _RESMGR_DEFAULT) {
+        return status;
+    }
+
+    /* Another client holds the bus for a sequence of requests */
+    if ((bus->lock_ocb != NULL) && (bus->lock_ocb != ocb) && (msg->i.dcmd != DCMD_I2C_DRIVER_INFO)) {
+        return EBUSY;
+    }
+
+    switch (msg->i.dcmd) {
+        case DCMD_I2C_SET_SLAVE_ADDR:
+            if (msg->i.nbytes < sizeof(*addr)) {
+                return EINVAL;
+            }
+            if (dwc_i2c_set_slave_addr(dev, addr->addr, (i2c_addrfmt_t)addr->fmt) == -1) {
+                return EINVAL;
+            }
+            break;
+        case DCMD_I2C_SET_BUS_SPEED:
+            if (msg->i.nbytes < sizeof(uint32_t)) {
+                return EINVAL;
+            }
+            if (dwc_i2c_set_bus_speed(dev, *(uint32_t *)data, NULL) == -1) {
+                return EINVAL;
+            }
+            bus->i2c.bus_speed = *(uint32_t *)data;
+            ocb->bus_speed     = bus->i2c.bus_speed;
+            break;
+        case DCMD_I2C_MASTER_SEND:
+        case DCMD_I2C_MASTER_RECV:
+            if (msg->i.nbytes < sizeof(*hdr)) {
+                return EINVAL;
+            }
+            if (dwc_i2c_set_slave_addr(dev, hdr->slave.addr, (i2c_addrfmt_t)hdr->slave.fmt) == -1) {
+                return EIO;
+            }
+            return dwc_i2c_bus_xfer(ctp, msg, ocb, sizeof(*hdr), hdr->len, hdr->stop,
+                                    (msg->i.dcmd == DCMD_I2C_MASTER_RECV));
+        case DCMD_I2C_SEND:
+            return dwc_i2c_bus_xfer(ctp, msg, ocb, 0, msg->i.nbytes, 1, false);
+        case DCMD_I2C_RECV:
+            return dwc_i2c_bus_xfer(ctp, msg, ocb, 0, msg->i.nbytes, 1, true);
+        case DCMD_I2C_SENDRECV:
+            return _i2c_master_sendrecv(ctp, msg, ocb);
+        case DCMD_I2C_LOCK:
+            bus->lock_ocb = ocb;
+            break;
+        case DCMD_I2C_UNLOCK:
+            bus->lock_ocb = NULL;
+            break;
+        case DCMD_I2C_DRIVER_INFO:
+            if (msg->i.nbytes < sizeof(i2c_driver_info_t)) {
+                return EINVAL;
+            }
+            (void)dwc_i2c_driver_info(dev, data);
+            nbytes = (int)sizeof(i2c_driver_info_t);
+            break;
+        case DCMD_I2C_STATUS:
+            /* Status of the client's last transfer, the failed ones only return EIO */
+            if (msg->i.nbytes < sizeof(uint32_t)) {
+                return EINVAL;
+            }
+            *(uint32_t *)data = (uint32_t)ocb->status;
+            nbytes = (int)sizeof(uint32_t);
+            break;
+        default:
+            return dwc_i2c_bus_ctl(ctp, msg, ocb);
+    }
+
+    (void)memset(&msg->o, 0, sizeof(msg->o));
+    msg->o.ret_val = info;
+    msg->o.nbytes  = (uint32_t)nbytes;
+    return _RESMGR_PTR(ctp, msg, sizeof(*msg) + (size_t)nbytes);
+}
+
+static void *dwc_i2c_bus_thread(void *arg)
+{
+    dwc_bus_t           *bus = arg;
+    resmgr_context_t    *ctp;
+
+    if ((bus->cfg->runmask != 0U) &&
+        (ThreadCtl(_NTO_TCTL_RUNMASK, (void *)(uintptr_t)bus->cfg->runmask) == -1)) {
+        i2c_slogf(bus->dev->verbose, _SLOG_ERROR, "i2c-designware %s: failed to set runmask 0x%x",
+                __func__, bus->cfg->runmask);
+    }
+
+    bus->status = dwc_i2c_attach_intr(bus->dev);
+    if (bus->status == 0) {
+        ctp = dispatch_context_alloc(bus->i2c.dpp);
+        if (ctp == NULL) {
+            dwc_i2c_detach_intr(bus->dev);
+            bus->status = -1;
+        }
+        bus->i2c.ctp = ctp;
+    }
+
+    (void)sem_post(&bus->ready);
+    if (bus->status != 0) {
+        return NULL;
+    }
+
+    while (true) {
+        ctp = dispatch_block(ctp);
+        if (ctp == NULL) {
+            continue;
+        }
+        (void)dispatch_handler(ctp);
+    }
+
+    return NULL;
+}
+
+static void dwc_i2c_bus_free(dwc_bus_t *bus)
+{
+    if (bus->i2c.id != -1) {
+        (void)resmgr_detach(bus->i2c.dpp, bus->i2c.id, _RESMGR_DETACH_ALL);
+    }
+    if (bus->i2c.dpp != NULL) {
+        (void)dispatch_destroy(bus->i2c.dpp);
+    }
+    if (bus->dev != NULL) {
+        dwc_i2c_cleanup(bus->dev);
+    }
+    (void)sem_destroy(&bus->ready);
+    free(bus);
+}
+
+static int32_t dwc_i2c_start_bus(dwc_dev_t *pdev, const dwc_bus_cfg_t *cfg, dwc_bus_t **pbus)
+{
+    dwc_bus_t   *bus;
+    dwc_dev_t   *dev;
+    char        name[32];
+
+    bus = calloc(1, sizeof(*bus));
+    if (bus == NULL) {
+        return -1;
+    }
+    bus->cfg = cfg;
+    bus->i2c.id = -1;
+    (void)sem_init(&bus->ready, 0, 0);
+
+    /* Same device options as the primary bus, but nothing it owns */
+    dev = calloc(1, sizeof(*dev));
+    if (dev == NULL) {
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+    dev->pbase          = cfg->pbase;
+    dev->irq            = cfg->irq;
+    dev->iid            = -1;
+    dev->chid           = -1;
+    dev->coid           = -1;
+    dev->master_cfg     = pdev->master_cfg;
+    dev->clock_khz      = pdev->clock_khz;
+    dev->verbose        = pdev->verbose;
+    dev->sda_hold_time  = pdev->sda_hold_time;
+    dev->fixed_scl      = pdev->fixed_scl;
+    dev->poll_thld      = pdev->poll_thld;
+    dev->hs_master_code = pdev->hs_master_code;
+    dev->fast           = pdev->fast;
+    dev->std            = pdev->std;
+    dev->fastplus       = pdev->fastplus;
+    dev->high           = pdev->high;
+    dev->xbuf_size      = pdev->xbuf_size;
+    dev->scl_gpio       = DWC_NO_GPIO;
+    dev->sda_gpio       = DWC_NO_GPIO;
+    dev->gpio_fd        = -1;
+
+    if (dwc_i2c_lock_init(dev) != EOK) {
+        free(dev);
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+    bus->dev = dev;
+
+    if ((dwc_i2c_probe_device(dev) == -1) || (dwc_i2c_init_controller(dev) != 0)) {
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+
+    /* Resource manager attribute, laid out as the library's */
+    if (i2c_master_getfuncs(&bus->i2c.mfuncs, (int)sizeof(bus->i2c.mfuncs)) != 0) {
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+    bus->i2c.hdl               = dev;
+    bus->i2c.verbosity         = dev->verbose;
+    bus->i2c.default_bus_speed = 100000;
+    bus->i2c.bus_speed         = 100000;
+
+    bus->i2c.dpp = dispatch_create();
+    if (bus->i2c.dpp == NULL) {
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+
+    iofunc_func_init(_RESMGR_CONNECT_NFUNCS, &bus->connect_funcs,
+                     _RESMGR_IO_NFUNCS, &bus->io_funcs);
+    bus->io_funcs.devctl = dwc_i2c_bus_devctl;
+
+    bus->ocb_funcs.nfuncs     = _IOFUNC_NFUNCS;
+    bus->ocb_funcs.ocb_calloc = dwc_i2c_ocb_calloc;
+    bus->ocb_funcs.ocb_free   = dwc_i2c_ocb_free;
+    bus->mount.funcs          = &bus->ocb_funcs;
+
+    iofunc_attr_init(&bus->i2c.hdr, S_IFCHR | 0666, NULL, NULL);
+    bus->i2c.hdr.mount = &bus->mount;
+
+    (void)snprintf(name, sizeof(name), "/dev/i2c%u", cfg->unit);
+    bus->i2c.id = resmgr_attach(bus->i2c.dpp, NULL, name, _FTYPE_ANY, 0,
+                                &bus->connect_funcs, &bus->io_funcs, &bus->i2c.hdr);
+    if (bus->i2c.id == -1) {
+        logerr("%s: resmgr_attach %s: %s", __func__, name, strerror(errno));
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+
+    if (pthread_create(&bus->tid, NULL, dwc_i2c_bus_thread, bus) != EOK) {
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+
+    (void)sem_wait(&bus->ready);
+    if (bus->status != 0) {
+        (void)pthread_join(bus->tid, NULL);
+        dwc_i2c_bus_free(bus);
+        return -1;
+    }
+
+    logfyi("%s served at 0x%lx irq %d", name, cfg->pbase, cfg->irq);
+
+    *pbus = bus;
+
+    return 0;
+}
+
+int32_t dwc_i2c_start_buses(dwc_dev_t *dev)
+{
+    uint32_t    i;
+
+    for (i = 0; i < dev->nbus; i++) {
+        if (dwc_i2c_start_bus(dev, &dev->bus_cfg[i], &dev->bus[i]) != 0) {
+            logerr("%s: failed to start bus %u", __func__, dev->bus_cfg[i].unit);
+            dwc_i2c_stop_buses(dev);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void dwc_i2c_stop_buses(dwc_dev_t *dev)
+{
+    dwc_bus_t   *bus;
+    uint32_t    i;
+
+    for (i = 0; i < dev->nbus; i++) {
+        bus = dev->bus[i];
+        if (bus == NULL) {
+            continue;
+        }
+
+        (void)pthread_cancel(bus->tid);
+        (void)pthread_join(bus->tid, NULL);
+
+        (void)dwc_i2c_enable(bus->dev, DW_IC_ENABLE_STATUS_DISABLE);
+        dwc_i2c_detach_intr(bus->dev);
+        if (bus->i2c.ctp != NULL) {
+            dispatch_context_free(bus->i2c.ctp);
+        }
+
+        dwc_i2c_bus_free(bus);
+        dev->bus[i] = NULL;
+    }
+}
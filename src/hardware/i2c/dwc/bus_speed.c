@@ -42,9 +42,39 @@
 #include "proto.h"
 
 
+/*
+ * Load the timing set selected by the bus speed. Must be called with the
+ * adapter disabled; the registers are only written when the set changes.
+ */
+void dwc_i2c_load_timing(dwc_dev_t *dev)
+{
+    if (dev->timing == dev->timing_loaded) {
+        return;
+    }
+
+    /* Fast plus runs in fast mode with its own counts, HS sends the master code in fast mode */
+    if (dev->timing == DWC_TIMING_FASTPLUS) {
+        i2c_reg_write32(dev, DW_IC_FS_SCL_HCNT, dev->fp_hcnt);
+        i2c_reg_write32(dev, DW_IC_FS_SCL_LCNT, dev->fp_lcnt);
+    } else if ((dev->timing_loaded == DWC_TIMING_FASTPLUS) ||
+               (dev->timing_loaded == DWC_TIMING_NONE)) {
+        i2c_reg_write32(dev, DW_IC_FS_SCL_HCNT, dev->fs_hcnt);
+        i2c_reg_write32(dev, DW_IC_FS_SCL_LCNT, dev->fs_lcnt);
+    } else {
+        /* FS counts already loaded */
+    }
+
+    if (dev->sda_hold[dev->timing] != 0U) {
+        i2c_reg_write32(dev, DW_IC_SDA_HOLD, dev->sda_hold[dev->timing]);
+    }
+
+    dev->timing_loaded = dev->timing;
+}
+
 int32_t dwc_i2c_set_bus_speed(void *hdl, uint32_t speed, uint32_t *ospeed)
 {
     dwc_dev_t   *dev = hdl;
+    uint32_t    cfg, timing;
 
     if (speed == dev->scl_freq) {
         if (ospeed != NULL) {
@@ -54,24 +84,37 @@ int32_t dwc_i2c_set_bus_speed(void *hdl, uint32_t speed, uint32_t *ospeed)
     }
 
     if (speed == 100000U) {
-        dev->scl_freq = 100000;
-
-        /* set the bus speed */
-        dev->master_cfg &= ~DW_IC_CON_SPEED_MASK;
-        dev->master_cfg |= DW_IC_CON_SPEED_STD;
+        cfg = DW_IC_CON_SPEED_STD;
+        timing = DWC_TIMING_STD;
     }
     else if (speed == 400000U) {
-        dev->scl_freq = 400000;
-
-        /* set the bus speed */
-        dev->master_cfg &= ~DW_IC_CON_SPEED_MASK;
-        dev->master_cfg |= DW_IC_CON_SPEED_FAST;
+        cfg = DW_IC_CON_SPEED_FAST;
+        timing = DWC_TIMING_FAST;
+    }
+    else if (speed == 1000000U) {
+        cfg = DW_IC_CON_SPEED_FAST;
+        timing = DWC_TIMING_FASTPLUS;
+    }
+    else if ((speed == 3400000U) && (dev->hs_capable != 0U)) {
+        cfg = DW_IC_CON_SPEED_HIGH;
+        timing = DWC_TIMING_HIGH;
     }
     else {
         errno = ERANGE;
         return -1;
     }
 
+    (void)pthread_mutex_lock(&dev->lock);
+
+    dev->scl_freq = speed;
+    dev->timing = timing;
+
+    /* set the bus speed, the timing set is loaded by the next transfer */
+    dev->master_cfg &= ~DW_IC_CON_SPEED_MASK;
+    dev->master_cfg |= cfg;
+
+    (void)pthread_mutex_unlock(&dev->lock);
+
     if (ospeed != NULL) {
         *ospeed = dev->scl_freq;
     }
@@ -75,6 +75,23 @@ int32_t dwc_i2c_handle_common_option(dwc_dev_t *dev, int32_t opt)
     int32_t ret = 0;
 
     switch (opt) {
+        case (int32_t)'A':
+            errno = 0; /* CERT ERR30-C */
+            dev->runmask = (uint32_t)strtoul(optarg, NULL, 0);
+            if (errno != EOK) {
+                ret = -1;
+                break;
+            }
+            break;
+        case (int32_t)'B':
+            errno = 0; /* CERT ERR30-C */
+            dev->xbuf_size = (uint32_t)strtoul(optarg, NULL, 0);
+            if ((errno != EOK) || (dev->xbuf_size == 0U)) {
+                logerr("invalid transfer buffer size.\n");
+                ret = -1;
+                break;
+            }
+            break;
         case (int32_t)'c':
             errno = 0; /* CERT ERR30-C */
             dev->clock_khz = (uint32_t)strtoul(optarg, NULL, 0) / 1000U;
@@ -89,6 +106,27 @@ int32_t dwc_i2c_handle_common_option(dwc_dev_t *dev, int32_t opt)
                 ret = -1;
             }
             break;
+        case (int32_t)'F':
+            if (parse_scl_timing(&dev->fastplus, optarg) != 0) {
+                logerr("failed to parse SCL timing parameter for fast plus mode.\n");
+                ret = -1;
+            }
+            break;
+        case (int32_t)'g':
+            errno = 0; /* CERT ERR30-C */
+            dev->scl_gpio = (uint32_t)strtoul(optarg, &optarg, 0);
+            if ((errno != EOK) || (*optarg != ':')) {
+                logerr("failed to parse recovery GPIOs.\n");
+                ret = -1;
+                break;
+            }
+            dev->sda_gpio = (uint32_t)strtoul(optarg + 1, NULL, 0);
+            if (errno != EOK) {
+                logerr("failed to parse recovery GPIOs.\n");
+                ret = -1;
+                break;
+            }
+            break;
         case (int32_t)'h':
             errno = 0; /* CERT ERR30-C */
             dev->sda_hold_time = (uint32_t)strtoul(optarg, NULL, 0);
@@ -97,17 +135,43 @@ int32_t dwc_i2c_handle_common_option(dwc_dev_t *dev, int32_t opt)
                 break;
             }
             break;
+        case (int32_t)'H':
+            if (parse_scl_timing(&dev->high, optarg) != 0) {
+                logerr("failed to parse SCL timing parameter for high-speed mode.\n");
+                ret = -1;
+            }
+            break;
 #ifdef DWC_SUPPORT_FIXED_SCL
         case (int32_t)'I':
             dev->fixed_scl = 1;
             break;
 #endif
+        case (int32_t)'m':
+            errno = 0; /* CERT ERR30-C */
+            dev->hs_master_code = (uint32_t)strtoul(optarg, NULL, 0);
+            if ((errno != EOK) || (dev->hs_master_code > DW_IC_HS_MADDR_MASK)) {
+                logerr("invalid high-speed master code.\n");
+                ret = -1;
+                break;
+            }
+            break;
+        case (int32_t)'P':
+            errno = 0; /* CERT ERR30-C */
+            dev->poll_thld = (uint32_t)strtoul(optarg, NULL, 0);
+            if (errno != EOK) {
+                ret = -1;
+                break;
+            }
+            break;
         case (int32_t)'s':
             if (parse_scl_timing(&dev->std, optarg) != 0) {
                 logerr("failed to parse SCL timing parameter for std mode.\n");
                 ret = -1;
             }
             break;
+        case (int32_t)'S':
+            dev->sample_shm = optarg;
+            break;
         case (int32_t)'v':
             dev->verbose++;
             break;
@@ -118,3 +182,46 @@ int32_t dwc_i2c_handle_common_option(dwc_dev_t *dev, int32_t opt)
 
     return ret;
 }
+
+/*
+ * Additional bus: base:irq:unit[:runmask]
+ */
+int32_t dwc_i2c_parse_bus(dwc_dev_t *dev, char *popt)
+{
+    dwc_bus_cfg_t   *cfg;
+
+    if (dev->nbus >= DWC_MAX_BUSES) {
+        logerr("too many buses, at most %u additional ones.\n", DWC_MAX_BUSES);
+        return -1;
+    }
+
+    cfg = &dev->bus_cfg[dev->nbus];
+
+    errno = 0; /* CERT ERR30-C */
+    cfg->pbase = strtoull(popt, &popt, 0);
+    if ((errno != EOK) || (*popt != ':')) {
+        return -1;
+    }
+
+    cfg->irq = (int)strtol(++popt, &popt, 0);
+    if ((errno != EOK) || (*popt != ':')) {
+        return -1;
+    }
+
+    cfg->unit = (uint32_t)strtoul(++popt, &popt, 0);
+    if (errno != EOK) {
+        return -1;
+    }
+
+    cfg->runmask = 0;
+    if (*popt == ':') {
+        cfg->runmask = (uint32_t)strtoul(++popt, &popt, 0);
+        if (errno != EOK) {
+            return -1;
+        }
+    }
+
+    dev->nbus++;
+
+    return 0;
+}
@@ -53,5 +53,11 @@ void dwc_i2c_cleanup(dwc_dev_t *dev)
         dev->vbase = 0;
     }
 
+    dwc_i2c_gpio_fini(dev);
+
+    free(dev->xbuf);
+
+    (void)pthread_mutex_destroy(&dev->lock);
+
     free(dev); /* free device object */
 }
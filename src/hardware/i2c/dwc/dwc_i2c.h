@@ -89,6 +89,8 @@
 #define DW_IC_ENABLE_STATUS                 0x9c
 #define DW_IC_FS_SPKLEN                     0xa0
 #define DW_IC_HS_SPKLEN                     0xa4
+#define DW_IC_SCL_STUCK_AT_LOW_TIMEOUT      0xac
+#define DW_IC_SDA_STUCK_AT_LOW_TIMEOUT      0xb0
 #define DW_IC_COMP_PARAM_1                  0xf4
 #define DW_IC_COMP_VERSION                  0xf8
 #define DW_IC_COMP_TYPE                     0xfc
@@ -101,11 +103,13 @@
 #define DW_IC_CON_MASTER                    0x01u       // must set this bit for I2C master
 #define DW_IC_CON_SPEED_MASK                0x06u       // DW_IC_CON[2:1]
 #define DW_IC_CON_SPEED_STD                 0x02u       // STD:  100KHz
-#define DW_IC_CON_SPEED_FAST                0x04u       // FAST: 400KHz
+#define DW_IC_CON_SPEED_FAST                0x04u       // FAST: 400KHz, FAST PLUS: 1MHz
+#define DW_IC_CON_SPEED_HIGH                0x06u       // HIGH: 3.4MHz
 #define DW_IC_CON_10BITADDR_MASTER          0x10u
 #define DW_IC_CON_7BITADDR_MASTER           0u
 #define DW_IC_CON_RESTART_EN                0x20u
 #define DW_IC_CON_SLAVE_DISABLE             0x40u       // must set this bit for I2C master
+#define DW_IC_CON_BUS_CLEAR_CTRL            0x800u      // SDA/SCL stuck at low detection and recovery
 
 #define DW_IC_TAR_10BITADDR_MASTER          0x1000u     /* 1 << 12 */
 
@@ -134,6 +138,11 @@
 #define DW_IC_FIFO_DEPTH                    256
 #define DW_IC_COMP_PARAM_1_RX_DEPTH_F       8
 #define DW_IC_COMP_PARAM_1_TX_DEPTH_F       16
+#define DW_IC_COMP_PARAM_1_SPEED_MODE_F     2
+#define DW_IC_COMP_PARAM_1_SPEED_MODE_MASK  0x03u
+#define DW_IC_COMP_PARAM_1_SPEED_MODE_HIGH  0x03u
+
+#define DW_IC_HS_MADDR_MASK                 0x07u
 
 #define DW_IC_TX_ABRT_7B_ADDR_NOACK         0x00000001u /* 1 << 0 */
 #define DW_IC_TX_ABRT_10ADDR1_NOACK         0x00000002u /* 1 << 1 */
@@ -147,6 +156,7 @@
 #define DW_IC_TX_ABRT_MASTER_DIS            0x00000800u /* 1 << 11 */
 #define DW_IC_TX_ARBT_LOST                  0x00001000u /* 1 << 12 */
 #define DW_IC_TX_ARBT_USER_ARBT             0x00010000u /* 1 << 16 */
+#define DW_IC_TX_ABRT_SDA_STUCK_AT_LOW      0x00020000u /* 1 << 17 */
 
 #define DW_IC_TX_ABRT_ADDR_NOACK            (DW_IC_TX_ABRT_7B_ADDR_NOACK | \
                                              DW_IC_TX_ABRT_10ADDR1_NOACK | \
@@ -156,6 +166,7 @@
 #define DW_IC_ENABLE_STATUS_ENABLE          0x01u
 #define DW_IC_ENABLE_STATUS_DISABLE         0u
 #define DW_IC_ENABLE_ABORT                  0x02u
+#define DW_IC_ENABLE_SDA_STUCK_RECOVERY     0x08u
 
 
 /*
@@ -192,12 +203,24 @@
 #define DW_IC_STATUS_TFE                    0x04u
 #define DW_IC_STATUS_RFNE                   0x08u
 #define DW_IC_STATUS_RFF                    0x10u
+#define DW_IC_STATUS_SDA_STUCK_NOT_RECOVERED 0x800u
+
+// SDA held low by a slave for this long aborts the transfer (bus clear feature only)
+#define DW_IC_SDA_STUCK_TIMEOUT_ms          10U
 
 #define DW_IC_SDA_HOLD_MIN_VERS             0x3131312AU
 // According to the I2C-bus specification from Philips Semiconductors:
 // A device must internally provide a hold time of at least 300 ns for the SDA signal
 // to bridge the undefined region of the falling edge of SCL.
 #define SDA_HOLD_TIME_VALUE_ns              350U
+// Fast-mode Plus and High-speed mode have a much shorter tLOW, the hold time only
+// needs to bridge the (shorter) SCL fall time there
+#define FP_SDA_HOLD_TIME_VALUE_ns           120U
+#define HS_SDA_HOLD_TIME_VALUE_ns           10U
+
+// Width of spikes to suppress: 50 ns for standard, fast and fast plus mode, 10 ns for high-speed mode
+#define FS_SPKLEN_VALUE_ns                  50U
+#define HS_SPKLEN_VALUE_ns                  10U
 
 #define DW_IC_COMP_TYPE_VALUE               0x44570140U
 
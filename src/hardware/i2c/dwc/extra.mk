@@ -1 +1,6 @@
-USEFILE=$(PROJECT_ROOT)/$(SECTION)/$(CPU)/$(VARIANT1)/Usemsg
\ No newline at end of file
+USEFILE=$(PROJECT_ROOT)/$(SECTION)/$(CPU)/$(VARIANT1)/Usemsg
+EXTRA_INCVPATH += $(PROJECT_ROOT)/$(SECTION)/public
+PUBLIC_INCVPATH += $(wildcard $(PROJECT_ROOT)/$(SECTION)/public )
+
+# Sender of the devctl requests for the ctl function, see lib.c
+LDFLAGS += -Wl,--wrap=_i2c_devctl
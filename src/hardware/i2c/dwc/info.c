@@ -47,6 +47,9 @@ int32_t dwc_i2c_driver_info(void *hdl, i2c_driver_info_t *info)
     const dwc_dev_t* const dev = hdl;
 
     info->speed_mode = (uint32_t)I2C_SPEED_STANDARD | (uint32_t)I2C_SPEED_FAST;
+    if (dev->hs_capable != 0U) {
+        info->speed_mode |= (uint32_t)I2C_SPEED_HIGH;
+    }
     info->addr_mode  = (uint32_t)I2C_ADDRFMT_7BIT | (uint32_t)I2C_ADDRFMT_10BIT;
     info->verbosity  = dev->verbose;
 
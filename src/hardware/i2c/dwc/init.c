@@ -139,7 +139,8 @@ static uint32_t i2c_dw_scl_lcnt(const uint32_t ic_clk, const uint32_t tlow,
 						- 1U + (uint32_t)offset;
 }
 
-int32_t dwc_i2c_bus_active(dwc_dev_t* const dev)
+int32_t dwc_i2c_bus_active(dwc_dev_t* const dev, const uint32_t addr,
+		const i2c_addrfmt_t fmt)
 {
 	/* Wait Bus Idle */
 	int32_t busy_retry = BUSY_RETRY;
@@ -171,16 +172,20 @@ int32_t dwc_i2c_bus_active(dwc_dev_t* const dev)
 		return (int32_t)I2C_STATUS_BUSY;
 	}
 
-	/* Set slave address */
-	if (dev->slave_addr_fmt == I2C_ADDRFMT_7BIT) {
-		i2c_reg_write32(dev, DW_IC_TAR, dev->slave_addr);
+	/* Set slave address, speed and master mode */
+	if (fmt == I2C_ADDRFMT_7BIT) {
+		i2c_reg_write32(dev, DW_IC_TAR, addr);
+		i2c_reg_write32(dev, DW_IC_CON,
+				dev->master_cfg & ~DW_IC_CON_10BITADDR_MASTER);
 	} else {
 		i2c_reg_write32(dev, DW_IC_TAR,
-				dev->slave_addr | DW_IC_TAR_10BITADDR_MASTER);
+				addr | DW_IC_TAR_10BITADDR_MASTER);
+		i2c_reg_write32(dev, DW_IC_CON,
+				dev->master_cfg | DW_IC_CON_10BITADDR_MASTER);
 	}
 
-	/* set speed and master mode */
-	i2c_reg_write32(dev, DW_IC_CON, dev->master_cfg);
+	/* Load the timing set for the bus speed */
+	dwc_i2c_load_timing(dev);
 
 	/* Enforce disabled interrupts (due to HW issues) */
 	i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
@@ -215,7 +220,7 @@ static int32_t map_in_device_registers(dwc_dev_t *dev)
 	return 0;
 }
 
-static void dwc_i2c_set_fifo_threshold(dwc_dev_t *dev)
+static void dwc_i2c_get_fifo_depth(dwc_dev_t *dev)
 {
 	uint32_t reg, tx_fifo_depth, rx_fifo_depth;
 
@@ -224,15 +229,119 @@ static void dwc_i2c_set_fifo_threshold(dwc_dev_t *dev)
 	rx_fifo_depth = ((reg >> DW_IC_COMP_PARAM_1_RX_DEPTH_F) & 0xffU) + 1U;
 
 	dev->fifo_depth = min(tx_fifo_depth, rx_fifo_depth);
+}
 
-	i2c_reg_write32(dev, DW_IC_TX_TL, dev->fifo_depth / 2U);
-	i2c_reg_write32(dev, DW_IC_RX_TL, dev->fifo_depth / 2U);
+/*
+ * Set up the parts of a bus that do not depend on the thread serving it.
+ * dev->lock must be initialized, the options parsed and the device probed.
+ */
+int32_t dwc_i2c_init_controller(dwc_dev_t *dev)
+{
+	uint32_t reg;
+
+	if (map_in_device_registers(dev) != 0) {
+		return -1;
+	}
+
+	if (dwc_i2c_gpio_init(dev) != 0) {
+		return -1;
+	}
+
+	/* check I2C component type*/
+	reg = i2c_reg_read32(dev, DW_IC_COMP_TYPE);
+	if (reg != DW_IC_COMP_TYPE_VALUE) {
+		logerr("%s: Unknown I2C component type: 0x%08x",
+				__func__, reg);
+		return -1;
+	}
+
+	/* Preallocated transfer buffer, keeps allocation out of the transfer path */
+	dev->xbuf = malloc(dev->xbuf_size);
+	if (dev->xbuf == NULL) {
+		logerr("%s: no memory for %u byte transfer buffer",
+				__func__, dev->xbuf_size);
+		return -1;
+	}
+
+	/* Disable the I2C adapter */
+	(void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
+
+	dwc_i2c_init_registers(dev);
+
+	dwc_i2c_stats_clear(dev);
+
+	return 0;
+}
+
+/*
+ * Attach the interrupt. It is delivered as a pulse on a private channel, so
+ * the resource manager thread and the sampler can both wait for it; the
+ * device lock keeps them from waiting at the same time.
+ */
+int32_t dwc_i2c_attach_intr(dwc_dev_t *dev)
+{
+	struct sigevent intrevent;
+
+	dev->chid = ChannelCreate(_NTO_CHF_PRIVATE);
+	if (dev->chid == -1) {
+		logerr("%s: ChannelCreate: %s", __func__, strerror(errno));
+		return -1;
+	}
+
+	dev->coid = ConnectAttach(0, 0, dev->chid, _NTO_SIDE_CHANNEL, 0);
+	if (dev->coid == -1) {
+		logerr("%s: ConnectAttach: %s", __func__, strerror(errno));
+		dwc_i2c_detach_intr(dev);
+		return -1;
+	}
+
+	SIGEV_PULSE_INIT(&intrevent, dev->coid, getprio(0), DWC_PULSE_CODE_INTR, NULL);
+
+	dev->iid = InterruptAttachEvent(dev->irq, &intrevent,
+				_NTO_INTR_FLAGS_TRK_MSK);
+	if (dev->iid == -1) {
+		logerr("%s: InterruptAttachEvent", __func__);
+		dwc_i2c_detach_intr(dev);
+		return -1;
+	}
+	logfyi("connected to IRQ %u", dev->irq);
+
+	return 0;
+}
+
+void dwc_i2c_detach_intr(dwc_dev_t *dev)
+{
+	if (dev->iid != -1) {
+		(void)InterruptDetach(dev->iid);
+		dev->iid = -1;
+	}
+	if (dev->coid != -1) {
+		(void)ConnectDetach(dev->coid);
+		dev->coid = -1;
+	}
+	if (dev->chid != -1) {
+		(void)ChannelDestroy(dev->chid);
+		dev->chid = -1;
+	}
+}
+
+int32_t dwc_i2c_lock_init(dwc_dev_t *dev)
+{
+	pthread_mutexattr_t mattr;
+	int32_t ret;
+
+	/* Recursive, the controller may be re-initialized with the lock held */
+	(void)pthread_mutexattr_init(&mattr);
+	(void)pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+	ret = pthread_mutex_init(&dev->lock, &mattr);
+	(void)pthread_mutexattr_destroy(&mattr);
+
+	return ret;
 }
 
 void* dwc_i2c_init(int argc, char *argv[])
 {
 	dwc_dev_t *dev;
-	uint32_t reg;
 	uintptr_t iolevel;
 
 	iolevel = _NTO_IO_LEVEL_NONE | _NTO_TCTL_IO_LEVEL_INHERIT;
@@ -246,6 +355,11 @@ void* dwc_i2c_init(int argc, char *argv[])
 		return NULL;
 	}
 
+	if (dwc_i2c_lock_init(dev) != EOK) {
+		free(dev);
+		return NULL;
+	}
+
 	if (dwc_i2c_parseopts(dev, argc, argv) == -1) {
 		goto fail_cleanup;
 	}
@@ -254,35 +368,33 @@ void* dwc_i2c_init(int argc, char *argv[])
 		goto fail_cleanup;
 	}
 
-	if (map_in_device_registers(dev) != 0) {
+	if (dwc_i2c_init_controller(dev) != 0) {
 		goto fail_cleanup;
 	}
 
-	/* check I2C component type*/
-	reg = i2c_reg_read32(dev, DW_IC_COMP_TYPE);
-	if (reg != DW_IC_COMP_TYPE_VALUE) {
-		logerr("%s: Unknown I2C component type: 0x%08x",
-				__func__, reg);
+	/* The primary bus is served by this thread */
+	if (dwc_i2c_attach_intr(dev) != 0) {
 		goto fail_cleanup;
 	}
 
-	/* Attach interrupt */
-	struct sigevent intrevent;
-
-	SIGEV_INTR_INIT(&intrevent);
-
-	dev->iid = InterruptAttachEvent(dev->irq, &intrevent,
-				_NTO_INTR_FLAGS_TRK_MSK);
-	if (dev->iid == -1) {
-		logerr("%s: InterruptAttachEvent", __func__);
+	/* Start periodic sampling */
+	if ((dev->sample_shm != NULL) && (dwc_i2c_sample_init(dev) != EOK)) {
+		dwc_i2c_detach_intr(dev);
 		goto fail_cleanup;
 	}
-	logfyi("connected to IRQ %u", dev->irq);
 
-	/* Disable the I2C adapter */
-	(void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
+	/* Start the additional buses, each served by its own thread */
+	if (dwc_i2c_start_buses(dev) != 0) {
+		dwc_i2c_sample_fini(dev);
+		dwc_i2c_detach_intr(dev);
+		goto fail_cleanup;
+	}
 
-	dwc_i2c_init_registers(dev);
+	/* Not inherited, so only the primary bus thread is bound */
+	if ((dev->runmask != 0U) &&
+	    (ThreadCtl(_NTO_TCTL_RUNMASK, (void *)(uintptr_t)dev->runmask) == -1)) {
+		logerr("%s: failed to set runmask 0x%x", __func__, dev->runmask);
+	}
 
 	return dev;
 
@@ -292,6 +404,27 @@ fail_cleanup:
 	return NULL;
 }
 
+/*
+ * SDA hold time in i2c_clk periods for one timing set. It has to stay below
+ * the SCL low count of that set, a user supplied value that does not fit
+ * falls back to the computed one.
+ */
+static uint32_t dwc_i2c_sda_hold(dwc_dev_t *dev, const uint32_t hold_ns,
+		const uint32_t lcnt)
+{
+	const uint32_t min_hold = max(1U,
+			((dev->clock_khz * hold_ns) + 500000U) / 1000000U);
+	uint32_t sda_hold_time = max(dev->sda_hold_time, min_hold);
+
+	if (sda_hold_time >= lcnt) {
+		logerr("%s: SDA hold time %u too large for SCL_LCNT %u",
+			__func__, sda_hold_time, lcnt);
+		sda_hold_time = (min_hold < lcnt) ? min_hold : 0U;
+	}
+
+	return sda_hold_time;
+}
+
 void dwc_i2c_init_registers(dwc_dev_t *dev)
 {
 	uint32_t reg;
@@ -303,6 +436,14 @@ void dwc_i2c_init_registers(dwc_dev_t *dev)
 
 	logfyi("Set clock to %ld Khz", dev->clock_khz);
 
+	/* Spike suppression, the SCL counts must leave room for it */
+	dev->fs_spklen = max(1U, ((dev->clock_khz * FS_SPKLEN_VALUE_ns) + 500000U) / 1000000U);
+	dev->hs_spklen = max(1U, ((dev->clock_khz * HS_SPKLEN_VALUE_ns) + 500000U) / 1000000U);
+
+	reg = i2c_reg_read32(dev, DW_IC_COMP_PARAM_1);
+	dev->hs_capable = (((reg >> DW_IC_COMP_PARAM_1_SPEED_MODE_F) & DW_IC_COMP_PARAM_1_SPEED_MODE_MASK)
+			== DW_IC_COMP_PARAM_1_SPEED_MODE_HIGH) ? 1U : 0U;
+
 #ifdef DWC_SUPPORT_FIXED_SCL
 	/* Set SCL timing parameters for standard-mode */
 	/* Intel Recommended setting; SF Case # 00168315 */
@@ -326,9 +467,6 @@ void dwc_i2c_init_registers(dwc_dev_t *dev)
 	logfyi("DW_IC_SS_SCL_HCNT %08x ", dev->ss_hcnt);
 	logfyi("DW_IC_SS_SCL_LCNT %08x ", dev->ss_lcnt);
 
-	i2c_reg_write32(dev, DW_IC_SS_SCL_HCNT, dev->ss_hcnt);
-	i2c_reg_write32(dev, DW_IC_SS_SCL_LCNT, dev->ss_lcnt);
-
 #ifdef DWC_SUPPORT_FIXED_SCL
 	/* Set SCL timing parameters for fast-mode */
 	/* Intel Recommended setting; SF Case # 00168315 */
@@ -352,19 +490,51 @@ void dwc_i2c_init_registers(dwc_dev_t *dev)
 	logfyi("DW_IC_FS_SCL_HCNT %08x ", dev->fs_hcnt);
 	logfyi("DW_IC_FS_SCL_LCNT %08x ", dev->fs_lcnt);
 
-	i2c_reg_write32(dev, DW_IC_FS_SCL_HCNT, dev->fs_hcnt);
-	i2c_reg_write32(dev, DW_IC_FS_SCL_LCNT, dev->fs_lcnt);
+	/*
+	 * Set SCL timing parameters for fast-mode plus. They share the FS
+	 * registers, which are loaded by dwc_i2c_load_timing().
+	 * The DW core needs HCNT >= SPKLEN + 5 and LCNT >= SPKLEN + 7.
+	 */
+	dev->fp_hcnt = max(dev->fs_spklen + 5U, i2c_dw_scl_hcnt(dev->clock_khz,
+				dev->fastplus.high,
+				dev->fastplus.fall,
+				0,      // 0: DW default, 1: Ideal
+				0));    // No offset
+	dev->fp_lcnt = max(dev->fs_spklen + 7U, i2c_dw_scl_lcnt(dev->clock_khz,
+				dev->fastplus.low,
+				dev->fastplus.fall,
+				0));    // No offset
+
+	logfyi("FP SCL_HCNT %08x ", dev->fp_hcnt);
+	logfyi("FP SCL_LCNT %08x ", dev->fp_lcnt);
+
+	/* Set SCL timing parameters and master code for high-speed mode */
+	if (dev->hs_capable != 0U) {
+		dev->hs_hcnt = max(dev->hs_spklen + 5U, i2c_dw_scl_hcnt(dev->clock_khz,
+					dev->high.high,
+					dev->high.fall,
+					0,      // 0: DW default, 1: Ideal
+					0));    // No offset
+		dev->hs_lcnt = max(dev->hs_spklen + 7U, i2c_dw_scl_lcnt(dev->clock_khz,
+					dev->high.low,
+					dev->high.fall,
+					0));    // No offset
+
+		logfyi("DW_IC_HS_SCL_HCNT %08x ", dev->hs_hcnt);
+		logfyi("DW_IC_HS_SCL_LCNT %08x ", dev->hs_lcnt);
+	}
 
 	/* Configure SDA Hold Time */
-	reg = i2c_reg_read32(dev, DW_IC_COMP_VERSION);
-	if (reg >= DW_IC_SDA_HOLD_MIN_VERS) {
+	(void)memset(dev->sda_hold, 0, sizeof(dev->sda_hold));
+	dev->comp_version = i2c_reg_read32(dev, DW_IC_COMP_VERSION);
+	if (dev->comp_version >= DW_IC_SDA_HOLD_MIN_VERS) {
 #ifdef DWC_SUPPORT_FIXED_SCL
 		/* Intel Recommended setting; SF Case # 00168315 */
 		if (dev->fixed_scl != 0U) {
 			const uint32_t sda_hold_time = 28;
-			i2c_reg_write32(dev, DW_IC_SDA_HOLD, sda_hold_time);
 
-			logfyi("DW_IC_SDA_HOLD %08x ", sda_hold_time);
+			dev->sda_hold[DWC_TIMING_STD] = sda_hold_time;
+			dev->sda_hold[DWC_TIMING_FAST] = sda_hold_time;
 		} else
 #endif
 		{
@@ -372,24 +542,34 @@ void dwc_i2c_init_registers(dwc_dev_t *dev)
 			 * The I2C-bus specification requires at least 300 ns
 			 * for the SDA hold time
 			 */
-			const uint32_t sda_hold_time = max(dev->sda_hold_time,
-					((dev->clock_khz * SDA_HOLD_TIME_VALUE_ns) + 500000U) / 1000000U);
-			if (sda_hold_time < dev->fs_lcnt) {
-				i2c_reg_write32(dev, DW_IC_SDA_HOLD, sda_hold_time);
-
-				logfyi("DW_IC_SDA_HOLD %08x ", sda_hold_time);
-			} else {
-				logerr("%s: SDA hold time %u too large for SCL_LCNT %u",
-					__func__, sda_hold_time, dev->fs_lcnt);
-			}
+			dev->sda_hold[DWC_TIMING_STD] = dwc_i2c_sda_hold(dev,
+					SDA_HOLD_TIME_VALUE_ns, dev->fs_lcnt);
+			dev->sda_hold[DWC_TIMING_FAST] = dev->sda_hold[DWC_TIMING_STD];
 		}
+		dev->sda_hold[DWC_TIMING_FASTPLUS] = dwc_i2c_sda_hold(dev,
+				FP_SDA_HOLD_TIME_VALUE_ns, dev->fp_lcnt);
+		if (dev->hs_capable != 0U) {
+			dev->sda_hold[DWC_TIMING_HIGH] = dwc_i2c_sda_hold(dev,
+					HS_SDA_HOLD_TIME_VALUE_ns, dev->hs_lcnt);
+		}
+
+		logfyi("DW_IC_SDA_HOLD %08x/%08x/%08x ", dev->sda_hold[DWC_TIMING_FAST],
+				dev->sda_hold[DWC_TIMING_FASTPLUS], dev->sda_hold[DWC_TIMING_HIGH]);
 	} else {
 		logerr("%s: Hardware too old to adjust SDA hold time!",
 				__func__);
 	}
 
-	/* Configure Tx/Rx FIFO threshold */
-	dwc_i2c_set_fifo_threshold(dev);
+	/* Get Tx/Rx FIFO depth */
+	dwc_i2c_get_fifo_depth(dev);
+
+	/* Probe for SDA stuck at low recovery, CON only keeps the bit if it is present */
+	i2c_reg_write32(dev, DW_IC_CON, dev->master_cfg | DW_IC_CON_BUS_CLEAR_CTRL);
+	if ((i2c_reg_read32(dev, DW_IC_CON) & DW_IC_CON_BUS_CLEAR_CTRL) != 0U) {
+		dev->bus_clear = 1;
+		dev->master_cfg |= DW_IC_CON_BUS_CLEAR_CTRL;
+		logfyi("SDA stuck at low recovery supported");
+	}
 
 	/* set default bus speed */
 	errno = EOK; /* CERT ERR30-C */
@@ -397,6 +577,46 @@ void dwc_i2c_init_registers(dwc_dev_t *dev)
 		logerr("%s: Failed to set bus speed.", __func__);
 	}
 
+	dwc_i2c_program_registers(dev);
+}
+
+/*
+ * Write the computed configuration to the controller, after init or
+ * after a soft reset. The adapter must be disabled.
+ */
+void dwc_i2c_program_registers(dwc_dev_t *dev)
+{
+	i2c_reg_write32(dev, DW_IC_SS_SCL_HCNT, dev->ss_hcnt);
+	i2c_reg_write32(dev, DW_IC_SS_SCL_LCNT, dev->ss_lcnt);
+
+	if (dev->hs_capable != 0U) {
+		i2c_reg_write32(dev, DW_IC_HS_SCL_HCNT, dev->hs_hcnt);
+		i2c_reg_write32(dev, DW_IC_HS_SCL_LCNT, dev->hs_lcnt);
+		i2c_reg_write32(dev, DW_IC_HS_MADDR, dev->hs_master_code & DW_IC_HS_MADDR_MASK);
+	}
+
+	/* Spike suppression */
+	if (dev->comp_version >= DW_IC_SDA_HOLD_MIN_VERS) {
+		i2c_reg_write32(dev, DW_IC_FS_SPKLEN, dev->fs_spklen);
+		if (dev->hs_capable != 0U) {
+			i2c_reg_write32(dev, DW_IC_HS_SPKLEN, dev->hs_spklen);
+		}
+	}
+
+	/* Let the controller detect a slave holding SDA low */
+	if (dev->bus_clear != 0U) {
+		i2c_reg_write32(dev, DW_IC_SDA_STUCK_AT_LOW_TIMEOUT,
+				dev->clock_khz * DW_IC_SDA_STUCK_TIMEOUT_ms);
+	}
+
+	/* Configure Tx/Rx FIFO threshold */
+	i2c_reg_write32(dev, DW_IC_TX_TL, dev->fifo_depth / 2U);
+	i2c_reg_write32(dev, DW_IC_RX_TL, dev->fifo_depth / 2U);
+
+	/* Registers are at their defaults, load the selected timing set */
+	dev->timing_loaded = DWC_TIMING_NONE;
+	dwc_i2c_load_timing(dev);
+
 	/* Clear and Disable i2c Interrupt */
 	(void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
 	i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
@@ -411,9 +631,13 @@ void dwc_i2c_fini(void *hdl)
 		return;
 	}
 
+	dwc_i2c_stop_buses(dev);
+
+	dwc_i2c_sample_fini(dev);
+
 	(void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
 
-	(void)InterruptDetach(dev->iid);
+	dwc_i2c_detach_intr(dev);
 
 	dwc_i2c_cleanup(dev);
 }
@@ -60,5 +60,29 @@ int i2c_master_getfuncs(i2c_master_funcs_t *funcs, int tabsize)
             version_info, dwc_i2c_version_info, tabsize);
     I2C_ADD_FUNC(i2c_master_funcs_t, funcs,
             driver_info, dwc_i2c_driver_info, tabsize);
+    I2C_ADD_FUNC(i2c_master_funcs_t, funcs,
+            ctl, dwc_i2c_ctl, tabsize);
     return 0;
 }
+
+/*
+    BEWARE: This function wraps _i2c_devctl in lib/i2c/master/devctl.c, the
+            driver is linked with --wrap=_i2c_devctl (see extra.mk). The
+            library hands driver specific requests to the ctl function
+            without the message context, so the sender is recorded here.
+*/
+int __real__i2c_devctl(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb);
+int __wrap__i2c_devctl(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb);
+
+int __wrap__i2c_devctl(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb)
+{
+    i2c_dev_t   *dev = ocb->hdr.attr;
+    dwc_dev_t   *hdl = dev->hdl;
+    int         status;
+
+    hdl->client = ctp->info.pid;
+    status = __real__i2c_devctl(ctp, msg, ocb);
+    hdl->client = 0;
+
+    return status;
+}
@@ -50,8 +50,10 @@
 #include <sys/slog.h>
 #include <sys/slogcodes.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <hw/i2c.h>
 #include "dwc_i2c.h"
+#include <hw/dcmd_i2c_dwc.h>
 
 #ifdef DWC_SUPPORT_PCI
 #include <pci/pci.h>
@@ -63,7 +65,73 @@ struct i2c_ocb;
 #define IOFUNC_OCB_T    struct i2c_ocb
 #include <sys/iofunc.h>
 
-#define COMMON_OPTIONS_STRING   "c:f:h:Is:v"
+#define COMMON_OPTIONS_STRING   "A:B:c:f:F:g:h:H:Im:P:s:S:v"
+
+/* Polled transfers are only used at fast mode speed and above */
+#define DWC_POLL_MIN_SPEED      400000U
+
+/*
+ * One part of a transfer. Segments up to and including one flagged
+ * DWC_SEG_STOP (or the last one) form a transaction on the bus.
+ */
+typedef struct {
+    uint8_t         *buf;
+    uint32_t        len;
+    uint32_t        flags;
+#define DWC_SEG_READ        0x01u
+#define DWC_SEG_STOP        0x02u
+    uint32_t        status;         // i2c_status_t of the segment, 0 if not executed
+} dwc_seg_t;
+
+/*
+ * SCL timing sets. FS_SCL_HCNT/LCNT and SDA_HOLD are shared by fast, fast plus
+ * and (for the master code) high-speed mode, so they are reloaded when the
+ * bus speed selects a different set.
+ */
+#define DWC_TIMING_NONE     0U
+#define DWC_TIMING_STD      1U
+#define DWC_TIMING_FAST     2U
+#define DWC_TIMING_FASTPLUS 3U
+#define DWC_TIMING_HIGH     4U
+#define DWC_TIMING_NUM      5U
+
+#define DWC_NO_GPIO         0xffffffffU
+
+/* Buses hosted by one process, the primary one and up to DWC_MAX_BUSES more */
+#define DWC_MAX_BUSES       6U
+#define DWC_XBUF_SIZE       4096U
+
+typedef struct {
+    uint64_t        pbase;
+    int             irq;
+    uint32_t        unit;           // served as /dev/i2c<unit>
+    uint32_t        runmask;        // CPU affinity of the bus thread, 0 for any
+} dwc_bus_cfg_t;
+
+struct dwc_bus;
+
+/* Jobs that fall due within this window are executed together */
+#define DWC_SAMPLE_PACK_NS  500000U
+/* Interval of the check for jobs whose owner has exited */
+#define DWC_SAMPLE_REAP_NS  1000000000U
+/* Pulse code of the controller interrupt */
+#define DWC_PULSE_CODE_INTR (_PULSE_CODE_MINAVAIL + 1)
+
+typedef struct {
+    i2c_dwc_sample_job_t    req;
+    uint64_t                due;            // next due time, CLOCK_MONOTONIC ns
+    uint32_t                active;
+} dwc_sample_job_t;
+
+typedef struct {
+    pthread_mutex_t         mutex;          // protects the job table
+    pthread_cond_t          cond;           // job table changed or stop requested
+    pthread_t               tid;
+    uint32_t                stop;
+    uint64_t                reap;           // next check for jobs of exited owners, CLOCK_MONOTONIC ns
+    i2c_dwc_sample_ring_t   *ring;
+    dwc_sample_job_t        job[I2C_DWC_SAMPLE_MAX_JOBS];
+} dwc_sampler_t;
 
 struct scl_timing_param {
     uint32_t high;
@@ -86,8 +154,13 @@ typedef struct {
     pci_cap_t       msi;
 #endif
 
-    /* Interrupt */
+    /* Interrupt, delivered as a pulse so any thread holding the lock can wait for it */
     int             iid;
+    int             chid;
+    int             coid;
+
+    /* Serializes controller access between the resource manager and the sampler */
+    pthread_mutex_t lock;
 
     /* Slave address */
     unsigned        slave_addr;
@@ -96,6 +169,8 @@ typedef struct {
     /* SCL timing parameters */
     struct scl_timing_param fast;
     struct scl_timing_param std;
+    struct scl_timing_param fastplus;
+    struct scl_timing_param high;
 
     /* Clock */
     uint32_t        clock_khz;
@@ -103,14 +178,33 @@ typedef struct {
     uint32_t        ss_lcnt;
     uint32_t        fs_hcnt;
     uint32_t        fs_lcnt;
+    uint32_t        fp_hcnt;
+    uint32_t        fp_lcnt;
+    uint32_t        hs_hcnt;
+    uint32_t        hs_lcnt;
+    uint32_t        fs_spklen;
+    uint32_t        hs_spklen;
+    uint32_t        hs_master_code;
+    uint32_t        hs_capable;     // controller supports high-speed mode
     uint32_t        scl_freq;
     uint32_t        sda_hold_time;
+    uint32_t        sda_hold[DWC_TIMING_NUM];   // SDA_HOLD per timing set, 0 if not adjustable
+    uint32_t        timing;         // timing set selected by the bus speed
+    uint32_t        timing_loaded;  // timing set currently in FS_SCL_xCNT/SDA_HOLD
+
+    /* transfer information */
+    dwc_seg_t       *seg;           // segments of the transfer
+    uint32_t        nseg;
+    uint32_t        totlen;         // how many bytes for all segments
+    uint32_t        wr_seg;         // segment and offset of the next cmd for TxFIFO
+    uint32_t        wr_off;
+    uint32_t        rd_seg;         // segment and offset of the next data from RxFIFO
+    uint32_t        rd_off;
 
     /* transaction information */
-    uint8_t         *txbuf;
-    uint8_t         *rxbuf;
+    uint32_t        txn_first;      // first and last segment of the current transaction
+    uint32_t        txn_last;
     uint32_t        xlen;           // how many bytes for total transaction (isend and irecv)
-    uint32_t        txlen;          // how many bytes for slave transmit (isend)
     uint32_t        rxlen;          // how many bytes for slave receive (irecv)
     uint32_t        wrlen;          // how many cmds have been write to TxFIFO
     uint32_t        rdlen;          // how many data have been read from RxFIFO
@@ -122,6 +216,36 @@ typedef struct {
     uint32_t        abort_source;
     uint32_t        fifo_depth;
     uint32_t        fixed_scl;      // To set scl and hold registers to a fixed, Intel-recommended value
+    uint32_t        intr_mask;      // copy of DW_IC_INTR_MASK for the current transfer
+    uint32_t        polled;         // current transfer is polled, interrupts stay masked
+    uint32_t        poll_thld;      // poll transfers up to this many bytes, 0 to disable
+
+    /* Bus recovery */
+    uint32_t        comp_version;
+    uint32_t        bus_clear;      // controller can recover SDA stuck at low
+    uint32_t        scl_gpio;       // GPIOs for SCL toggle recovery, DWC_NO_GPIO if not used
+    uint32_t        sda_gpio;
+    uintptr_t       gpio_vbase;
+    int             gpio_fd;        // GPIO manager connection claiming them during recovery, -1 if none
+    i2c_dwc_recovery_stats_t rec_stats;
+
+    /* Transfer statistics */
+    i2c_dwc_stats_t stats;
+
+    /* Periodic sampling */
+    const char      *sample_shm;    // shared memory object name, NULL if sampling is disabled
+    dwc_sampler_t   *sampler;
+    pid_t           client;         // sender of the devctl being served, 0 outside of one
+
+    /* Transfer buffer for requests that do not fit the receive buffer */
+    uint8_t         *xbuf;
+    uint32_t        xbuf_size;
+
+    /* Additional buses hosted by this process, primary bus only */
+    uint32_t        runmask;        // CPU affinity of the primary bus thread, 0 for any
+    uint32_t        nbus;
+    dwc_bus_cfg_t   bus_cfg[DWC_MAX_BUSES];
+    struct dwc_bus  *bus[DWC_MAX_BUSES];
 } dwc_dev_t;
 
 typedef struct i2c_ocb {
@@ -150,19 +274,37 @@ typedef struct i2c_dev {
 } i2c_dev_t;
 
 void dwc_i2c_reset(dwc_dev_t* const dev);
+uint64_t dwc_i2c_cycles_to_ns(const uint64_t cycles);
+void dwc_i2c_stats_clear(dwc_dev_t* const dev);
+void dwc_i2c_stats_record(dwc_dev_t* const dev, const i2c_status_t status, const uint32_t polled,
+                const uint64_t start);
 void *dwc_i2c_init(int argc, char *argv[]);
 int32_t dwc_i2c_probe_device(dwc_dev_t *dev);
 void dwc_i2c_cleanup(dwc_dev_t *dev);
 uint32_t dwc_i2c_get_input_clock(dwc_dev_t *dev);
 void dwc_i2c_init_registers(dwc_dev_t *dev);
+int32_t dwc_i2c_init_controller(dwc_dev_t *dev);
+int32_t dwc_i2c_attach_intr(dwc_dev_t *dev);
+void dwc_i2c_detach_intr(dwc_dev_t *dev);
+int32_t dwc_i2c_lock_init(dwc_dev_t *dev);
+int32_t dwc_i2c_start_buses(dwc_dev_t *dev);
+void dwc_i2c_stop_buses(dwc_dev_t *dev);
+int32_t dwc_i2c_parse_bus(dwc_dev_t *dev, char *popt);
+void dwc_i2c_program_registers(dwc_dev_t *dev);
+int32_t dwc_i2c_gpio_init(dwc_dev_t *dev);
+void dwc_i2c_gpio_fini(dwc_dev_t *dev);
+int32_t dwc_i2c_gpio_sda_level(dwc_dev_t *dev);
+int32_t dwc_i2c_gpio_recover(dwc_dev_t *dev);
 void dwc_i2c_fini(void *hdl);
 void i2c_reg_write32(dwc_dev_t* const dev, const uint32_t offset, const uint32_t value);
 uint32_t i2c_reg_read32(dwc_dev_t* const dev, const uint32_t offset);
 i2c_status_t dwc_i2c_wait_complete(dwc_dev_t* const dev);
+i2c_status_t dwc_i2c_poll_complete(dwc_dev_t* const dev);
 int32_t dwc_i2c_enable(dwc_dev_t* const dev, const uint32_t enable);
-int32_t dwc_i2c_bus_active(dwc_dev_t* const dev);
+int32_t dwc_i2c_bus_active(dwc_dev_t* const dev, const uint32_t addr, const i2c_addrfmt_t fmt);
 int32_t dwc_i2c_parseopts(dwc_dev_t *dev, const int32_t argc, char *argv[]);
 int32_t dwc_i2c_set_slave_addr(void *hdl, uint32_t addr, i2c_addrfmt_t fmt);
+void dwc_i2c_load_timing(dwc_dev_t *dev);
 int32_t dwc_i2c_set_bus_speed(void *hdl, uint32_t speed, uint32_t *ospeed);
 int32_t dwc_i2c_version_info(i2c_libversion_t *version);
 int32_t dwc_i2c_driver_info(void *hdl, i2c_driver_info_t *info);
@@ -170,6 +312,15 @@ int32_t dwc_i2c_wait_bus_not_busy(dwc_dev_t* const dev);
 i2c_status_t dwc_i2c_send(void *hdl, void *buf, uint32_t len, uint32_t stop);
 i2c_status_t dwc_i2c_recv(void *hdl, void *buf, uint32_t len, uint32_t stop);
 int32_t dwc_i2c_handle_common_option(dwc_dev_t *dev, int32_t opt);
+void dwc_i2c_next_txn(dwc_dev_t* const dev);
+i2c_status_t dwc_i2c_xfer(dwc_dev_t* const dev, dwc_seg_t *seg, uint32_t nseg);
+i2c_status_t dwc_i2c_xfer_slave(dwc_dev_t* const dev, const uint32_t addr, const i2c_addrfmt_t fmt,
+                dwc_seg_t *seg, uint32_t nseg);
+int dwc_i2c_sample_init(dwc_dev_t *dev);
+void dwc_i2c_sample_fini(dwc_dev_t *dev);
+int dwc_i2c_sample_add(dwc_dev_t *dev, i2c_dwc_sample_job_t *req, pid_t owner);
+int dwc_i2c_sample_del(dwc_dev_t *dev, uint32_t id, pid_t owner);
+int dwc_i2c_ctl(void *hdl, int cmd, void *msg, int msglen, int *nbytes, int *info);
 
 static inline
 bool xmit_FIFO_is_full(dwc_dev_t *dev)
@@ -177,6 +328,15 @@ bool xmit_FIFO_is_full(dwc_dev_t *dev)
     return (i2c_reg_read32(dev, DW_IC_STATUS) & DW_IC_STATUS_TFNF) == 0U;
 }
 
+static inline
+void dwc_i2c_set_intr_mask(dwc_dev_t *dev, uint32_t mask)
+{
+    dev->intr_mask = mask;
+    if (dev->polled == 0U) {
+        i2c_reg_write32(dev, DW_IC_INTR_MASK, mask);
+    }
+}
+
 #define logerr(fmt, ...) \
     (i2c_slogf((dev)->verbose, _SLOG_ERROR, \
            "i2c-designware " fmt, ##__VA_ARGS__))
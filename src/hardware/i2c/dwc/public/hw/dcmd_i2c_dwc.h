@@ -0,0 +1,221 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+/*
+ *  dcmd_i2c_dwc.h   Driver specific devctl definitions for i2c-dwc
+ *
+ */
+
+#ifndef __DCMD_I2C_DWC_H_INCLUDED
+#define __DCMD_I2C_DWC_H_INCLUDED
+
+#ifndef _DEVCTL_H_INCLUDED
+ #include <devctl.h>
+#endif
+
+#include <hw/i2c.h>
+
+#include <_pack64.h>
+
+#define I2C_DWC_XFER_MAX_SEGS       64
+
+/*
+ * One segment of a combined transfer.
+ *
+ * Consecutive segments to the same slave are executed back to back in one
+ * adapter session, separated by a RESTART unless the segment asks for a
+ * STOP.  A change of slave address always ends the previous segment with a
+ * STOP.  The last segment always ends with a STOP.
+ */
+typedef struct _i2c_dwc_seg {
+    i2c_addr_t      slave;
+#define I2C_DWC_SEG_READ            0x0001  /* master receive, otherwise master transmit */
+#define I2C_DWC_SEG_STOP            0x0002  /* STOP after this segment */
+    _Uint32t        flags;
+    _Uint32t        len;                    /* number of bytes, must not be 0 */
+    _Uint32t        status;                 /* out: i2c_status_t, 0 if not executed */
+    _Uint32t        rsvd;
+} i2c_dwc_seg_t;
+
+/*
+ * DCMD_I2C_DWC_XFER message layout:
+ *   i2c_dwc_xfer_t     header
+ *   i2c_dwc_seg_t      seg[nsegs]
+ *   _Uint8t            data[]      the data of all segments in order; write
+ *                                  data is supplied by the client, read data
+ *                                  is returned in place
+ * Execution stops at the first segment that fails.
+ */
+typedef struct _i2c_dwc_xfer {
+    _Uint32t        nsegs;
+    _Uint32t        status;                 /* out: I2C_STATUS_DONE or the status of the failing segment */
+} i2c_dwc_xfer_t;
+
+#define DCMD_I2C_DWC_XFER           (__DIOTF(_DCMD_I2C, 0x80, struct _i2c_dwc_xfer))
+
+/*
+ * Periodic sampling.
+ *
+ * A sampling job writes wlen bytes (e.g. a register address) to the slave
+ * and, after a RESTART, reads rlen bytes back, every period_us (at least
+ * I2C_DWC_SAMPLE_MIN_PERIOD).  Either length may be 0 but not both.  Jobs
+ * run at the current bus speed.  Jobs are run by the driver; jobs that fall
+ * due together are executed back to back.  Every result is published in
+ * the shared memory ring named by the driver's -S option, which clients
+ * map read-only.
+ *
+ * The process sending DCMD_I2C_DWC_SAMPLE_ADD owns the job, only it can
+ * delete it.  The i2c-master library does not report closes to the driver,
+ * so a job lives until DCMD_I2C_DWC_SAMPLE_DEL or until its owner process
+ * exits; jobs of an exited owner are removed within a second.
+ */
+#define I2C_DWC_SAMPLE_MAX_JOBS     16
+#define I2C_DWC_SAMPLE_MIN_PERIOD   100         /* us */
+#define I2C_DWC_SAMPLE_MAX_WRITE    8
+#define I2C_DWC_SAMPLE_MAX_READ     32
+#define I2C_DWC_SAMPLE_SLOTS        256
+#define I2C_DWC_SAMPLE_MAGIC        0x53435749  /* "IWCS" */
+
+typedef struct _i2c_dwc_sample_job {
+    i2c_addr_t      slave;
+    _Uint32t        period_us;
+    _Uint32t        wlen;
+    _Uint32t        rlen;
+    _Uint32t        id;                     /* out: job id for the ring and DCMD_I2C_DWC_SAMPLE_DEL */
+    _Int32t         pid;                    /* out: owner, its jobs are removed when it exits */
+    _Uint8t         wdata[I2C_DWC_SAMPLE_MAX_WRITE];
+} i2c_dwc_sample_job_t;
+
+typedef struct _i2c_dwc_sample {
+    _Uint64t        seq;                    /* sequence number, 0 while the slot is being written */
+    _Uint64t        timestamp;              /* CLOCK_MONOTONIC in ns at completion of the transfer */
+    _Uint32t        id;                     /* job id */
+    _Uint32t        status;                 /* i2c_status_t of the transfer */
+    _Uint8t         data[I2C_DWC_SAMPLE_MAX_READ];
+} i2c_dwc_sample_t;
+
+/*
+ * Sample n (n >= 1) is stored in slot[(n - 1) % nslots]; seq is the number
+ * of the latest complete sample.  A reader copies a slot and accepts it if
+ * the slot's seq is the expected one both before and after the copy.
+ */
+typedef struct _i2c_dwc_sample_ring {
+    _Uint32t        magic;
+    _Uint32t        nslots;
+    _Uint64t        seq;
+    i2c_dwc_sample_t slot[I2C_DWC_SAMPLE_SLOTS];
+} i2c_dwc_sample_ring_t;
+
+#define DCMD_I2C_DWC_SAMPLE_ADD     (__DIOTF(_DCMD_I2C, 0x81, struct _i2c_dwc_sample_job))
+#define DCMD_I2C_DWC_SAMPLE_DEL     (__DIOT(_DCMD_I2C, 0x82, _Uint32t))
+
+/*
+ * Bus recovery statistics. A recovery aborts the transfer in progress,
+ * releases a slave holding SDA low (controller bus clear or SCL toggling
+ * through GPIO) and falls back to a controller soft reset only if the
+ * adapter does not respond.
+ */
+typedef struct _i2c_dwc_recovery_stats {
+    _Uint32t        recoveries;             /* number of recoveries */
+    _Uint32t        bus_clears;             /* SDA released by the controller bus clear */
+    _Uint32t        scl_toggles;            /* SDA released by toggling SCL through GPIO */
+    _Uint32t        soft_resets;            /* controller soft resets */
+    _Uint32t        failures;               /* SDA still low after recovery */
+    _Uint32t        rsvd;
+    _Uint64t        last_ns;                /* duration of the last recovery */
+    _Uint64t        max_ns;                 /* longest recovery */
+    _Uint64t        total_ns;               /* time spent in recovery */
+} i2c_dwc_recovery_stats_t;
+
+#define DCMD_I2C_DWC_RECOVERY_STATS (__DIOF(_DCMD_I2C, 0x83, struct _i2c_dwc_recovery_stats))
+
+/*
+ * Transfer statistics, kept per bus since the driver started or the last
+ * DCMD_I2C_DWC_STATS_CLEAR.  Transfers are counted by operation (write
+ * only, read only, or both in one transfer, e.g. DCMD_I2C_SENDRECV) and by
+ * outcome.  Latency is the time the driver waits for the transfer to
+ * complete on the bus; wire_ns is the sum of the bus time the transfers
+ * would take at the bus speed without clock stretching.
+ *
+ * Histograms are log2: latency bucket n counts transfers that took
+ * [2^n, 2^(n+1)) us (bucket 0 includes shorter ones), size bucket n counts
+ * transfers of [2^n, 2^(n+1)) bytes.  The last bucket also counts anything
+ * beyond it.
+ */
+#define I2C_DWC_STATS_OP_SEND       0
+#define I2C_DWC_STATS_OP_RECV       1
+#define I2C_DWC_STATS_OP_SENDRECV   2
+#define I2C_DWC_STATS_OP_NUM        3
+
+#define I2C_DWC_STATS_RES_DONE      0
+#define I2C_DWC_STATS_RES_NACK      1   /* address or data not acknowledged */
+#define I2C_DWC_STATS_RES_ARBL      2   /* arbitration lost */
+#define I2C_DWC_STATS_RES_TIMEOUT   3   /* bus busy or transfer did not complete */
+#define I2C_DWC_STATS_RES_ERROR     4   /* any other abort or error */
+#define I2C_DWC_STATS_RES_NUM       5
+
+#define I2C_DWC_STATS_LAT_BUCKETS   24
+#define I2C_DWC_STATS_SIZE_BUCKETS  16
+
+typedef struct _i2c_dwc_op_stats {
+    _Uint64t        count[I2C_DWC_STATS_RES_NUM];
+    _Uint64t        bytes;                  /* bytes of the completed transfers */
+    _Uint64t        polled;                 /* transfers that started in polled mode */
+    _Uint64t        total_ns;               /* sum of the latencies */
+    _Uint64t        max_ns;                 /* longest latency */
+    _Uint64t        wire_ns;                /* estimated bus time */
+    _Uint32t        lat_hist[I2C_DWC_STATS_RES_NUM][I2C_DWC_STATS_LAT_BUCKETS];
+    _Uint32t        size_hist[I2C_DWC_STATS_SIZE_BUCKETS];
+} i2c_dwc_op_stats_t;
+
+typedef struct _i2c_dwc_stats {
+    _Uint64t        start_ns;               /* CLOCK_MONOTONIC time the statistics started */
+    _Uint32t        bus_speed;              /* current bus speed */
+    _Uint32t        rsvd;
+    _Uint32t        abort_src[32];          /* transfers aborted per TX_ABRT_SOURCE bit */
+    i2c_dwc_op_stats_t op[I2C_DWC_STATS_OP_NUM];
+} i2c_dwc_stats_t;
+
+#define DCMD_I2C_DWC_STATS          (__DIOF(_DCMD_I2C, 0x84, struct _i2c_dwc_stats))
+#define DCMD_I2C_DWC_STATS_CLEAR    (__DION(_DCMD_I2C, 0x85))
+
+#include <_packpop.h>
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include "proto.h"
+#include <unistd.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+
+#define RESET_RETRY (3)
+
+uint64_t dwc_i2c_cycles_to_ns(const uint64_t cycles)
+{
+    return (cycles * 1000000000ULL) / SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+}
+
+/*
+ * Abort the transfer in progress. The controller flushes the FIFO and
+ * issues a STOP after the current byte; the ABORT bit clears when done.
+ */
+static void dwc_i2c_abort(dwc_dev_t *const dev)
+{
+    const uint64_t limit = ClockCycles() + (SYSPAGE_ENTRY(qtime)->cycles_per_sec / 1000U);
+
+    if ((i2c_reg_read32(dev, DW_IC_ENABLE_STATUS) & DW_IC_ENABLE_STATUS_ENABLE_MASK) == 0U) {
+        return;
+    }
+
+    i2c_reg_write32(dev, DW_IC_ENABLE, DW_IC_ENABLE_ABORT | DW_IC_ENABLE_STATUS_ENABLE);
+
+    while ((i2c_reg_read32(dev, DW_IC_ENABLE) & DW_IC_ENABLE_ABORT) != 0U) {
+        if (ClockCycles() > limit) {
+            logerr("%s: abort did not complete\n", __func__);
+            break;
+        }
+    }
+
+    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
+}
+
+/*
+ * Let the controller clock SCL (up to 9 times) until the slave releases
+ * SDA, followed by a STOP. The adapter must be enabled.
+ */
+static int32_t dwc_i2c_bus_clear(dwc_dev_t *const dev)
+{
+    const uint64_t limit = ClockCycles() + (SYSPAGE_ENTRY(qtime)->cycles_per_sec / 1000U);
+
+    i2c_reg_write32(dev, DW_IC_ENABLE, DW_IC_ENABLE_SDA_STUCK_RECOVERY | DW_IC_ENABLE_STATUS_ENABLE);
+
+    while ((i2c_reg_read32(dev, DW_IC_ENABLE) & DW_IC_ENABLE_SDA_STUCK_RECOVERY) != 0U) {
+        if (ClockCycles() > limit) {
+            logerr("%s: SDA stuck recovery did not complete\n", __func__);
+            return -1;
+        }
+    }
+
+    if ((i2c_reg_read32(dev, DW_IC_STATUS) & DW_IC_STATUS_SDA_STUCK_NOT_RECOVERED) != 0U) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static bool dwc_i2c_sda_stuck(dwc_dev_t *const dev)
+{
+    if ((dev->abort_source & DW_IC_TX_ABRT_SDA_STUCK_AT_LOW) != 0U) {
+        return true;
+    }
+
+    return (dwc_i2c_gpio_sda_level(dev) == 0);
+}
+
+static void dwc_i2c_soft_reset(dwc_dev_t *const dev)
+{
+    int32_t reset_retry = RESET_RETRY;
+
+    do {
+
+        /* Perform soft reset.
+         * Notes:
+         * If the driver isn’t using DMA, then it is OK to just leave iDMA in Reset.
+         * To be 100% sure the DMA is not being used, read register BAR0 + 0xB98
+         * (DMACFGREG) bit[0], which is the DMA enable bit. If it is '0', then no
+         * need to worry about any pending transactions.
+         * At the time this soft reset was added, DMACFGREG is 0. So DMA is NOT being
+         * used.
+         * Additionally, in case DMA support is added in the future, there is a need
+         * to check whether or not DMA transactions need to be stopped before performing
+         * soft reset.
+         */
+
+        logfyi("Assert soft reset. retry=%d\n", reset_retry);
+        i2c_reg_write32(dev, DW_IC_SOFT_RESET, DW_IC_SOFT_RESET_ASSERTED);
+        (void)usleep(25); //Just miniscule delay
+
+        logfyi("De-assert soft reset.\n");
+        i2c_reg_write32(dev, DW_IC_SOFT_RESET, DW_IC_SOFT_RESET_NOT_ASSERTED);
+
+        logfyi("Re-initializing...");
+        if (dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE) == 0) {
+            /* The configuration is already computed, just write it back */
+            dwc_i2c_program_registers(dev);
+            logfyi("I2C reinitialized.\n");
+            return;
+        }
+        else {
+            logerr("Failed to reinitialize!\n");
+        }
+    } while (--reset_retry > 0);
+
+    logerr("I2C failed to reset!\n");
+}
+
+/*
+ * Recover the controller and the bus after a failed transfer.
+ */
+void dwc_i2c_reset(dwc_dev_t *const dev)
+{
+    i2c_dwc_recovery_stats_t    *st = &dev->rec_stats;
+    const uint64_t              start = ClockCycles();
+    uint64_t                    ns;
+    int32_t                     ret;
+
+    st->recoveries++;
+
+    /* Abort the I2C transfer */
+    dwc_i2c_abort(dev);
+
+    /* Release a slave that holds SDA low */
+    if (dwc_i2c_sda_stuck(dev)) {
+        ret = -1;
+        if ((dev->bus_clear != 0U) &&
+            ((i2c_reg_read32(dev, DW_IC_ENABLE_STATUS) & DW_IC_ENABLE_STATUS_ENABLE_MASK) != 0U)) {
+            ret = dwc_i2c_bus_clear(dev);
+            if (ret == 0) {
+                st->bus_clears++;
+            }
+        }
+        if (ret != 0) {
+            /* Disable the adapter so that it does not see the GPIO activity */
+            (void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
+            ret = dwc_i2c_gpio_recover(dev);
+            if (ret == 0) {
+                st->scl_toggles++;
+            }
+        }
+        if (ret != 0) {
+            st->failures++;
+            logerr("%s: SDA stuck at low\n", __func__);
+        }
+    }
+
+    /* Disable the adapter, its configuration is kept unless it needs a soft reset */
+    if (dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE) != 0) {
+        st->soft_resets++;
+        dwc_i2c_soft_reset(dev);
+    }
+
+    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
+
+    ns = dwc_i2c_cycles_to_ns(ClockCycles() - start);
+    st->last_ns = ns;
+    st->max_ns = max(st->max_ns, ns);
+    st->total_ns += ns;
+}
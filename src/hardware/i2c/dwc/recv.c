@@ -45,39 +45,13 @@
 i2c_status_t dwc_i2c_recv(void *hdl, void *buf, uint32_t len, uint32_t stop)
 {
     dwc_dev_t  *dev = hdl;
-    i2c_status_t    ret = I2C_STATUS_ERROR;
+    dwc_seg_t  seg;
 
     (void)stop;
 
-    if (len <= 0U) {
-        return I2C_STATUS_DONE;
-    }
+    seg.buf   = buf;
+    seg.len   = len;
+    seg.flags = DWC_SEG_READ | DWC_SEG_STOP;
 
-    dev->txlen  = 0;                        // how many bytes for slave transmit (isend)
-    dev->rxlen  = len;                      // how many bytes for slave receive (irecv)
-    dev->xlen   = dev->txlen + dev->rxlen;  // how many bytes for total transaction (isend and irecv)
-    dev->wrlen  = 0;                        // how many cmds have been write to TxFIFO
-    dev->rdlen  = 0;                        // how many data have been read from RxFIFO
-    dev->rxbuf  = buf;
-    dev->status = 0;
-
-    /* Active I2C bus */
-    if (0 != dwc_i2c_bus_active(dev)) {
-        return I2C_STATUS_BUSY;
-    }
-
-    /* Clear and enable interrupts */
-    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
-    i2c_reg_write32(dev, DW_IC_INTR_MASK, DW_IC_INTR_DEFAULT_MASK);
-
-    /* Wait for transaction complete event */
-    ret = dwc_i2c_wait_complete(dev);
-
-    /* Disabled interrupts */
-    i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
-
-    /* Disable the I2C adapter */
-    (void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
-
-    return ret;
+    return dwc_i2c_xfer(dev, &seg, 1);
 }
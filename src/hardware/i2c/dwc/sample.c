@@ -0,0 +1,368 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include "proto.h"
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/neutrino.h>
+
+static uint64_t sample_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec2nsec(&ts);
+}
+
+/*
+ * Publish one result. Only the sampler thread writes the ring; readers
+ * detect a slot being rewritten by its seq changing during the copy.
+ */
+static void sample_publish(i2c_dwc_sample_ring_t *ring, const dwc_sample_job_t *job,
+                const uint32_t status, const uint8_t *data, const uint64_t timestamp)
+{
+    const uint64_t      seq = ring->seq + 1U;
+    i2c_dwc_sample_t    *slot = &ring->slot[(seq - 1U) % ring->nslots];
+
+    slot->seq = 0;
+    __cpu_membarrier();
+
+    slot->timestamp = timestamp;
+    slot->id        = job->req.id;
+    slot->status    = status;
+    (void)memset(slot->data, 0, sizeof(slot->data));
+    if (status == (uint32_t)I2C_STATUS_DONE) {
+        (void)memcpy(slot->data, data, job->req.rlen);
+    }
+    __cpu_membarrier();
+
+    slot->seq = seq;
+    ring->seq = seq;
+}
+
+/*
+ * Run the due jobs back to back. The lock is taken per job, so a client
+ * transfer waits for one job at most; like client transfers, a job that
+ * outlasts its polling window completes on the interrupt.
+ */
+static void sample_run(dwc_dev_t *dev, dwc_sample_job_t *job, const uint32_t njob)
+{
+    uint8_t         rbuf[I2C_DWC_SAMPLE_MAX_READ];
+    dwc_seg_t       seg[2];
+    uint32_t        i, nseg;
+    i2c_status_t    status;
+
+    for (i = 0; i < njob; i++) {
+        nseg = 0;
+        if (job[i].req.wlen != 0U) {
+            seg[nseg].buf   = job[i].req.wdata;
+            seg[nseg].len   = job[i].req.wlen;
+            seg[nseg].flags = 0;
+            nseg++;
+        }
+        if (job[i].req.rlen != 0U) {
+            seg[nseg].buf   = rbuf;
+            seg[nseg].len   = job[i].req.rlen;
+            seg[nseg].flags = DWC_SEG_READ;
+            nseg++;
+        }
+
+        (void)pthread_mutex_lock(&dev->lock);
+        status = dwc_i2c_xfer_slave(dev, job[i].req.slave.addr, job[i].req.slave.fmt, seg, nseg);
+        (void)pthread_mutex_unlock(&dev->lock);
+
+        sample_publish(dev->sampler->ring, &job[i], (uint32_t)status, rbuf, sample_now());
+    }
+}
+
+/*
+ * Drop the jobs of owners that have exited. Called with the job table locked.
+ */
+static void sample_reap(dwc_sampler_t *smp)
+{
+    uint32_t    i;
+
+    for (i = 0; i < I2C_DWC_SAMPLE_MAX_JOBS; i++) {
+        if ((smp->job[i].active != 0U) &&
+            (kill((pid_t)smp->job[i].req.pid, 0) == -1) && (errno == ESRCH)) {
+            smp->job[i].active = 0;
+        }
+    }
+}
+
+static void *sample_thread(void *arg)
+{
+    dwc_dev_t           *dev = arg;
+    dwc_sampler_t       *smp = dev->sampler;
+    dwc_sample_job_t    due[I2C_DWC_SAMPLE_MAX_JOBS];
+    struct timespec     ts;
+    uint64_t            now, next, period;
+    uint32_t            i, ndue;
+
+    (void)pthread_mutex_lock(&smp->mutex);
+
+    while (smp->stop == 0U) {
+        now  = sample_now();
+        next = UINT64_MAX;
+        ndue = 0;
+
+        if (now >= smp->reap) {
+            sample_reap(smp);
+            smp->reap = now + DWC_SAMPLE_REAP_NS;
+        }
+
+        /* Collect everything due now or within the packing window */
+        for (i = 0; i < I2C_DWC_SAMPLE_MAX_JOBS; i++) {
+            if (smp->job[i].active == 0U) {
+                continue;
+            }
+            if (smp->job[i].due <= (now + DWC_SAMPLE_PACK_NS)) {
+                due[ndue++] = smp->job[i];
+
+                period = (uint64_t)smp->job[i].req.period_us * 1000U;
+                smp->job[i].due += period;
+                if (smp->job[i].due <= now) {
+                    /* Overrun, drop the missed periods */
+                    smp->job[i].due = now + period;
+                }
+            }
+            next = min(next, smp->job[i].due);
+        }
+        if (next != UINT64_MAX) {
+            next = min(next, smp->reap);
+        }
+
+        if (ndue != 0U) {
+            (void)pthread_mutex_unlock(&smp->mutex);
+            sample_run(dev, due, ndue);
+            (void)pthread_mutex_lock(&smp->mutex);
+        } else if (next == UINT64_MAX) {
+            (void)pthread_cond_wait(&smp->cond, &smp->mutex);
+        } else {
+            nsec2timespec(&ts, next);
+            (void)pthread_cond_timedwait(&smp->cond, &smp->mutex, &ts);
+        }
+    }
+
+    (void)pthread_mutex_unlock(&smp->mutex);
+
+    return NULL;
+}
+
+/*
+ * The owner is the process that sent the request, the pid in the request
+ * is replaced with it.
+ */
+int dwc_i2c_sample_add(dwc_dev_t *dev, i2c_dwc_sample_job_t *req, pid_t owner)
+{
+    dwc_sampler_t   *smp = dev->sampler;
+    uint32_t        i;
+
+    if (smp == NULL) {
+        return ENOTSUP;
+    }
+
+    if ((req->period_us < I2C_DWC_SAMPLE_MIN_PERIOD) ||
+        (req->wlen > I2C_DWC_SAMPLE_MAX_WRITE) || (req->rlen > I2C_DWC_SAMPLE_MAX_READ) ||
+        ((req->wlen + req->rlen) == 0U)) {
+        return EINVAL;
+    }
+
+    if (owner <= 0) {
+        return EPERM;
+    }
+
+    if ((req->slave.fmt != (uint32_t)I2C_ADDRFMT_7BIT) && (req->slave.fmt != (uint32_t)I2C_ADDRFMT_10BIT)) {
+        return EINVAL;
+    }
+
+    (void)pthread_mutex_lock(&smp->mutex);
+
+    sample_reap(smp);
+
+    for (i = 0; i < I2C_DWC_SAMPLE_MAX_JOBS; i++) {
+        if (smp->job[i].active == 0U) {
+            break;
+        }
+    }
+
+    if (i == I2C_DWC_SAMPLE_MAX_JOBS) {
+        (void)pthread_mutex_unlock(&smp->mutex);
+        return ENOSPC;
+    }
+
+    req->id  = i;
+    req->pid = owner;
+    smp->job[i].req    = *req;
+    smp->job[i].due    = sample_now();
+    smp->job[i].active = 1;
+
+    (void)pthread_cond_signal(&smp->cond);
+    (void)pthread_mutex_unlock(&smp->mutex);
+
+    return EOK;
+}
+
+/* Only the owner can delete a job */
+int dwc_i2c_sample_del(dwc_dev_t *dev, uint32_t id, pid_t owner)
+{
+    dwc_sampler_t   *smp = dev->sampler;
+    int             ret = EOK;
+
+    if (smp == NULL) {
+        return ENOTSUP;
+    }
+
+    if (id >= I2C_DWC_SAMPLE_MAX_JOBS) {
+        return EINVAL;
+    }
+
+    (void)pthread_mutex_lock(&smp->mutex);
+
+    if (smp->job[id].active == 0U) {
+        ret = EINVAL;
+    } else if (smp->job[id].req.pid != owner) {
+        ret = EPERM;
+    } else {
+        smp->job[id].active = 0;
+        (void)pthread_cond_signal(&smp->cond);
+    }
+
+    (void)pthread_mutex_unlock(&smp->mutex);
+
+    return ret;
+}
+
+int dwc_i2c_sample_init(dwc_dev_t *dev)
+{
+    dwc_sampler_t       *smp;
+    pthread_condattr_t  cattr;
+    void                *ring;
+    int                 fd, ret;
+
+    smp = calloc(1, sizeof(*smp));
+    if (smp == NULL) {
+        return ENOMEM;
+    }
+
+    /* Clients map the ring read-only */
+    fd = shm_open(dev->sample_shm, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        ret = errno;
+        logerr("%s: shm_open %s: %s", __func__, dev->sample_shm, strerror(ret));
+        free(smp);
+        return ret;
+    }
+
+    if (ftruncate(fd, (off_t)sizeof(*smp->ring)) == -1) {
+        ret = errno;
+        logerr("%s: ftruncate: %s", __func__, strerror(ret));
+        (void)close(fd);
+        (void)shm_unlink(dev->sample_shm);
+        free(smp);
+        return ret;
+    }
+
+    ring = mmap(NULL, sizeof(*smp->ring), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (ring == MAP_FAILED) {
+        ret = errno;
+        logerr("%s: mmap: %s", __func__, strerror(ret));
+        (void)shm_unlink(dev->sample_shm);
+        free(smp);
+        return ret;
+    }
+
+    smp->ring = ring;
+    smp->ring->nslots = I2C_DWC_SAMPLE_SLOTS;
+    smp->ring->seq    = 0;
+    __cpu_membarrier();
+    smp->ring->magic  = I2C_DWC_SAMPLE_MAGIC;
+
+    /* Due times are CLOCK_MONOTONIC */
+    (void)pthread_condattr_init(&cattr);
+    (void)pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&smp->cond, &cattr);
+    (void)pthread_condattr_destroy(&cattr);
+    (void)pthread_mutex_init(&smp->mutex, NULL);
+
+    dev->sampler = smp;
+
+    ret = pthread_create(&smp->tid, NULL, sample_thread, dev);
+    if (ret != EOK) {
+        logerr("%s: pthread_create: %s", __func__, strerror(ret));
+        dev->sampler = NULL;
+        (void)pthread_cond_destroy(&smp->cond);
+        (void)pthread_mutex_destroy(&smp->mutex);
+        (void)munmap(smp->ring, sizeof(*smp->ring));
+        (void)shm_unlink(dev->sample_shm);
+        free(smp);
+        return ret;
+    }
+
+    logfyi("periodic sampling ring %s, %u slots", dev->sample_shm, I2C_DWC_SAMPLE_SLOTS);
+
+    return EOK;
+}
+
+void dwc_i2c_sample_fini(dwc_dev_t *dev)
+{
+    dwc_sampler_t   *smp = dev->sampler;
+
+    if (smp == NULL) {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&smp->mutex);
+    smp->stop = 1;
+    (void)pthread_cond_signal(&smp->cond);
+    (void)pthread_mutex_unlock(&smp->mutex);
+
+    (void)pthread_join(smp->tid, NULL);
+
+    dev->sampler = NULL;
+    (void)pthread_cond_destroy(&smp->cond);
+    (void)pthread_mutex_destroy(&smp->mutex);
+    (void)munmap(smp->ring, sizeof(*smp->ring));
+    (void)shm_unlink(dev->sample_shm);
+    free(smp);
+}
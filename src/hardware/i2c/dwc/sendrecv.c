@@ -45,42 +45,26 @@ static i2c_status_t dwc_i2c_sendrecv(void* const hdl, void* const txbuf,
                 const uint32_t txlen, void* const rxbuf, const uint32_t rxlen, const uint32_t stop)
 {
     dwc_dev_t  *dev = hdl;
-    i2c_status_t    ret = I2C_STATUS_ERROR;
+    dwc_seg_t  seg[2];
+    uint32_t   nseg = 0;
 
     (void)stop;
 
-    dev->txlen  = txlen;                    // how many bytes for slave transmit (isend)
-    dev->rxlen  = rxlen;                    // how many bytes for slave receive (irecv)
-    dev->xlen   = dev->txlen + dev->rxlen;  // how many bytes for total transaction (isend and irecv)
-    dev->wrlen  = 0;                        // how many cmds have been write to TxFIFO
-    dev->rdlen  = 0;                        // how many data have been read from RxFIFO
-    dev->txbuf  = txbuf;
-    dev->rxbuf  = rxbuf;
-    dev->status = 0;
-
-    if (dev->xlen <= 0U) {
-        return I2C_STATUS_DONE;
+    if (txlen > 0U) {
+        seg[nseg].buf   = txbuf;
+        seg[nseg].len   = txlen;
+        seg[nseg].flags = 0;
+        nseg++;
     }
 
-    /* Active I2C bus */
-    if (dwc_i2c_bus_active(dev) != 0) {
-        return I2C_STATUS_BUSY;
+    if (rxlen > 0U) {
+        seg[nseg].buf   = rxbuf;
+        seg[nseg].len   = rxlen;
+        seg[nseg].flags = DWC_SEG_READ;
+        nseg++;
     }
 
-    /* Clear and enable interrupts */
-    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
-    i2c_reg_write32(dev, DW_IC_INTR_MASK, DW_IC_INTR_DEFAULT_MASK);
-
-    /* Wait for transaction complete event */
-    ret = dwc_i2c_wait_complete(dev);
-
-    /* Disabled interrupts */
-    i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
-
-    /* Disable the I2C adapter */
-    (void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
-
-    return ret;
+    return dwc_i2c_xfer(dev, seg, nseg);
 }
 
 /*
@@ -92,6 +76,7 @@ int _i2c_master_sendrecv(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb
 int _i2c_master_sendrecv(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb)
 {
     i2c_dev_t           *dev = ocb->hdr.attr;
+    dwc_dev_t           *hdl = dev->hdl;
     i2c_sendrecv_t      *hdr;
     void                *txbuf, *rxbuf;
     i2c_status_t        mstatus;
@@ -126,34 +111,30 @@ int _i2c_master_sendrecv(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb
         return EINVAL;
     }
 
+    /* Requests that do not fit the receive buffer use the preallocated transfer buffer */
     if ((sizeof(*msg) + sizeof(*hdr) + maxbuflen) > ctp->msg_max_size) {
-        if (maxbuflen > dev->buflen) {
-            free(dev->buf);
-            dev->buf = malloc(maxbuflen);
-            if (dev->buf == NULL) {
-                dev->buflen = 0;
-                return ENOMEM;
-            }
-            dev->buflen = maxbuflen;
+        if (maxbuflen > hdl->xbuf_size) {
+            i2c_slogf(dev->verbosity, _SLOG_ERROR, "Request of %u bytes exceeds transfer buffer", maxbuflen);
+            return EMSGSIZE;
         }
     }
 
     if ((sizeof(*msg) + sizeof(*hdr) + hdr->send_len) > ctp->msg_max_size) {
         int status;
-        status = (int32_t)resmgr_msgread(ctp, dev->buf, (size_t)hdr->send_len, sizeof(*msg) + sizeof(*hdr));
+        status = (int32_t)resmgr_msgread(ctp, hdl->xbuf, (size_t)hdr->send_len, sizeof(*msg) + sizeof(*hdr));
         if (status < 0) {
             return errno;
         }
         if ((uint32_t)status < hdr->send_len) {
             return EFAULT;
         }
-        txbuf = dev->buf;
+        txbuf = hdl->xbuf;
     } else {
         txbuf = (void *)(hdr + 1);
     }
 
     if ((sizeof(*msg) + sizeof(*hdr) + hdr->recv_len) > ctp->msg_max_size) {
-        rxbuf = dev->buf;
+        rxbuf = hdl->xbuf;
     } else {
         rxbuf = (void *)(hdr + 1);
     }
@@ -0,0 +1,141 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include "proto.h"
+#include <time.h>
+#include <sys/neutrino.h>
+
+/* Index of the most significant bit set, 0 for 0 and 1, limited to the last bucket */
+static uint32_t dwc_i2c_stats_bucket(uint64_t val, const uint32_t nbuckets)
+{
+    uint32_t    n = 0;
+
+    while ((val > 1U) && (n < (nbuckets - 1U))) {
+        val >>= 1;
+        n++;
+    }
+
+    return n;
+}
+
+static uint32_t dwc_i2c_stats_result(const i2c_status_t status)
+{
+    const uint32_t  st = (uint32_t)status;
+
+    if ((st & ((uint32_t)I2C_STATUS_ADDR_NACK | (uint32_t)I2C_STATUS_DATA_NACK)) != 0U) {
+        return I2C_DWC_STATS_RES_NACK;
+    }
+    if ((st & (uint32_t)I2C_STATUS_ARBL) != 0U) {
+        return I2C_DWC_STATS_RES_ARBL;
+    }
+    if ((st & (uint32_t)I2C_STATUS_BUSY) != 0U) {
+        return I2C_DWC_STATS_RES_TIMEOUT;
+    }
+    if (st == (uint32_t)I2C_STATUS_DONE) {
+        return I2C_DWC_STATS_RES_DONE;
+    }
+
+    return I2C_DWC_STATS_RES_ERROR;
+}
+
+void dwc_i2c_stats_clear(dwc_dev_t* const dev)
+{
+    struct timespec ts;
+
+    (void)memset(&dev->stats, 0, sizeof(dev->stats));
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    dev->stats.start_ns = timespec2nsec(&ts);
+}
+
+/*
+ * Account a transfer of the current segments that started waiting for
+ * completion at ClockCycles() start. Called with dev->lock held.
+ */
+void dwc_i2c_stats_record(dwc_dev_t* const dev, const i2c_status_t status, const uint32_t polled,
+                const uint64_t start)
+{
+    i2c_dwc_op_stats_t  *op;
+    uint32_t            rd = 0, wr = 0, res, i;
+    uint64_t            ns, bits;
+
+    for (i = 0; i < dev->nseg; i++) {
+        if ((dev->seg[i].flags & DWC_SEG_READ) != 0U) {
+            rd++;
+        } else {
+            wr++;
+        }
+    }
+
+    if (rd == 0U) {
+        op = &dev->stats.op[I2C_DWC_STATS_OP_SEND];
+    } else if (wr == 0U) {
+        op = &dev->stats.op[I2C_DWC_STATS_OP_RECV];
+    } else {
+        op = &dev->stats.op[I2C_DWC_STATS_OP_SENDRECV];
+    }
+
+    ns  = dwc_i2c_cycles_to_ns(ClockCycles() - start);
+    res = dwc_i2c_stats_result(status);
+
+    op->count[res]++;
+    op->total_ns += ns;
+    op->max_ns = max(op->max_ns, ns);
+    op->lat_hist[res][dwc_i2c_stats_bucket(ns / 1000U, I2C_DWC_STATS_LAT_BUCKETS)]++;
+    op->size_hist[dwc_i2c_stats_bucket(dev->totlen, I2C_DWC_STATS_SIZE_BUCKETS)]++;
+    if (polled != 0U) {
+        op->polled++;
+    }
+    if (res == I2C_DWC_STATS_RES_DONE) {
+        op->bytes += dev->totlen;
+    }
+
+    /* 9 clocks per byte plus START/STOP for each segment */
+    if (dev->scl_freq != 0U) {
+        bits = ((uint64_t)dev->totlen * 9U) + ((uint64_t)dev->nseg * 2U);
+        op->wire_ns += (bits * 1000000000ULL) / dev->scl_freq;
+    }
+
+    for (i = 0; i < 32U; i++) {
+        if ((dev->abort_source & (1U << i)) != 0U) {
+            dev->stats.abort_src[i]++;
+        }
+    }
+}
@@ -0,0 +1,572 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include <stdarg.h>
+#include <time.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#include "dwc_model.h"
+
+dwc_model_t dwc_model;
+
+/* The model runs ClockCycles() off CLOCK_MONOTONIC */
+static struct syspage_entry dwc_model_syspage = { .num_cpu = 1, .qtime = { 1000000000U } };
+struct syspage_entry *_syspage_ptr = &dwc_model_syspage;
+
+static dwc_dev_t model_dev;
+
+/* Host sleeps overshoot by tens of us */
+#define DWC_MODEL_SPIN_NS   1000000U
+
+#define REG(__off)  (dwc_model.reg[(__off) >> 2])
+
+uint64_t dwc_model_now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec2nsec(&ts);
+}
+
+static dwc_model_slave_t *model_find_slave(const uint32_t addr)
+{
+    for (uint32_t i = 0; i < dwc_model.nslaves; i++) {
+        if (dwc_model.slave[i].addr == addr) {
+            return &dwc_model.slave[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void model_flush_tx(void)
+{
+    dwc_model.txn = 0;
+    dwc_model.txh = 0;
+    dwc_model.pending = 0;
+}
+
+static void model_bus_free(const uint32_t stop)
+{
+    if ((stop != 0U) && (dwc_model.started != 0U)) {
+        dwc_model.raw |= DW_IC_INTR_STOP_DET;
+    }
+    dwc_model.started = 0;
+    dwc_model.cur = NULL;
+}
+
+/*
+ * Abort the transaction: the TX FIFO is flushed and stays flushed until
+ * TX_ABRT is cleared. The controller sends a STOP unless it lost the bus.
+ */
+static void model_abort(const uint32_t source, const uint32_t stop)
+{
+    dwc_model.abrt |= source;
+    dwc_model.raw |= DW_IC_INTR_TX_ABRT;
+    dwc_model.tx_flushed = 1;
+    model_flush_tx();
+    model_bus_free(stop);
+}
+
+static void model_exec(const uint32_t cmd)
+{
+    dwc_model_t         *m = &dwc_model;
+    dwc_model_slave_t   *s;
+
+    if ((m->started == 0U) || ((cmd & DW_IC_DATA_CMD_RESTART) != 0U)) {
+        /* (repeated) START and the address */
+        m->started = 1;
+        m->cur = NULL;
+        s = model_find_slave(REG(DW_IC_TAR) & 0x3ffU);
+        if (s == NULL) {
+            model_abort(DW_IC_TX_ABRT_7B_ADDR_NOACK, 1);
+            return;
+        }
+        m->cur = s;
+        m->first_wr = 1;
+        s->wr_bytes = 0;
+        s->txn_bytes = 0;
+    }
+
+    s = m->cur;
+    s->txn_bytes++;
+    if ((s->arbl_at != 0U) && (s->txn_bytes == s->arbl_at)) {
+        model_abort(DW_IC_TX_ARBT_LOST, 0);
+        return;
+    }
+
+    if ((cmd & DW_IC_DATA_CMD_READ) != 0U) {
+        if (m->rxn == DWC_MODEL_FIFO_DEPTH) {
+            m->raw |= DW_IC_INTR_RX_OVER;
+        } else {
+            m->rxq[(m->rxh + m->rxn) % DWC_MODEL_FIFO_DEPTH] = s->mem[s->ptr++];
+            m->rxn++;
+        }
+    } else {
+        s->wr_bytes++;
+        if ((s->nack_at != 0U) && (s->wr_bytes == s->nack_at)) {
+            model_abort(DW_IC_TX_ABRT_TXDATA_NOACK, 1);
+            return;
+        }
+        if (m->first_wr != 0U) {
+            s->ptr = (uint8_t)cmd;
+            m->first_wr = 0;
+        } else {
+            s->mem[s->ptr++] = (uint8_t)cmd;
+        }
+    }
+
+    if ((cmd & DW_IC_DATA_CMD_STOP) != 0U) {
+        model_bus_free(1);
+    }
+}
+
+/* Execute the commands that are due */
+static void model_step(void)
+{
+    dwc_model_t         *m = &dwc_model;
+    dwc_model_slave_t   *s;
+    uint64_t            now;
+    uint32_t            cmd;
+
+    while ((m->enabled != 0U) && (m->txn > 0U)) {
+        now = dwc_model_now_ns();
+        if (m->pending == 0U) {
+            s = (m->cur != NULL) ? m->cur : model_find_slave(REG(DW_IC_TAR) & 0x3ffU);
+            m->busy_until = now + m->byte_ns + ((s != NULL) ? s->stretch_ns : 0U);
+            m->pending = 1;
+        }
+        if (now < m->busy_until) {
+            break;
+        }
+
+        cmd = m->txq[m->txh];
+        m->txh = (m->txh + 1U) % DWC_MODEL_FIFO_DEPTH;
+        m->txn--;
+        m->pending = 0;
+        model_exec(cmd);
+    }
+}
+
+static uint32_t model_raw_intr(void)
+{
+    uint32_t    raw = dwc_model.raw;
+
+    if ((dwc_model.enabled != 0U) && (dwc_model.txn <= REG(DW_IC_TX_TL))) {
+        raw |= DW_IC_INTR_TX_EMPTY;
+    }
+    if (dwc_model.rxn > REG(DW_IC_RX_TL)) {
+        raw |= DW_IC_INTR_RX_FULL;
+    }
+
+    return raw;
+}
+
+static uint32_t model_clear(const uint32_t bits)
+{
+    const uint32_t  raw = dwc_model.raw & bits;
+
+    dwc_model.raw &= ~bits;
+    if ((bits & DW_IC_INTR_TX_ABRT) != 0U) {
+        dwc_model.abrt = 0;
+        dwc_model.tx_flushed = 0;
+    }
+
+    return (raw != 0U) ? 1U : 0U;
+}
+
+uint32_t i2c_reg_read32(dwc_dev_t* const dev, const uint32_t offset)
+{
+    dwc_model_t *m = &dwc_model;
+    uint32_t    val;
+
+    (void)dev;
+
+    model_step();
+
+    switch (offset) {
+        case DW_IC_DATA_CMD:
+            if (m->rxn == 0U) {
+                m->raw |= DW_IC_INTR_RX_UNDER;
+                return 0;
+            }
+            val = m->rxq[m->rxh];
+            m->rxh = (m->rxh + 1U) % DWC_MODEL_FIFO_DEPTH;
+            m->rxn--;
+            return val;
+        case DW_IC_INTR_STAT:
+            return model_raw_intr() & REG(DW_IC_INTR_MASK);
+        case DW_IC_RAW_INTR_STAT:
+            return model_raw_intr();
+        case DW_IC_CLR_INTR:
+            return model_clear(DW_IC_INTR_RX_UNDER | DW_IC_INTR_RX_OVER | DW_IC_INTR_TX_OVER |
+                               DW_IC_INTR_TX_ABRT | DW_IC_INTR_STOP_DET);
+        case DW_IC_CLR_RX_UNDER:
+            return model_clear(DW_IC_INTR_RX_UNDER);
+        case DW_IC_CLR_RX_OVER:
+            return model_clear(DW_IC_INTR_RX_OVER);
+        case DW_IC_CLR_TX_OVER:
+            return model_clear(DW_IC_INTR_TX_OVER);
+        case DW_IC_CLR_TX_ABRT:
+            return model_clear(DW_IC_INTR_TX_ABRT);
+        case DW_IC_CLR_STOP_DET:
+            return model_clear(DW_IC_INTR_STOP_DET);
+        case DW_IC_ENABLE_STATUS:
+            return m->enabled;
+        case DW_IC_STATUS:
+            val = 0;
+            if ((m->started != 0U) || (m->txn != 0U)) {
+                val |= DW_IC_STATUS_ACTIVITY;
+            }
+            if (m->txn < DWC_MODEL_FIFO_DEPTH) {
+                val |= DW_IC_STATUS_TFNF;
+            }
+            if (m->txn == 0U) {
+                val |= DW_IC_STATUS_TFE;
+            }
+            if (m->rxn != 0U) {
+                val |= DW_IC_STATUS_RFNE;
+            }
+            return val;
+        case DW_IC_TXFLR:
+            return m->txn;
+        case DW_IC_RXFLR:
+            return m->rxn;
+        case DW_IC_TX_ABRT_SOURCE:
+            return m->abrt;
+        default:
+            break;
+    }
+
+    return ((offset >> 2) < (sizeof(m->reg) / sizeof(m->reg[0]))) ? REG(offset) : 0U;
+}
+
+void i2c_reg_write32(dwc_dev_t* const dev, const uint32_t offset, const uint32_t value)
+{
+    dwc_model_t *m = &dwc_model;
+
+    (void)dev;
+
+    switch (offset) {
+        case DW_IC_DATA_CMD:
+            if ((m->enabled == 0U) || (m->tx_flushed != 0U)) {
+                break;
+            }
+            if (m->txn == DWC_MODEL_FIFO_DEPTH) {
+                m->raw |= DW_IC_INTR_TX_OVER;
+                break;
+            }
+            m->txq[(m->txh + m->txn) % DWC_MODEL_FIFO_DEPTH] = value;
+            m->txn++;
+            break;
+        case DW_IC_ENABLE:
+            if (((value & DW_IC_ENABLE_ABORT) != 0U) && (m->enabled != 0U)) {
+                model_abort(DW_IC_TX_ARBT_USER_ARBT, 1);
+            }
+            if ((value & DW_IC_ENABLE_STATUS_ENABLE) == 0U) {
+                /* Disabling flushes both FIFOs and frees the bus */
+                model_flush_tx();
+                m->rxn = 0;
+                m->rxh = 0;
+                model_bus_free(1);
+            }
+            m->enabled = value & DW_IC_ENABLE_STATUS_ENABLE;
+            /* ABORT and SDA_STUCK_RECOVERY complete at once */
+            REG(DW_IC_ENABLE) = m->enabled;
+            break;
+        default:
+            if ((offset >> 2) < (sizeof(m->reg) / sizeof(m->reg[0]))) {
+                REG(offset) = value;
+            }
+            break;
+    }
+
+    model_step();
+}
+
+/*
+ * The interrupt is delivered while an unmasked interrupt is pending and
+ * masked until the driver unmasks it, as with InterruptAttachEvent(). A
+ * wait that cannot end with an interrupt, because nothing is left on the
+ * bus, reports the timeout at once instead of sleeping through it.
+ */
+int MsgReceivePulse(int chid, void *pulse, size_t bytes, void *info)
+{
+    dwc_model_t     *m = &dwc_model;
+    struct _pulse   *p = pulse;
+    struct timespec ts;
+    uint64_t        now, deadline, until;
+
+    (void)chid;
+    (void)bytes;
+    (void)info;
+
+    now = dwc_model_now_ns();
+    deadline = (m->timeout_ns != 0U) ? (now + m->timeout_ns) : UINT64_MAX;
+    m->timeout_ns = 0;
+
+    while (true) {
+        model_step();
+
+        if ((m->irq_masked == 0U) && ((model_raw_intr() & REG(DW_IC_INTR_MASK)) != 0U)) {
+            m->irq_masked = 1;
+            m->pulses++;
+            (void)memset(p, 0, sizeof(*p));
+            p->code = DWC_PULSE_CODE_INTR;
+            return 0;
+        }
+
+        now = dwc_model_now_ns();
+        if ((m->enabled == 0U) || (m->txn == 0U) || (now >= deadline)) {
+            m->timeouts++;
+            errno = ETIMEDOUT;
+            return -1;
+        }
+
+        /* Sleep through long waits, spin on short ones to keep the byte timing */
+        until = min(m->busy_until, deadline);
+        if (until > (now + DWC_MODEL_SPIN_NS)) {
+            nsec2timespec(&ts, until - now - DWC_MODEL_SPIN_NS);
+            (void)nanosleep(&ts, NULL);
+        }
+    }
+}
+
+int TimerTimeout(clockid_t id, int flags, const struct sigevent *notify, const uint64_t *ntime, uint64_t *otime)
+{
+    (void)id;
+    (void)flags;
+    (void)notify;
+    (void)otime;
+
+    dwc_model.timeout_ns = (ntime != NULL) ? *ntime : 0U;
+    return 0;
+}
+
+int InterruptUnmask(int intr, int id)
+{
+    (void)intr;
+    (void)id;
+
+    dwc_model.irq_masked = 0;
+    return 0;
+}
+
+uint64_t ClockCycles(void)
+{
+    return dwc_model_now_ns();
+}
+
+uint64_t timespec2nsec(const struct timespec *ts)
+{
+    return ((uint64_t)ts->tv_sec * 1000000000U) + (uint64_t)ts->tv_nsec;
+}
+
+void nsec2timespec(struct timespec *ts, const uint64_t nsec)
+{
+    ts->tv_sec  = (time_t)(nsec / 1000000000U);
+    ts->tv_nsec = (long)(nsec % 1000000000U);
+}
+
+ssize_t resmgr_msgread(resmgr_context_t *ctp, void *msg, size_t nbytes, size_t offset)
+{
+    (void)memcpy(msg, (uint8_t *)ctp->msg + offset, nbytes);
+    return (ssize_t)nbytes;
+}
+
+int i2c_slogf(int verbosity, int severity, const char *fmt, ...)
+{
+    va_list ap;
+
+    if ((getenv("DWC_MODEL_LOG") == NULL) || (severity > (_SLOG_WARNING + verbosity))) {
+        return 0;
+    }
+
+    va_start(ap, fmt);
+    (void)vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    (void)fputc('\n', stderr);
+
+    return 0;
+}
+
+/*
+ * Stand-ins for init.c, following the same register sequences
+ */
+int32_t dwc_i2c_enable(dwc_dev_t* const dev, const uint32_t enable)
+{
+    i2c_reg_write32(dev, DW_IC_ENABLE, enable);
+    if ((i2c_reg_read32(dev, DW_IC_ENABLE_STATUS) & DW_IC_ENABLE_STATUS_ENABLE_MASK) == enable) {
+        return 0;
+    }
+
+    return -ETIMEDOUT;
+}
+
+int32_t dwc_i2c_bus_active(dwc_dev_t* const dev, const uint32_t addr, const i2c_addrfmt_t fmt)
+{
+    if (dwc_i2c_wait_bus_not_busy(dev) != 0) {
+        return (int32_t)I2C_STATUS_BUSY;
+    }
+
+    if (dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE) != 0) {
+        return (int32_t)I2C_STATUS_BUSY;
+    }
+
+    if (fmt == I2C_ADDRFMT_7BIT) {
+        i2c_reg_write32(dev, DW_IC_TAR, addr);
+        i2c_reg_write32(dev, DW_IC_CON, dev->master_cfg & ~DW_IC_CON_10BITADDR_MASTER);
+    } else {
+        i2c_reg_write32(dev, DW_IC_TAR, addr | DW_IC_TAR_10BITADDR_MASTER);
+        i2c_reg_write32(dev, DW_IC_CON, dev->master_cfg | DW_IC_CON_10BITADDR_MASTER);
+    }
+
+    dwc_i2c_load_timing(dev);
+    i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
+
+    if (dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_ENABLE) != 0) {
+        return (int32_t)I2C_STATUS_BUSY;
+    }
+
+    return 0;
+}
+
+void dwc_i2c_program_registers(dwc_dev_t *dev)
+{
+    i2c_reg_write32(dev, DW_IC_SS_SCL_HCNT, dev->ss_hcnt);
+    i2c_reg_write32(dev, DW_IC_SS_SCL_LCNT, dev->ss_lcnt);
+    i2c_reg_write32(dev, DW_IC_TX_TL, dev->fifo_depth / 2U);
+    i2c_reg_write32(dev, DW_IC_RX_TL, dev->fifo_depth / 2U);
+
+    dev->timing_loaded = DWC_TIMING_NONE;
+    dwc_i2c_load_timing(dev);
+
+    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
+    i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
+}
+
+/* No GPIO recovery and no sampler in the model */
+int32_t dwc_i2c_gpio_sda_level(dwc_dev_t *dev)
+{
+    (void)dev;
+    return -1;
+}
+
+int32_t dwc_i2c_gpio_recover(dwc_dev_t *dev)
+{
+    (void)dev;
+    return -1;
+}
+
+int dwc_i2c_sample_add(dwc_dev_t *dev, i2c_dwc_sample_job_t *req, pid_t owner)
+{
+    (void)dev;
+    (void)req;
+    (void)owner;
+    return ENOTSUP;
+}
+
+int dwc_i2c_sample_del(dwc_dev_t *dev, uint32_t id, pid_t owner)
+{
+    (void)dev;
+    (void)id;
+    (void)owner;
+    return ENOTSUP;
+}
+
+dwc_model_slave_t *dwc_model_add_slave(const uint32_t addr)
+{
+    dwc_model_slave_t   *s;
+
+    if (dwc_model.nslaves == DWC_MODEL_MAX_SLAVES) {
+        return NULL;
+    }
+
+    s = &dwc_model.slave[dwc_model.nslaves++];
+    (void)memset(s, 0, sizeof(*s));
+    s->addr = addr;
+
+    return s;
+}
+
+/*
+ * Reset the model and the bus, which runs at 400 kHz with polling disabled
+ */
+void dwc_model_reset(void)
+{
+    dwc_dev_t           *dev = &model_dev;
+    pthread_mutexattr_t mattr;
+
+    (void)memset(&dwc_model, 0, sizeof(dwc_model));
+
+    if (dev->xbuf == NULL) {
+        (void)pthread_mutexattr_init(&mattr);
+        (void)pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+        (void)pthread_mutex_init(&dev->lock, &mattr);
+        (void)pthread_mutexattr_destroy(&mattr);
+        dev->xbuf_size = DWC_XBUF_SIZE;
+        dev->xbuf = malloc(dev->xbuf_size);
+    }
+
+    dev->irq = 1;
+    dev->iid = 1;
+    dev->chid = 1;
+    dev->coid = 1;
+    dev->gpio_fd = -1;
+    dev->scl_gpio = DWC_NO_GPIO;
+    dev->sda_gpio = DWC_NO_GPIO;
+    dev->fifo_depth = DWC_MODEL_FIFO_DEPTH;
+    dev->poll_thld = 0;
+    dev->master_cfg = DW_IC_CON_MASTER | DW_IC_CON_SLAVE_DISABLE | DW_IC_CON_RESTART_EN | DW_IC_CON_SPEED_FAST;
+    dev->scl_freq = 400000U;
+    dev->timing = DWC_TIMING_FAST;
+    dev->slave_addr = 0;
+    dev->slave_addr_fmt = I2C_ADDRFMT_7BIT;
+    (void)memset(&dev->rec_stats, 0, sizeof(dev->rec_stats));
+
+    dwc_i2c_program_registers(dev);
+    dwc_i2c_stats_clear(dev);
+}
+
+dwc_dev_t *dwc_model_dev(void)
+{
+    return &model_dev;
+}
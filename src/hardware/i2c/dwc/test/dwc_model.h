@@ -0,0 +1,109 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#ifndef DWC_MODEL_H_INCLUDED
+#define DWC_MODEL_H_INCLUDED
+
+#include "proto.h"
+
+/*
+ * Host model of the DesignWare I2C master and the slaves on its bus. The
+ * driver sources are linked against it in place of init.c: the register
+ * accessors, adapter enable and bus activation, the interrupt pulse and
+ * ClockCycles() all run here.
+ *
+ * Commands written to DATA_CMD are executed one at a time, each after the
+ * wire time of a byte at the configured rate plus the stretch of the
+ * addressed slave. Raw interrupts follow the FIFO levels and thresholds;
+ * TX_ABRT and STOP_DET latch until cleared by the read-to-clear registers.
+ */
+
+#define DWC_MODEL_FIFO_DEPTH    32U
+#define DWC_MODEL_MAX_SLAVES    4U
+
+typedef struct {
+    uint32_t    addr;
+    uint8_t     mem[256];           // registers, the first byte written sets the pointer
+    uint8_t     ptr;
+    uint32_t    nack_at;            // NACK the n-th data byte written (1-based), 0 for never
+    uint32_t    arbl_at;            // lose arbitration at the n-th byte of a transaction, 0 for never
+    uint64_t    stretch_ns;         // clock stretching per byte
+    uint32_t    wr_bytes;           // data bytes received, reset by each START
+    uint32_t    txn_bytes;
+} dwc_model_slave_t;
+
+typedef struct {
+    /* configuration */
+    uint64_t            byte_ns;    // wire time of one byte, 0 to execute at once
+    uint32_t            nslaves;
+    dwc_model_slave_t   slave[DWC_MODEL_MAX_SLAVES];
+
+    /* controller state */
+    uint32_t            reg[0x100];
+    uint32_t            enabled;
+    uint32_t            raw;        // latched raw interrupts
+    uint32_t            abrt;       // TX_ABRT_SOURCE
+    uint32_t            tx_flushed; // TX FIFO held flushed until TX_ABRT is cleared
+    uint32_t            txq[DWC_MODEL_FIFO_DEPTH];
+    uint32_t            txn, txh;
+    uint8_t             rxq[DWC_MODEL_FIFO_DEPTH];
+    uint32_t            rxn, rxh;
+    dwc_model_slave_t   *cur;       // addressed slave while a transaction is on the bus
+    uint32_t            started;
+    uint32_t            first_wr;   // next write of the transaction is the register pointer
+    uint64_t            busy_until; // completion time of the command at the head of the queue
+    uint32_t            pending;
+
+    /* interrupt and timeout */
+    uint32_t            irq_masked;
+    uint64_t            timeout_ns; // armed by TimerTimeout() for the next receive, 0 if none
+    uint32_t            pulses;
+    uint32_t            timeouts;
+} dwc_model_t;
+
+extern dwc_model_t dwc_model;
+
+void dwc_model_reset(void);
+dwc_model_slave_t *dwc_model_add_slave(uint32_t addr);
+dwc_dev_t *dwc_model_dev(void);
+uint64_t dwc_model_now_ns(void);
+
+#endif /* DWC_MODEL_H_INCLUDED */
@@ -0,0 +1,104 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#ifndef TEST_HW_I2C_H_INCLUDED
+#define TEST_HW_I2C_H_INCLUDED
+
+#include <devctl.h>
+
+typedef enum {
+    I2C_ADDRFMT_10BIT   = 0x0100,
+    I2C_ADDRFMT_7BIT    = 0x0200,
+} i2c_addrfmt_t;
+
+typedef enum {
+    I2C_STATUS_DONE         = 0x0001,
+    I2C_STATUS_ERROR        = 0x0002,
+    I2C_STATUS_NACK         = 0x0004,
+    I2C_STATUS_ADDR_NACK    = 0x0004,
+    I2C_STATUS_DATA_NACK    = 0x0008,
+    I2C_STATUS_ARBL         = 0x0010,
+    I2C_STATUS_BUSY         = 0x0020,
+    I2C_STATUS_ABORT        = 0x0040,
+} i2c_status_t;
+
+typedef struct {
+    _Uint32t    addr;
+    _Uint32t    fmt;
+} i2c_addr_t;
+
+typedef struct {
+    i2c_addr_t  slave;
+    _Uint32t    send_len;
+    _Uint32t    recv_len;
+    _Uint32t    stop;
+} i2c_sendrecv_t;
+
+typedef struct {
+    _Uint8t     major;
+    _Uint8t     minor;
+    _Uint16t    revision;
+} i2c_libversion_t;
+
+typedef struct {
+    _Uint32t    speed_mode;
+    _Uint32t    addr_mode;
+    _Uint32t    reserved[2];
+} i2c_driver_info_t;
+
+typedef struct {
+    size_t          size;
+    void            *(*init)(int argc, char *argv[]);
+    void            (*fini)(void *hdl);
+    i2c_status_t    (*send)(void *hdl, void *buf, unsigned int len, unsigned int stop);
+    i2c_status_t    (*recv)(void *hdl, void *buf, unsigned int len, unsigned int stop);
+    int             (*abort)(void *hdl, int rcvid);
+    int             (*set_slave_addr)(void *hdl, unsigned int addr, i2c_addrfmt_t fmt);
+    int             (*set_bus_speed)(void *hdl, unsigned int speed, unsigned int *ospeed);
+    int             (*version_info)(i2c_libversion_t *version);
+    int             (*driver_info)(void *hdl, i2c_driver_info_t *info);
+    int             (*ctl)(void *hdl, int cmd, void *msg, int msglen, int *nbytes, int *info);
+    int             (*bus_reset)(void *hdl);
+} i2c_master_funcs_t;
+
+int i2c_slogf(int verbosity, int severity, const char *fmt, ...);
+
+#endif /* TEST_HW_I2C_H_INCLUDED */
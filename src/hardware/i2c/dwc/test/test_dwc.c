@@ -0,0 +1,499 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+/*
+ * Regression tests and benchmark of the transfer path (xfer.c, wait.c,
+ * sendrecv.c, stats.c, recover.c) against the register model.
+ *
+ *   test_dwc               run the tests
+ *   test_dwc -b [-n N] [-s speed]
+ *                          time N transfers of each size, interrupt driven
+ *                          and polled, with the wire time of the bus speed
+ *                          (0 for an infinitely fast bus)
+ */
+
+#include <unistd.h>
+#include "dwc_model.h"
+
+int _i2c_master_sendrecv(resmgr_context_t *ctp, io_devctl_t *msg, i2c_ocb_t *ocb);
+
+static uint32_t failures;
+
+#define CHECK(__cond) \
+    do { \
+        if (!(__cond)) { \
+            (void)fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #__cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static i2c_status_t xfer(dwc_dev_t *dev, uint32_t addr, uint8_t *wbuf, uint32_t wlen, uint8_t *rbuf, uint32_t rlen)
+{
+    dwc_seg_t   seg[2];
+    uint32_t    nseg = 0;
+
+    if (wlen > 0U) {
+        seg[nseg].buf = wbuf;
+        seg[nseg].len = wlen;
+        seg[nseg].flags = 0;
+        nseg++;
+    }
+    if (rlen > 0U) {
+        seg[nseg].buf = rbuf;
+        seg[nseg].len = rlen;
+        seg[nseg].flags = DWC_SEG_READ;
+        nseg++;
+    }
+
+    (void)dwc_i2c_set_slave_addr(dev, addr, I2C_ADDRFMT_7BIT);
+    return dwc_i2c_xfer(dev, seg, nseg);
+}
+
+static void get_stats(dwc_dev_t *dev, i2c_dwc_stats_t *st)
+{
+    int nbytes;
+
+    CHECK(dwc_i2c_ctl(dev, DCMD_I2C_DWC_STATS, st, sizeof(*st), &nbytes, NULL) == EOK);
+}
+
+static void test_send_recv(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[4] = { 0x10, 0xa1, 0xb2, 0xc3 };
+    uint8_t             rbuf[3] = { 0 };
+    i2c_dwc_stats_t     st;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+
+    (void)dwc_i2c_set_slave_addr(dev, 0x50, I2C_ADDRFMT_7BIT);
+    CHECK(dwc_i2c_send(dev, wbuf, sizeof(wbuf), 1) == I2C_STATUS_DONE);
+    CHECK((s->mem[0x10] == 0xa1) && (s->mem[0x11] == 0xb2) && (s->mem[0x12] == 0xc3));
+
+    s->ptr = 0x11;
+    CHECK(dwc_i2c_recv(dev, rbuf, 2, 1) == I2C_STATUS_DONE);
+    CHECK((rbuf[0] == 0xb2) && (rbuf[1] == 0xc3));
+
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK(memcmp(rbuf, &wbuf[1], sizeof(rbuf)) == 0);
+
+    get_stats(dev, &st);
+    CHECK(st.op[I2C_DWC_STATS_OP_SEND].count[I2C_DWC_STATS_RES_DONE] == 1U);
+    CHECK(st.op[I2C_DWC_STATS_OP_RECV].count[I2C_DWC_STATS_RES_DONE] == 1U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].count[I2C_DWC_STATS_RES_DONE] == 1U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].bytes == 4U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].polled == 0U);
+    CHECK(dwc_model.pulses > 0U);
+}
+
+/* Transfers longer than the FIFO are refilled and drained on the thresholds */
+static void test_long(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[201], rbuf[200];
+    uint32_t            i;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+
+    wbuf[0] = 0x20;
+    for (i = 1; i < sizeof(wbuf); i++) {
+        wbuf[i] = (uint8_t)(i * 7U);
+    }
+
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) == I2C_STATUS_DONE);
+    CHECK(memcmp(&s->mem[0x20], &wbuf[1], sizeof(wbuf) - 1U) == 0);
+
+    (void)memset(rbuf, 0, sizeof(rbuf));
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK(memcmp(rbuf, &wbuf[1], sizeof(rbuf)) == 0);
+    CHECK(dwc_model.raw == 0U);
+}
+
+static void test_nack(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[4] = { 0x00, 1, 2, 3 };
+    uint8_t             rbuf[2];
+    i2c_dwc_stats_t     st;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+
+    CHECK(xfer(dev, 0x51, wbuf, sizeof(wbuf), NULL, 0) ==
+          (i2c_status_t)((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_ADDR_NACK));
+
+    s->nack_at = 2;
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) ==
+          (i2c_status_t)((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_DATA_NACK));
+
+    /* The aborted transfers leave the controller usable */
+    s->nack_at = 0;
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+
+    get_stats(dev, &st);
+    CHECK(st.op[I2C_DWC_STATS_OP_SEND].count[I2C_DWC_STATS_RES_NACK] == 2U);
+    CHECK(st.abort_src[0] == 1U);       // 7B_ADDR_NOACK
+    CHECK(st.abort_src[3] == 1U);       // TXDATA_NOACK
+    CHECK(dev->rec_stats.recoveries == 0U);
+}
+
+static void test_arbitration_lost(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[4] = { 0x00, 1, 2, 3 };
+    i2c_dwc_stats_t     st;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+
+    s->arbl_at = 3;
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) ==
+          (i2c_status_t)((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_ARBL));
+    CHECK(dev->rec_stats.recoveries == 1U);
+
+    s->arbl_at = 0;
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) == I2C_STATUS_DONE);
+    CHECK(s->mem[1] == 2U);
+
+    get_stats(dev, &st);
+    CHECK(st.op[I2C_DWC_STATS_OP_SEND].count[I2C_DWC_STATS_RES_ARBL] == 1U);
+    CHECK(st.abort_src[12] == 1U);      // ARBT_LOST
+}
+
+/* A slave that never lets the transfer finish */
+static void test_timeout(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[2] = { 0x00, 1 };
+    i2c_dwc_stats_t     st;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+
+    s->stretch_ns = 10U * 1000000000U;
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) == I2C_STATUS_BUSY);
+    CHECK(dwc_model.timeouts == 1U);
+    CHECK(dev->rec_stats.recoveries == 1U);
+
+    s->stretch_ns = 0;
+    CHECK(xfer(dev, 0x50, wbuf, sizeof(wbuf), NULL, 0) == I2C_STATUS_DONE);
+
+    get_stats(dev, &st);
+    CHECK(st.op[I2C_DWC_STATS_OP_SEND].count[I2C_DWC_STATS_RES_TIMEOUT] == 1U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SEND].count[I2C_DWC_STATS_RES_DONE] == 1U);
+}
+
+static void test_polled(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *s;
+    uint8_t             wbuf[1] = { 0x40 };
+    uint8_t             rbuf[3];
+    i2c_dwc_stats_t     st;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+    s->mem[0x40] = 0x11;
+    s->mem[0x41] = 0x22;
+    s->mem[0x42] = 0x33;
+    dev->poll_thld = 8;
+
+    /* Short transfer completes without an interrupt */
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK((rbuf[0] == 0x11) && (rbuf[1] == 0x22) && (rbuf[2] == 0x33));
+    CHECK(dwc_model.pulses == 0U);
+
+    /* Address NACK while polling */
+    CHECK(xfer(dev, 0x52, wbuf, 1, rbuf, sizeof(rbuf)) ==
+          (i2c_status_t)((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_ADDR_NACK));
+    CHECK(dwc_model.pulses == 0U);
+
+    /* Clock stretching beyond the polling budget continues in interrupt mode */
+    s->stretch_ns = 300000U;
+    (void)memset(rbuf, 0, sizeof(rbuf));
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK((rbuf[0] == 0x11) && (rbuf[1] == 0x22) && (rbuf[2] == 0x33));
+    CHECK(dwc_model.pulses > 0U);
+
+    /* Above the threshold and at standard mode the interrupt is used */
+    s->stretch_ns = 0;
+    dwc_model.pulses = 0;
+    dev->poll_thld = 2;
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK(dwc_model.pulses > 0U);
+
+    get_stats(dev, &st);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].polled == 3U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].count[I2C_DWC_STATS_RES_DONE] == 3U);
+    CHECK(st.op[I2C_DWC_STATS_OP_SENDRECV].count[I2C_DWC_STATS_RES_NACK] == 1U);
+
+    dwc_model.pulses = 0;
+    dev->poll_thld = 8;
+    CHECK(dwc_i2c_set_bus_speed(dev, 100000U, NULL) == 0);
+    CHECK(xfer(dev, 0x50, wbuf, 1, rbuf, sizeof(rbuf)) == I2C_STATUS_DONE);
+    CHECK(dwc_model.pulses > 0U);
+}
+
+/* DCMD_I2C_DWC_XFER: one session per slave, the first failure ends the transfer */
+static void test_combined(void)
+{
+    dwc_dev_t           *dev;
+    dwc_model_slave_t   *a, *b;
+    struct {
+        i2c_dwc_xfer_t  hdr;
+        i2c_dwc_seg_t   seg[4];
+        uint8_t         data[8];
+    } msg;
+    int                 nbytes;
+
+    dwc_model_reset();
+    dev = dwc_model_dev();
+    a = dwc_model_add_slave(0x50);
+    b = dwc_model_add_slave(0x60);
+    a->mem[0x05] = 0x55;
+    b->mem[0x07] = 0x77;
+
+    (void)memset(&msg, 0, sizeof(msg));
+    msg.hdr.nsegs = 4;
+    msg.seg[0] = (i2c_dwc_seg_t){ .slave = { 0x50, I2C_ADDRFMT_7BIT }, .flags = 0, .len = 1 };
+    msg.seg[1] = (i2c_dwc_seg_t){ .slave = { 0x50, I2C_ADDRFMT_7BIT }, .flags = I2C_DWC_SEG_READ, .len = 1 };
+    msg.seg[2] = (i2c_dwc_seg_t){ .slave = { 0x60, I2C_ADDRFMT_7BIT }, .flags = 0, .len = 1 };
+    msg.seg[3] = (i2c_dwc_seg_t){ .slave = { 0x60, I2C_ADDRFMT_7BIT }, .flags = I2C_DWC_SEG_READ, .len = 1 };
+    msg.data[0] = 0x05;
+    msg.data[2] = 0x07;
+
+    CHECK(dwc_i2c_ctl(dev, DCMD_I2C_DWC_XFER, &msg, sizeof(msg), &nbytes, NULL) == EOK);
+    CHECK(msg.hdr.status == (uint32_t)I2C_STATUS_DONE);
+    CHECK((msg.data[1] == 0x55) && (msg.data[3] == 0x77));
+    CHECK(msg.seg[3].status == (uint32_t)I2C_STATUS_DONE);
+
+    b->nack_at = 1;
+    msg.data[1] = 0;
+    CHECK(dwc_i2c_ctl(dev, DCMD_I2C_DWC_XFER, &msg, sizeof(msg), &nbytes, NULL) == EOK);
+    CHECK(msg.hdr.status == ((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_DATA_NACK));
+    CHECK(msg.seg[1].status == (uint32_t)I2C_STATUS_DONE);
+    CHECK(msg.data[1] == 0x55);
+}
+
+/* DCMD_I2C_SENDRECV through the override of the library handler */
+static void test_sendrecv_devctl(void)
+{
+    dwc_dev_t           *hdl;
+    dwc_model_slave_t   *s;
+    i2c_dev_t           dev;
+    i2c_ocb_t           ocb;
+    resmgr_context_t    ctp;
+    io_devctl_t         *msg;
+    i2c_sendrecv_t      *hdr;
+    uint8_t             *data;
+    size_t              size;
+    uint32_t            i;
+
+    dwc_model_reset();
+    hdl = dwc_model_dev();
+    s = dwc_model_add_slave(0x50);
+    for (i = 0; i < 256U; i++) {
+        s->mem[i] = (uint8_t)(255U - i);
+    }
+
+    (void)memset(&dev, 0, sizeof(dev));
+    dev.hdl = hdl;
+    dev.bus_speed = 400000U;
+    dev.mfuncs.set_slave_addr = dwc_i2c_set_slave_addr;
+    dev.mfuncs.set_bus_speed = dwc_i2c_set_bus_speed;
+    (void)memset(&ocb, 0, sizeof(ocb));
+    ocb.hdr.attr = &dev;
+    ocb.bus_speed = 400000U;
+
+    size = sizeof(*msg) + sizeof(*hdr) + 200U;
+    msg = calloc(1, size);
+    hdr = _IO_INPUT_PAYLOAD(msg);
+    data = (uint8_t *)(hdr + 1);
+
+    /* Fits the receive buffer */
+    (void)memset(&ctp, 0, sizeof(ctp));
+    ctp.msg = msg;
+    ctp.msg_max_size = size;
+    msg->i.nbytes = (uint32_t)(sizeof(*hdr) + 200U);
+    hdr->slave.addr = 0x50;
+    hdr->slave.fmt = I2C_ADDRFMT_7BIT;
+    hdr->send_len = 1;
+    hdr->recv_len = 200;
+    data[0] = 0x10;
+
+    CHECK(_i2c_master_sendrecv(&ctp, msg, &ocb) == _RESMGR_NPARTS(2));
+    CHECK(ocb.status == I2C_STATUS_DONE);
+    CHECK(msg->o.ret_val == 200);
+    CHECK(ctp.iov[1].iov_base == data);
+    CHECK(memcmp(data, &s->mem[0x10], 200) == 0);
+
+    /* Does not fit, the data goes through the transfer buffer */
+    ctp.msg_max_size = sizeof(*msg) + sizeof(*hdr) + 16U;
+    msg->i.nbytes = (uint32_t)(sizeof(*hdr) + 200U);
+    hdr->send_len = 1;
+    hdr->recv_len = 100;
+    data[0] = 0x30;
+
+    CHECK(_i2c_master_sendrecv(&ctp, msg, &ocb) == _RESMGR_NPARTS(2));
+    CHECK(ctp.iov[1].iov_base == hdl->xbuf);
+    CHECK(memcmp(hdl->xbuf, &s->mem[0x30], 100) == 0);
+
+    /* Failures are reported as EIO with the status in the OCB */
+    ctp.msg_max_size = size;
+    hdr->slave.addr = 0x51;
+    CHECK(_i2c_master_sendrecv(&ctp, msg, &ocb) == EIO);
+    CHECK(ocb.status == (i2c_status_t)((uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_ADDR_NACK));
+
+    free(msg);
+}
+
+static int run_tests(void)
+{
+    test_send_recv();
+    test_long();
+    test_nack();
+    test_arbitration_lost();
+    test_timeout();
+    test_polled();
+    test_combined();
+    test_sendrecv_devctl();
+
+    if (failures != 0U) {
+        (void)printf("FAILED: %u checks\n", failures);
+        return 1;
+    }
+
+    (void)printf("all tests passed\n");
+    return 0;
+}
+
+/*
+ * Time the driver for transfers of a register address write followed by a
+ * read, from bus activation to completion as recorded by the driver's own
+ * statistics.
+ */
+static int run_bench(const uint32_t iterations, const uint32_t speed)
+{
+    static const uint32_t   sizes[] = { 1, 2, 4, 8, 16, 31, 64, 128, 256 };
+    dwc_dev_t               *dev;
+    i2c_dwc_stats_t         st;
+    i2c_dwc_op_stats_t      *op;
+    uint8_t                 wbuf[1] = { 0 };
+    uint8_t                 rbuf[256];
+    uint32_t                i, n, polled;
+
+    (void)printf("%-6s %-9s %12s %12s %12s %8s\n", "bytes", "mode", "mean_ns", "max_ns", "wire_ns", "polled");
+
+    for (i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (polled = 0; polled < 2U; polled++) {
+            dwc_model_reset();
+            dev = dwc_model_dev();
+            (void)dwc_model_add_slave(0x50);
+            if (speed != 0U) {
+                if (dwc_i2c_set_bus_speed(dev, speed, NULL) != 0) {
+                    (void)printf("unsupported bus speed %u\n", speed);
+                    return 1;
+                }
+                dwc_model.byte_ns = 9000000000ULL / speed;
+            }
+            dev->poll_thld = (polled != 0U) ? DWC_MODEL_FIFO_DEPTH : 0U;
+
+            for (n = 0; n < iterations; n++) {
+                if (xfer(dev, 0x50, wbuf, 1, rbuf, sizes[i]) != I2C_STATUS_DONE) {
+                    (void)printf("transfer failed\n");
+                    return 1;
+                }
+            }
+
+            get_stats(dev, &st);
+            op = &st.op[I2C_DWC_STATS_OP_SENDRECV];
+            (void)printf("%-6u %-9s %12llu %12llu %12llu %8llu\n", sizes[i] + 1U,
+                         (polled != 0U) ? "poll_thld" : "interrupt",
+                         (unsigned long long)(op->total_ns / iterations),
+                         (unsigned long long)op->max_ns,
+                         (unsigned long long)(op->wire_ns / iterations),
+                         (unsigned long long)op->polled);
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    iterations = 10000, speed = 0, bench = 0;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "bn:s:")) != -1) {
+        switch (opt) {
+            case 'b':
+                bench = 1;
+                break;
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                speed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-b [-n iterations] [-s bus_speed]]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (bench != 0U) {
+        return run_bench(max(iterations, 1U), speed);
+    }
+
+    return run_tests();
+}
@@ -43,8 +43,8 @@
 #include <assert.h>
 #include <string.h>
 #include <atomic.h>
+#include <sys/syspage.h>
 
-#define RESET_RETRY (3)
 #define DW_I2C_TIMEOUT  20
 
 int32_t dwc_i2c_wait_bus_not_busy(dwc_dev_t* const dev)
@@ -63,12 +63,39 @@ int32_t dwc_i2c_wait_bus_not_busy(dwc_dev_t* const dev)
     return 0;
 }
 
-static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
+/*
+ * Store data read from RxFIFO into the read segments of the transaction
+ */
+static void dwc_i2c_read_rx_fifo(dwc_dev_t* const dev, uint32_t numbers)
 {
-    uint32_t    status;
-    uint32_t    numbers, reg;
+    dwc_seg_t   *seg;
+    uint32_t    reg;
+
+    for ( ; numbers > 0U; numbers--) {
+        seg = &dev->seg[dev->rd_seg];
+        while (((seg->flags & DWC_SEG_READ) == 0U) || (dev->rd_off >= seg->len)) {
+            dev->rd_seg++;
+            dev->rd_off = 0;
+            seg = &dev->seg[dev->rd_seg];
+        }
 
-    status = i2c_reg_read32(dev, DW_IC_INTR_STAT);
+        reg = i2c_reg_read32(dev, DW_IC_DATA_CMD);
+        seg->buf[dev->rd_off++] = (uint8_t)(reg & 0x00FFU);
+        dev->rdlen++;
+    }
+}
+
+static void dwc_i2c_txn_status(dwc_dev_t* const dev, const uint32_t status)
+{
+    for (uint32_t i = dev->txn_first; i <= dev->txn_last; i++) {
+        dev->seg[i].status = status;
+    }
+}
+
+static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev, const uint32_t status)
+{
+    dwc_seg_t   *seg;
+    uint32_t    numbers, reg;
 
     if ((status & DW_IC_INTR_TX_ABRT) != 0U) {
         /* Get the Abort source and clean the ABRT interrupt bit */
@@ -88,9 +115,10 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
         else {
             dev->status = (uint32_t)I2C_STATUS_DONE | (uint32_t)I2C_STATUS_ABORT;
         }
+        dwc_i2c_txn_status(dev, dev->status);
 
         /* Disable interrupt and return interrupt event */
-        i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
+        dwc_i2c_set_intr_mask(dev, 0);
         return EOK;
     }
 
@@ -108,16 +136,21 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
                 numbers = 0;
             }
 
-            for ( ; numbers > 0U; numbers--) {
-                reg = i2c_reg_read32(dev, DW_IC_DATA_CMD);
-                *dev->rxbuf++ = (uint8_t)(reg & 0x00FFU);
-                dev->rdlen++;
-            }
+            dwc_i2c_read_rx_fifo(dev, numbers);
+        }
+
+        dwc_i2c_txn_status(dev, dev->status | (uint32_t)I2C_STATUS_DONE);
+
+        /* Start the next transaction of a combined transfer in the same session */
+        if ((dev->status == 0U) && ((dev->txn_last + 1U) < dev->nseg)) {
+            dwc_i2c_next_txn(dev);
+            dwc_i2c_set_intr_mask(dev, DW_IC_INTR_DEFAULT_MASK);
+            return EAGAIN;
         }
 
         /* Disable interrupt and return interrupt event */
         dev->status |= (uint32_t)I2C_STATUS_DONE;
-        i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
+        dwc_i2c_set_intr_mask(dev, 0);
         return EOK;
     }
 
@@ -134,20 +167,14 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
                 dev->status |= (uint32_t)I2C_STATUS_ERROR;
 
                 /* Disable DW_IC_INTR_RX_FULL interrupt */
-                reg = i2c_reg_read32(dev, DW_IC_INTR_MASK) & ~DW_IC_INTR_RX_FULL;
-                i2c_reg_write32(dev, DW_IC_INTR_MASK, reg);
+                dwc_i2c_set_intr_mask(dev, dev->intr_mask & ~DW_IC_INTR_RX_FULL);
             }
 
-            for ( ; numbers > 0U; numbers--) {
-                reg = i2c_reg_read32(dev, DW_IC_DATA_CMD);
-                *dev->rxbuf++ = (uint8_t)(reg & 0x00FFU);
-                dev->rdlen++;
-            }
+            dwc_i2c_read_rx_fifo(dev, numbers);
         }
         else {
             /* Disable DW_IC_INTR_RX_FULL interrupt, it should never go here */
-            reg = i2c_reg_read32(dev, DW_IC_INTR_MASK) & ~DW_IC_INTR_RX_FULL;
-            i2c_reg_write32(dev, DW_IC_INTR_MASK, reg);
+            dwc_i2c_set_intr_mask(dev, dev->intr_mask & ~DW_IC_INTR_RX_FULL);
         }
     }
 
@@ -156,8 +183,7 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
         for (uint32_t i = 0; i < dev->fifo_depth; i++) {
             if (dev->wrlen >= dev->xlen) {
                 /* No more command left, disable R_TX_EMPTY interrupt */
-                reg = i2c_reg_read32(dev, DW_IC_INTR_MASK) & ~DW_IC_INTR_TX_EMPTY;
-                i2c_reg_write32(dev, DW_IC_INTR_MASK, reg);
+                dwc_i2c_set_intr_mask(dev, dev->intr_mask & ~DW_IC_INTR_TX_EMPTY);
                 break;
             }
 
@@ -166,35 +192,29 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
                 break;
             }
 
-            if (dev->wrlen < dev->txlen) {
+            seg = &dev->seg[dev->wr_seg];
+            if ((seg->flags & DWC_SEG_READ) != 0U) {
+                /* Command for master-receive */
+                reg = DW_IC_DATA_CMD_READ;
+            }
+            else {
                 /* Command for master-transmit */
-                if (dev->wrlen == (dev->xlen - 1U)) {
-                    /* If last byte for master-transmit, force set STOP condition */
-                    reg = (uint32_t)*dev->txbuf++ | DW_IC_DATA_CMD_WRITE | DW_IC_DATA_CMD_STOP;
-                }
-                else {
-                    reg = (uint32_t)*dev->txbuf++ | DW_IC_DATA_CMD_WRITE;
-                }
+                reg = (uint32_t)seg->buf[dev->wr_off] | DW_IC_DATA_CMD_WRITE;
             }
-            else if ((dev->wrlen == dev->txlen) && (0U != dev->txlen)) {
-                /* First command for master-receive of isendrecv , need restart cmd */
-                if (dev->wrlen == (dev->xlen - 1U)) {
-                    /* If last byte for master-receive, force set STOP condition */
-                    reg = DW_IC_DATA_CMD_READ | DW_IC_DATA_CMD_RESTART | DW_IC_DATA_CMD_STOP;
-                }
-                else {
-                    reg = DW_IC_DATA_CMD_READ | DW_IC_DATA_CMD_RESTART;
-                }
+
+            if ((dev->wr_off == 0U) && (dev->wr_seg != dev->txn_first)) {
+                /* First command of a following segment, need restart cmd */
+                reg |= DW_IC_DATA_CMD_RESTART;
             }
-            else {
-                /* Command for master-receive */
-                if (dev->wrlen == (dev->xlen - 1U)) {
-                    /* If last byte for master-receive, force set STOP condition */
-                    reg = DW_IC_DATA_CMD_READ | DW_IC_DATA_CMD_STOP;
-                }
-                else {
-                    reg = DW_IC_DATA_CMD_READ;
+
+            dev->wr_off++;
+            if (dev->wr_off == seg->len) {
+                if (dev->wr_seg == dev->txn_last) {
+                    /* Last byte of the transaction, force set STOP condition */
+                    reg |= DW_IC_DATA_CMD_STOP;
                 }
+                dev->wr_seg++;
+                dev->wr_off = 0;
             }
 
             i2c_reg_write32(dev, DW_IC_DATA_CMD, reg);
@@ -205,56 +225,6 @@ static int32_t dwc_i2c_process_intr(dwc_dev_t* const dev)
     return EAGAIN;
 }
 
-void dwc_i2c_reset(dwc_dev_t *const dev)
-{
-    int32_t ret;
-    int32_t reset_retry = RESET_RETRY;
-
-    /* Abort the I2C transfer */
-    i2c_reg_write32(dev, DW_IC_ENABLE, DW_IC_ENABLE_ABORT | DW_IC_ENABLE_STATUS_ENABLE);
-
-    (void)usleep(1000);
-
-    /* Disable the adapter */
-    (void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
-
-    do {
-
-        /* Perform soft reset.
-         * Notes:
-         * If the driver isn’t using DMA, then it is OK to just leave iDMA in Reset.
-         * To be 100% sure the DMA is not being used, read register BAR0 + 0xB98
-         * (DMACFGREG) bit[0], which is the DMA enable bit. If it is '0', then no
-         * need to worry about any pending transactions.
-         * At the time this soft reset was added, DMACFGREG is 0. So DMA is NOT being
-         * used.
-         * Additionally, in case DMA support is added in the future, there is a need
-         * to check whether or not DMA transactions need to be stopped before performing
-         * soft reset.
-         */
-
-        logfyi("Assert soft reset. retry=%d\n", reset_retry);
-        i2c_reg_write32(dev, DW_IC_SOFT_RESET, DW_IC_SOFT_RESET_ASSERTED);
-        (void)usleep(25); //Just miniscule delay
-
-        logfyi("De-assert soft reset.\n");
-        i2c_reg_write32(dev, DW_IC_SOFT_RESET, DW_IC_SOFT_RESET_NOT_ASSERTED);
-
-        logfyi("Re-initializing...");
-        ret = dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
-        if (ret == 0) {
-            dwc_i2c_init_registers(dev);
-            logfyi("I2C reinitialized.\n");
-            return;
-        }
-        else {
-            logerr("Failed to reinitialize!\n");
-        }
-    } while (--reset_retry > 0);
-
-    logerr("I2C failed to reset!\n");
-}
-
 i2c_status_t dwc_i2c_wait_complete(dwc_dev_t* const dev)
 {
     int32_t err;
@@ -263,14 +233,15 @@ i2c_status_t dwc_i2c_wait_complete(dwc_dev_t* const dev)
     // the timeout, so it doesn't have to be that accurate.  At higher clock
     // rates, a calcuated time of 0 would mess-up the timeout calculation, so
     // round up to 1 us per byte, and wait at least 2.5 ms for the xfer to complete.
-    const uint32_t xtime_us = max(2500U, max(1U, 10U * 1000U * 1000U / dev->scl_freq) * dev->xlen);
+    const uint32_t xtime_us = max(2500U, max(1U, 10U * 1000U * 1000U / dev->scl_freq) * dev->totlen);
 
     const uint64_t to_ns = (uint64_t)xtime_us * 1000U * 50U;  // convert to ns and extend to 50 times of estimate time
+    struct _pulse  pulse;
 
     while (true) {
         (void)TimerTimeout(CLOCK_MONOTONIC, _NTO_TIMEOUT_RECEIVE, NULL, &to_ns, NULL);
 
-        err = InterruptWait(0, NULL);
+        err = MsgReceivePulse(dev->chid, &pulse, sizeof(pulse), NULL);
 
         if (err == -1) {
             logerr("%s: PID_%d %s(%d), stat reg %x\n", __func__, getpid(),
@@ -279,7 +250,7 @@ i2c_status_t dwc_i2c_wait_complete(dwc_dev_t* const dev)
             break;
         }
 
-        if (dwc_i2c_process_intr(dev) == EAGAIN) {
+        if (dwc_i2c_process_intr(dev, i2c_reg_read32(dev, DW_IC_INTR_STAT)) == EAGAIN) {
             (void)InterruptUnmask(dev->irq, dev->iid);
             continue;
         }
@@ -298,3 +269,47 @@ i2c_status_t dwc_i2c_wait_complete(dwc_dev_t* const dev)
 
     return I2C_STATUS_BUSY;
 }
+
+/*
+ * Polled completion for short transfers. The whole transfer fits in the
+ * FIFO, so the state machine is driven from the raw interrupt status with
+ * interrupts left masked. The spin is bounded by a multiple of the wire
+ * time; a transfer that takes longer (e.g. clock stretching) continues in
+ * interrupt mode.
+ */
+i2c_status_t dwc_i2c_poll_complete(dwc_dev_t* const dev)
+{
+    uint64_t    limit, bits;
+    uint32_t    status;
+
+    /* 9 clocks per byte plus START/STOP for each segment, 4 times for margin */
+    bits  = ((uint64_t)dev->totlen * 9U) + ((uint64_t)dev->nseg * 2U);
+    limit = (bits * 4U * SYSPAGE_ENTRY(qtime)->cycles_per_sec) / dev->scl_freq;
+    limit += ClockCycles();
+
+    dev->polled = 1;
+    dev->intr_mask = DW_IC_INTR_DEFAULT_MASK;
+
+    while (true) {
+        status = i2c_reg_read32(dev, DW_IC_RAW_INTR_STAT) & dev->intr_mask;
+
+        if ((status != 0U) && (dwc_i2c_process_intr(dev, status) == EOK)) {
+            break;
+        }
+
+        if (ClockCycles() > limit) {
+            /* Too slow for polling, let the interrupt finish the transfer */
+            dev->polled = 0;
+            i2c_reg_write32(dev, DW_IC_INTR_MASK, dev->intr_mask);
+            return dwc_i2c_wait_complete(dev);
+        }
+    }
+
+    dev->polled = 0;
+
+    if ((dev->status & ((uint32_t)I2C_STATUS_ARBL | (uint32_t)I2C_STATUS_ERROR)) != 0U) {
+        dwc_i2c_reset(dev);
+    }
+
+    return (i2c_status_t)dev->status;
+}
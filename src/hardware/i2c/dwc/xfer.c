@@ -0,0 +1,288 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+
+#include "proto.h"
+
+/*
+ * Set up the next transaction: the segments from the next one to send up to
+ * and including the first one flagged for STOP (or the last one).
+ */
+void dwc_i2c_next_txn(dwc_dev_t* const dev)
+{
+    uint32_t    i;
+
+    dev->txn_first = dev->wr_seg;
+    dev->rd_seg = dev->wr_seg;
+    dev->rd_off = 0;
+    dev->xlen   = 0;
+    dev->rxlen  = 0;
+    dev->wrlen  = 0;
+    dev->rdlen  = 0;
+
+    for (i = dev->wr_seg; i < dev->nseg; i++) {
+        dev->xlen += dev->seg[i].len;
+        if ((dev->seg[i].flags & DWC_SEG_READ) != 0U) {
+            dev->rxlen += dev->seg[i].len;
+        }
+        if (((dev->seg[i].flags & DWC_SEG_STOP) != 0U) || (i == (dev->nseg - 1U))) {
+            break;
+        }
+    }
+    dev->txn_last = i;
+}
+
+/*
+ * Execute the segments to the given slave in one adapter session.
+ * Called with dev->lock held. Segments must not be empty.
+ */
+i2c_status_t dwc_i2c_xfer_slave(dwc_dev_t* const dev, const uint32_t addr, const i2c_addrfmt_t fmt,
+                dwc_seg_t *seg, uint32_t nseg)
+{
+    i2c_status_t    ret;
+    uint64_t        start;
+    uint32_t        polled;
+
+    dev->seg    = seg;
+    dev->nseg   = nseg;
+    dev->totlen = 0;
+    dev->wr_seg = 0;
+    dev->wr_off = 0;
+    dev->status = 0;
+    dev->abort_source = 0;
+
+    for (uint32_t i = 0; i < nseg; i++) {
+        seg[i].status = 0;
+        dev->totlen += seg[i].len;
+    }
+
+    if (dev->totlen == 0U) {
+        return I2C_STATUS_DONE;
+    }
+
+    dwc_i2c_next_txn(dev);
+
+    start = ClockCycles();
+
+    /* Active I2C bus */
+    if (dwc_i2c_bus_active(dev, addr, fmt) != 0) {
+        dwc_i2c_stats_record(dev, I2C_STATUS_BUSY, 0, start);
+        return I2C_STATUS_BUSY;
+    }
+
+    /* Clear interrupts */
+    (void)i2c_reg_read32(dev, DW_IC_CLR_INTR);
+
+    polled = ((dev->totlen <= dev->poll_thld) && (dev->totlen <= dev->fifo_depth) &&
+              (dev->scl_freq >= DWC_POLL_MIN_SPEED)) ? 1U : 0U;
+
+    start = ClockCycles();
+    if (polled != 0U) {
+        /* Short transfer, busy-poll for completion */
+        ret = dwc_i2c_poll_complete(dev);
+    } else {
+        /* Enable interrupts and wait for transaction complete event */
+        dwc_i2c_set_intr_mask(dev, DW_IC_INTR_DEFAULT_MASK);
+        ret = dwc_i2c_wait_complete(dev);
+    }
+
+    /* Disabled interrupts */
+    i2c_reg_write32(dev, DW_IC_INTR_MASK, 0);
+
+    /* Disable the I2C adapter */
+    (void)dwc_i2c_enable(dev, DW_IC_ENABLE_STATUS_DISABLE);
+
+    /* The transaction in progress did not complete (e.g. timeout) */
+    if (ret != I2C_STATUS_DONE) {
+        for (uint32_t i = dev->txn_first; i <= dev->txn_last; i++) {
+            if (seg[i].status == 0U) {
+                seg[i].status = (uint32_t)ret;
+            }
+        }
+    }
+
+    dwc_i2c_stats_record(dev, ret, polled, start);
+
+    return ret;
+}
+
+/*
+ * Execute the segments to the current slave in one adapter session.
+ */
+i2c_status_t dwc_i2c_xfer(dwc_dev_t* const dev, dwc_seg_t *seg, uint32_t nseg)
+{
+    i2c_status_t    ret;
+
+    (void)pthread_mutex_lock(&dev->lock);
+    ret = dwc_i2c_xfer_slave(dev, dev->slave_addr, dev->slave_addr_fmt, seg, nseg);
+    (void)pthread_mutex_unlock(&dev->lock);
+
+    return ret;
+}
+
+static int dwc_i2c_xfer_combined(dwc_dev_t* const dev, void *msg, int msglen, int *nbytes)
+{
+    i2c_dwc_xfer_t  *hdr = msg;
+    i2c_dwc_seg_t   *useg;
+    dwc_seg_t       seg[I2C_DWC_XFER_MAX_SEGS];
+    uint8_t         *data;
+    uint32_t        hdrlen, datalen = 0;
+    uint32_t        first, i;
+    i2c_status_t    status;
+
+    if (((uint32_t)msglen < sizeof(*hdr)) || (hdr->nsegs == 0U) || (hdr->nsegs > I2C_DWC_XFER_MAX_SEGS)) {
+        return EINVAL;
+    }
+
+    hdrlen = (uint32_t)sizeof(*hdr) + (hdr->nsegs * (uint32_t)sizeof(*useg));
+    if ((uint32_t)msglen < hdrlen) {
+        return EINVAL;
+    }
+
+    useg = (i2c_dwc_seg_t *)(hdr + 1);
+    data = (uint8_t *)(useg + hdr->nsegs);
+
+    for (i = 0; i < hdr->nsegs; i++) {
+        if ((useg[i].len == 0U) || (useg[i].len > ((uint32_t)msglen - hdrlen - datalen))) {
+            logerr("%s: bad length %u for segment %u", __func__, useg[i].len, i);
+            return EINVAL;
+        }
+        seg[i].buf   = data + datalen;
+        seg[i].len   = useg[i].len;
+        seg[i].flags = (((useg[i].flags & I2C_DWC_SEG_READ) != 0U) ? DWC_SEG_READ : 0U) |
+                       (((useg[i].flags & I2C_DWC_SEG_STOP) != 0U) ? DWC_SEG_STOP : 0U);
+        useg[i].status = 0;
+        datalen += useg[i].len;
+    }
+
+    hdr->status = (uint32_t)I2C_STATUS_DONE;
+
+    /*
+     * One adapter session for each run of segments to the same slave. The
+     * slave address is passed to each session, the one set by the client
+     * with DCMD_I2C_SET_SLAVE_ADDR is left alone, and the whole transfer
+     * holds dev->lock so the sampler or another bus user cannot run in
+     * between the sessions.
+     */
+    (void)pthread_mutex_lock(&dev->lock);
+    for (first = 0; first < hdr->nsegs; first = i) {
+        for (i = first + 1U; i < hdr->nsegs; i++) {
+            if ((useg[i].slave.addr != useg[first].slave.addr) ||
+                (useg[i].slave.fmt != useg[first].slave.fmt)) {
+                break;
+            }
+        }
+
+        if ((useg[first].slave.fmt != I2C_ADDRFMT_7BIT) && (useg[first].slave.fmt != I2C_ADDRFMT_10BIT)) {
+            useg[first].status = (uint32_t)I2C_STATUS_ERROR;
+            hdr->status = (uint32_t)I2C_STATUS_ERROR;
+            break;
+        }
+
+        status = dwc_i2c_xfer_slave(dev, useg[first].slave.addr, useg[first].slave.fmt, &seg[first], i - first);
+
+        for (uint32_t j = first; j < i; j++) {
+            useg[j].status = seg[j].status;
+        }
+
+        if (status != I2C_STATUS_DONE) {
+            hdr->status = (uint32_t)status;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&dev->lock);
+
+    *nbytes = (int)(hdrlen + datalen);
+
+    return EOK;
+}
+
+int dwc_i2c_ctl(void *hdl, int cmd, void *msg, int msglen, int *nbytes, int *info)
+{
+    dwc_dev_t   *dev = hdl;
+
+    (void)info;
+
+    switch (cmd) {
+        case DCMD_I2C_DWC_XFER:
+            return dwc_i2c_xfer_combined(dev, msg, msglen, nbytes);
+        case DCMD_I2C_DWC_SAMPLE_ADD:
+            if ((uint32_t)msglen < sizeof(i2c_dwc_sample_job_t)) {
+                return EINVAL;
+            }
+            *nbytes = (int)sizeof(i2c_dwc_sample_job_t);
+            return dwc_i2c_sample_add(dev, msg, dev->client);
+        case DCMD_I2C_DWC_SAMPLE_DEL:
+            if ((uint32_t)msglen < sizeof(uint32_t)) {
+                return EINVAL;
+            }
+            *nbytes = 0;
+            return dwc_i2c_sample_del(dev, *(uint32_t *)msg, dev->client);
+        case DCMD_I2C_DWC_RECOVERY_STATS:
+            if ((uint32_t)msglen < sizeof(i2c_dwc_recovery_stats_t)) {
+                return EINVAL;
+            }
+            (void)pthread_mutex_lock(&dev->lock);
+            (void)memcpy(msg, &dev->rec_stats, sizeof(i2c_dwc_recovery_stats_t));
+            (void)pthread_mutex_unlock(&dev->lock);
+            *nbytes = (int)sizeof(i2c_dwc_recovery_stats_t);
+            return EOK;
+        case DCMD_I2C_DWC_STATS:
+            if ((uint32_t)msglen < sizeof(i2c_dwc_stats_t)) {
+                return EINVAL;
+            }
+            (void)pthread_mutex_lock(&dev->lock);
+            dev->stats.bus_speed = dev->scl_freq;
+            (void)memcpy(msg, &dev->stats, sizeof(i2c_dwc_stats_t));
+            (void)pthread_mutex_unlock(&dev->lock);
+            *nbytes = (int)sizeof(i2c_dwc_stats_t);
+            return EOK;
+        case DCMD_I2C_DWC_STATS_CLEAR:
+            (void)pthread_mutex_lock(&dev->lock);
+            dwc_i2c_stats_clear(dev);
+            (void)pthread_mutex_unlock(&dev->lock);
+            *nbytes = 0;
+            return EOK;
+        default:
+            break;
+    }
+
+    return ENOTSUP;
+}
@@ -46,6 +46,9 @@
 #define DW_SPI_MIN_FIFO_LENGTH                  (2)               // Min FIFO depth for designware SPI device
 #define DW_SPI_MAX_FIFO_LENGTH                  (256)             // Max FIFO depth for designware SPI device
 
+#define DW_SPI_DMA_LIB                          "libdma-dw-axi.so"  // RP1 DMA controller
+#define DW_SPI_DMA_BUF_SIZE                     (4096)            // Default DMA bounce buffer size
+
 #define DW_SPI_SSTE_OFFSET                      (24)
 #define DW_SPI_CTRLR0_SPI_FRF_OFFSET            (21)               // SPI frame format
 /* DFS[20:16] for 32bit width */
@@ -42,6 +42,57 @@
 
 #include <dwc_variant.h>
 
+/**
+ *  @brief             Build the register image of a device.
+ *  @param  spi        SPI driver handler.
+ *  @param  cfg        The device configuration.
+ *  @param  dc         The register image.
+ *
+ *  @return            Void.
+ */
+static void dw_build_devcfg(const dw_spi_t *const spi, const spi_cfg_t *const cfg, dw_devcfg_t *const dc)
+{
+    static const uint32_t dscales[] = {0, 0, 1, 2, 2};
+
+    dc->mode       = cfg->mode;
+    dc->clock_rate = cfg->clock_rate;
+
+    /* Data bytes per word */
+    dc->nbits  = cfg->mode & SPI_MODE_WORD_WIDTH_MASK;
+    dc->dlen   = (dc->nbits + DW_NBIT_ROUNDER) / 8;
+    dc->dscale = dscales[dc->dlen];
+    if (dc->dlen == 3) {
+        dc->dlen = 4;
+    }
+
+    dc->cr0 = (DW_SPI_CTRLR0_FRF_MOTO_SPI << DW_SPI_CTRLR0_FRF_OFFSET) | (DW_SPI_CTRLR0_TMOD_TR << DW_SPI_CTRLR0_TMOD_OFFSET);
+
+    /* set nbits value */
+    dc->cr0 |= DW_PSSI_CTRLR0_DFS_CONFIG(dc->dlen);
+
+    if ((cfg->mode & SPI_MODE_CPOL_1) != 0) {
+        dc->cr0 |= DW_SPI_CTRLR0_SCPOL;    /* Clock Polarity */
+    }
+
+    if ((cfg->mode & SPI_MODE_CPHA_1) != 0) {
+        dc->cr0 |= DW_SPI_CTRLR0_SCPHA;    /* Clock Phase */
+    }
+
+    if (spi->loopback) {
+        dc->cr0 |= DW_PSSI_CTRLR0_SRL;    /* Loop-Back Mode */
+    }
+
+    if (spi->sste) {
+        dc->cr0 |= DW_SPI_SSTE;            /* Slave select Toggle Enable */
+    }
+
+    if (spi->version >= DW_HSSI_102A) {
+        dc->cr0 |= (1 << DW_SPI_CTRLR0_IS_MST_OFFSET); /* enable as master */
+    }
+
+    dc->baudr = (uint32_t)(spi->bus->input_clk / cfg->clock_rate);
+}
+
 /**
  *  @brief             Set SPI device configuration.
  *  @param hdl         SPI driver handler.
@@ -111,5 +162,7 @@ int dw_cfg(const void *const hdl, spi_dev_t *spi_dev)
         spi_slogf(_SLOG_DEBUG1, "%s: device clock rate is already set to %u", __func__, cfg->clock_rate);
     }
 
+    dw_build_devcfg(spi, cfg, &spi->devcfg[spi_dev->devinfo.devno]);
+
     return EOK;
 }
@@ -0,0 +1,325 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <dwc_variant.h>
+
+#ifdef  DW_DMA
+
+/**
+ *  @brief             Release DMA channels and library.
+ *  @param  spi        SPI driver handler.
+ *
+ *  @return            Void.
+ */
+void dw_spi_fini_dma(dw_spi_t *spi)
+{
+    dw_dma_t *const dma = &spi->dma;
+
+    if (dma->buf.vaddr != NULL) {
+        dma->dma_funcs.free_buffer(dma->tx_ch_handle, &dma->buf);
+        dma->buf.vaddr = NULL;
+    }
+    if (dma->rx_ch_handle != NULL) {
+        dma->dma_funcs.channel_release(dma->rx_ch_handle);
+        dma->rx_ch_handle = NULL;
+    }
+    if (dma->tx_ch_handle != NULL) {
+        dma->dma_funcs.channel_release(dma->tx_ch_handle);
+        dma->tx_ch_handle = NULL;
+    }
+    if (dma->dll_handle != NULL) {
+        dma->dma_funcs.fini();
+        dlclose(dma->dll_handle);
+        dma->dll_handle = NULL;
+    }
+}
+
+/**
+ *  @brief             Load the DMA library and attach the RX and TX channels.
+ *  @param  spi        SPI driver handler.
+ *
+ *  @return            EOK --success otherwise fail.
+ *
+ *  The RX channel signals completion with the bus event, an exchange is
+ *  complete once all words have been received.
+ */
+int dw_spi_init_dma(dw_spi_t *spi)
+{
+    dw_dma_t *const dma = &spi->dma;
+    int (*get_dmafuncs)(dma_functions_t *functable, int tabsize);
+
+    dma->dll_handle = dlopen(dma->lib, RTLD_NOW);
+    if (dma->dll_handle == NULL) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to load %s: %s", __func__, dma->lib, dlerror());
+        return ENOENT;
+    }
+
+    get_dmafuncs = dlsym(dma->dll_handle, "get_dmafuncs");
+    if ((get_dmafuncs == NULL) || (get_dmafuncs(&dma->dma_funcs, sizeof(dma->dma_funcs)) == -1)) {
+        spi_slogf(_SLOG_ERROR, "%s: no DMA functions in %s", __func__, dma->lib);
+        dlclose(dma->dll_handle);
+        dma->dll_handle = NULL;
+        return ENOENT;
+    }
+
+    if (dma->dma_funcs.init(NULL) == -1) {
+        spi_slogf(_SLOG_ERROR, "%s: DMA init failed", __func__);
+        dlclose(dma->dll_handle);
+        dma->dll_handle = NULL;
+        return EIO;
+    }
+
+    dma->dma_flags = DMA_ATTACH_EVENT_ON_COMPLETE;
+    dma->rx_ch_handle = dma->dma_funcs.channel_attach(NULL, &spi->bus->evt, &dma->rx_channel,
+            DW_SPI_PRIORITY, dma->dma_flags);
+    if (dma->rx_ch_handle == NULL) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to attach RX channel %u", __func__, dma->rx_channel);
+        dw_spi_fini_dma(spi);
+        return EIO;
+    }
+
+    dma->tx_ch_handle = dma->dma_funcs.channel_attach(NULL, NULL, &dma->tx_channel, DW_SPI_PRIORITY, 0);
+    if (dma->tx_ch_handle == NULL) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to attach TX channel %u", __func__, dma->tx_channel);
+        dw_spi_fini_dma(spi);
+        return EIO;
+    }
+
+    /* Bounce buffer for exchanges from io-spi's own buffer */
+    if (dma->dma_funcs.alloc_buffer(dma->tx_ch_handle, &dma->buf, dma->buf_size, DMA_BUF_FLAG_NOCACHE) != 0) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to allocate %u byte DMA buffer", __func__, dma->buf_size);
+        dma->buf.vaddr = NULL;
+        dw_spi_fini_dma(spi);
+        return ENOMEM;
+    }
+    dma->buf.len = dma->buf_size;
+
+    spi_slogf(_SLOG_INFO, "%s: DMA enabled, rx channel %u, tx channel %u, threshold %u bytes", __func__,
+            dma->rx_channel, dma->tx_channel, spi->bus->dma_thld);
+
+    return EOK;
+}
+
+/**
+ *  @brief             Program one DMA channel.
+ *  @param  spi        SPI driver handler.
+ *  @param  handle     DMA channel handle.
+ *  @param  src        Source address.
+ *  @param  src_flags  Source address flags.
+ *  @param  dst        Destination address.
+ *  @param  dst_flags  Destination address flags.
+ *  @param  nbytes     The number of bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+static int dw_spi_dma_setup(const dw_spi_t *const spi, void *handle, dma_addr_t *src, const dma_xfer_flags src_flags,
+        dma_addr_t *dst, const dma_xfer_flags dst_flags, const uint32_t nbytes)
+{
+    dma_transfer_t  tinfo;
+
+    memset(&tinfo, 0, sizeof(tinfo));
+    tinfo.src_addrs      = src;
+    tinfo.src_fragments  = 1;
+    tinfo.src_flags      = src_flags;
+    tinfo.dst_addrs      = dst;
+    tinfo.dst_fragments  = 1;
+    tinfo.dst_flags      = dst_flags;
+    tinfo.xfer_unit_size = spi->dlen * 8U;
+    tinfo.xfer_bytes     = nbytes;
+
+    if (spi->dma.dma_funcs.setup_xfer(handle, &tinfo) != 0) {
+        return EIO;
+    }
+
+    return EOK;
+}
+
+/**
+ *  @brief             SPI exchange through DMA.
+ *  @param spi         SPI driver handler.
+ *  @param spi_dev     SPI device structure pointer.
+ *  @param addr        DMA buffer, transmit data is replaced by the received data.
+ *  @param tnbytes     The number of transmit bytes.
+ *  @param rnbytes     The number of receive bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ *
+ *  The controller requests TX DMA while its FIFO is at most half full and
+ *  RX DMA for every received word. The RX channel completes last.
+ */
+int dw_spi_dma_exchange(dw_spi_t *spi, spi_dev_t *spi_dev, const dma_addr_t *addr,
+        const uint32_t tnbytes, const uint32_t rnbytes)
+{
+    dw_dma_t *const     dma = &spi->dma;
+    const uint32_t      nbytes = max(tnbytes, rnbytes);
+    dma_addr_t          fifo = { 0 };
+    dma_addr_t          buf = *addr;
+    int                 status;
+
+    if (nbytes > addr->len) {
+        spi_slogf(_SLOG_ERROR, "%s: %u bytes exceed the %u byte DMA buffer", __func__, nbytes, addr->len);
+        return EINVAL;
+    }
+
+    /* Both channels run, the exchange is always transmit and receive */
+    status = dw_prepare_for_transfer(spi, spi_dev, nbytes, nbytes);
+    if (status != EOK) {
+        spi_slogf(_SLOG_ERROR, "%s: dw_prepare_for_transfer failed", __func__);
+        return status;
+    }
+
+    fifo.paddr = spi->pbase + DW_SPI_DR;
+    fifo.len   = spi->dlen;
+    buf.len    = nbytes;
+
+    /* Completion is signalled by the RX channel, no controller interrupts */
+    dw_write32(spi, DW_SPI_IMR, 0);
+    dw_write32(spi, DW_SPI_DMATDLR, spi->fifo_len / SPI_FIFO_LEN_DIV);
+    dw_write32(spi, DW_SPI_DMARDLR, 0);
+    dw_write32(spi, DW_SPI_DMACR, DW_SPI_DMA_RDMAE | DW_SPI_DMA_TDMAE);
+
+    status = dw_spi_dma_setup(spi, dma->rx_ch_handle, &fifo, DMA_ADDR_FLAG_DEVICE | DMA_ADDR_FLAG_NO_INCREMENT,
+            &buf, 0, nbytes);
+    if (status == EOK) {
+        status = dw_spi_dma_setup(spi, dma->tx_ch_handle, &buf, 0,
+                &fifo, DMA_ADDR_FLAG_DEVICE | DMA_ADDR_FLAG_NO_INCREMENT, nbytes);
+    }
+    if (status != EOK) {
+        spi_slogf(_SLOG_ERROR, "%s: DMA setup failed", __func__);
+        dw_write32(spi, DW_SPI_DMACR, 0);
+        return status;
+    }
+
+    spi->dma_active = true;
+    dma->dma_funcs.xfer_start(dma->rx_ch_handle);
+    dma->dma_funcs.xfer_start(dma->tx_ch_handle);
+
+    dw_spi_enable(spi, DW_SPI_ENABLE);
+    dw_spi_select_slave(spi, spi_dev->devinfo.devno);
+
+    /* Wait for exchange to finish */
+    status = dw_wait(spi);
+    if (status != EOK) {
+        spi_slogf(_SLOG_ERROR, "%s: xfer timeout: xlen = %u, rlen = %u xtime = %lu us",
+                __func__, spi->xlen, spi->rlen, spi->xtime_us);
+    }
+
+    dw_spi_enable(spi, DW_SPI_DISABLE);
+    dw_write32(spi, DW_SPI_DMACR, 0);
+    spi->dma_active = false;
+
+    return status;
+}
+
+/**
+ *  @brief             SPI DMA transfer function.
+ *  @param hdl         SPI driver handler.
+ *  @param spi_dev     SPI device structure pointer.
+ *  @param addr        DMA buffer allocated by dw_spi_dma_allocbuf().
+ *  @param tnbytes     The number of transmit bytes.
+ *  @param rnbytes     The number of receive bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+int dw_spi_dmaxfer(void *const hdl, spi_dev_t *spi_dev, dma_addr_t *addr, const uint32_t tnbytes, const uint32_t rnbytes)
+{
+    dw_spi_t *const spi = hdl;
+    int             status;
+
+    /* Module busy */
+    if (dw_spi_busy(spi) == true) {
+        spi_slogf(_SLOG_ERROR, "%s: Controller is busy", __func__);
+        return EBUSY;
+    }
+
+    status = dw_spi_dma_exchange(spi, spi_dev, addr, tnbytes, rnbytes);
+
+    if (spi->cs_override) {
+        dw_spi_deselect_slave(spi);
+    }
+
+    return status;
+}
+
+/**
+ *  @brief             Allocate a DMA-safe buffer for a client.
+ *  @param hdl         SPI driver handler.
+ *  @param addr        DMA address structure to fill in.
+ *  @param len         Buffer length in bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+int dw_spi_dma_allocbuf(void *const hdl, dma_addr_t *addr, const uint32_t len)
+{
+    dw_spi_t *const spi = hdl;
+    dw_dma_t *const dma = &spi->dma;
+
+    if (dma->dma_funcs.alloc_buffer(dma->tx_ch_handle, addr, len, DMA_BUF_FLAG_NOCACHE) != 0) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to allocate %u byte DMA buffer", __func__, len);
+        return ENOMEM;
+    }
+
+    return EOK;
+}
+
+/**
+ *  @brief             Free a buffer allocated by dw_spi_dma_allocbuf().
+ *  @param hdl         SPI driver handler.
+ *  @param addr        DMA address structure.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+int dw_spi_dma_freebuf(void *const hdl, dma_addr_t *addr)
+{
+    dw_spi_t *const spi = hdl;
+    dw_dma_t *const dma = &spi->dma;
+
+    if (addr->vaddr == NULL) {
+        return EINVAL;
+    }
+
+    dma->dma_funcs.free_buffer(dma->tx_ch_handle, addr);
+    addr->vaddr = NULL;
+
+    return EOK;
+}
+
+#endif
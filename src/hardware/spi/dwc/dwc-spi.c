@@ -51,10 +51,36 @@
 bool dw_spi_busy(const dw_spi_t *const spi)
 {
     const volatile uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_SR);
-    const uint32_t value = *addr;
+    const uint32_t value = DW_REG_READ(addr);
     return ((value & DW_SPI_SR_BUSY) != 0);
 }
 
+/**
+ *  @brief             Check if a transmit only exchange is complete.
+ *  @param  spi        SPI driver handler.
+ *
+ *  @return            True:all words shifted out False:Not complete
+ *
+ *  The transmit FIFO may be empty while the last word is still shifting
+ *  out, wait a bounded time for the controller to go idle.
+ */
+bool dw_spi_tx_done(const dw_spi_t *const spi)
+{
+    uint32_t i;
+
+    if ((dw_read32(spi, DW_SPI_SR) & DW_SPI_SR_TF_EMPTY) == 0) {
+        return false;
+    }
+
+    for (i = 0; i < DW_SPI_BUSY_SPIN; i++) {
+        if (!dw_spi_busy(spi)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  *  @brief                   Enable Designware SPI device.
  *  @param  spi              SPI driver handler.
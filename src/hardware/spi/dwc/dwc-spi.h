@@ -57,6 +57,9 @@
 #include <sys/types.h>
 #include <hw/inout.h>
 #include <hw/io-spi.h>
+#include <hw/dcmd_spi_dwc.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
 
 #define _SLOG_DEBUG3                             8                // excessive details for debugging
 
@@ -67,6 +70,7 @@
 #define DW_SCK_DIV_MAX                          (0xffff)
 #define SPI_DFS_DEFAULT                         (8)               // Default spi data frame size
 #define CHANNEL_ID_MAX                          (0xffffffffu)
+#define DW_REG_INVALID                          (0xffffffffu)     // Shadow register not programmed
 
 #define DW_NBIT_ROUNDER                         (7)
 
@@ -78,6 +82,8 @@
 
 #define SPI_FIFO_LEN_DIV                        (2U)
 
+#define DW_POLL_SLACK_US                        (10U)             // Added to the polled exchange time bound
+
 /* Synopsys DW SSI component versions (FourCC sequence) */
 #define DW_HSSI_102A                            (0x3130322AU)
 
@@ -123,6 +129,10 @@
 #define DW_SPI_DR                               (0x60)            // SPI DATA Register for both Read and Write
 #define DW_SPI_RX_SAMPLE_DLY                    (0xf0)
 #define DW_SPI_CS_OVERRIDE                      (0xf4)
+#define DW_SPI_CS_OVERRIDE_ALL                  (0xf)             // Chip selects follow SER, not the transfer state
+
+/* Sequence delays up to this long are spun, longer ones sleep */
+#define DW_SEQ_SPIN_US                          (100U)
 
 //****************************************************************
 // CTRLR0 (DWC APB SSI) Bit fields
@@ -169,6 +179,9 @@
 //****************************************************************
 #define DW_SPI_NDF_MASK                         (0xffff)
 
+/* Bound of the wait for the last transmitted word to shift out */
+#define DW_SPI_BUSY_SPIN                        (10000U)
+
 //****************************************************************
 // Bit fields in SR, 7 bits
 //****************************************************************
@@ -207,8 +220,23 @@ typedef struct {
     void                *tx_ch_handle;
     uint32_t            rx_channel;
     uint32_t            tx_channel;
+    const char          *lib;                                     // DMA library
+    void                *dll_handle;
+    dma_addr_t          buf;                                      // Bounce buffer for io-spi buffer exchanges
+    uint32_t            buf_size;
 } dw_dma_t;
 
+/* Register image of a chip select device, built by dw_cfg() */
+typedef struct {
+    uint32_t        mode;                                         // spi_cfg_t the image was built for
+    uint32_t        clock_rate;
+    uint32_t        cr0;                                          // DW_SPI_CTRLR0 setting
+    uint32_t        baudr;                                        // DW_SPI_BAUDR setting
+    uint32_t        nbits;                                        // Data bits per word
+    uint32_t        dlen;                                         // Word size
+    uint32_t        dscale;                                       // Right shift to convert from byte count to word count
+} dw_devcfg_t;
+
 typedef struct
 {
     spi_ctrl_t     *spi_ctrl;                                     // The address of spi_ctrl structure
@@ -230,40 +258,66 @@ typedef struct
     bool            loopback;                                     // Loopback mode
 
     uint32_t        cr0;                                          // DW_SPI_CTRLR0 setting
-//    uint32_t        cr1;                                          // DW_SPI_CTRLR1 setting
+    uint32_t        tmod;                                         // Transfer mode of the exchange, DW_SPI_CTRLR0_TMOD_*
+    uint32_t        cr1;                                          // DW_SPI_CTRLR1 setting
+    uint32_t        hw_cr0;                                       // DW_SPI_CTRLR0 as programmed
+    uint32_t        hw_cr1;                                       // DW_SPI_CTRLR1 as programmed
+    uint32_t        hw_baudr;                                     // DW_SPI_BAUDR as programmed
+    uint32_t        version;                                      // DW_SPI_VERSION
+    dw_devcfg_t    *devcfg;                                       // Register images, indexed by devno
 
     uint32_t        cs_max;                                       // Chip select max
     bool            sste;                                         // Slave select toggle enable
+    bool            cs_override;                                  // Chip select driven by SER only
+    bool            in_seq;                                       // Exchanging a sequence, chip select held
     uint32_t        fifo_len;                                     // Length of the receive fifo
+    uint32_t        poll_thld;                                    // Poll exchanges up to this many bytes, 0 to disable
 #ifdef  DW_DMA
     bool            dma_active;
     dw_dma_t        dma;
 #endif
 } dw_spi_t;
 
+/*
+ * Register access. The host tests build the driver with DW_SPI_REG_MODEL
+ * and route every access to a software model of the controller.
+ */
+#ifdef DW_SPI_REG_MODEL
+uint32_t dw_model_read32(volatile const uint32_t *addr);
+void     dw_model_write32(volatile uint32_t *addr, uint32_t value);
+#define DW_REG_READ(addr)                       dw_model_read32(addr)
+#define DW_REG_WRITE(addr, value)               dw_model_write32((addr), (value))
+#else
+#define DW_REG_READ(addr)                       (*(addr))
+#define DW_REG_WRITE(addr, value)               (*(addr) = (value))
+#endif
+
 static inline uint32_t dw_read32(const dw_spi_t *const spi, const uint32_t offset)
 {
     volatile const uint32_t *const addr = (uint32_t*)(spi->vbase + offset);
-    const uint32_t value = *addr;
+    const uint32_t value = DW_REG_READ(addr);
     return value;
 }
 
 static inline void dw_write32(const dw_spi_t *const spi, const uint32_t offset, const uint32_t value)
 {
     volatile uint32_t *const addr = (uint32_t*)(spi->vbase + offset);
-    *addr = value;
+    DW_REG_WRITE(addr, value);
 }
 
 /* Function proto */
 int     spi_init(spi_bus_t *bus);
 int     dw_cfg(const void *const hdl, spi_dev_t *spi_dev);
 int     dw_wait(dw_spi_t *spi);
+int     dw_poll(dw_spi_t *const spi);
 void    dw_write_fifo(const dw_spi_t *const spi, const uint32_t len);
+void    dw_read_fifo(const dw_spi_t *const spi, const uint32_t len);
 bool    dw_spi_busy(const dw_spi_t *const spi);
+bool    dw_spi_tx_done(const dw_spi_t *const spi);
 void    dw_spi_enable(const  dw_spi_t *const spi, const uint32_t enable_value);
 int32_t dw_spi_deselect_slave(const dw_spi_t *const spi);
 int32_t dw_spi_select_slave(const dw_spi_t *const spi, const int slv);
-int dw_prepare_for_transfer(dw_spi_t *spi, const spi_cfg_t *const cfg, const uint32_t tnbytes, const uint32_t rnbytes);
+int dw_prepare_for_transfer(dw_spi_t *spi, spi_dev_t *const spi_dev, const uint32_t tnbytes, const uint32_t rnbytes);
 
 /* Function interface for io-spi */
 void dw_fini(void *const hdl);
@@ -271,6 +325,8 @@ void dw_drvinfo(const void *const hdl, spi_drvinfo_t *info);
 void dw_devinfo(const void *const hdl, const spi_dev_t *const spi_dev, spi_devinfo_t *const info);
 int  dw_setcfg(const void *const hdl, spi_dev_t *spi_dev, const spi_cfg_t *const cfg);
 int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes, const uint32_t rnbytes);
+int  dw_ctl(void *const hdl, spi_dev_t *const spi_dev, const int cmd, void *const msg, const int msglen, int *const nbytes, int *const info);
+int  dw_exchange(dw_spi_t *const spi, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes, const uint32_t rnbytes);
 
 #ifdef  DW_DMA
 int dw_spi_init_dma(dw_spi_t *spi);
@@ -278,6 +334,8 @@ void dw_spi_fini_dma(dw_spi_t *spi);
 int dw_spi_dmaxfer(void *const hdl, spi_dev_t *spi_dev, dma_addr_t *addr, const uint32_t tnbytes, const uint32_t rnbytes);
 int dw_spi_dma_allocbuf(void *const hdl, dma_addr_t *addr, const uint32_t len);
 int dw_spi_dma_freebuf(void *const hdl, dma_addr_t *addr);
+int dw_spi_dma_exchange(dw_spi_t *spi, spi_dev_t *spi_dev, const dma_addr_t *addr,
+        const uint32_t tnbytes, const uint32_t rnbytes);
 #endif
 
 #endif /* _DW_SPI_H_ */
@@ -0,0 +1,5 @@
+EXTRA_INCVPATH += $(PROJECT_ROOT)/$(SECTION)/public
+PUBLIC_INCVPATH += $(wildcard $(PROJECT_ROOT)/$(SECTION)/public )
+
+# DMA exchanges through the DMA library given by the dma_lib option
+CCFLAGS += -DDW_DMA
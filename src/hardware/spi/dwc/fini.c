@@ -77,5 +77,6 @@ void dw_fini(void *const hdl)
     }
 
     /* Free SPI structure */
+    free(spi->devcfg);
     free(spi);
 }
@@ -45,8 +45,12 @@ enum {
     OPTION_CS_MAX,
     OPTION_SSTE,
     OPTION_LOOPBACK,
+    OPTION_POLL_THLD,
+    OPTION_CS_OVERRIDE,
     OPTION_RX_CHANNEL,
     OPTION_TX_CHANNEL,
+    OPTION_DMA_LIB,
+    OPTION_DMA_BUF,
     NUM_OPTIONS
 };
 
@@ -128,9 +132,13 @@ static int dw_process_args(dw_spi_t *spi, char *options)
         [OPTION_CS_MAX]             = "cs_max",             /* Chip select max */
         [OPTION_SSTE]               = "sste",               /* Slave select Toggle enable */
         [OPTION_LOOPBACK]           = "loopback",           /* Loopback interface for testing */
+        [OPTION_POLL_THLD]          = "poll_thld",          /* Poll exchanges up to this size */
+        [OPTION_CS_OVERRIDE]        = "cs_override",        /* Chip select driven by SER only */
 #ifdef  DW_DMA
         [OPTION_RX_CHANNEL]         = "dma_rx_chan",        /* Receive channel ID for DMA */
         [OPTION_TX_CHANNEL]         = "dma_tx_chan",        /* Transmit channel ID for DMA */
+        [OPTION_DMA_LIB]            = "dma_lib",            /* DMA library */
+        [OPTION_DMA_BUF]            = "dma_buf",            /* DMA bounce buffer size */
 #endif
         [NUM_OPTIONS]               = NULL
     };
@@ -173,6 +181,19 @@ static int dw_process_args(dw_spi_t *spi, char *options)
             case OPTION_LOOPBACK:
                 spi->loopback = true; /* Enable loopback mode, used for testing */
                 break;
+            case OPTION_CS_OVERRIDE:
+                spi->cs_override = true;
+                spi_slogf(_SLOG_DEBUG2, "%s: chip select override is enabled", __func__);
+                break;
+            case OPTION_POLL_THLD:
+                if (value) {
+                    spi->poll_thld = (uint32_t) strtoul(value, NULL, 0);
+                    spi_slogf(_SLOG_DEBUG2, "%s: poll_thld = %u", __func__, spi->poll_thld);
+                } else {
+                    spi_slogf(_SLOG_ERROR, "%s: no poll_thld value provided", __func__);
+                    return EINVAL;
+                }
+                break;
 #ifdef  DW_DMA
             case OPTION_RX_CHANNEL:
                 spi->dma.rx_channel = (uint32_t)strtoul(value, NULL, 0);
@@ -180,6 +201,20 @@ static int dw_process_args(dw_spi_t *spi, char *options)
             case OPTION_TX_CHANNEL:
                 spi->dma.tx_channel = (uint32_t)strtoul(value, NULL, 0);
                 break;
+            case OPTION_DMA_LIB:
+                if (value == NULL) {
+                    spi_slogf(_SLOG_ERROR, "%s: no dma_lib value provided", __func__);
+                    return EINVAL;
+                }
+                spi->dma.lib = value;
+                break;
+            case OPTION_DMA_BUF:
+                spi->dma.buf_size = (value != NULL) ? (uint32_t)strtoul(value, NULL, 0) : 0;
+                if (spi->dma.buf_size == 0) {
+                    spi_slogf(_SLOG_ERROR, "%s: Invalid dma_buf value", __func__);
+                    return EINVAL;
+                }
+                break;
 #endif
             default:
                 spi_slogf(_SLOG_ERROR, "%s: wrong option", __func__);
@@ -220,6 +255,9 @@ static int dw_init_device(dw_spi_t *const spi)
     spi_bus_t *const    bus = spi->bus;
     spi_dev_t          *spi_dev = bus->devlist;
 
+    /* Read once, dw_cfg() needs it for the register images */
+    spi->version = dw_read32(spi, DW_SPI_VERSION);
+
     /*
      * Initial device configuration with defaults from config file
      */
@@ -236,6 +274,23 @@ static int dw_init_device(dw_spi_t *const spi)
     dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_MASK);
     dw_write32(spi, DW_SPI_CTRLR1, 0);
     dw_spi_deselect_slave(spi);
+    spi->hw_cr0   = DW_REG_INVALID;
+    spi->hw_cr1   = 0;
+
+    /*
+     * Chip selects follow SER so that they can be held across exchanges.
+     * The register is vendor specific, it reads back as written only if the
+     * controller implements it.
+     */
+    if (spi->cs_override) {
+        dw_write32(spi, DW_SPI_CS_OVERRIDE, DW_SPI_CS_OVERRIDE_ALL);
+        if ((dw_read32(spi, DW_SPI_CS_OVERRIDE) & DW_SPI_CS_OVERRIDE_ALL) != DW_SPI_CS_OVERRIDE_ALL) {
+            spi_slogf(_SLOG_WARNING, "%s: no chip select override on this controller, cs_override ignored", __func__);
+            dw_write32(spi, DW_SPI_CS_OVERRIDE, 0);
+            spi->cs_override = false;
+        }
+    }
+    spi->hw_baudr = DW_REG_INVALID;
 
     /* get fifo size */
     spi->fifo_len = dw_spi_get_fifo_len(spi);
@@ -249,10 +304,18 @@ static int dw_init_device(dw_spi_t *const spi)
             spi_slogf(_SLOG_INFO, "%s: SPI DMA threshold will be configured as %d on bus.", __func__, spi->bus->dma_thld);
         }
 
-        /* Init DMA */
+        /* Exchanges that fit the prefill complete with a single interrupt, no gain from DMA */
+        if (spi->bus->dma_thld == 0) {
+            spi->bus->dma_thld = (uint8_t)(spi->fifo_len / SPI_FIFO_LEN_DIV);
+        }
+
+        /* Init DMA, fall back to interrupt driven exchanges without it */
         status = dw_spi_init_dma(spi);
         if (status != EOK) {
             spi_slogf(_SLOG_ERROR, "%s: dw_spi_init_dma failed", __func__);
+            bus->funcs->dma_xfer        = NULL;
+            bus->funcs->dma_allocbuf    = NULL;
+            bus->funcs->dma_freebuf     = NULL;
         }
     }
 #endif
@@ -298,6 +361,7 @@ int spi_init(spi_bus_t *bus)
     bus->funcs->devinfo         = dw_devinfo;
     bus->funcs->setcfg          = dw_setcfg;
     bus->funcs->xfer            = dw_xfer;
+    bus->funcs->ctl             = dw_ctl;
     bus->funcs->dma_xfer        = NULL;
     bus->funcs->dma_allocbuf    = NULL;
     bus->funcs->dma_freebuf     = NULL;
@@ -312,9 +376,14 @@ int spi_init(spi_bus_t *bus)
     spi->map_size          = SPI0_SIZE;
     spi->cs_max            = SPI_CS_MAX_DEF;
     spi->sste              = false;
+    spi->poll_thld         = 0;
+    spi->cs_override       = false;
+    spi->in_seq            = false;
 #ifdef  DW_DMA
     spi->dma.rx_channel    = CHANNEL_ID_MAX;
     spi->dma.tx_channel    = CHANNEL_ID_MAX;
+    spi->dma.lib           = DW_SPI_DMA_LIB;
+    spi->dma.buf_size      = DW_SPI_DMA_BUF_SIZE;
 #endif
 
     /* Process args, override the defaults */
@@ -335,6 +404,14 @@ int spi_init(spi_bus_t *bus)
     }
 #endif
 
+    /* Register images of the chip select devices */
+    spi->devcfg = calloc(spi->cs_max, sizeof(dw_devcfg_t));
+    if (spi->devcfg == NULL) {
+        spi_slogf(_SLOG_ERROR, "%s: failed to allocate memory !", __func__);
+        dw_fini(spi);
+        return ENOMEM;
+    }
+
     /* Check the device interrupt number */
     if (spi->bus->irq <= 0) {
         spi_slogf(_SLOG_ERROR, "%s: Invalid IRQ: %x", __func__, spi->bus->irq);
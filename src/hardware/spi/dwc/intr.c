@@ -51,10 +51,17 @@
  */
 static inline void dw_read_fifo_uint8(const dw_spi_t *const spi, uint8_t *const buffer, const uint32_t len)
 {
-    register uint32_t i;
     volatile const uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        buffer[i] = (uint8_t) *addr;
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        buffer[i]      = (uint8_t) DW_REG_READ(addr);
+        buffer[i + 1U] = (uint8_t) DW_REG_READ(addr);
+        buffer[i + 2U] = (uint8_t) DW_REG_READ(addr);
+        buffer[i + 3U] = (uint8_t) DW_REG_READ(addr);
+    }
+    for (; i < len; i++) {
+        buffer[i] = (uint8_t) DW_REG_READ(addr);
     }
 }
 
@@ -68,10 +75,17 @@ static inline void dw_read_fifo_uint8(const dw_spi_t *const spi, uint8_t *const
  */
 static inline void dw_write_fifo_uint8(const dw_spi_t *const spi, const uint8_t *const buffer, const uint32_t len)
 {
-    register size_t i;
     volatile uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        *addr = buffer[i];
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        DW_REG_WRITE(addr, buffer[i]);
+        DW_REG_WRITE(addr, buffer[i + 1U]);
+        DW_REG_WRITE(addr, buffer[i + 2U]);
+        DW_REG_WRITE(addr, buffer[i + 3U]);
+    }
+    for (; i < len; i++) {
+        DW_REG_WRITE(addr, buffer[i]);
     }
 }
 
@@ -85,10 +99,17 @@ static inline void dw_write_fifo_uint8(const dw_spi_t *const spi, const uint8_t
  */
 static inline void dw_read_fifo_uint16(const dw_spi_t *const spi, uint16_t *const buffer, const uint32_t len)
 {
-    register size_t i;
     volatile const uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        buffer[i] = (uint16_t) *addr;
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        buffer[i]      = (uint16_t) DW_REG_READ(addr);
+        buffer[i + 1U] = (uint16_t) DW_REG_READ(addr);
+        buffer[i + 2U] = (uint16_t) DW_REG_READ(addr);
+        buffer[i + 3U] = (uint16_t) DW_REG_READ(addr);
+    }
+    for (; i < len; i++) {
+        buffer[i] = (uint16_t) DW_REG_READ(addr);
     }
 }
 
@@ -102,10 +123,17 @@ static inline void dw_read_fifo_uint16(const dw_spi_t *const spi, uint16_t *cons
  */
 static inline void dw_write_fifo_uint16(const dw_spi_t *const spi, const uint16_t *const buffer, const uint32_t len)
 {
-    register size_t i;
     volatile uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        *addr = buffer[i];
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        DW_REG_WRITE(addr, buffer[i]);
+        DW_REG_WRITE(addr, buffer[i + 1U]);
+        DW_REG_WRITE(addr, buffer[i + 2U]);
+        DW_REG_WRITE(addr, buffer[i + 3U]);
+    }
+    for (; i < len; i++) {
+        DW_REG_WRITE(addr, buffer[i]);
     }
 }
 
@@ -119,10 +147,17 @@ static inline void dw_write_fifo_uint16(const dw_spi_t *const spi, const uint16_
  */
 static inline void dw_read_fifo_uint32(const dw_spi_t *const spi, uint32_t *const buffer, const uint32_t len)
 {
-    register size_t i;
     volatile const uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        buffer[i] = *addr;
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        buffer[i]      = DW_REG_READ(addr);
+        buffer[i + 1U] = DW_REG_READ(addr);
+        buffer[i + 2U] = DW_REG_READ(addr);
+        buffer[i + 3U] = DW_REG_READ(addr);
+    }
+    for (; i < len; i++) {
+        buffer[i] = DW_REG_READ(addr);
     }
 }
 
@@ -136,10 +171,17 @@ static inline void dw_read_fifo_uint32(const dw_spi_t *const spi, uint32_t *cons
  */
 static inline void dw_write_fifo_uint32(const dw_spi_t *const spi, const uint32_t *const buffer, const uint32_t len)
 {
-    register size_t i;
     volatile uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR);
-    for (i = 0; i < len; i++) {
-        *addr = buffer[i];
+    uint32_t i = 0;
+
+    for (; (i + 4U) <= len; i += 4U) {
+        DW_REG_WRITE(addr, buffer[i]);
+        DW_REG_WRITE(addr, buffer[i + 1U]);
+        DW_REG_WRITE(addr, buffer[i + 2U]);
+        DW_REG_WRITE(addr, buffer[i + 3U]);
+    }
+    for (; i < len; i++) {
+        DW_REG_WRITE(addr, buffer[i]);
     }
 }
 
@@ -177,7 +219,7 @@ void dw_write_fifo(const dw_spi_t *const spi, const uint32_t len) {
  *
  *  @return            Void.
  */
-static void dw_read_fifo(const dw_spi_t *const spi, const uint32_t len) {
+void dw_read_fifo(const dw_spi_t *const spi, const uint32_t len) {
     switch (spi->dscale) {
         case 0:
             dw_read_fifo_uint8(spi, ((uint8_t*) spi->pbuf) + spi->rlen, len);
@@ -194,6 +236,39 @@ static void dw_read_fifo(const dw_spi_t *const spi, const uint32_t len) {
     }
 }
 
+/**
+ *  @brief             Process SPI interrupts of a transmit only exchange.
+ *  @param  spi        SPI driver handler.
+ *
+ *  @return            0: Transfer complete; 1: Transfer not complete.
+ */
+static int dw_process_tx_only(dw_spi_t *spi) {
+    uint32_t len;
+
+    if (spi->tlen < spi->xlen) {
+        len = min(spi->fifo_len - dw_read32(spi, DW_SPI_TXFLR), spi->xlen - spi->tlen);
+        dw_write_fifo(spi, len);
+        spi->tlen += len;
+
+        if (spi->tlen == spi->xlen) {
+            /* Interrupt once the FIFO is empty */
+            dw_write32(spi, DW_SPI_TXFTLR, 0);
+        }
+        return SPI_INTR_CONTINUE;
+    }
+
+    if (!dw_spi_tx_done(spi)) {
+        return SPI_INTR_CONTINUE;
+    }
+
+    /* Disable SPI and mask interrupts */
+    dw_spi_enable(spi, DW_SPI_DISABLE);
+    dw_write32(spi, DW_SPI_IMR, 0);
+    spi->rlen = spi->xlen;
+
+    return SPI_INTR_DONE;
+}
+
 /**
  *  @brief             Process SPI interrupts.
  *  @param  bus        The SPI bus structure
@@ -224,6 +299,21 @@ static int dw_process_interrupts(dw_spi_t *spi) {
         return SPI_INTR_ERR;
     }
 
+    /* Receive FIFO overflow, words are lost */
+    if ((dw_read32(spi, DW_SPI_RISR) & DW_SPI_INT_RXOI) != 0) {
+        dw_read32(spi, DW_SPI_RXOICR);
+        /* Disable SPI and mask interrupts */
+        dw_spi_enable(spi, DW_SPI_DISABLE);
+        dw_write32(spi, DW_SPI_IMR, 0);
+
+        spi_slogf(_SLOG_ERROR, "%s: Receive FIFO overflow, rlen = %u", __func__, spi->rlen);
+        return SPI_INTR_ERR;
+    }
+
+    if (spi->tmod == DW_SPI_CTRLR0_TMOD_TO) {
+        return dw_process_tx_only(spi);
+    }
+
     spi_slogf(_SLOG_DEBUG3, "%s: Starting interrupt routine read",
             __func__);
     len = dw_read32(spi, DW_SPI_RXFLR);
@@ -240,8 +330,8 @@ static int dw_process_interrupts(dw_spi_t *spi) {
     }
 
     if (spi->tlen < spi->xlen) {
-        //Get size of transmit
-        len = min(len, spi->xlen - spi->tlen);
+        /* Top the FIFO up, words in flight must not exceed the receive FIFO */
+        len = min(spi->fifo_len - (spi->tlen - spi->rlen), spi->xlen - spi->tlen);
         spi_slogf(_SLOG_DEBUG3, "%s:Size of fifo: %u, Transmit transaction left: %u",
                 __func__, spi->fifo_len, spi->xlen - spi->tlen);
 
@@ -304,7 +394,7 @@ int dw_wait(dw_spi_t *const spi)
             if (spi->dma_active) {
                 spi_slogf(_SLOG_DEBUG2, "%s: DMA xfer is done", __func__);
 
-                spi->rlen = spi->xlen - dma->dma_funcs.bytes_left(dma->rx_ch_handle);
+                spi->rlen = spi->xlen - (dma->dma_funcs.bytes_left(dma->rx_ch_handle) >> spi->dscale);
 
                 /* xfer_complete is used by some DMA lib to clear INT flags.
                  * It returns EOK on success, -1 on failure. Errors are logged in DMA lib.
@@ -351,3 +441,46 @@ int dw_wait(dw_spi_t *const spi)
 
     return status;
 }
+
+/**
+ *  @brief             Poll for SPI transfer complete.
+ *  @param  spi        SPI driver handler.
+ *
+ *  @return            EOK --success otherwise fail.
+ *
+ *  The whole exchange has been written to the transmit FIFO (or started
+ *  with a dummy word in receive only mode), drain the receive FIFO until
+ *  all words are in, or wait for the last word to shift out in transmit
+ *  only mode. The spin is bounded by four times the exchange time.
+ */
+int dw_poll(dw_spi_t *const spi)
+{
+    const uint64_t  cps = SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+    const uint64_t  limit = ClockCycles() + (((spi->xtime_us * 4U) + DW_POLL_SLACK_US) * cps) / 1000000U;
+    uint32_t        len;
+
+    if (spi->tmod == DW_SPI_CTRLR0_TMOD_TO) {
+        while (!dw_spi_tx_done(spi)) {
+            if (ClockCycles() > limit) {
+                spi_slogf(_SLOG_ERROR, "%s: polled exchange timeout, SR 0x%x", __func__, dw_read32(spi, DW_SPI_SR));
+                return ETIMEDOUT;
+            }
+        }
+        spi->rlen = spi->xlen;
+        return EOK;
+    }
+
+    while (spi->rlen < spi->xlen) {
+        len = dw_read32(spi, DW_SPI_RXFLR);
+        if (len != 0) {
+            len = min(len, spi->xlen - spi->rlen);
+            dw_read_fifo(spi, len);
+            spi->rlen += len;
+        } else if (ClockCycles() > limit) {
+            spi_slogf(_SLOG_ERROR, "%s: polled exchange timeout, SR 0x%x", __func__, dw_read32(spi, DW_SPI_SR));
+            return ETIMEDOUT;
+        }
+    }
+
+    return EOK;
+}
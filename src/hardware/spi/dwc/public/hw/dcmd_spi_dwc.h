@@ -0,0 +1,97 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+/*
+ *  dcmd_spi_dwc.h   Driver specific devctl definitions for spi-dwc
+ *
+ */
+
+#ifndef __DCMD_SPI_DWC_H_INCLUDED
+#define __DCMD_SPI_DWC_H_INCLUDED
+
+#ifndef _DEVCTL_H_INCLUDED
+ #include <devctl.h>
+#endif
+
+#include <_pack64.h>
+
+#define SPI_DWC_SEQ_MAX_SEGS        32
+
+/*
+ * One segment of a sequence.
+ *
+ * The segments of a sequence are exchanged with the device in order with
+ * its chip select held asserted from the first word to the last.
+ */
+typedef struct _spi_dwc_seg {
+#define SPI_DWC_SEG_TX              0x0001  /* transmit the segment data */
+#define SPI_DWC_SEG_RX              0x0002  /* receive into the segment data */
+    _Uint32t        flags;                  /* at least one of SPI_DWC_SEG_TX/RX */
+    _Uint32t        len;                    /* bytes, a multiple of the word size, must not be 0 */
+    _Uint32t        word_width;             /* bits per word, 0 for the device configuration */
+    _Uint32t        delay_us;               /* delay after the segment */
+    _Uint32t        status;                 /* out: EOK or errno, ECANCELED if not executed */
+    _Uint32t        rsvd;
+} spi_dwc_seg_t;
+
+/*
+ * DCMD_SPI_DWC_SEQ message layout:
+ *   spi_dwc_seq_t      header
+ *   spi_dwc_seg_t      seg[nsegs]
+ *   _Uint8t            data[]      the data of all segments in order; transmit
+ *                                  data is supplied by the client, received
+ *                                  data is returned in place
+ * Execution stops at the first segment that fails.
+ *
+ * Segments can differ in word width and have delays only if the driver runs
+ * with the cs_override option. Otherwise the sequence is exchanged as one
+ * continuous transfer: all segments must use the same word width and have no
+ * delay, and the data of transmit only segments is overwritten.
+ */
+typedef struct _spi_dwc_seq {
+    _Uint32t        nsegs;
+    _Uint32t        status;                 /* out: EOK or the status of the failing segment */
+} spi_dwc_seq_t;
+
+#define DCMD_SPI_DWC_SEQ            (__DIOTF(_DCMD_SPI, 0x80, struct _spi_dwc_seq))
+
+#include <_packpop.h>
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <dwc_variant.h>
+
+/**
+ *  @brief             Delay between the segments of a sequence.
+ *  @param  delay_us   Delay in microseconds.
+ *
+ *  @return            Void.
+ */
+static void dw_seq_delay(const uint32_t delay_us)
+{
+    if (delay_us <= DW_SEQ_SPIN_US) {
+        nanospin_ns((unsigned long)delay_us * 1000UL);
+    } else {
+        usleep(delay_us);
+    }
+}
+
+/**
+ *  @brief             Exchange a sequence as one continuous transfer.
+ *  @param  spi        SPI driver handler.
+ *  @param  spi_dev    SPI device structure pointer.
+ *  @param  seg        The segments.
+ *  @param  nsegs      The number of segments.
+ *  @param  data       The data of all segments.
+ *  @param  datalen    The number of data bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ *
+ *  Without chip select override the controller releases the chip select
+ *  when it is disabled, the only way to hold it is a single exchange.
+ */
+static int dw_seq_merged(dw_spi_t *const spi, spi_dev_t *const spi_dev, spi_dwc_seg_t *const seg,
+        const uint32_t nsegs, uint8_t *const data, const uint32_t datalen)
+{
+    const uint32_t  nbits = spi_dev->devinfo.cfg.mode & SPI_MODE_WORD_WIDTH_MASK;
+    uint32_t        flags = 0;
+    uint32_t        i;
+    int             status;
+
+    for (i = 0; i < nsegs; i++) {
+        if (((seg[i].word_width != 0) && (seg[i].word_width != nbits)) || (seg[i].delay_us != 0)) {
+            spi_slogf(_SLOG_ERROR, "%s: segment %u needs cs_override", __func__, i);
+            return ENOTSUP;
+        }
+        flags |= seg[i].flags;
+    }
+
+    /* No slave select toggle between the words */
+    spi->in_seq = true;
+    status = dw_xfer(spi, spi_dev, data,
+            ((flags & SPI_DWC_SEG_TX) != 0) ? datalen : 0,
+            ((flags & SPI_DWC_SEG_RX) != 0) ? datalen : 0);
+    spi->in_seq = false;
+
+    for (i = 0; i < nsegs; i++) {
+        seg[i].status = (uint32_t)status;
+    }
+
+    return status;
+}
+
+/**
+ *  @brief             Exchange a sequence segment by segment.
+ *  @param  spi        SPI driver handler.
+ *  @param  spi_dev    SPI device structure pointer.
+ *  @param  seg        The segments.
+ *  @param  nsegs      The number of segments.
+ *  @param  data       The data of all segments.
+ *
+ *  @return            EOK --success otherwise fail.
+ *
+ *  The chip select follows SER, which stays set from the first segment to
+ *  the last.
+ */
+static int dw_seq_segments(dw_spi_t *const spi, spi_dev_t *const spi_dev, spi_dwc_seg_t *const seg,
+        const uint32_t nsegs, uint8_t *data)
+{
+    spi_cfg_t *const    cfg = &spi_dev->devinfo.cfg;
+    const uint32_t      mode = cfg->mode;
+    uint32_t            i;
+    int                 status = EOK;
+
+    spi->in_seq = true;
+
+    for (i = 0; i < nsegs; i++) {
+        /* Word width of the segment, the register image is rebuilt for it */
+        if (seg[i].word_width != 0) {
+            cfg->mode = (mode & ~SPI_MODE_WORD_WIDTH_MASK) | seg[i].word_width;
+        } else {
+            cfg->mode = mode;
+        }
+
+        status = dw_exchange(spi, spi_dev, data,
+                ((seg[i].flags & SPI_DWC_SEG_TX) != 0) ? seg[i].len : 0,
+                ((seg[i].flags & SPI_DWC_SEG_RX) != 0) ? seg[i].len : 0);
+        seg[i].status = (uint32_t)status;
+        if (status != EOK) {
+            break;
+        }
+
+        if (seg[i].delay_us != 0) {
+            dw_seq_delay(seg[i].delay_us);
+        }
+        data += seg[i].len;
+    }
+
+    spi->in_seq = false;
+    dw_spi_deselect_slave(spi);
+
+    if (cfg->mode != mode) {
+        cfg->mode = mode;
+        (void)dw_cfg(spi, spi_dev);
+    }
+
+    return status;
+}
+
+/**
+ *  @brief             Exchange a sequence of segments with the chip select held.
+ *  @param  spi        SPI driver handler.
+ *  @param  spi_dev    SPI device structure pointer.
+ *  @param  msg        DCMD_SPI_DWC_SEQ message.
+ *  @param  msglen     Message length.
+ *  @param  nbytes     Reply length.
+ *
+ *  @return            EOK --the sequence was executed, its status is in the
+ *                     message, otherwise the message is invalid.
+ */
+static int dw_seq(dw_spi_t *const spi, spi_dev_t *const spi_dev, void *const msg, const int msglen, int *const nbytes)
+{
+    spi_dwc_seq_t  *hdr = msg;
+    spi_dwc_seg_t  *seg;
+    uint8_t        *data;
+    uint32_t        hdrlen, datalen = 0;
+    uint32_t        i;
+
+    if (((uint32_t)msglen < sizeof(*hdr)) || (hdr->nsegs == 0U) || (hdr->nsegs > SPI_DWC_SEQ_MAX_SEGS)) {
+        return EINVAL;
+    }
+
+    hdrlen = (uint32_t)sizeof(*hdr) + (hdr->nsegs * (uint32_t)sizeof(*seg));
+    if ((uint32_t)msglen < hdrlen) {
+        return EINVAL;
+    }
+
+    seg  = (spi_dwc_seg_t *)(hdr + 1);
+    data = (uint8_t *)(seg + hdr->nsegs);
+
+    for (i = 0; i < hdr->nsegs; i++) {
+        if ((seg[i].len == 0U) || (seg[i].len > ((uint32_t)msglen - hdrlen - datalen)) ||
+            ((seg[i].flags & (SPI_DWC_SEG_TX | SPI_DWC_SEG_RX)) == 0U) ||
+            ((seg[i].word_width != 0U) &&
+             ((seg[i].word_width <= SPI_MIN_WORD_WIDTH) || (seg[i].word_width > SPI_MAX_WORD_WIDTH)))) {
+            spi_slogf(_SLOG_ERROR, "%s: bad segment %u", __func__, i);
+            return EINVAL;
+        }
+        seg[i].status = ECANCELED;
+        datalen += seg[i].len;
+    }
+
+    if (spi->cs_override) {
+        hdr->status = (uint32_t)dw_seq_segments(spi, spi_dev, seg, hdr->nsegs, data);
+    } else {
+        hdr->status = (uint32_t)dw_seq_merged(spi, spi_dev, seg, hdr->nsegs, data, datalen);
+    }
+
+    *nbytes = (int)(hdrlen + datalen);
+
+    return EOK;
+}
+
+/**
+ *  @brief             Driver specific devctl.
+ *  @param  hdl        SPI driver handler.
+ *  @param  spi_dev    SPI device structure pointer.
+ *  @param  cmd        Devctl command.
+ *  @param  msg        Message.
+ *  @param  msglen     Message length.
+ *  @param  nbytes     Reply length.
+ *  @param  info       Devctl return info.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+int dw_ctl(void *const hdl, spi_dev_t *const spi_dev, const int cmd, void *const msg, const int msglen, int *const nbytes, int *const info)
+{
+    dw_spi_t *const spi = hdl;
+
+    (void)info;
+
+    switch (cmd) {
+        case DCMD_SPI_DWC_SEQ:
+            return dw_seq(spi, spi_dev, msg, msglen, nbytes);
+        default:
+            break;
+    }
+
+    return ENOTSUP;
+}
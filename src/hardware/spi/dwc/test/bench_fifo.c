@@ -0,0 +1,185 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+/*
+ * Microbenchmark of the FIFO copy kernels of intr.c against the per-word
+ * loops they replaced. intr.c is built without the register model, the
+ * data register is plain memory: the figures are the loop cost around the
+ * register access, the access itself is far slower on the device.
+ *
+ *   bench_fifo [-n iterations] [-l words]
+ */
+
+#include <time.h>
+#include "../intr.c"
+
+static struct syspage_entry dw_model_syspage = { .num_cpu = 1, .qtime = { 1000000000ULL } };
+struct syspage_entry *_syspage_ptr = &dw_model_syspage;
+
+/* intr.c references these outside the kernels */
+void dw_spi_enable(const dw_spi_t *const spi, const uint32_t enable_value) { }
+bool dw_spi_tx_done(const dw_spi_t *const spi) { return true; }
+int InterruptUnmask(int intr, int id) { return 0; }
+int sem_timedwait_monotonic(sem_t *sem, const struct timespec *abs_timeout) { return 0; }
+uint64_t ClockCycles(void) { return 0; }
+void nsec2timespec(struct timespec *ts, uint64_t nsec) { }
+void spi_slogf(const int level, const char *const fmt, ...) { }
+
+uint64_t clock_gettime_mon_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+typedef void (*kernel_t)(const dw_spi_t *const spi, void *const buffer, const uint32_t len);
+
+/* The per-word loops before the kernels were unrolled */
+#define ROLLED_READ(__name, __type) \
+    static void __attribute__((noinline)) __name(const dw_spi_t *const spi, void *const buffer, const uint32_t len) \
+    { \
+        volatile const uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR); \
+        __type *const buf = buffer; \
+        uint32_t i; \
+        for (i = 0; i < len; i++) { \
+            buf[i] = (__type) *addr; \
+        } \
+    }
+
+#define ROLLED_WRITE(__name, __type) \
+    static void __attribute__((noinline)) __name(const dw_spi_t *const spi, void *const buffer, const uint32_t len) \
+    { \
+        volatile uint32_t *const addr = (uint32_t*)(spi->vbase + DW_SPI_DR); \
+        const __type *const buf = buffer; \
+        uint32_t i; \
+        for (i = 0; i < len; i++) { \
+            *addr = buf[i]; \
+        } \
+    }
+
+/* The kernels of intr.c, same call overhead */
+#define UNROLLED(__name, __kernel) \
+    static void __attribute__((noinline)) __name(const dw_spi_t *const spi, void *const buffer, const uint32_t len) \
+    { \
+        __kernel(spi, buffer, len); \
+    }
+
+ROLLED_READ(rolled_read_uint8, uint8_t)
+ROLLED_READ(rolled_read_uint16, uint16_t)
+ROLLED_READ(rolled_read_uint32, uint32_t)
+ROLLED_WRITE(rolled_write_uint8, uint8_t)
+ROLLED_WRITE(rolled_write_uint16, uint16_t)
+ROLLED_WRITE(rolled_write_uint32, uint32_t)
+
+UNROLLED(unrolled_read_uint8, dw_read_fifo_uint8)
+UNROLLED(unrolled_read_uint16, dw_read_fifo_uint16)
+UNROLLED(unrolled_read_uint32, dw_read_fifo_uint32)
+UNROLLED(unrolled_write_uint8, dw_write_fifo_uint8)
+UNROLLED(unrolled_write_uint16, dw_write_fifo_uint16)
+UNROLLED(unrolled_write_uint32, dw_write_fifo_uint32)
+
+static const struct {
+    const char  *name;
+    kernel_t    rolled;
+    kernel_t    unrolled;
+} kernels[] = {
+    { "read 8",   rolled_read_uint8,   unrolled_read_uint8 },
+    { "read 16",  rolled_read_uint16,  unrolled_read_uint16 },
+    { "read 32",  rolled_read_uint32,  unrolled_read_uint32 },
+    { "write 8",  rolled_write_uint8,  unrolled_write_uint8 },
+    { "write 16", rolled_write_uint16, unrolled_write_uint16 },
+    { "write 32", rolled_write_uint32, unrolled_write_uint32 },
+};
+
+static uint32_t     regs[SPI0_SIZE / sizeof(uint32_t)];
+static uint32_t     buffer[DW_SPI_MAX_FIFO_LENGTH];
+
+static double time_kernel(const dw_spi_t *const spi, const kernel_t kernel, const uint32_t iterations,
+        const uint32_t words)
+{
+    const uint64_t start = clock_gettime_mon_ns();
+    uint32_t n;
+
+    for (n = 0; n < iterations; n++) {
+        kernel(spi, buffer, words);
+    }
+    return (double)(clock_gettime_mon_ns() - start) / ((double)iterations * words);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    iterations = 1000000, words = 32;
+    dw_spi_t    spi;
+    uint32_t    i;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "n:l:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = max((uint32_t)strtoul(optarg, NULL, 0), 1U);
+                break;
+            case 'l':
+                words = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-n iterations] [-l words]\n", argv[0]);
+                return 2;
+        }
+    }
+    words = min(max(words, 1U), DW_SPI_MAX_FIFO_LENGTH);
+
+    (void)memset(&spi, 0, sizeof(spi));
+    spi.vbase = (uintptr_t)regs;
+
+    (void)printf("%u words per call\n%-9s %12s %12s\n", words, "kernel", "rolled_ns", "unrolled_ns");
+    for (i = 0; i < (sizeof(kernels) / sizeof(kernels[0])); i++) {
+        /* Warm up */
+        (void)time_kernel(&spi, kernels[i].rolled, max(iterations / 10U, 1U), words);
+        (void)time_kernel(&spi, kernels[i].unrolled, max(iterations / 10U, 1U), words);
+        (void)printf("%-9s %12.3f %12.3f\n", kernels[i].name,
+                     time_kernel(&spi, kernels[i].rolled, iterations, words),
+                     time_kernel(&spi, kernels[i].unrolled, iterations, words));
+    }
+
+    return 0;
+}
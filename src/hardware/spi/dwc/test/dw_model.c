@@ -0,0 +1,791 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#include <stdarg.h>
+#include "dw_model.h"
+
+#define DW_MODEL_TMOD(__cr0)    (((__cr0) & DW_SPI_CTRLR0_TMOD_MASK) >> DW_SPI_CTRLR0_TMOD_OFFSET)
+#define DW_MODEL_NO_IRQ         UINT64_MAX
+
+dw_model_t                  dw_model;
+static struct syspage_entry dw_model_syspage = { .num_cpu = 1, .qtime = { 1000000000ULL } };
+struct syspage_entry        *_syspage_ptr = &dw_model_syspage;  /* ClockCycles() counts the model's nanoseconds */
+
+static uint32_t             dw_model_regs[SPI0_SIZE / sizeof(uint32_t)];
+static spi_ctrl_t           dw_model_ctrl;
+static spi_funcs_t          dw_model_funcs;
+static spi_bus_t            dw_model_spi_bus;
+static spi_dev_t            dw_model_spi_dev;
+static sem_t                dw_model_sem;
+static char                 dw_model_opts[256];
+
+uint32_t dw_model_miso(uint32_t n)
+{
+    return (n * 0x9e3779b1U) ^ 0x5a5a5a5aU;
+}
+
+static uint32_t model_word_mask(void)
+{
+    const uint32_t dfs32 = (dw_model.ctrlr0 & DW_PSSI_CTRLR0_DFS32_MASK) >> DW_PSSI_CTRLR0_DFS32_OFFSET;
+    const uint32_t nbits = (dfs32 != 0U) ? (dfs32 + 1U) : ((dw_model.ctrlr0 & DW_PSSI_CTRLR0_DFS_MASK) + 1U);
+
+    return (nbits >= 32U) ? 0xffffffffU : ((1U << nbits) - 1U);
+}
+
+static bool model_override(void)
+{
+    return dw_model.cs_override_impl && ((dw_model.cs_override & DW_SPI_CS_OVERRIDE_ALL) != 0U);
+}
+
+static void model_cs(const bool assert)
+{
+    if (assert && !dw_model.cs) {
+        dw_model.cs_asserts++;
+    }
+    dw_model.cs = assert;
+}
+
+static void tx_push(const uint32_t value)
+{
+    if (dw_model.txn == DW_MODEL_FIFO_DEPTH) {
+        dw_model.latched |= DW_SPI_INT_TXOI;
+        return;
+    }
+    dw_model.tx[(dw_model.txh + dw_model.txn) % DW_MODEL_FIFO_DEPTH] = value;
+    dw_model.txn++;
+}
+
+static uint32_t tx_pop(void)
+{
+    const uint32_t value = dw_model.tx[dw_model.txh];
+
+    dw_model.txh = (dw_model.txh + 1U) % DW_MODEL_FIFO_DEPTH;
+    dw_model.txn--;
+    return value;
+}
+
+static void rx_push(const uint32_t value)
+{
+    if (dw_model.rxn == DW_MODEL_FIFO_DEPTH) {
+        dw_model.latched |= DW_SPI_INT_RXOI;
+        dw_model.rx_overflows++;
+        return;
+    }
+    dw_model.rx[(dw_model.rxh + dw_model.rxn) % DW_MODEL_FIFO_DEPTH] = value;
+    dw_model.rxn++;
+}
+
+static uint32_t rx_pop(void)
+{
+    uint32_t value;
+
+    if (dw_model.rxn == 0U) {
+        dw_model.latched |= DW_SPI_INT_RXUI;
+        return 0;
+    }
+    value = dw_model.rx[dw_model.rxh];
+    dw_model.rxh = (dw_model.rxh + 1U) % DW_MODEL_FIFO_DEPTH;
+    dw_model.rxn--;
+    return value;
+}
+
+static bool model_can_start(void)
+{
+    if ((dw_model.ssienr == 0U) || (dw_model.ser == 0U)) {
+        return false;
+    }
+    if (DW_MODEL_TMOD(dw_model.ctrlr0) == DW_SPI_CTRLR0_TMOD_RO) {
+        return dw_model.ro_left != 0U;
+    }
+    return dw_model.txn != 0U;
+}
+
+static uint32_t model_risr(void)
+{
+    uint32_t risr = dw_model.latched;
+
+    if ((dw_model.ssienr != 0U) && (dw_model.txn <= dw_model.txftlr)) {
+        risr |= DW_SPI_INT_TXEI;
+    }
+    if (dw_model.rxn > dw_model.rxftlr) {
+        risr |= DW_SPI_INT_RXFI;
+    }
+    return risr;
+}
+
+static uint32_t model_sr(void)
+{
+    uint32_t sr = 0;
+
+    if (dw_model.shifting || model_can_start()) {
+        sr |= DW_SPI_SR_BUSY;
+    }
+    if (dw_model.txn < DW_MODEL_FIFO_DEPTH) {
+        sr |= DW_SPI_SR_TF_NOT_FULL;
+    }
+    if (dw_model.txn == 0U) {
+        sr |= DW_SPI_SR_TF_EMPTY;
+    }
+    if (dw_model.rxn != 0U) {
+        sr |= DW_SPI_SR_RF_NOT_EMPTY;
+    }
+    if (dw_model.rxn == DW_MODEL_FIFO_DEPTH) {
+        sr |= DW_SPI_SR_RF_FULL;
+    }
+    return sr;
+}
+
+static uint32_t chan_get(const dw_model_chan_t *const ch)
+{
+    const uint8_t *const p = (const uint8_t *)(uintptr_t)ch->mem.paddr + ch->pos;
+    uint32_t value = 0;
+    uint32_t i;
+
+    for (i = 0; i < ch->unit; i++) {
+        value |= (uint32_t)p[i] << (8U * i);
+    }
+    return value;
+}
+
+static void chan_put(const dw_model_chan_t *const ch, const uint32_t value)
+{
+    uint8_t *const p = (uint8_t *)(uintptr_t)ch->mem.paddr + ch->pos;
+    uint32_t i;
+
+    for (i = 0; i < ch->unit; i++) {
+        p[i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+/* Serve the DMA requests of the controller, a whole burst at a time */
+static void model_dma(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2U; i++) {
+        dw_model_chan_t *const ch = &dw_model.chan[i];
+
+        if (!ch->active) {
+            continue;
+        }
+        if (ch->to_device) {
+            if (((dw_model.dmacr & DW_SPI_DMA_TDMAE) == 0U) || (dw_model.ssienr == 0U) ||
+                (dw_model.txn > dw_model.dmatdlr)) {
+                continue;
+            }
+            while ((dw_model.txn < DW_MODEL_FIFO_DEPTH) && (ch->pos < ch->bytes)) {
+                tx_push(chan_get(ch));
+                ch->pos += ch->unit;
+            }
+        } else {
+            if (((dw_model.dmacr & DW_SPI_DMA_RDMAE) == 0U) || (dw_model.rxn <= dw_model.dmardlr)) {
+                continue;
+            }
+            while ((dw_model.rxn != 0U) && (ch->pos < ch->bytes)) {
+                chan_put(ch, rx_pop());
+                ch->pos += ch->unit;
+            }
+        }
+        if (ch->pos >= ch->bytes) {
+            ch->active = false;
+            if (ch->event) {
+                dw_model.dma_done = true;
+            }
+        }
+    }
+}
+
+static void model_start_word(void)
+{
+    const uint32_t tmod = DW_MODEL_TMOD(dw_model.ctrlr0);
+
+    if (!model_override()) {
+        if (dw_model.cs && ((dw_model.ctrlr0 & DW_SPI_SSTE) != 0U)) {
+            dw_model.cs = false;            /* Toggled between the words */
+        }
+        model_cs(true);
+    }
+
+    if (tmod == DW_SPI_CTRLR0_TMOD_RO) {
+        dw_model.ro_left--;
+        dw_model.word = 0;
+    } else {
+        dw_model.word = tx_pop() & model_word_mask();
+    }
+    if ((dw_model.last_done != 0U) && (dw_model.free_at > dw_model.last_done)) {
+        dw_model.gaps++;
+        dw_model.gap_ns += dw_model.free_at - dw_model.last_done;
+    }
+    dw_model.shifting  = true;
+    dw_model.word_done = dw_model.free_at + dw_model.word_ns;
+}
+
+static void model_finish_word(void)
+{
+    const uint32_t tmod = DW_MODEL_TMOD(dw_model.ctrlr0);
+    uint32_t miso = dw_model_miso(dw_model.nmiso) & model_word_mask();
+
+    if (tmod != DW_SPI_CTRLR0_TMOD_RO) {
+        if (dw_model.nmosi < DW_MODEL_LOG_MAX) {
+            dw_model.mosi[dw_model.nmosi] = dw_model.word;
+        }
+        dw_model.nmosi++;
+    }
+    if ((dw_model.ctrlr0 & DW_PSSI_CTRLR0_SRL) != 0U) {
+        miso = dw_model.word;
+    }
+    dw_model.nmiso++;
+    if (tmod != DW_SPI_CTRLR0_TMOD_TO) {
+        rx_push(miso);
+    }
+
+    dw_model.shifting  = false;
+    dw_model.free_at   = dw_model.word_done;
+    dw_model.last_done = dw_model.word_done;
+}
+
+/* Run the controller up to the current time */
+static void model_run(void)
+{
+    for (;;) {
+        model_dma();
+        if (!dw_model.shifting) {
+            if (!model_can_start()) {
+                break;
+            }
+            model_start_word();
+        }
+        if (dw_model.word_done > dw_model.now) {
+            return;
+        }
+        model_finish_word();
+    }
+
+    /* Idle, the next word starts no earlier than now */
+    dw_model.free_at = dw_model.now;
+    if (!model_override()) {
+        model_cs(false);
+    }
+}
+
+static uint32_t model_access(volatile const uint32_t *const addr)
+{
+    dw_model.now += DW_MODEL_REG_NS;
+    model_run();
+    return (uint32_t)((uintptr_t)addr - (uintptr_t)dw_model_regs);
+}
+
+uint32_t dw_model_read32(volatile const uint32_t *addr)
+{
+    const uint32_t offset = model_access(addr);
+    uint32_t value = 0;
+
+    switch (offset) {
+        case DW_SPI_CTRLR0:     value = dw_model.ctrlr0; break;
+        case DW_SPI_CTRLR1:     value = dw_model.ctrlr1; break;
+        case DW_SPI_SSIENR:     value = dw_model.ssienr; break;
+        case DW_SPI_SER:        value = dw_model.ser; break;
+        case DW_SPI_BAUDR:      value = dw_model.baudr; break;
+        case DW_SPI_TXFTLR:     value = dw_model.txftlr; break;
+        case DW_SPI_RXFTLR:     value = dw_model.rxftlr; break;
+        case DW_SPI_TXFLR:      value = dw_model.txn; break;
+        case DW_SPI_RXFLR:      value = dw_model.rxn; break;
+        case DW_SPI_SR:         value = model_sr(); break;
+        case DW_SPI_IMR:        value = dw_model.imr; break;
+        case DW_SPI_ISR:        value = model_risr() & dw_model.imr; break;
+        case DW_SPI_RISR:       value = model_risr(); break;
+        case DW_SPI_TXOICR:
+            value = (dw_model.latched & DW_SPI_INT_TXOI) != 0U;
+            dw_model.latched &= ~DW_SPI_INT_TXOI;
+            break;
+        case DW_SPI_RXOICR:
+            value = (dw_model.latched & DW_SPI_INT_RXOI) != 0U;
+            dw_model.latched &= ~DW_SPI_INT_RXOI;
+            break;
+        case DW_SPI_RXUICR:
+            value = (dw_model.latched & DW_SPI_INT_RXUI) != 0U;
+            dw_model.latched &= ~DW_SPI_INT_RXUI;
+            break;
+        case DW_SPI_ICR:
+            value = dw_model.latched != 0U;
+            dw_model.latched = 0;
+            break;
+        case DW_SPI_DMACR:      value = dw_model.dmacr; break;
+        case DW_SPI_DMATDLR:    value = dw_model.dmatdlr; break;
+        case DW_SPI_DMARDLR:    value = dw_model.dmardlr; break;
+        case DW_SPI_VERSION:    value = DW_MODEL_VERSION; break;
+        case DW_SPI_DR:         value = rx_pop(); break;
+        case DW_SPI_CS_OVERRIDE:
+            value = dw_model.cs_override_impl ? dw_model.cs_override : 0U;
+            break;
+        default:
+            break;
+    }
+
+    return value;
+}
+
+void dw_model_write32(volatile uint32_t *addr, uint32_t value)
+{
+    const uint32_t offset = model_access(addr);
+    const bool enabled = dw_model.ssienr != 0U;
+
+    switch (offset) {
+        /* Only writable while the controller is disabled */
+        case DW_SPI_CTRLR0:
+            if (!enabled) {
+                dw_model.ctrlr0 = value;
+            }
+            break;
+        case DW_SPI_CTRLR1:
+            if (!enabled) {
+                dw_model.ctrlr1 = value & DW_SPI_NDF_MASK;
+            }
+            break;
+        case DW_SPI_BAUDR:
+            if (!enabled) {
+                dw_model.baudr = value & 0xfffeU;
+            }
+            break;
+        case DW_SPI_SSIENR:
+            dw_model.ssienr = value & 1U;
+            if (dw_model.ssienr == 0U) {
+                /* Disabling halts the transfer and clears the FIFOs */
+                dw_model.txn = dw_model.txh = 0;
+                dw_model.rxn = dw_model.rxh = 0;
+                dw_model.ro_left = 0;
+                dw_model.shifting = false;
+                dw_model.latched = 0;
+                dw_model.last_done = 0;
+                dw_model.free_at = dw_model.now;
+                if (!model_override()) {
+                    model_cs(false);
+                }
+            }
+            break;
+        case DW_SPI_SER:
+            dw_model.ser = value;
+            if (model_override()) {
+                model_cs(value != 0U);
+            }
+            break;
+        case DW_SPI_TXFTLR:
+            if (value < DW_MODEL_FIFO_DEPTH) {
+                dw_model.txftlr = value;
+            }
+            break;
+        case DW_SPI_RXFTLR:
+            if (value < DW_MODEL_FIFO_DEPTH) {
+                dw_model.rxftlr = value;
+            }
+            break;
+        case DW_SPI_IMR:        dw_model.imr = value & DW_SPI_INT_MASK; break;
+        case DW_SPI_DMACR:      dw_model.dmacr = value & (DW_SPI_DMA_RDMAE | DW_SPI_DMA_TDMAE); break;
+        case DW_SPI_DMATDLR:
+            if (value < DW_MODEL_FIFO_DEPTH) {
+                dw_model.dmatdlr = value;
+            }
+            break;
+        case DW_SPI_DMARDLR:
+            if (value < DW_MODEL_FIFO_DEPTH) {
+                dw_model.dmardlr = value;
+            }
+            break;
+        case DW_SPI_DR:
+            if (!enabled) {
+                break;
+            }
+            if (DW_MODEL_TMOD(dw_model.ctrlr0) == DW_SPI_CTRLR0_TMOD_RO) {
+                /* The dummy word starts CTRLR1 + 1 words */
+                if ((dw_model.ro_left == 0U) && !dw_model.shifting) {
+                    dw_model.ro_left = dw_model.ctrlr1 + 1U;
+                }
+            } else {
+                tx_push(value);
+            }
+            break;
+        case DW_SPI_CS_OVERRIDE:
+            if (dw_model.cs_override_impl) {
+                dw_model.cs_override = value & DW_SPI_CS_OVERRIDE_ALL;
+                model_cs(model_override() && (dw_model.ser != 0U));
+            }
+            break;
+        default:
+            break;
+    }
+
+    model_run();
+}
+
+/*
+ * The bus event is delivered for a DMA completion, or for a pending
+ * controller interrupt once the latency has passed and the interrupt is
+ * unmasked. Time jumps to the next word or interrupt, a wait that can
+ * never be satisfied times out at once.
+ */
+int sem_timedwait_monotonic(sem_t *sem, const struct timespec *abs_timeout)
+{
+    const uint64_t deadline = ((uint64_t)abs_timeout->tv_sec * 1000000000ULL) + (uint64_t)abs_timeout->tv_nsec;
+    uint64_t next;
+
+    (void)sem;
+
+    for (;;) {
+        model_run();
+
+        if (dw_model.dma_done) {
+            dw_model.dma_done = false;
+            return 0;
+        }
+
+        next = deadline;
+        if (!dw_model.irq_masked && ((model_risr() & dw_model.imr) != 0U)) {
+            if (dw_model.irq_at == DW_MODEL_NO_IRQ) {
+                dw_model.irq_at = dw_model.now + dw_model.irq_latency_ns;
+            }
+            if (dw_model.now >= dw_model.irq_at) {
+                dw_model.irq_at = DW_MODEL_NO_IRQ;
+                dw_model.irq_masked = true;
+                dw_model.irqs++;
+                return 0;
+            }
+            next = min(next, dw_model.irq_at);
+        } else {
+            dw_model.irq_at = DW_MODEL_NO_IRQ;
+            if (!dw_model.shifting) {
+                next = max(next, dw_model.now);
+                dw_model.now = next;
+                errno = ETIMEDOUT;
+                return -1;
+            }
+        }
+        if (dw_model.shifting) {
+            next = min(next, dw_model.word_done);
+        }
+        if (next >= deadline) {
+            dw_model.now = max(dw_model.now, deadline);
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        dw_model.now = max(dw_model.now, next);
+    }
+}
+
+int InterruptAttachEvent(int intr, const struct sigevent *event, unsigned flags)
+{
+    (void)intr;
+    (void)event;
+    (void)flags;
+    dw_model.irq_masked = false;
+    return 1;
+}
+
+int InterruptDetach(int id)
+{
+    (void)id;
+    return 0;
+}
+
+int InterruptUnmask(int intr, int id)
+{
+    (void)intr;
+    (void)id;
+    dw_model.irq_masked = false;
+    return 0;
+}
+
+uint64_t ClockCycles(void)
+{
+    dw_model.now += DW_MODEL_REG_NS;
+    model_run();
+    return dw_model.now;
+}
+
+uint64_t clock_gettime_mon_ns(void)
+{
+    return dw_model.now;
+}
+
+void nsec2timespec(struct timespec *ts, uint64_t nsec)
+{
+    ts->tv_sec  = (time_t)(nsec / 1000000000ULL);
+    ts->tv_nsec = (long)(nsec % 1000000000ULL);
+}
+
+int nanospin_ns(unsigned long nsec)
+{
+    dw_model.now += nsec;
+    return 0;
+}
+
+int usleep(useconds_t usec)
+{
+    dw_model.now += (uint64_t)usec * 1000ULL;
+    return 0;
+}
+
+void *mmap_device_memory(void *addr, size_t len, int prot, int flags, uint64_t physical)
+{
+    (void)addr;
+    (void)len;
+    (void)prot;
+    (void)flags;
+    (void)physical;
+    return dw_model_regs;
+}
+
+int munmap_device_memory(void *addr, size_t len)
+{
+    (void)addr;
+    (void)len;
+    return 0;
+}
+
+int spi_create_devs(spi_dev_t *head)
+{
+    (void)head;
+    return EOK;
+}
+
+void spi_slogf(const int level, const char *const fmt, ...)
+{
+    va_list ap;
+
+    if ((level > _SLOG_WARNING) && (getenv("DW_MODEL_LOG") == NULL)) {
+        return;
+    }
+    va_start(ap, fmt);
+    (void)vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    (void)fputc('\n', stderr);
+}
+
+size_t dw_model_strlcpy(char *dst, const char *src, size_t size)
+{
+    const size_t len = strlen(src);
+
+    if (size != 0U) {
+        const size_t n = min(len, size - 1U);
+        (void)memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+/* DMA library */
+
+static int dma_init(const char *options)
+{
+    (void)options;
+    return 0;
+}
+
+static void dma_fini(void)
+{
+}
+
+static void *dma_channel_attach(const char *options, const struct sigevent *event, unsigned *channel,
+        int priority, dma_attach_flags flags)
+{
+    dw_model_chan_t *ch;
+
+    (void)options;
+    (void)priority;
+    if (*channel >= 2U) {
+        return NULL;
+    }
+    ch = &dw_model.chan[*channel];
+    if (ch->attached) {
+        return NULL;
+    }
+    ch->attached = true;
+    ch->event = (event != NULL) && ((flags & DMA_ATTACH_EVENT_ON_COMPLETE) != 0);
+    return ch;
+}
+
+static void dma_channel_release(void *handle)
+{
+    dw_model_chan_t *const ch = handle;
+
+    ch->attached = false;
+    ch->active = false;
+}
+
+static int dma_alloc_buffer(void *handle, dma_addr_t *addr, unsigned size, unsigned flags)
+{
+    (void)handle;
+    (void)flags;
+    addr->vaddr = calloc(1, size);
+    if (addr->vaddr == NULL) {
+        return -1;
+    }
+    addr->paddr = (uintptr_t)addr->vaddr;
+    addr->len   = size;
+    return 0;
+}
+
+static void dma_free_buffer(void *handle, dma_addr_t *addr)
+{
+    (void)handle;
+    free(addr->vaddr);
+}
+
+static int dma_setup_xfer(void *handle, const dma_transfer_t *tinfo)
+{
+    dw_model_chan_t *const ch = handle;
+
+    ch->to_device = (tinfo->dst_flags & DMA_ADDR_FLAG_DEVICE) != 0;
+    ch->mem   = ch->to_device ? tinfo->src_addrs[0] : tinfo->dst_addrs[0];
+    ch->unit  = tinfo->xfer_unit_size / 8U;
+    ch->bytes = tinfo->xfer_bytes;
+    ch->pos   = 0;
+    if ((ch->unit == 0U) || (ch->bytes > ch->mem.len)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int dma_xfer_start(void *handle)
+{
+    dw_model_chan_t *const ch = handle;
+
+    ch->active = true;
+    return 0;
+}
+
+static int dma_xfer_abort(void *handle)
+{
+    dw_model_chan_t *const ch = handle;
+
+    ch->active = false;
+    return 0;
+}
+
+static int dma_xfer_complete(void *handle)
+{
+    (void)handle;
+    return 0;
+}
+
+static unsigned dma_bytes_left(void *handle)
+{
+    const dw_model_chan_t *const ch = handle;
+
+    return ch->bytes - ch->pos;
+}
+
+int dw_model_get_dmafuncs(dma_functions_t *functable, int tabsize)
+{
+    if (tabsize < (int)sizeof(*functable)) {
+        return -1;
+    }
+    functable->init            = dma_init;
+    functable->fini            = dma_fini;
+    functable->channel_attach  = dma_channel_attach;
+    functable->channel_release = dma_channel_release;
+    functable->alloc_buffer    = dma_alloc_buffer;
+    functable->free_buffer     = dma_free_buffer;
+    functable->setup_xfer      = dma_setup_xfer;
+    functable->xfer_start      = dma_xfer_start;
+    functable->xfer_abort      = dma_xfer_abort;
+    functable->xfer_complete   = dma_xfer_complete;
+    functable->bytes_left      = dma_bytes_left;
+    return 0;
+}
+
+/* Harness */
+
+void dw_model_reset(void)
+{
+    (void)memset(&dw_model, 0, sizeof(dw_model));
+    dw_model.now = 1000000000ULL;
+    dw_model.free_at = dw_model.now;
+    dw_model.irq_at = DW_MODEL_NO_IRQ;
+}
+
+dw_spi_t *dw_model_init(const char *options)
+{
+    (void)memset(&dw_model_funcs, 0, sizeof(dw_model_funcs));
+    (void)memset(&dw_model_spi_bus, 0, sizeof(dw_model_spi_bus));
+    (void)memset(&dw_model_spi_dev, 0, sizeof(dw_model_spi_dev));
+
+    dw_model_spi_dev.bus = &dw_model_spi_bus;
+    dw_model_spi_dev.devinfo.devno = 0;
+    (void)strlcpy(dw_model_spi_dev.devinfo.name, "dev0", sizeof(dw_model_spi_dev.devinfo.name));
+    dw_model_spi_dev.devinfo.cfg.mode = SPI_MODE_WORD_WIDTH_8;
+    dw_model_spi_dev.devinfo.cfg.clock_rate = 10000000U;
+
+    dw_model_spi_bus.spi_ctrl  = &dw_model_ctrl;
+    dw_model_spi_bus.funcs     = &dw_model_funcs;
+    dw_model_spi_bus.devlist   = &dw_model_spi_dev;
+    dw_model_spi_bus.pbase     = SPI0_DEF_BASE;
+    dw_model_spi_bus.irq       = 0x80;
+    dw_model_spi_bus.sem       = &dw_model_sem;
+    dw_model_spi_bus.input_clk = DW_MODEL_INPUT_CLK;
+    if (options != NULL) {
+        (void)strlcpy(dw_model_opts, options, sizeof(dw_model_opts));
+        dw_model_spi_bus.bs = dw_model_opts;
+    }
+
+    if (spi_init(&dw_model_spi_bus) != EOK) {
+        return NULL;
+    }
+    return dw_model_spi_bus.drvhdl;
+}
+
+void dw_model_fini(void)
+{
+    if (dw_model_spi_bus.drvhdl != NULL) {
+        dw_model_funcs.spi_fini(dw_model_spi_bus.drvhdl);
+        dw_model_spi_bus.drvhdl = NULL;
+    }
+}
+
+spi_dev_t *dw_model_dev(void)
+{
+    return &dw_model_spi_dev;
+}
+
+spi_bus_t *dw_model_bus(void)
+{
+    return &dw_model_spi_bus;
+}
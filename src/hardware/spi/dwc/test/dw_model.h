@@ -0,0 +1,149 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef DW_MODEL_H_INCLUDED
+#define DW_MODEL_H_INCLUDED
+
+#include <dwc_variant.h>
+
+/*
+ * Host model of the DesignWare SSI master, the slave on its chip select
+ * and the DMA channels serving its FIFOs. The driver sources are built with
+ * DW_SPI_REG_MODEL and every register access lands here.
+ *
+ * Time is virtual: it advances by DW_MODEL_REG_NS per register access and
+ * ClockCycles() call, and jumps to the next event while the driver waits
+ * for its interrupt. Words shift one at a time, each word_ns long, while
+ * the controller is enabled and a chip select is set. Raw interrupts follow
+ * the FIFO levels and thresholds; TXOI, RXOI and RXUI latch until cleared
+ * by the read-to-clear registers.
+ *
+ * The slave records every word on MOSI and answers with dw_model_miso() of
+ * the word number. Without chip select override its chip select is asserted
+ * while words shift and released when the shifter runs dry; with SSTE set
+ * it is pulsed between words.
+ */
+
+#define DW_MODEL_FIFO_DEPTH     16U
+#define DW_MODEL_REG_NS         10U
+#define DW_MODEL_LOG_MAX        8192U
+#define DW_MODEL_VERSION        0x3430312aU
+#define DW_MODEL_INPUT_CLK      200000000U
+#define DW_MODEL_DMA_LIB        "./libdma-model.so"
+
+typedef struct {
+    bool                attached;
+    bool                event;                  /* completion signals the bus event */
+    bool                active;
+    bool                to_device;
+    dma_addr_t          mem;
+    uint32_t            unit;                   /* bytes per element */
+    uint32_t            bytes;
+    uint32_t            pos;
+} dw_model_chan_t;
+
+typedef struct {
+    /* Set by the tests between dw_model_reset() and dw_model_init() */
+    uint64_t            word_ns;                /* wire time of a word, 0 for an infinitely fast bus */
+    uint64_t            irq_latency_ns;         /* raw interrupt to the driver handling it */
+    bool                cs_override_impl;       /* DW_SPI_CS_OVERRIDE is implemented */
+
+    /* Registers */
+    uint32_t            ctrlr0;
+    uint32_t            ctrlr1;
+    uint32_t            ssienr;
+    uint32_t            ser;
+    uint32_t            baudr;
+    uint32_t            txftlr;
+    uint32_t            rxftlr;
+    uint32_t            imr;
+    uint32_t            latched;                /* TXOI, RXOI and RXUI */
+    uint32_t            dmacr;
+    uint32_t            dmatdlr;
+    uint32_t            dmardlr;
+    uint32_t            cs_override;
+
+    /* FIFOs and shifter */
+    uint32_t            tx[DW_MODEL_FIFO_DEPTH];
+    uint32_t            txh, txn;
+    uint32_t            rx[DW_MODEL_FIFO_DEPTH];
+    uint32_t            rxh, rxn;
+    uint32_t            ro_left;                /* words left of a receive only exchange */
+    bool                shifting;
+    uint32_t            word;
+    uint64_t            word_done;
+    uint64_t            free_at;
+
+    /* Interrupt and time */
+    uint64_t            now;
+    bool                irq_masked;
+    uint64_t            irq_at;
+    bool                dma_done;
+
+    /* Slave */
+    bool                cs;
+    uint32_t            cs_asserts;
+    uint32_t            mosi[DW_MODEL_LOG_MAX];
+    uint32_t            nmosi;
+    uint32_t            nmiso;
+
+    /* Statistics */
+    uint32_t            irqs;
+    uint32_t            rx_overflows;
+    uint32_t            gaps;                   /* shifter ran dry while enabled */
+    uint64_t            gap_ns;
+    uint64_t            last_done;              /* last word of the enabled period, 0 before it */
+
+    dw_model_chan_t     chan[2];
+} dw_model_t;
+
+extern dw_model_t dw_model;
+
+void        dw_model_reset(void);
+dw_spi_t   *dw_model_init(const char *options);
+void        dw_model_fini(void);
+spi_dev_t  *dw_model_dev(void);
+spi_bus_t  *dw_model_bus(void);
+uint32_t    dw_model_miso(uint32_t n);
+int         dw_model_get_dmafuncs(dma_functions_t *functable, int tabsize);
+
+#endif /* DW_MODEL_H_INCLUDED */
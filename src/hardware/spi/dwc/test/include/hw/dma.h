@@ -0,0 +1,94 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef TEST_HW_DMA_H_INCLUDED
+#define TEST_HW_DMA_H_INCLUDED
+
+#include <sys/platform.h>
+#include <sys/types.h>
+#include <signal.h>
+
+typedef enum {
+    DMA_ATTACH_ANY_CHANNEL          = 0x00000001,
+    DMA_ATTACH_EVENT_ON_COMPLETE    = 0x00000010,
+} dma_attach_flags;
+
+typedef enum {
+    DMA_ADDR_FLAG_NO_INCREMENT      = 0x00000001,
+    DMA_ADDR_FLAG_DEVICE            = 0x00000002,
+} dma_xfer_flags;
+
+#define DMA_BUF_FLAG_NOCACHE        0x00000001
+
+typedef struct {
+    void            *vaddr;
+    uint64_t        paddr;                  /* off64_t on QNX */
+    unsigned        len;
+} dma_addr_t;
+
+typedef struct {
+    dma_addr_t      *src_addrs;
+    unsigned        src_fragments;
+    dma_xfer_flags  src_flags;
+    dma_addr_t      *dst_addrs;
+    unsigned        dst_fragments;
+    dma_xfer_flags  dst_flags;
+    unsigned        xfer_unit_size;
+    unsigned        xfer_bytes;
+} dma_transfer_t;
+
+typedef struct {
+    int         (*init)(const char *options);
+    void        (*fini)(void);
+    void        *(*channel_attach)(const char *options, const struct sigevent *event, unsigned *channel,
+                                   int priority, dma_attach_flags flags);
+    void        (*channel_release)(void *handle);
+    int         (*alloc_buffer)(void *handle, dma_addr_t *addr, unsigned size, unsigned flags);
+    void        (*free_buffer)(void *handle, dma_addr_t *addr);
+    int         (*setup_xfer)(void *handle, const dma_transfer_t *tinfo);
+    int         (*xfer_start)(void *handle);
+    int         (*xfer_abort)(void *handle);
+    int         (*xfer_complete)(void *handle);
+    unsigned    (*bytes_left)(void *handle);
+} dma_functions_t;
+
+#endif /* TEST_HW_DMA_H_INCLUDED */
@@ -0,0 +1,134 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef TEST_HW_IO_SPI_H_INCLUDED
+#define TEST_HW_IO_SPI_H_INCLUDED
+
+#include <sys/platform.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <hw/dma.h>
+
+#define SPI_VERSION_MAJOR           1
+#define SPI_VERSION_MINOR           0
+#define SPI_REVISION                0
+#define SPI_VERMAJOR_SHIFT          16
+#define SPI_VERMINOR_SHIFT          8
+#define SPI_VERREV_SHIFT            0
+
+#define SPI_DRVR_NAME_LEN           24
+#define SPI_DEV_NAME_LEN            16
+
+#define SPI_MODE_WORD_WIDTH_MASK    0xff
+#define SPI_MODE_WORD_WIDTH_8       8
+#define SPI_MODE_WORD_WIDTH_16      16
+#define SPI_MODE_WORD_WIDTH_32      32
+#define SPI_MODE_CPOL_1             0x00000100
+#define SPI_MODE_CPHA_1             0x00000200
+
+typedef struct {
+    uint32_t        mode;
+    uint32_t        clock_rate;
+} spi_cfg_t;
+
+typedef struct {
+    uint32_t        version;
+    char            name[SPI_DRVR_NAME_LEN];
+    uint32_t        feature;
+    uint32_t        verbosity;
+} spi_drvinfo_t;
+
+typedef struct {
+    int             devno;
+    char            name[SPI_DEV_NAME_LEN];
+    spi_cfg_t       cfg;
+    uint32_t        current_clkrate;
+} spi_devinfo_t;
+
+typedef struct spi_bus spi_bus_t;
+typedef struct spi_dev spi_dev_t;
+
+struct spi_dev {
+    spi_dev_t       *next;
+    spi_bus_t       *bus;
+    spi_devinfo_t   devinfo;
+};
+
+typedef struct {
+    struct {
+        uint32_t    verbosity;
+    } global;
+} spi_ctrl_t;
+
+typedef struct {
+    void    (*spi_fini)(void *const hdl);
+    void    (*drvinfo)(const void *const hdl, spi_drvinfo_t *info);
+    void    (*devinfo)(const void *const hdl, const spi_dev_t *const spi_dev, spi_devinfo_t *const info);
+    int     (*setcfg)(const void *const hdl, spi_dev_t *spi_dev, const spi_cfg_t *const cfg);
+    int     (*xfer)(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes,
+                    const uint32_t rnbytes);
+    int     (*dma_xfer)(void *const hdl, spi_dev_t *spi_dev, dma_addr_t *addr, const uint32_t tnbytes,
+                        const uint32_t rnbytes);
+    int     (*dma_allocbuf)(void *const hdl, dma_addr_t *addr, const uint32_t len);
+    int     (*dma_freebuf)(void *const hdl, dma_addr_t *addr);
+    int     (*ctl)(void *const hdl, spi_dev_t *const spi_dev, const int cmd, void *const msg, const int msglen,
+                   int *const nbytes, int *const info);
+} spi_funcs_t;
+
+struct spi_bus {
+    spi_ctrl_t      *spi_ctrl;
+    spi_funcs_t     *funcs;
+    spi_dev_t       *devlist;
+    void            *drvhdl;
+    char            *bs;
+    uint64_t        pbase;
+    int             irq;
+    struct sigevent evt;
+    sem_t           *sem;
+    uint64_t        input_clk;
+    uint8_t         dma_thld;
+};
+
+int spi_create_devs(spi_dev_t *head);
+void spi_slogf(const int level, const char *const fmt, ...);
+
+#endif /* TEST_HW_IO_SPI_H_INCLUDED */
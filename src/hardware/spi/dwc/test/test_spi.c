@@ -0,0 +1,603 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+/*
+ * Regression tests and benchmark of the exchange paths (xfer.c, intr.c,
+ * dma.c, seq.c) against the register model.
+ *
+ *   test_spi               run the tests
+ *   test_spi -b [-n N] [-w word_ns] [-l latency_ns]
+ *                          run N exchanges of each size, interrupt driven
+ *                          and through DMA, with the wire time of a word
+ *                          (160 ns, 8 bits at 50 MHz) and the interrupt
+ *                          latency; report the model time and the gaps in
+ *                          the clock where the transmit FIFO ran dry
+ */
+
+#include <unistd.h>
+#include "dw_model.h"
+
+static uint32_t failures;
+
+#define CHECK(__cond) \
+    do { \
+        if (!(__cond)) { \
+            (void)fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #__cond); \
+            failures++; \
+        } \
+    } while (0)
+
+#define DW_TEST_DMA_OPTS    "dma_rx_chan=0,dma_tx_chan=1,dma_lib=" DW_MODEL_DMA_LIB
+
+static int xfer(dw_spi_t *spi, uint8_t *buf, const uint32_t tnbytes, const uint32_t rnbytes)
+{
+    return dw_model_bus()->funcs->xfer(spi, dw_model_dev(), buf, tnbytes, rnbytes);
+}
+
+static void fill(uint8_t *buf, const uint32_t len, const uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        buf[i] = (uint8_t)((i * 13U) + seed);
+    }
+}
+
+/* The bytes on MOSI from word first on */
+static bool mosi_is(const uint32_t first, const uint8_t *buf, const uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        if (dw_model.mosi[first + i] != buf[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool mosi_zero(const uint32_t first, const uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        if (dw_model.mosi[first + i] != 0U) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* The bytes answered by the slave from word first on */
+static bool miso_is(const uint32_t first, const uint8_t *buf, const uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        if (buf[i] != (uint8_t)dw_model_miso(first + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Exchanges longer than the FIFO are refilled and drained on the thresholds */
+static void test_exchange(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     tx[64], buf[64];
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init(NULL);
+    CHECK(spi != NULL);
+    if (spi == NULL) {
+        return;
+    }
+    CHECK(spi->fifo_len == DW_MODEL_FIFO_DEPTH);
+
+    fill(tx, sizeof(tx), 1);
+    (void)memcpy(buf, tx, sizeof(buf));
+    CHECK(xfer(spi, buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(dw_model.nmosi == sizeof(tx));
+    CHECK(mosi_is(0, tx, sizeof(tx)));
+    CHECK(miso_is(0, buf, sizeof(buf)));
+    CHECK(dw_model.irqs > 0U);
+    CHECK(dw_model.rx_overflows == 0U);
+    CHECK(dw_model.ssienr == 0U);
+
+    dw_model_fini();
+}
+
+static void test_tx_only(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     tx[100], buf[100];
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init(NULL);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    fill(tx, sizeof(tx), 2);
+    (void)memcpy(buf, tx, sizeof(buf));
+    CHECK(xfer(spi, buf, sizeof(buf), 0) == EOK);
+    CHECK(spi->tmod == DW_SPI_CTRLR0_TMOD_TO);
+    CHECK(dw_model.nmosi == sizeof(tx));
+    CHECK(mosi_is(0, tx, sizeof(tx)));
+    CHECK(memcmp(buf, tx, sizeof(buf)) == 0);
+
+    dw_model_fini();
+}
+
+/* A read longer than a polled exchange stays transmit and receive, paced by the driver */
+static void test_rx_only(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     buf[100];
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init(NULL);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    (void)memset(buf, 0xee, sizeof(buf));
+    CHECK(xfer(spi, buf, 0, sizeof(buf)) == EOK);
+    CHECK(spi->tmod == DW_SPI_CTRLR0_TMOD_TR);
+    CHECK(dw_model.nmosi == sizeof(buf));
+    CHECK(mosi_zero(0, sizeof(buf)));
+    CHECK(dw_model.nmiso == sizeof(buf));
+    CHECK(miso_is(0, buf, sizeof(buf)));
+
+    dw_model_fini();
+}
+
+static void test_word16(void)
+{
+    dw_spi_t    *spi;
+    spi_cfg_t   cfg;
+    uint16_t    tx[24], buf[24];
+    uint32_t    i;
+
+    dw_model_reset();
+    spi = dw_model_init(NULL);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    cfg = dw_model_dev()->devinfo.cfg;
+    cfg.mode = (cfg.mode & ~SPI_MODE_WORD_WIDTH_MASK) | SPI_MODE_WORD_WIDTH_16;
+    CHECK(dw_model_bus()->funcs->setcfg(spi, dw_model_dev(), &cfg) == EOK);
+
+    for (i = 0; i < 24U; i++) {
+        tx[i] = (uint16_t)(0x8001U + (i * 0x0203U));
+    }
+    (void)memcpy(buf, tx, sizeof(buf));
+    CHECK(xfer(spi, (uint8_t *)buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(dw_model.nmosi == 24U);
+    for (i = 0; i < 24U; i++) {
+        CHECK(dw_model.mosi[i] == tx[i]);
+        CHECK(buf[i] == (uint16_t)dw_model_miso(i));
+    }
+
+    dw_model_fini();
+}
+
+/* Short exchanges are prefilled and polled, without interrupts; reads are receive only */
+static void test_polled(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     tx[12], buf[12];
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init("poll_thld=16");
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    fill(tx, sizeof(tx), 3);
+    (void)memcpy(buf, tx, sizeof(buf));
+    CHECK(xfer(spi, buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(mosi_is(0, tx, sizeof(tx)));
+    CHECK(miso_is(0, buf, sizeof(buf)));
+
+    CHECK(xfer(spi, buf, 0, sizeof(buf)) == EOK);
+    CHECK(spi->tmod == DW_SPI_CTRLR0_TMOD_RO);
+    CHECK(dw_model.nmosi == sizeof(tx));
+    CHECK(miso_is(sizeof(tx), buf, sizeof(buf)));
+    CHECK(dw_model.irqs == 0U);
+
+    dw_model_fini();
+}
+
+/*
+ * A fast read served by slow interrupts waits for the driver instead of
+ * overflowing the receive FIFO, as it would in receive only mode.
+ */
+static void test_rx_slow_irq(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     buf[200];
+
+    dw_model_reset();
+    dw_model.word_ns = 100;
+    dw_model.irq_latency_ns = 5000;
+    spi = dw_model_init(NULL);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    CHECK(xfer(spi, buf, 0, sizeof(buf)) == EOK);
+    CHECK(spi->tmod == DW_SPI_CTRLR0_TMOD_TR);
+    CHECK(dw_model.rx_overflows == 0U);
+    CHECK(miso_is(0, buf, sizeof(buf)));
+    CHECK(dw_model.latched == 0U);
+    CHECK(dw_model.ssienr == 0U);
+
+    dw_model_fini();
+}
+
+/*
+ * Words past the transmit data of an exchange that receives more than it
+ * transmits are zeros, whatever the buffer held before.
+ */
+static void test_tx_tail(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     tx[4], buf[64];
+
+    dw_model_reset();
+    spi = dw_model_init(NULL);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    fill(tx, sizeof(tx), 4);
+    (void)memset(buf, 0xee, sizeof(buf));
+    (void)memcpy(buf, tx, sizeof(tx));
+    CHECK(xfer(spi, buf, sizeof(tx), sizeof(buf)) == EOK);
+    CHECK(dw_model.nmosi == sizeof(buf));
+    CHECK(mosi_is(0, tx, sizeof(tx)));
+    CHECK(mosi_zero(sizeof(tx), sizeof(buf) - sizeof(tx)));
+    CHECK(miso_is(0, buf, sizeof(buf)));
+
+    dw_model_fini();
+}
+
+static void test_dma(void)
+{
+    dw_spi_t    *spi;
+    uint8_t     tx[256], buf[256];
+    dma_addr_t  addr;
+    uint32_t    n;
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init(DW_TEST_DMA_OPTS);
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+    CHECK(dw_model_bus()->funcs->dma_xfer != NULL);
+
+    fill(tx, sizeof(tx), 5);
+    (void)memcpy(buf, tx, sizeof(buf));
+    CHECK(xfer(spi, buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(dw_model.nmosi == sizeof(tx));
+    CHECK(mosi_is(0, tx, sizeof(tx)));
+    CHECK(miso_is(0, buf, sizeof(buf)));
+    CHECK(dw_model.irqs == 0U);
+    CHECK(dw_model.rx_overflows == 0U);
+
+    /* The bounce buffer still holds the previous exchange, none of it goes out */
+    n = dw_model.nmosi;
+    (void)memset(buf, 0xee, sizeof(buf));
+    (void)memcpy(buf, tx, 4);
+    CHECK(xfer(spi, buf, 4, 200) == EOK);
+    CHECK(dw_model.nmosi == (n + 200U));
+    CHECK(mosi_is(n, tx, 4));
+    CHECK(mosi_zero(n + 4U, 196));
+    CHECK(miso_is(n, buf, 200));
+
+    /* Client buffer */
+    CHECK(dw_model_bus()->funcs->dma_allocbuf(spi, &addr, 128) == EOK);
+    if (addr.vaddr != NULL) {
+        n = dw_model.nmosi;
+        (void)memcpy(addr.vaddr, tx, 128);
+        CHECK(dw_model_bus()->funcs->dma_xfer(spi, dw_model_dev(), &addr, 128, 128) == EOK);
+        CHECK(mosi_is(n, tx, 128));
+        CHECK(miso_is(n, addr.vaddr, 128));
+        CHECK(dw_model_bus()->funcs->dma_freebuf(spi, &addr) == EOK);
+    }
+    CHECK(dw_model.irqs == 0U);
+
+    dw_model_fini();
+}
+
+typedef struct {
+    spi_dwc_seq_t   hdr;
+    spi_dwc_seg_t   seg[4];
+    uint8_t         data[64];
+} seq_msg_t;
+
+static int seq(dw_spi_t *spi, seq_msg_t *msg, const uint32_t nsegs)
+{
+    int             nbytes = 0;
+    uint32_t        i, len = 0;
+
+    msg->hdr.nsegs = nsegs;
+    for (i = 0; i < nsegs; i++) {
+        len += msg->seg[i].len;
+    }
+    /* Segment headers and data are contiguous */
+    (void)memmove(&msg->seg[nsegs], msg->data, len);
+    CHECK(dw_model_bus()->funcs->ctl(spi, dw_model_dev(), DCMD_SPI_DWC_SEQ, msg,
+                                     (int)(sizeof(msg->hdr) + (nsegs * sizeof(msg->seg[0])) + len),
+                                     &nbytes, NULL) == EOK);
+    (void)memmove(msg->data, &msg->seg[nsegs], len);
+    return (int)msg->hdr.status;
+}
+
+static void seg(seq_msg_t *msg, const uint32_t i, const uint32_t flags, const uint32_t len,
+        const uint32_t word_width, const uint32_t delay_us)
+{
+    (void)memset(&msg->seg[i], 0, sizeof(msg->seg[i]));
+    msg->seg[i].flags      = flags;
+    msg->seg[i].len        = len;
+    msg->seg[i].word_width = word_width;
+    msg->seg[i].delay_us   = delay_us;
+}
+
+/* Without chip select override a sequence is one exchange, SSTE must not pulse the chip select in it */
+static void test_seq_merged(void)
+{
+    dw_spi_t    *spi;
+    seq_msg_t   msg;
+    uint8_t     buf[8];
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    spi = dw_model_init("sste");
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+
+    /* SSTE pulses the chip select between the words of plain exchanges */
+    fill(buf, sizeof(buf), 6);
+    CHECK(xfer(spi, buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(dw_model.cs_asserts == sizeof(buf));
+
+    dw_model.cs_asserts = 0;
+    dw_model.nmosi = 0;
+    dw_model.nmiso = 0;
+    seg(&msg, 0, SPI_DWC_SEG_TX, 2, 0, 0);
+    seg(&msg, 1, SPI_DWC_SEG_RX, 6, 0, 0);
+    fill(msg.data, 8, 7);
+    CHECK(seq(spi, &msg, 2) == EOK);
+    CHECK(msg.seg[0].status == EOK);
+    CHECK(msg.seg[1].status == EOK);
+    CHECK(dw_model.cs_asserts == 1U);
+    CHECK(dw_model.nmosi == 8U);
+    CHECK(miso_is(2, &msg.data[2], 6));
+    CHECK(!spi->in_seq);
+
+    /* Plain exchanges toggle again */
+    dw_model.cs_asserts = 0;
+    CHECK(xfer(spi, buf, sizeof(buf), sizeof(buf)) == EOK);
+    CHECK(dw_model.cs_asserts == sizeof(buf));
+
+    /* Delays need chip select override */
+    seg(&msg, 0, SPI_DWC_SEG_TX, 2, 0, 10);
+    seg(&msg, 1, SPI_DWC_SEG_RX, 6, 0, 0);
+    CHECK(seq(spi, &msg, 2) == ENOTSUP);
+
+    dw_model_fini();
+}
+
+/* With chip select override the segments are separate exchanges under one chip select */
+static void test_seq_override(void)
+{
+    dw_spi_t    *spi;
+    seq_msg_t   msg;
+    uint64_t    start;
+
+    dw_model_reset();
+    dw_model.word_ns = 800;
+    dw_model.cs_override_impl = true;
+    spi = dw_model_init("cs_override,sste");
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+    CHECK(spi->cs_override);
+    CHECK(dw_model.cs_override == DW_SPI_CS_OVERRIDE_ALL);
+
+    seg(&msg, 0, SPI_DWC_SEG_TX, 1, 0, 50);
+    seg(&msg, 1, SPI_DWC_SEG_TX, 4, 16, 0);
+    seg(&msg, 2, SPI_DWC_SEG_RX, 8, 0, 0);
+    fill(msg.data, 13, 8);
+    msg.data[1] = 0x34;
+    msg.data[2] = 0x12;
+    start = dw_model.now;
+    CHECK(seq(spi, &msg, 3) == EOK);
+    CHECK((dw_model.now - start) >= 50000U);
+    CHECK(dw_model.cs_asserts == 1U);
+    CHECK(!dw_model.cs);
+    CHECK(dw_model.nmosi == 11U);
+    CHECK(dw_model.mosi[1] == 0x1234U);
+    CHECK(mosi_zero(3, 8));
+    CHECK(miso_is(3, &msg.data[5], 8));
+
+    dw_model_fini();
+}
+
+/* The option is dropped on a controller without the override register */
+static void test_cs_override_probe(void)
+{
+    dw_spi_t    *spi;
+    seq_msg_t   msg;
+
+    dw_model_reset();
+    spi = dw_model_init("cs_override");
+    if (spi == NULL) {
+        CHECK(spi != NULL);
+        return;
+    }
+    CHECK(!spi->cs_override);
+
+    seg(&msg, 0, SPI_DWC_SEG_TX, 2, 0, 10);
+    seg(&msg, 1, SPI_DWC_SEG_RX, 2, 0, 0);
+    CHECK(seq(spi, &msg, 2) == ENOTSUP);
+
+    dw_model_fini();
+}
+
+static int run_tests(void)
+{
+    test_exchange();
+    test_tx_only();
+    test_rx_only();
+    test_rx_slow_irq();
+    test_word16();
+    test_polled();
+    test_tx_tail();
+    test_dma();
+    test_seq_merged();
+    test_seq_override();
+    test_cs_override_probe();
+
+    if (failures != 0U) {
+        (void)printf("FAILED: %u checks\n", failures);
+        return 1;
+    }
+
+    (void)printf("all tests passed\n");
+    return 0;
+}
+
+static int run_bench(const uint32_t iterations, const uint64_t word_ns, const uint64_t latency_ns)
+{
+    static const uint32_t   sizes[] = { 16, 64, 256, 1024, 4096 };
+    static uint8_t          buf[4096];
+    dw_spi_t                *spi;
+    uint64_t                start;
+    uint32_t                i, n, dma;
+
+    (void)printf("%-6s %-9s %12s %12s %10s %12s\n", "bytes", "mode", "mean_ns", "wire_ns", "gaps", "gap_ns");
+
+    for (i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (dma = 0; dma < 2U; dma++) {
+            dw_model_reset();
+            dw_model.word_ns = word_ns;
+            dw_model.irq_latency_ns = latency_ns;
+            spi = dw_model_init((dma != 0U) ? DW_TEST_DMA_OPTS : NULL);
+            if (spi == NULL) {
+                (void)printf("driver init failed\n");
+                return 1;
+            }
+
+            start = dw_model.now;
+            for (n = 0; n < iterations; n++) {
+                if (xfer(spi, buf, sizes[i], sizes[i]) != EOK) {
+                    (void)printf("exchange failed\n");
+                    dw_model_fini();
+                    return 1;
+                }
+            }
+
+            (void)printf("%-6u %-9s %12llu %12llu %10.2f %12llu\n", sizes[i],
+                         (dma != 0U) ? "dma" : "interrupt",
+                         (unsigned long long)((dw_model.now - start) / iterations),
+                         (unsigned long long)(sizes[i] * word_ns),
+                         (double)dw_model.gaps / iterations,
+                         (unsigned long long)(dw_model.gap_ns / iterations));
+            dw_model_fini();
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    iterations = 100, bench = 0;
+    uint64_t    word_ns = 160, latency_ns = 2000;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "bn:w:l:")) != -1) {
+        switch (opt) {
+            case 'b':
+                bench = 1;
+                break;
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                word_ns = strtoull(optarg, NULL, 0);
+                break;
+            case 'l':
+                latency_ns = strtoull(optarg, NULL, 0);
+                break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-b [-n iterations] [-w word_ns] [-l latency_ns]]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (bench != 0U) {
+        return run_bench(max(iterations, 1U), word_ns, latency_ns);
+    }
+
+    return run_tests();
+}
@@ -75,34 +75,51 @@ int32_t dw_spi_select_slave(const dw_spi_t *const spi, const int slv)
     return 0;
 }
 
+/**
+ *  @brief             Whether an exchange is prefilled and polled.
+ *  @param spi         SPI driver handler, word size already set.
+ *  @param nbytes      The number of bytes exchanged.
+ *
+ *  @return            true if the whole exchange fits the FIFO and is short enough to poll.
+ */
+static bool dw_polled(const dw_spi_t *const spi, const uint32_t nbytes)
+{
+    return (nbytes <= spi->poll_thld) && ((nbytes >> spi->dscale) <= spi->fifo_len);
+}
+
 /**
  *  @brief             Prepare for SPI exchange.
  *  @param spi         SPI driver handler.
- *  @param cfg         The SPI config structure.
+ *  @param spi_dev     SPI device structure pointer.
  *  @param tnbytes     The number of transmit bytes.
  *  @param rnbytes     The number of receive bytes.
  *
  *  @return            EOK --success otherwise fail.
+ *
+ *  Uses the register image built by dw_cfg(); the controller registers are
+ *  only written when the image differs from the one last programmed.
  */
-int dw_prepare_for_transfer(dw_spi_t *spi, const spi_cfg_t *const cfg, const uint32_t tnbytes, const uint32_t rnbytes)
+int dw_prepare_for_transfer(dw_spi_t *spi, spi_dev_t *const spi_dev, const uint32_t tnbytes, const uint32_t rnbytes)
 {
-    static const uint32_t dscales[] = {0, 0, 1, 2, 2};
+    const spi_cfg_t *const  cfg = &spi_dev->devinfo.cfg;
+    const dw_devcfg_t      *dc = &spi->devcfg[spi_dev->devinfo.devno];
+    int                     status;
+
+    /* Configuration changed without dw_setcfg() */
+    if ((dc->mode != cfg->mode) || (dc->clock_rate != cfg->clock_rate)) {
+        status = dw_cfg(spi, spi_dev);
+        if (status != EOK) {
+            return status;
+        }
+    }
 
     /* Data bits per word */
-    const uint32_t nbits = cfg->mode & SPI_MODE_WORD_WIDTH_MASK;
-    if ((nbits <= SPI_MIN_WORD_WIDTH) || (nbits > SPI_MAX_WORD_WIDTH)) {
+    if ((dc->nbits <= SPI_MIN_WORD_WIDTH) || (dc->nbits > SPI_MAX_WORD_WIDTH)) {
         return EINVAL;
     }
 
-    /* Spi must be disablled to change configuration */
-    dw_spi_enable(spi, DW_SPI_DISABLE);
-
-    /* Data bytes per word */
-    spi->dlen = (nbits + DW_NBIT_ROUNDER) / 8;
-    spi->dscale = dscales[spi->dlen];
-    if (spi->dlen == 3) {
-        spi->dlen = 4;
-    }
+    spi->dlen   = dc->dlen;
+    spi->dscale = dc->dscale;
 
     /* Transation data length - word */
     const uint32_t nbytes = max(tnbytes, rnbytes);
@@ -111,45 +128,39 @@ int dw_prepare_for_transfer(dw_spi_t *spi, const spi_cfg_t *const cfg, const uin
         return EINVAL;
     }
 
-    /* Check clock rate */
-    if (cfg->clock_rate == 0) {
-        spi_slogf(_SLOG_ERROR, "%s: invalid clock rate %u", __func__, cfg->clock_rate);
-        return EINVAL;
-    }
-
-    spi->cr0 = (DW_SPI_CTRLR0_FRF_MOTO_SPI << DW_SPI_CTRLR0_FRF_OFFSET) | (DW_SPI_CTRLR0_TMOD_TR << DW_SPI_CTRLR0_TMOD_OFFSET);
-
-    /* set nbits value */
-    spi->cr0 |= DW_PSSI_CTRLR0_DFS_CONFIG(spi->dlen);
-
-    /* Update cr0 value */
-    if ((cfg->mode & SPI_MODE_CPOL_1) != 0) {
-        spi->cr0 |= DW_SPI_CTRLR0_SCPOL;    /* Clock Polarity */
-    }
-
-    if ((cfg->mode & SPI_MODE_CPHA_1) != 0) {
-        spi->cr0 |= DW_SPI_CTRLR0_SCPHA;    /* Clock Phase */
-    }
-
-    if (spi->loopback) {
-        spi->cr0 |= DW_PSSI_CTRLR0_SRL;    /* Loop-Back Mode */
+    /*
+     * One-directional exchanges do not move data the client does not want.
+     * In receive only mode the controller keeps clocking whether or not the
+     * receive FIFO is drained, so it is only used for exchanges that fit the
+     * FIFO and are polled; longer reads are paced by the transmit words.
+     */
+    spi->cr1 = 0;
+    if (rnbytes == 0) {
+        spi->tmod = DW_SPI_CTRLR0_TMOD_TO;
+    } else if ((tnbytes == 0) && dw_polled(spi, nbytes)) {
+        spi->tmod = DW_SPI_CTRLR0_TMOD_RO;
+        spi->cr1  = spi->xlen - 1U;         /* Number of data frames */
+    } else {
+        spi->tmod = DW_SPI_CTRLR0_TMOD_TR;
     }
-
-    if (spi->sste) {
-        spi->cr0 |= DW_SPI_SSTE;            /* Slave select Toggle Enable */
+    spi->cr0 = (dc->cr0 & ~DW_SPI_CTRLR0_TMOD_MASK) | (spi->tmod << DW_SPI_CTRLR0_TMOD_OFFSET);
+    if (spi->in_seq) {
+        spi->cr0 &= ~DW_SPI_SSTE;   /* No chip select pulse between the words of a sequence */
     }
 
-    const uint32_t version = dw_read32(spi, DW_SPI_VERSION);
-    if (version >= DW_HSSI_102A) {
-        spi->cr0 |= (1 << DW_SPI_CTRLR0_IS_MST_OFFSET); /* enable as master */
+    /* Spi must be disabled to change configuration, it is left disabled after every exchange */
+    if ((spi->cr0 != spi->hw_cr0) || (spi->cr1 != spi->hw_cr1) || (dc->baudr != spi->hw_baudr)) {
+        dw_spi_enable(spi, DW_SPI_DISABLE);
+        dw_write32(spi, DW_SPI_BAUDR, dc->baudr);
+        dw_write32(spi, DW_SPI_CTRLR0, spi->cr0);
+        dw_write32(spi, DW_SPI_CTRLR1, spi->cr1);
+        spi->hw_cr0   = spi->cr0;
+        spi->hw_cr1   = spi->cr1;
+        spi->hw_baudr = dc->baudr;
     }
 
-    dw_write32(spi, DW_SPI_BAUDR, (uint32_t)(spi->bus->input_clk / cfg->clock_rate));
-    dw_write32(spi, DW_SPI_CTRLR0, spi->cr0);
-    dw_write32(spi, DW_SPI_CTRLR1, 0);
-
     /* Calculate the transaction time, minimal 1 us */
-    spi->xtime_us = max(1, (uint64_t)nbits * 1000 * 1000 * spi->xlen / cfg->clock_rate);
+    spi->xtime_us = max(1, (uint64_t)dc->nbits * 1000 * 1000 * spi->xlen / dc->clock_rate);
 
     /* Reset RX and TX length */
     spi->rlen = 0;
@@ -159,19 +170,52 @@ int dw_prepare_for_transfer(dw_spi_t *spi, const spi_cfg_t *const cfg, const uin
 }
 
 /**
- *  @brief             SPI transfer function.
- *  @param hdl         SPI driver handler.
+ *  @brief             Prefill the FIFO of a transmit and receive exchange.
+ *  @param spi         SPI driver handler.
+ *
+ *  @return            Void.
+ */
+static void dw_prefill(dw_spi_t *const spi)
+{
+    /* Prefill transmit FIFO */
+    spi_slogf(_SLOG_DEBUG1, "%s: Starting prefill transmit FIFO", __func__);
+
+    const uint32_t len = min(spi->xlen, spi->fifo_len);
+    dw_write_fifo(spi, len);
+    spi->tlen += len;
+    const uint32_t thresh = min(spi->xlen, spi->fifo_len / SPI_FIFO_LEN_DIV);
+
+    if (spi->tlen < spi->xlen) {
+        dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_MASK);
+        /* When the number of receive FIFO entries is greater than
+           or equal to this value + 1, the receive FIFO full interrupt
+           is triggered.*/
+        dw_write32(spi, DW_SPI_RXFTLR, (thresh - 1U));
+        /* When the number of transmit FIFO entries is less than or
+           equal to this value, the transmit FIFO empty interrupt is
+           triggered. */
+        dw_write32(spi, DW_SPI_TXFTLR, thresh);
+    } else {
+        dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_RXUI
+                | DW_SPI_INT_RXOI | DW_SPI_INT_RXFI);
+        dw_write32(spi, DW_SPI_RXFTLR,  (thresh - 1U));
+    }
+}
+
+/**
+ *  @brief             SPI exchange.
+ *  @param spi         SPI driver handler.
  *  @param spi_dev     SPI device structure pointer.
  *  @param buf         The buffer which stores the transfer data.
  *  @param tnbytes     The number of transmit bytes.
  *  @param rnbytes     The number of receive bytes.
  *
  *  @return            EOK --success otherwise fail.
+ *
+ *  The chip select stays asserted after the exchange if it is driven by SER.
  */
-int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes, const uint32_t rnbytes)
+int dw_exchange(dw_spi_t *const spi, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes, const uint32_t rnbytes)
 {
-    dw_spi_t             *spi = hdl;
-    const spi_cfg_t *const  cfg = &spi_dev->devinfo.cfg;
     int                     status = EOK;
 
 #ifdef  DW_DMA
@@ -184,10 +228,31 @@ int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, cons
         return EBUSY;
     }
 
+    /*
+     * The exchange clocks out max(tnbytes, rnbytes) bytes, past the transmit
+     * data the buffer holds whatever it had before: send zeros instead.
+     */
+    const uint32_t nbytes = max(tnbytes, rnbytes);
+    if (tnbytes < nbytes) {
+        memset(buf + tnbytes, 0, nbytes - tnbytes);
+    }
+
+#ifdef  DW_DMA
+    /* Longer exchanges go through DMA, staged in the bounce buffer */
+    if ((spi->bus->funcs->dma_xfer != NULL) && (nbytes > spi->bus->dma_thld) && (nbytes <= spi->dma.buf.len)) {
+        memcpy(spi->dma.buf.vaddr, buf, nbytes);
+        status = dw_spi_dma_exchange(spi, spi_dev, &spi->dma.buf, tnbytes, rnbytes);
+        if (status == EOK) {
+            memcpy(buf, spi->dma.buf.vaddr, rnbytes);
+        }
+        return status;
+    }
+#endif
+
     spi->pbuf = buf;
 
     /* Configure SPI device */
-    status = dw_prepare_for_transfer(spi, cfg, tnbytes, rnbytes);
+    status = dw_prepare_for_transfer(spi, spi_dev, tnbytes, rnbytes);
     if (status != EOK) {
         spi_slogf(_SLOG_ERROR, "%s: dw_prepare_for_transfer failed", __func__);
         return status;
@@ -196,31 +261,37 @@ int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, cons
     /* Disable DMA transaction on SPI when non-DMA and DMA co-exits */
     dw_write32(spi, DW_SPI_DMACR, 0);
 
-    /* Enable FIFO Interrupts and SPI */
-    dw_device_reset(spi);
+    /* Short exchange, fits the FIFO: prefill it all and poll for completion */
+    if (dw_polled(spi, nbytes)) {
+        dw_write32(spi, DW_SPI_IMR, 0);
+        dw_device_reset(spi);
 
-    /* Prefill transmit FIFO */
-    spi_slogf(_SLOG_DEBUG1, "%s: Starting prefill transmit FIFO", __func__);
+        if (spi->tmod == DW_SPI_CTRLR0_TMOD_RO) {
+            dw_write32(spi, DW_SPI_DR, 0);  /* Dummy word starts the exchange */
+        } else {
+            dw_write_fifo(spi, spi->xlen);
+        }
+        spi->tlen = spi->xlen;
+        dw_spi_select_slave(spi, spi_dev->devinfo.devno);
 
-    const uint32_t len = min(spi->xlen, spi->fifo_len / SPI_FIFO_LEN_DIV);
-    dw_write_fifo(spi, len);
-    spi->tlen += len;
-    const uint32_t thresh = len;
+        status = dw_poll(spi);
+        dw_spi_enable(spi, DW_SPI_DISABLE);
 
-    if (spi->tlen < spi->xlen) {
-        dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_MASK);
-        /* When the number of receive FIFO entries is greater than
-           or equal to this value + 1, the receive FIFO full interrupt
-           is triggered.*/
-        dw_write32(spi, DW_SPI_RXFTLR, (thresh - 1U));
-        /* When the number of transmit FIFO entries is less than or
-           equal to this value, the transmit FIFO empty interrupt is
-           triggered. */
-        dw_write32(spi, DW_SPI_TXFTLR, thresh);
+        return status;
+    }
+
+    /* Enable FIFO Interrupts and SPI */
+    dw_device_reset(spi);
+
+    if (spi->tmod == DW_SPI_CTRLR0_TMOD_TO) {
+        /* Fill the FIFO, refill when half empty, and finish when it is empty */
+        const uint32_t len = min(spi->xlen, spi->fifo_len);
+        dw_write_fifo(spi, len);
+        spi->tlen = len;
+        dw_write32(spi, DW_SPI_TXFTLR, (spi->tlen < spi->xlen) ? (spi->fifo_len / SPI_FIFO_LEN_DIV) : 0);
+        dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_TXEI | DW_SPI_INT_TXOI);
     } else {
-        dw_write32(spi, DW_SPI_IMR, DW_SPI_INT_RXUI
-                | DW_SPI_INT_RXOI | DW_SPI_INT_RXFI);
-        dw_write32(spi, DW_SPI_RXFTLR,  (thresh - 1U));
+        dw_prefill(spi);
     }
 
     dw_spi_select_slave(spi, spi_dev->devinfo.devno);
@@ -236,3 +307,25 @@ int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, cons
 
     return status;
 }
+
+/**
+ *  @brief             SPI transfer function.
+ *  @param hdl         SPI driver handler.
+ *  @param spi_dev     SPI device structure pointer.
+ *  @param buf         The buffer which stores the transfer data.
+ *  @param tnbytes     The number of transmit bytes.
+ *  @param rnbytes     The number of receive bytes.
+ *
+ *  @return            EOK --success otherwise fail.
+ */
+int  dw_xfer(void *const hdl, spi_dev_t *const spi_dev, uint8_t *const buf, const uint32_t tnbytes, const uint32_t rnbytes)
+{
+    dw_spi_t *const spi = hdl;
+    const int       status = dw_exchange(spi, spi_dev, buf, tnbytes, rnbytes);
+
+    if (spi->cs_override) {
+        dw_spi_deselect_slave(spi);
+    }
+
+    return status;
+}
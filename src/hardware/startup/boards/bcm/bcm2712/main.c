@@ -173,7 +173,8 @@ int main(const int argc, char ** const argv)
     /* Re-initialize in case the "-D" option was specified. */
     select_debug(debug_devices, sizeof(debug_devices));
 
-    cpu_freq = mbox_get_clock_rate(MBOX_CLK_ARM);
+    /* revision, serial, MAC, memory and ARM clock in two mailbox round trips */
+    cpu_freq = mbox_get_board_info()->arm_clock;
     cycles_freq = cpu_freq;
     timer_freq = 0;
 
@@ -199,29 +200,50 @@ int main(const int argc, char ** const argv)
     init_smp();
 
     if (debug_flag > 3) {
+        // temperature, 4 voltages, 14 clocks and 9 power states, six mailbox round trips
+        struct mbox_prop props[1U + 4U + 14U + 9U];
+        struct mbox_prop *prop = props;
         uint32_t i;
 
+        memset(props, 0, sizeof(props));
+        prop->tag = MBOX_TAG_GET_TEMPERATURE;
+        prop++;
+        for (i = 1U; i <= 4U; i++, prop++) {
+            prop->tag = MBOX_TAG_GET_VOLTAGE;
+            prop->value[0] = i;
+        }
+        for (i = 1U; i <= 14U; i++, prop++) {
+            prop->tag = MBOX_TAG_GET_CLOCKRATE;
+            prop->value[0] = i;
+        }
+        for (i = 0U; i <= 8U; i++, prop++) {
+            prop->tag = MBOX_TAG_GET_POWERSTATE;
+            prop->value[0] = i;
+        }
+        (void) mbox_get_props(props, NUM_ELTS(props));
+
+        prop = props;
         kprintf("%u CPUs @ %uMHz\n", lsp.syspage.p->num_cpu, cpu_freq / 1000000U);
-        kprintf("Temps %d\n", mbox_get_temperature(0U));
+        kprintf("Temps %d\n", (int32_t)prop->value[1]);
+        prop++;
         //0=rsvd 1=core 2=sdram_c 3=sdram_p 4=sdram_i
         kprintf("Volts");
-        for (i = 1U; i <= 4U; i++) {
-            kprintf(" %u=%u", i, mbox_get_voltage(i));
+        for (i = 1U; i <= 4U; i++, prop++) {
+            kprintf(" %u=%u", i, ((int32_t)prop->value[1] < 0) ? 0U : prop->value[1]);
         }
         kprintf("\n");
         kprintf("Clock");
         // 0=rsvd 1=EMMC1 2=UART 3=ARM 4=CORE 5=V3D 6=H264 7=ISP 8=SDRAM 9=PIXEL 10=PWM 12=EMMC2
-        for (i = 1U; i <= 14U; i++) {
-            const uint32_t clk = mbox_get_clock_rate(i);
-            if (clk) {
-                kprintf(" %u=%uMHz", i, clk / 1000000U);
+        for (i = 1U; i <= 14U; i++, prop++) {
+            if (prop->value[1]) {
+                kprintf(" %u=%uMHz", i, prop->value[1] / 1000000U);
             }
         }
         kprintf("\n");
         kprintf("Power");
         // 0=SD-Card 1=UART0 2=UART1 3=USB-HCD 4=I2C0 5=I2C1 6=I2C2 7=SPI 8=CCP2TX
-        for (i = 0U; i <= 8U; i++) {
-            kprintf(" %u=%u", i, mbox_get_power_state(i));
+        for (i = 0U; i <= 8U; i++, prop++) {
+            kprintf(" %u=%u", i, prop->value[1]);
         }
         kprintf("\n");
     }
@@ -75,59 +75,6 @@
 #define	MBOX_TAG_REQUEST            (0U << 31)
 #define	MBOX_TAG_RESPONSE           (1U << 31)
 
-#define	MBOX_TAG_NULL               0x00000000
-#define	MBOX_TAG_GET_FIRMWAREREV    0x00000001
-#define	MBOX_TAG_GET_BOARDMODEL     0x00010001
-#define	MBOX_TAG_GET_BOARDREVISION  0x00010002
-#define	MBOX_TAG_GET_MACADDRESS     0x00010003
-#define	MBOX_TAG_GET_BOARDSERIAL    0x00010004
-#define	MBOX_TAG_GET_ARMMEMORY      0x00010005
-#define	MBOX_TAG_GET_VCMEMORY       0x00010006
-#define	MBOX_TAG_GET_CLOCKS         0x00010007
-
-#define MBOX_TAG_GET_POWERSTATE     0x00020001
-#define MBOX_TAG_GET_POWERTIMING    0x00020002
-#define MBOX_TAG_SET_POWERSTATE     0x00028001
-
-#define	MBOX_TAG_GET_CLOCKSTATE     0x00030001
-#define	MBOX_TAG_SET_CLOCKSTATE     0x00038001
-#define	MBOX_TAG_GET_CLOCKRATE      0x00030002
-#define	MBOX_TAG_SET_CLOCKRATE      0x00038002
-#define	MBOX_TAG_GET_MIN_CLOCKRATE  0x00030007
-#define	MBOX_TAG_GET_MAX_CLOCKRATE  0x00030004
-
-#define MBOX_TAG_GET_VOLTAGE        0x00030003
-#define MBOX_TAG_SET_VOLTAGE        0x00038003
-#define MBOX_TAG_GET_MIN_VOLTAGE    0x00030008
-#define MBOX_TAG_GET_MAX_VOLTAGE    0x00030005
-
-#define MBOX_TAG_GET_TEMPERATURE    0x00030006
-#define MBOX_TAG_GET_MAX_TEMPERATURE 0x0003000a
-
-#define MBOX_TAG_GET_GPIO_STATE     0x00030041  // expansion gpio
-#define MBOX_TAG_SET_GPIO_STATE     0x00038041  // expansion gpio
-#define MBOX_TAG_GET_GPIO_CONFIG    0x00030043  // expansion gpio
-#define MBOX_TAG_SET_GPIO_CONFIG    0x00038043  // expansion gpio
-
-#define	MBOX_TAG_GET_CMDLINE        0x00050001
-#define	MBOX_TAG_GET_DMACHAN        0x00060001
-
-#define	MBOX_TAG_ALLOCATE_BUFFER    0x00040001
-#define	MBOX_TAG_BLANK_SCREEN       0x00040002
-#define	MBOX_TAG_GET_FB_RES         0x00040003
-#define	MBOX_TAG_SET_FB_RES         0x00048003
-#define	MBOX_TAG_GET_FB_VRES        0x00040004
-#define	MBOX_TAG_SET_FB_VRES        0x00048004
-#define	MBOX_TAG_GET_FB_DEPTH       0x00040005
-#define	MBOX_TAG_SET_FB_DEPTH       0x00048005
-#define	MBOX_TAG_GET_FB_PIXEL_ORDER 0x00040006
-#define	MBOX_TAG_SET_FB_PIXEL_ORDER 0x00048006
-#define	MBOX_TAG_GET_FB_ALPHA_MODE  0x00040007
-#define	MBOX_TAG_SET_FB_ALPHA_MODE  0x00048007
-#define	MBOX_TAG_GET_FB_PITCH       0x00040008
-
-#define	MBOX_TAG_GET_EDID_BLOCK     0x00030020
-
 #define	MBOX0_BASE                  0x00
 #define	MBOX1_BASE                  0x20
 
@@ -145,6 +92,9 @@
 #define	MBOX1_STATUS                (MBOX1_BASE + MBOX_STATUS)
 #define	MBOX1_CFG                   (MBOX1_BASE + MBOX_READ)
 
+/* tag, size, code and the two value words of a batched property */
+#define	MBOX_PROP_WORDS             5U
+
 struct mbox_msg_header {
     uint32_t size;
     uint32_t code;
@@ -205,84 +155,105 @@ static uint32_t mbox_send_message(void) {
     return 0;
 }
 
-uint32_t mbox_get_board_revision(void) {
-    volatile struct mbox_msg_get_board_revision {
-        struct mbox_msg_header header;
-        struct mbox_msg_tag tag;
-        struct {
-            uint32_t revision;
-        } body;
-        uint32_t end;
-    } *msg = (volatile struct mbox_msg_get_board_revision *) MBOX_BUFFER_ADDR;
-    msg->body.revision = 0;
-    MSG_INIT(msg, MBOX_TAG_GET_BOARDREVISION);
-    mbox_send_message();
-    return msg->body.revision;
+/**
+ * Query several properties with as few mailbox round trips as possible.
+ * Every property gets a two-word value buffer, so this covers the get tags
+ * taking at most one argument and returning at most eight bytes. A round
+ * trip carries as many as fit MBOX_BUFFER_SIZE, the image starts right
+ * after the buffer.
+ * @param   props   properties to query, value[] holds the request argument
+ *                  on entry and the response on return (zeroes if the
+ *                  firmware did not answer the tag)
+ * @param   nprops  number of entries in props
+ * @return  the number of properties answered by the firmware.
+ */
+unsigned mbox_get_props(struct mbox_prop * const props, const unsigned nprops) {
+    volatile uint32_t * const buf = (volatile uint32_t *) MBOX_BUFFER_ADDR;
+    const unsigned max = (MBOX_BUFFER_SIZE / sizeof(uint32_t) - 3U) / MBOX_PROP_WORDS;
+    unsigned answered = 0;
+    unsigned i, j, n;
+
+    for (i = 0; i < nprops; i += n) {
+        n = ((nprops - i) < max) ? (nprops - i) : max;
+
+        buf[0] = (3U + (n * MBOX_PROP_WORDS)) * sizeof(uint32_t);
+        buf[1] = MBOX_PROCESS_REQUEST;
+        for (j = 0; j < n; j++) {
+            volatile uint32_t * const tag = &buf[2U + (j * MBOX_PROP_WORDS)];
+            tag[0] = props[i + j].tag;
+            tag[1] = sizeof(props[i + j].value);
+            tag[2] = MBOX_TAG_REQUEST;
+            tag[3] = props[i + j].value[0];
+            tag[4] = props[i + j].value[1];
+        }
+        buf[2U + (n * MBOX_PROP_WORDS)] = MBOX_TAG_NULL;
+
+        mbox_send_message();
+
+        for (j = 0; j < n; j++) {
+            volatile uint32_t * const tag = &buf[2U + (j * MBOX_PROP_WORDS)];
+            struct mbox_prop * const prop = &props[i + j];
+            if ((buf[1] == MBOX_REQ_SUCCESS) && (tag[2] & MBOX_TAG_RESPONSE)) {
+                prop->code = tag[2];
+                prop->value[0] = tag[3];
+                prop->value[1] = tag[4];
+                answered++;
+            } else {
+                prop->code = 0;
+                prop->value[0] = 0;
+                prop->value[1] = 0;
+            }
+        }
+    }
+
+    return answered;
 }
 
-void mbox_get_board_mac_address(uint8_t* const address) {
-    volatile struct mbox_msg_get_board_mac_address {
-        struct mbox_msg_header header;
-        struct mbox_msg_tag tag;
-        struct {
-            uint8_t address[6];
-            uint8_t _pad[2];
-        } body;
-        uint32_t end;
-    } *msg = (volatile struct mbox_msg_get_board_mac_address *) MBOX_BUFFER_ADDR;
+const struct mbox_board_info *mbox_get_board_info(void) {
+    static struct mbox_board_info info;
+    static unsigned valid;
+
+    if (!valid) {
+        struct mbox_prop props[] = {
+            { .tag = MBOX_TAG_GET_BOARDREVISION },
+            { .tag = MBOX_TAG_GET_BOARDSERIAL },
+            { .tag = MBOX_TAG_GET_MACADDRESS },
+            { .tag = MBOX_TAG_GET_ARMMEMORY },
+            { .tag = MBOX_TAG_GET_VCMEMORY },
+            { .tag = MBOX_TAG_GET_CLOCKRATE, .value = { MBOX_CLK_ARM } },
+        };
+
+        (void) mbox_get_props(props, NUM_ELTS(props));
+
+        info.revision = props[0].value[0];
+        info.serial = ((uint64_t)props[1].value[1] << 32) | (uint64_t)props[1].value[0];
+        memcpy(info.mac, props[2].value, sizeof(info.mac));
+        info.arm_memory = props[3].value[1];
+        info.vc_memory = props[4].value[1];
+        info.arm_clock = props[5].value[1];
+        valid = 1;
+    }
+    return &info;
+}
 
-    memset((void *)msg, 0x0, sizeof(struct mbox_msg_get_board_mac_address));
-    MSG_INIT(msg, MBOX_TAG_GET_MACADDRESS);
-    mbox_send_message();
+uint32_t mbox_get_board_revision(void) {
+    return mbox_get_board_info()->revision;
+}
 
-    memcpy(address, (uint8_t*) msg->body.address, 6);
+void mbox_get_board_mac_address(uint8_t* const address) {
+    memcpy(address, mbox_get_board_info()->mac, sizeof(mbox_get_board_info()->mac));
 }
 
 uint64_t mbox_get_board_serial(void) {
-    volatile struct {
-        struct mbox_msg_header header;
-        struct mbox_msg_tag tag;
-        struct {
-            uint32_t serial[2];
-        } body;
-        uint32_t end;
-    } *msg = (volatile void *) MBOX_BUFFER_ADDR;
-
-    MSG_INIT(msg, MBOX_TAG_GET_BOARDSERIAL);
-    mbox_send_message();
-    return ((uint64_t)msg->body.serial[1] << 32) | (uint64_t)(msg->body.serial[0]);
+    return mbox_get_board_info()->serial;
 }
 
 uint32_t mbox_get_arm_memory(void) {
-    volatile struct {
-        struct mbox_msg_header header;
-        struct mbox_msg_tag tag;
-        struct {
-            uint32_t base;
-            uint32_t size;
-        } body[1];
-        uint32_t end;
-    } *msg = (volatile void *) MBOX_BUFFER_ADDR;
-
-    MSG_INIT(msg, MBOX_TAG_GET_ARMMEMORY);
-    mbox_send_message();
-    return msg->body[0].size;
+    return mbox_get_board_info()->arm_memory;
 }
 
 uint32_t mbox_get_vc_memory(void) {
-    volatile struct {
-        struct mbox_msg_header header;
-        struct mbox_msg_tag tag;
-        struct {
-            uint32_t base;
-            uint32_t size;
-        } body;
-        uint32_t end;
-    } *msg = (volatile void *) MBOX_BUFFER_ADDR;
-
-    MSG_INIT(msg, MBOX_TAG_GET_VCMEMORY);
-    mbox_send_message();
-    return msg->body.size;
+    return mbox_get_board_info()->vc_memory;
 }
 
 char *mbox_get_cmdline(void) {
@@ -65,6 +65,78 @@
 #define	MBOX_CLK_PWM    10
 #define	MBOX_CLK_EMMC2  12
 
+#define	MBOX_TAG_NULL               0x00000000
+#define	MBOX_TAG_GET_FIRMWAREREV    0x00000001
+#define	MBOX_TAG_GET_BOARDMODEL     0x00010001
+#define	MBOX_TAG_GET_BOARDREVISION  0x00010002
+#define	MBOX_TAG_GET_MACADDRESS     0x00010003
+#define	MBOX_TAG_GET_BOARDSERIAL    0x00010004
+#define	MBOX_TAG_GET_ARMMEMORY      0x00010005
+#define	MBOX_TAG_GET_VCMEMORY       0x00010006
+#define	MBOX_TAG_GET_CLOCKS         0x00010007
+
+#define MBOX_TAG_GET_POWERSTATE     0x00020001
+#define MBOX_TAG_GET_POWERTIMING    0x00020002
+#define MBOX_TAG_SET_POWERSTATE     0x00028001
+
+#define	MBOX_TAG_GET_CLOCKSTATE     0x00030001
+#define	MBOX_TAG_SET_CLOCKSTATE     0x00038001
+#define	MBOX_TAG_GET_CLOCKRATE      0x00030002
+#define	MBOX_TAG_SET_CLOCKRATE      0x00038002
+#define	MBOX_TAG_GET_MIN_CLOCKRATE  0x00030007
+#define	MBOX_TAG_GET_MAX_CLOCKRATE  0x00030004
+
+#define MBOX_TAG_GET_VOLTAGE        0x00030003
+#define MBOX_TAG_SET_VOLTAGE        0x00038003
+#define MBOX_TAG_GET_MIN_VOLTAGE    0x00030008
+#define MBOX_TAG_GET_MAX_VOLTAGE    0x00030005
+
+#define MBOX_TAG_GET_TEMPERATURE    0x00030006
+#define MBOX_TAG_GET_MAX_TEMPERATURE 0x0003000a
+
+#define MBOX_TAG_GET_GPIO_STATE     0x00030041  // expansion gpio
+#define MBOX_TAG_SET_GPIO_STATE     0x00038041  // expansion gpio
+#define MBOX_TAG_GET_GPIO_CONFIG    0x00030043  // expansion gpio
+#define MBOX_TAG_SET_GPIO_CONFIG    0x00038043  // expansion gpio
+
+#define	MBOX_TAG_GET_CMDLINE        0x00050001
+#define	MBOX_TAG_GET_DMACHAN        0x00060001
+
+#define	MBOX_TAG_ALLOCATE_BUFFER    0x00040001
+#define	MBOX_TAG_BLANK_SCREEN       0x00040002
+#define	MBOX_TAG_GET_FB_RES         0x00040003
+#define	MBOX_TAG_SET_FB_RES         0x00048003
+#define	MBOX_TAG_GET_FB_VRES        0x00040004
+#define	MBOX_TAG_SET_FB_VRES        0x00048004
+#define	MBOX_TAG_GET_FB_DEPTH       0x00040005
+#define	MBOX_TAG_SET_FB_DEPTH       0x00048005
+#define	MBOX_TAG_GET_FB_PIXEL_ORDER 0x00040006
+#define	MBOX_TAG_SET_FB_PIXEL_ORDER 0x00048006
+#define	MBOX_TAG_GET_FB_ALPHA_MODE  0x00040007
+#define	MBOX_TAG_SET_FB_ALPHA_MODE  0x00048007
+#define	MBOX_TAG_GET_FB_PITCH       0x00040008
+
+#define	MBOX_TAG_GET_EDID_BLOCK     0x00030020
+
+/* One property of a batched request, see mbox_get_props() */
+struct mbox_prop {
+    uint32_t tag;
+    uint32_t value[2];
+    uint32_t code;
+};
+
+/* Board properties fetched together on first use */
+struct mbox_board_info {
+    uint32_t revision;
+    uint64_t serial;
+    uint8_t  mac[6];
+    uint32_t arm_memory;
+    uint32_t vc_memory;
+    uint32_t arm_clock;     // ARM clock rate at the time of the query
+};
+
+unsigned mbox_get_props(struct mbox_prop *props, unsigned nprops);
+const struct mbox_board_info *mbox_get_board_info(void);
 uint32_t mbox_get_board_revision(void);
 void mbox_get_board_mac_address(uint8_t *address);
 uint32_t mbox_get_clock_rate(uint32_t id);
@@ -44,6 +44,9 @@
 #include <stdint.h>
 #include <sys/types.h>
 #include <libfdt.h>
+#include <hw/hwinfo_private.h>
+#include <drvr/hwinfo.h>
+#include <hw/hwinfo_bcm2712.h>
 #include "bcm2712_startup.h"
 #include "board.h"
 
@@ -53,8 +56,6 @@
  *  - revision 1.1, uses BCM2712 D0 stepping SOC with
  *    FDT pinctrl@7d504100 node has: compatible = "brcm,bcm2712d0-pinctrl";
  */
-#define BCM2712_STEPPING_C1         (0U)
-#define BCM2712_STEPPING_D0         (1U)
 static uint32_t bcm2712_stepping = BCM2712_STEPPING_C1;
 static uint32_t gpio_bank_widths[BCM2712_AON_GPIO_BANK_NUM] = { BCM2712_AON_GPIO_BANK0_GPIO, BCM2712_AON_GPIO_BANK1_GPIO };
 
@@ -542,6 +543,12 @@ void init_gpio_aon_bcm(void)
 
     fdt_get_soc_stepping();
 
+    /* Publish the stepping, the gpio utilities then don't have to map and search the FDT */
+    {
+        const unsigned hwi_off = hwidev_add(BCM2712_HWI_SOC, 0, HWI_NULL_OFF);
+        hwitag_add_regname(hwi_off, BCM2712_HWI_STEPPING, bcm2712_stepping);
+    }
+
     for(i = 0; i < NUM_ELTS(pi5_aon_gpio); i++) {
         const struct bcm2712_pinmux_t *p = (bcm2712_stepping == BCM2712_STEPPING_D0)? &pi5_aon_gpio_d0[i] : &pi5_aon_gpio[i];
 
@@ -53,6 +53,7 @@
 #define BCM2712_RP1_ENET_SIZE          0x4000
 #define BCM2712_RP1_ENET_IRQ           0xa6
 #define BCM2712_HWI_CGEM               "cgem"
+#define BCM2712_HWI_BOARD              "bcm2712,board"
 
 static void fdt_get_mac_addr(uint8_t* const mac)
 {
@@ -196,6 +197,13 @@ void init_hwinfo(void)
         hwitag_add_regname(hwi_off, "write_width", 32);
         hwitag_add_regname(hwi_off, "enable_width", 32);
     }
+
+    /* Board revision for mbox-bcm, which would otherwise ask the firmware again */
+    {
+        const unsigned hwi_off = hwidev_add(BCM2712_HWI_BOARD, 0, HWI_NULL_OFF);
+        ASSERT(hwi_off != HWI_NULL_OFF);
+        hwitag_add_regname(hwi_off, "revision", get_board_revision());
+    }
 }
 
 #define PCIE_EXT_MIP_INTC_ADDR            0x1000131000 /* msi-controller for the PCIe extension port */
@@ -1,4 +1,6 @@
 NEEDS_FDT=yes
+# hwinfo_bcm2712.h
+EXTRA_INCVPATH += $(BOARD_ROOT)/../../../../../support/bcm2712/public
 define PINFO
 PINFO DESCRIPTION=Raspberry Pi 5
 endef
@@ -4,10 +4,13 @@ endif
 include $(QCONFIG)
 include $(MKFILES_ROOT)/qmacros.mk
 
+LIBS+=drvr
 NAME = gpio-aon-bcm
 EXTRA_SILENT_VARIANTS+=$(SECTION)
 USEFILE=$(PROJECT_ROOT)/$(NAME).use
 
+EXTRA_INCVPATH += $(PROJECT_ROOT)/../public
+
 define PINFO
 PINFO DESCRIPTION=Raspberry Pi 5 gpio-aon-bcm utility
 endef
@@ -49,6 +49,8 @@
 #include <sys/mman.h>
 #include <hw/inout.h>
 #include <sys/asinfo.h>
+#include <drvr/hwinfo.h>
+#include <hw/hwinfo_bcm2712.h>
 #include <libfdt.h>
 
 #define BCM2712_AON_GPIO_BASE          (0x107d517c00UL)
@@ -301,8 +303,6 @@ static const uint32_t gpio_aon_bcm_d0_to_c0[GPIO_MAX] =
  *  - revision 1.1, uses BCM2712 D0 stepping SOC with
  *    FDT pinctrl@7d504100 node has: compatible = "brcm,bcm2712d0-pinctrl";
  */
-#define BCM2712_STEPPING_C1         (0U)
-#define BCM2712_STEPPING_D0         (1U)
 static uint32_t bcm2712_stepping = BCM2712_STEPPING_C1;
 
 struct fdt_info
@@ -337,6 +337,13 @@ static void check_bcm2712_stepping(void)
 {
     struct fdt_info         fdt = { (void *)MAP_FAILED, 0 };
 
+    if (hwinfo_bcm2712_stepping(&bcm2712_stepping)) {
+        if (bcm2712_stepping == BCM2712_STEPPING_D0) {
+            gpio_bank_widths[0] = BCM2712D0_AON_GPIO_BANK0_GPIO;
+        }
+        return;
+    }
+
     // Map the FDT.
     if (walk_asinfo("fdt", &map_fdt, (void *)&fdt) != 0) {
         (void)printf("FDT not in syspage asinfo\n");
@@ -4,10 +4,15 @@ endif
 include $(QCONFIG)
 include $(MKFILES_ROOT)/qmacros.mk
 
+LIBS+=drvr
 NAME = gpio-bcm
 EXTRA_SILENT_VARIANTS+=$(SECTION)
 USEFILE=$(PROJECT_ROOT)/$(NAME).use
 
+# hwinfo_bcm2712.h is shared with gpio-aon-bcm and startup
+EXTRA_INCVPATH += $(PROJECT_ROOT)/../public
+PUBLIC_INCVPATH += $(PROJECT_ROOT)/../public
+
 define PINFO
 PINFO DESCRIPTION=Raspberry pi5 RP1 gpio utility
 endef
@@ -49,6 +49,8 @@
 #include <sys/mman.h>
 #include <hw/inout.h>
 #include <sys/asinfo.h>
+#include <drvr/hwinfo.h>
+#include <hw/hwinfo_bcm2712.h>
 #include <libfdt.h>
 
 #define BCM2712_GPIO_BASE           (0x107d508500UL)
@@ -328,8 +330,6 @@ static const uint32_t gpio_bcm_d0_to_c0[GPIO_MAX] =
  *  - revision 1.1, uses BCM2712 D0 stepping SOC with
  *    FDT pinctrl@7d504100 node has: compatible = "brcm,bcm2712d0-pinctrl";
  */
-#define BCM2712_STEPPING_C1         (0U)
-#define BCM2712_STEPPING_D0         (1U)
 static uint32_t bcm2712_stepping = BCM2712_STEPPING_C1;
 
 struct fdt_info
@@ -364,6 +364,10 @@ static void check_bcm2712_stepping(void)
 {
     struct fdt_info         fdt = { (void *)MAP_FAILED, 0 };
 
+    if (hwinfo_bcm2712_stepping(&bcm2712_stepping)) {
+        return;
+    }
+
     // Map the FDT.
     if (walk_asinfo("fdt", &map_fdt, (void *)&fdt) != 0) {
         (void)printf("FDT not in syspage asinfo\n");
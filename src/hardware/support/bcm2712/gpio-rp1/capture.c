@@ -0,0 +1,278 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * 
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#include <hw/inout.h>
+#include "proto.h"
+
+/*
+ * Capture state. Started and stopped from the resource manager thread, the
+ * sampling thread only reads it besides writing the ring.
+ */
+typedef struct gpio_capture_ {
+    rp1_gpio_capture_ring_t *ring;
+    const gpio_ocb_t        *owner;             /* NULL when no capture runs */
+    pthread_t               tid;
+    volatile uint32_t       stop;
+    uint32_t                runmask;
+    uint64_t                period;             /* ClockCycles() between samples, 0 for back to back */
+    uint32_t                nbanks;             /* banks with pins to sample */
+    uintptr_t               sync_in[RP1_GPIO_BANKS];
+    uint32_t                bank_mask[RP1_GPIO_BANKS];
+    uint32_t                bank_base[RP1_GPIO_BANKS];
+    rp1_gpio_t              *dev;
+} gpio_capture_t;
+
+static gpio_capture_t gpio_cap;
+
+static void *gpio_capture_thread(void *arg)
+{
+    gpio_capture_t *const cap = arg;
+    rp1_gpio_capture_ring_t *const ring = cap->ring;
+    uint64_t seq = 0ULL;
+    uint64_t last = 0ULL;
+    uint64_t levels, now, next;
+    uint32_t i;
+
+    if ((cap->runmask != 0U) && (ThreadCtl(_NTO_TCTL_RUNMASK, (void *)(uintptr_t)cap->runmask) == -1)) {
+        (void)slogf(_SLOGC_GPIO, (cap->period == 0ULL) ? _SLOG_ERROR : _SLOG_WARNING,
+                "%s failed to set runmask 0x%x, errno: %d", __func__, cap->runmask, errno);
+        /* Back to back sampling never yields, don't let it spin on a CPU it wasn't given */
+        if (cap->period == 0ULL) {
+            ring->running = 0;
+            return NULL;
+        }
+    }
+
+    next = ClockCycles();
+    while (cap->stop == 0U) {
+        now = ClockCycles();
+        levels = 0ULL;
+        for (i = 0; i < cap->nbanks; i++) {
+            levels |= (uint64_t)(in32(cap->sync_in[i]) & cap->bank_mask[i]) << cap->bank_base[i];
+        }
+
+        /* Only changes are stored, the first sample gives the initial levels */
+        if ((seq == 0ULL) || (levels != last)) {
+            rp1_gpio_sample_t *const slot = &ring->slot[seq % RP1_GPIO_CAPTURE_SLOTS];
+
+            slot->timestamp = now;
+            slot->levels = levels;
+            __cpu_membarrier();
+            ring->seq = ++seq;
+            last = levels;
+        }
+
+        if (cap->period != 0ULL) {
+            next += cap->period;
+            do {
+                now = ClockCycles();
+            } while ((now < next) && (cap->stop == 0U));
+            /* Restart the schedule after a preemption rather than sample in a burst */
+            if ((now - next) > cap->period) {
+                next = now;
+            }
+        }
+    }
+
+    ring->running = 0;
+    return NULL;
+}
+
+int rp1_gpio_capture_start(gpio_ocb_t *ocb, const rp1_gpio_capture_t *req)
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    uint64_t cps;
+    uint32_t bank;
+    int status;
+
+    if (gpio_cap.ring == NULL) {
+        return ENODEV;
+    }
+    if ((gpio_cap.owner != NULL) && (gpio_cap.owner != ocb)) {
+        return EBUSY;
+    }
+    if ((req->mask == 0ULL) || ((req->mask >> GPIO_MAX) != 0ULL)) {
+        return EINVAL;
+    }
+    if ((req->prio != 0U) && (((int)req->prio < sched_get_priority_min(SCHED_FIFO)) ||
+                              ((int)req->prio > sched_get_priority_max(SCHED_FIFO)))) {
+        return EINVAL;
+    }
+    /* Back to back sampling needs a CPU of its own */
+    if (((req->period_ns == 0U) && (req->runmask == 0U)) ||
+        ((_syspage_ptr->num_cpu < 32U) && ((req->runmask >> _syspage_ptr->num_cpu) != 0U))) {
+        return EINVAL;
+    }
+
+    /* A new request from the owner replaces its capture */
+    (void)rp1_gpio_capture_stop(ocb);
+
+    gpio_cap.nbanks = 0;
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        const uint32_t pins = (uint32_t)(req->mask >> rp1_bank_base[bank]) & rp1_bank_pins(bank);
+
+        if (pins != 0U) {
+            gpio_cap.sync_in[gpio_cap.nbanks] = gpio_cap.dev->vbase + gpio_sys_rio_bank_offset[bank] +
+                                                RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET;
+            gpio_cap.bank_mask[gpio_cap.nbanks] = pins;
+            gpio_cap.bank_base[gpio_cap.nbanks] = rp1_bank_base[bank];
+            gpio_cap.nbanks++;
+        }
+    }
+
+    cps = SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+    gpio_cap.period = 0ULL;
+    if (req->period_ns != 0U) {
+        gpio_cap.period = ((uint64_t)req->period_ns * cps) / 1000000000ULL;
+        if (gpio_cap.period == 0ULL) {
+            gpio_cap.period = 1ULL;
+        }
+    }
+    gpio_cap.runmask = req->runmask;
+    gpio_cap.stop = 0;
+
+    gpio_cap.ring->running = 0;
+    __cpu_membarrier();
+    gpio_cap.ring->seq = 0ULL;
+    gpio_cap.ring->mask = req->mask;
+    gpio_cap.ring->cycles_per_sec = cps;
+    __cpu_membarrier();
+    gpio_cap.ring->running = 1;
+
+    (void)pthread_attr_init(&attr);
+    if (req->prio != 0U) {
+        (void)memset(&param, 0, sizeof(param));
+        param.sched_priority = (int)req->prio;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
+    status = pthread_create(&gpio_cap.tid, &attr, gpio_capture_thread, &gpio_cap);
+    (void)pthread_attr_destroy(&attr);
+    if (status != EOK) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s pthread_create failed, error: %d", __func__, status);
+        gpio_cap.ring->running = 0;
+        return status;
+    }
+    gpio_cap.owner = ocb;
+
+    return EOK;
+}
+
+int rp1_gpio_capture_stop(const gpio_ocb_t *ocb)
+{
+    if (gpio_cap.owner == NULL) {
+        return EOK;
+    }
+    if (gpio_cap.owner != ocb) {
+        return EBUSY;
+    }
+
+    gpio_cap.stop = 1;
+    (void)pthread_join(gpio_cap.tid, NULL);
+    gpio_cap.owner = NULL;
+
+    return EOK;
+}
+
+int rp1_gpio_capture_init(rp1_gpio_t *dev)
+{
+    void *ring;
+    int fd, status;
+
+    gpio_cap.dev = dev;
+
+    /* Clients map the ring read-only */
+    fd = shm_open(RP1_GPIO_CAPTURE_SHM, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s shm_open %s failed, errno: %d", __func__, RP1_GPIO_CAPTURE_SHM, status);
+        return status;
+    }
+
+    if (ftruncate(fd, (off_t)sizeof(*gpio_cap.ring)) == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s ftruncate failed, errno: %d", __func__, status);
+        (void)close(fd);
+        (void)shm_unlink(RP1_GPIO_CAPTURE_SHM);
+        return status;
+    }
+
+    ring = mmap(NULL, sizeof(*gpio_cap.ring), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (ring == MAP_FAILED) {
+        status = errno;
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s mmap failed, errno: %d", __func__, status);
+        (void)shm_unlink(RP1_GPIO_CAPTURE_SHM);
+        return status;
+    }
+
+    gpio_cap.ring = ring;
+    gpio_cap.ring->nslots = RP1_GPIO_CAPTURE_SLOTS;
+    gpio_cap.ring->cycles_per_sec = SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+    gpio_cap.ring->seq = 0ULL;
+    __cpu_membarrier();
+    gpio_cap.ring->magic = RP1_GPIO_CAPTURE_MAGIC;
+
+    return EOK;
+}
+
+void rp1_gpio_capture_deinit(void)
+{
+    if (gpio_cap.owner != NULL) {
+        (void)rp1_gpio_capture_stop(gpio_cap.owner);
+    }
+    if (gpio_cap.ring != NULL) {
+        (void)munmap(gpio_cap.ring, sizeof(*gpio_cap.ring));
+        (void)shm_unlink(RP1_GPIO_CAPTURE_SHM);
+        gpio_cap.ring = NULL;
+    }
+}
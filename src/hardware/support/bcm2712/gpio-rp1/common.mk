@@ -8,8 +8,11 @@ NAME = gpio-rp1
 EXTRA_SILENT_VARIANTS+=$(SECTION)
 USEFILE=$(PROJECT_ROOT)/$(NAME).use
 
+EXTRA_INCVPATH += $(PROJECT_ROOT)/public
+PUBLIC_INCVPATH += $(PROJECT_ROOT)/public
+
 define PINFO
-PINFO DESCRIPTION=Raspberry pi5 RP1 gpio utility
+PINFO DESCRIPTION=Raspberry pi5 RP1 gpio utility and resource manager
 endef
 
 
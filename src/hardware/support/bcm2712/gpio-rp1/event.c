@@ -0,0 +1,329 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <hw/inout.h>
+#include "proto.h"
+
+typedef struct gpio_irq_bank_ {
+    uint32_t        bank;
+    int             iid;
+    int             code;               /* pulse code */
+} gpio_irq_bank_t;
+
+/*
+ * Interrupt state, only touched from the resource manager thread: the
+ * interrupts arrive there as pulses alongside the devctl messages.
+ */
+typedef struct gpio_irq_ {
+    rp1_gpio_t      *dev;
+    uintptr_t       msix_vbase;
+    int             coid;
+    uint64_t        level_pins;         /* level triggered, disarmed when they fire */
+    gpio_ocb_t      *owner[GPIO_MAX];
+    gpio_irq_bank_t bank[RP1_GPIO_BANKS];
+} gpio_irq_t;
+
+static gpio_irq_t gpio_irq = { .msix_vbase = 0, .coid = -1 };
+
+static void gpio_event_notify(gpio_ocb_t *ocb)
+{
+    if ((ocb->rcvid != -1) && (MsgDeliverEvent(ocb->rcvid, &ocb->event) == -1)) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_WARNING, "%s MsgDeliverEvent failed, errno: %d", __func__, errno);
+    }
+}
+
+static void gpio_event_push(gpio_ocb_t *ocb, const uint32_t pin, const int level, const uint64_t timestamp)
+{
+    rp1_gpio_event_t *ev;
+
+    if (ocb->cnt == RP1_GPIO_EVENT_SLOTS) {
+        ocb->dropped++;
+        return;
+    }
+
+    ev = &ocb->slot[ocb->head];
+    ev->timestamp = timestamp;
+    ev->pin = (uint8_t)pin;
+    ev->level = (int8_t)level;
+    ocb->head = (ocb->head + 1U) % RP1_GPIO_EVENT_SLOTS;
+
+    /* One delivery per empty to non-empty transition, the client drains the queue */
+    if (ocb->cnt++ == 0U) {
+        gpio_event_notify(ocb);
+    }
+}
+
+static int gpio_irq_pulse(message_context_t *ctp, int code, unsigned flags, void *handle)
+{
+    const gpio_irq_bank_t *const irq = handle;
+    /* Dispatch time, the pulse may have waited behind other messages */
+    const uint64_t now = ClockCycles();
+    const uintptr_t io = gpio_irq.dev->vbase + gpio_io_bank_offset[irq->bank];
+    const uint32_t ints = in32(io + RP1_GPIO_IO_REG_INTS_OFFSET);
+    const uint32_t sync_in = in32(gpio_irq.dev->vbase + gpio_sys_rio_bank_offset[irq->bank] +
+                                  RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET);
+    uint32_t pending = ints;
+
+    (void)ctp;
+    (void)code;
+    (void)flags;
+
+    while (pending != 0U) {
+        const uint32_t offset = (uint32_t)__builtin_ctz(pending);
+        const uint32_t pin = rp1_bank_base[irq->bank] + offset;
+        gpio_ocb_t *const ocb = gpio_irq.owner[pin];
+
+        pending &= pending - 1U;
+
+        /* Edges stay latched until reset, a level would fire again straight away */
+        out32(io + RP1_GPIO_IO_REG_CTRL_OFFSET(offset) + RP1_SET_OFFSET, RP1_GPIO_CTRL_IRQRESET);
+        if ((ocb == NULL) || ((gpio_irq.level_pins & (1ULL << pin)) != 0ULL)) {
+            out32(io + RP1_GPIO_IO_REG_INTE_OFFSET + RP1_CLR_OFFSET, 1U << offset);
+        }
+        if (ocb != NULL) {
+            gpio_event_push(ocb, pin, (int)((sync_in >> offset) & 1U), now);
+        }
+    }
+
+    /* The vector is level triggered, acknowledge it before unmasking */
+    out32(gpio_irq.msix_vbase + RP1_PCIE_MSIX_CFG(irq->bank) + RP1_PCIE_MSIX_CFG_SET_OFFSET, RP1_PCIE_MSIX_CFG_IACK);
+    (void)InterruptUnmask((int)RP1_GPIO_GIC_IRQ(irq->bank), irq->iid);
+
+    return 0;
+}
+
+/* Program the trigger of a pin, a trigger of 0 disables its interrupt */
+static void gpio_irq_arm(const uint32_t pin, const uint32_t trigger, const uint32_t debounce)
+{
+    uint32_t bank = 0;
+    uint32_t offset;
+    uintptr_t io;
+    uint32_t ctrl;
+
+    while ((bank < (RP1_GPIO_BANKS - 1U)) && (pin >= rp1_bank_base[bank + 1U])) {
+        bank++;
+    }
+    offset = pin - rp1_bank_base[bank];
+    io = gpio_irq.dev->vbase + gpio_io_bank_offset[bank];
+
+    out32(io + RP1_GPIO_IO_REG_INTE_OFFSET + RP1_CLR_OFFSET, 1U << offset);
+
+    ctrl = in32(io + RP1_GPIO_IO_REG_CTRL_OFFSET(offset));
+    ctrl &= ~(RP1_GPIO_CTRL_IRQ_MASK | RP1_GPIO_CTRL_F_M_MASK);
+    if (trigger != 0U) {
+        ctrl |= trigger << ((debounce != 0U) ? RP1_GPIO_CTRL_IRQ_DB_SHIFT : RP1_GPIO_CTRL_IRQ_SHIFT);
+        ctrl |= debounce << RP1_GPIO_CTRL_F_M_SHIFT;
+    }
+    out32(io + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), ctrl);
+
+    /* Drop any edge latched before the pin was armed */
+    out32(io + RP1_GPIO_IO_REG_CTRL_OFFSET(offset) + RP1_SET_OFFSET, RP1_GPIO_CTRL_IRQRESET);
+
+    if ((trigger & (RP1_GPIO_TRIG_LOW | RP1_GPIO_TRIG_HIGH)) != 0U) {
+        gpio_irq.level_pins |= 1ULL << pin;
+    } else {
+        gpio_irq.level_pins &= ~(1ULL << pin);
+    }
+
+    if (trigger != 0U) {
+        out32(io + RP1_GPIO_IO_REG_INTE_OFFSET + RP1_SET_OFFSET, 1U << offset);
+    }
+}
+
+int rp1_gpio_notify(resmgr_context_t *ctp, gpio_ocb_t *ocb, const rp1_gpio_notify_t *req)
+{
+    uint32_t pin;
+
+    if (((req->mask & ~RP1_GPIO_ALL_MASK) != 0ULL) || ((req->trigger & ~RP1_GPIO_TRIG_MASK) != 0U) ||
+        (req->debounce > RP1_GPIO_DEBOUNCE_MAX)) {
+        return EINVAL;
+    }
+    if (gpio_irq.coid == -1) {
+        return ENODEV;
+    }
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if (((req->mask & (1ULL << pin)) != 0ULL) && (gpio_irq.owner[pin] != NULL) && (gpio_irq.owner[pin] != ocb)) {
+            return EBUSY;
+        }
+    }
+
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((req->mask & (1ULL << pin)) != 0ULL) {
+            gpio_irq_arm(pin, req->trigger, req->debounce);
+            gpio_irq.owner[pin] = (req->trigger != 0U) ? ocb : NULL;
+        }
+    }
+    if (req->trigger != 0U) {
+        ocb->pins |= req->mask;
+    } else {
+        ocb->pins &= ~req->mask;
+    }
+
+    if (req->event.sigev_notify == SIGEV_NONE) {
+        ocb->rcvid = -1;
+    } else {
+        ocb->rcvid = ctp->rcvid;
+        ocb->event = req->event;
+        if (ocb->cnt != 0U) {
+            gpio_event_notify(ocb);
+        }
+    }
+
+    return EOK;
+}
+
+void rp1_gpio_notify_release(gpio_ocb_t *ocb)
+{
+    uint32_t pin;
+
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if (gpio_irq.owner[pin] == ocb) {
+            gpio_irq_arm(pin, 0U, 0U);
+            gpio_irq.owner[pin] = NULL;
+        }
+    }
+    ocb->pins = 0ULL;
+    ocb->rcvid = -1;
+}
+
+void rp1_gpio_events_read(gpio_ocb_t *ocb, rp1_gpio_events_t *out)
+{
+    uint32_t n = 0;
+
+    while ((ocb->cnt != 0U) && (n < RP1_GPIO_EVENTS_MAX)) {
+        const uint32_t tail = (ocb->head + RP1_GPIO_EVENT_SLOTS - ocb->cnt) % RP1_GPIO_EVENT_SLOTS;
+        out->event[n++] = ocb->slot[tail];
+        ocb->cnt--;
+    }
+    out->nevents = n;
+    out->dropped = ocb->dropped;
+    ocb->dropped = 0;
+}
+
+/*
+ * Deliver the bank interrupts to the dispatch loop as pulses. msix-rp1 must
+ * have enabled vectors 0 to 2, pins cannot be watched when this fails.
+ */
+int rp1_gpio_event_init(rp1_gpio_t *dev, dispatch_t *dpp)
+{
+    struct sigevent event;
+    uint32_t bank;
+    int status;
+
+    gpio_irq.dev = dev;
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        gpio_irq.bank[bank].bank = bank;
+        gpio_irq.bank[bank].iid = -1;
+    }
+
+    gpio_irq.msix_vbase = (uintptr_t) mmap_device_memory(NULL, RP1_PCIE_MSIX_CFG_SIZE, PROT_NOCACHE|PROT_READ|PROT_WRITE,
+                                                         0, RP1_PCIE_MSIX_CFG_BASE);
+    if (gpio_irq.msix_vbase == (uintptr_t) MAP_FAILED) {
+        gpio_irq.msix_vbase = 0;
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s mmap (MSI-X) failed, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    gpio_irq.coid = message_connect(dpp, MSG_FLAG_SIDE_CHANNEL);
+    if (gpio_irq.coid == -1) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s message_connect failed, errno: %d", __func__, errno);
+        status = errno;
+        rp1_gpio_event_deinit();
+        return status;
+    }
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        gpio_irq_bank_t *const irq = &gpio_irq.bank[bank];
+
+        irq->code = pulse_attach(dpp, MSG_FLAG_ALLOC_PULSE, 0, gpio_irq_pulse, irq);
+        if (irq->code == -1) {
+            (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s pulse_attach failed, errno: %d", __func__, errno);
+            status = errno;
+            rp1_gpio_event_deinit();
+            return status;
+        }
+
+        SIGEV_PULSE_INIT(&event, gpio_irq.coid, SIGEV_PULSE_PRIO_INHERIT, irq->code, 0);
+        irq->iid = InterruptAttachEvent((int)RP1_GPIO_GIC_IRQ(bank), &event, _NTO_INTR_FLAGS_TRK_MSK);
+        if (irq->iid == -1) {
+            (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s InterruptAttachEvent (irq 0x%x) failed, errno: %d", __func__,
+                    RP1_GPIO_GIC_IRQ(bank), errno);
+            status = errno;
+            rp1_gpio_event_deinit();
+            return status;
+        }
+    }
+
+    return EOK;
+}
+
+void rp1_gpio_event_deinit(void)
+{
+    uint32_t bank;
+    uint32_t pin;
+
+    if (gpio_irq.dev != NULL) {
+        for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+            if (gpio_irq.owner[pin] != NULL) {
+                gpio_irq_arm(pin, 0U, 0U);
+                gpio_irq.owner[pin] = NULL;
+            }
+        }
+    }
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        if (gpio_irq.bank[bank].iid != -1) {
+            (void)InterruptDetach(gpio_irq.bank[bank].iid);
+            gpio_irq.bank[bank].iid = -1;
+        }
+    }
+    if (gpio_irq.coid != -1) {
+        (void)ConnectDetach(gpio_irq.coid);
+        gpio_irq.coid = -1;
+    }
+    if (gpio_irq.msix_vbase != 0) {
+        (void)munmap_device_memory((void *)gpio_irq.msix_vbase, RP1_PCIE_MSIX_CFG_SIZE);
+        gpio_irq.msix_vbase = 0;
+    }
+}
@@ -45,76 +45,17 @@
 #include <stdbool.h>
 #include <errno.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <devctl.h>
 #include <sys/mman.h>
-#include <hw/inout.h>
-
-#define RP1_GPIO_BASE              (0x1f000d0000UL)
-#define RP1_IO_BANK0_OFFSET        (0x00000000U)
-#define RP1_IO_BANK1_OFFSET        (0x00004000U)
-#define RP1_IO_BANK2_OFFSET        (0x00008000U)
-#define RP1_SYS_RIO_BANK0_OFFSET   (0x00010000U)
-#define RP1_SYS_RIO_BANK1_OFFSET   (0x00014000U)
-#define RP1_SYS_RIO_BANK2_OFFSET   (0x00018000U)
-#define RP1_PADS_BANK0_OFFSET      (0x00020000U)
-#define RP1_PADS_BANK1_OFFSET      (0x00024000U)
-#define RP1_PADS_BANK2_OFFSET      (0x00028000U)
-
-
-#define DRIVE_UNSET       (0xFFFFFFFFU)
-#define DRIVE_LOW         (0U)
-#define DRIVE_HIGH        (1U)
-
-#define PULL_UNSET        (0xFFFFFFFFU)
-#define PULL_NONE         (0U)
-#define PULL_DOWN         (1U)
-#define PULL_UP           (2U)
-
-#define FUNC_UNSET        (0xFFFFFFFFU)
-#define FUNC_A0           (0U)
-#define FUNC_A1           (1U)
-#define FUNC_A2           (2U)
-#define FUNC_A3           (3U)
-#define FUNC_A4           (4U)
-#define FUNC_A5           (5U)
-#define RP1_FSEL_SYS_RIO  (FUNC_A5)
-#define FUNC_A6           (6U)
-#define FUNC_A7           (7U)
-#define FUNC_A8           (8U)
-#define NUM_ALT_FUNCS     (9U)
-#define FUNC_SEL_MASK     (0x1fU)
-#define FUNC_NULL         (FUNC_SEL_MASK)
-
-
-#define FUNC_IP           (20U)
-#define FUNC_OP           (21U)
-#define FUNC_GP           (22U)
-#define FUNC_NO           (23U)
-
-#define RP1_GPIO_NUM      (54U)
-#define GPIO_MIN          (0U)
-#define GPIO_MAX          (RP1_GPIO_NUM)
-
-#define RP1_PADS_OD_SET   (1U << 7)
-#define RP1_PADS_IE_SET   (1U << 6)
-#define RP1_PADS_PUE_SET  (1U << 3)
-#define RP1_PADS_PDE_SET  (1U << 2)
-
-/* RP1 GPIO io read*/
-#define RP1_GPIO_IO_REG_STATUS_OFFSET(offset) ((((offset) * 2U) + 0U) * sizeof(uint32_t))
-#define RP1_GPIO_IO_REG_CTRL_OFFSET(offset)   ((((offset) * 2U) + 1U) * sizeof(uint32_t))
-
-/* RP1 GPIO pads read*/
-#define RP1_GPIO_PADS_REG_OFFSET(offset)      (sizeof(uint32_t) + ((offset) * sizeof(uint32_t)))
-
-/* RP1 GPIO sys_io read*/
-#define RP1_GPIO_SYS_RIO_REG_OUT_OFFSET        (0x0U)
-#define RP1_GPIO_SYS_RIO_REG_OE_OFFSET         (0x4U)
-#define RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET    (0x8U)
-
-#define RP1_RW_OFFSET     (0x0000U)
-#define RP1_XOR_OFFSET    (0x1000U)
-#define RP1_SET_OFFSET    (0x2000U)
-#define RP1_CLR_OFFSET    (0x3000U)
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#include <sys/procmgr.h>
+#include "proto.h"
+
+int32_t verbose = 0;
 
 static const char * const rp1_gpio_fsel_names[] =
 {
@@ -232,40 +173,6 @@ static const char * const rp1_gpio_fdt_names[GPIO_MAX] =
     "-                ",    // 53
 };
 
-#define BLOCK_SIZE          (0x2c000)
-
-/* Pointer to HW */
-static uintptr_t gpio_base;
-static const uint32_t rp1_bank_base[] = {0, 28, 34};
-static int32_t debug=0;
-
-static const uint32_t gpio_io_bank_offset[] = { RP1_IO_BANK0_OFFSET, RP1_IO_BANK1_OFFSET, RP1_IO_BANK2_OFFSET };
-static const uint32_t gpio_pads_bank_offset[] = { RP1_PADS_BANK0_OFFSET, RP1_PADS_BANK1_OFFSET, RP1_PADS_BANK2_OFFSET };
-static const uint32_t gpio_sys_rio_bank_offset[] = { RP1_SYS_RIO_BANK0_OFFSET, RP1_SYS_RIO_BANK1_OFFSET, RP1_SYS_RIO_BANK2_OFFSET };
-
-static void rp1_gpio_get_bank_offset(const uint32_t gpio, uint32_t *bank, uint32_t *offset)
-{
-    *bank = 0;
-    *offset = 0;
-    if (gpio >= GPIO_MAX)
-    {
-        (void)printf("Invalid gpio number %u\n", gpio);
-        exit (EXIT_FAILURE);
-    }
-
-    if (gpio < rp1_bank_base[1]) {
-        *bank = 0;
-    }
-    else if (gpio < rp1_bank_base[2]) {
-        *bank = 1;
-    }
-    else {
-        *bank = 2;
-    }
-
-   *offset = gpio - rp1_bank_base[*bank];
-}
-
 static void print_funcs(const bool all_pins, const uint64_t pin_mask)
 {
     uint32_t pin;
@@ -312,314 +219,689 @@ static void print_funcs(const bool all_pins, const uint64_t pin_mask)
     }
 }
 
-static void set_gpio_dir(const uint32_t gpio, const uint32_t dir)
+static int gpio_fsel_to_namestr(const uint32_t gpio, const uint32_t fsel, char * const name)
 {
-    uint32_t bank, offset;
+    if (gpio >= GPIO_MAX) {
+        return -1;
+    }
 
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    if (dir == FUNC_IP) {
-        out32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_CLR_OFFSET, (1u << offset));
-        if (debug > 0) {
-            (void)printf("%s gpio:%u bank-offset: %u-%u, write sys_rio oe register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                    (uint64_t)RP1_GPIO_BASE+ gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_CLR_OFFSET, (1u << offset));
-        }
+    switch (fsel) {
+        case FUNC_GP:
+            return sprintf(name, "GPIO");
+        case FUNC_IP:
+            return sprintf(name, "INPUT");
+        case FUNC_OP:
+            return sprintf(name, "OUTPUT");
+        case FUNC_A0:
+        case FUNC_A1:
+        case FUNC_A2:
+        case FUNC_A3:
+        case FUNC_A4:
+        case FUNC_A5:
+        case FUNC_A6:
+        case FUNC_A7:
+        case FUNC_A8:
+            break;
+        case FUNC_NULL:
+            return sprintf(name, "none");
+            break;
+        default:
+            return -1;
     }
-    else if (dir == FUNC_OP) {
-        out32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_SET_OFFSET, (1u << offset));
-        if (debug > 0) {
-            (void)printf("%s gpio:%u bank-offset: %u-%u, write sys_rio oe register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_SET_OFFSET, (1u << offset));
+    return sprintf(name, "%s", rp1_gpio_fsel_names[(gpio * NUM_ALT_FUNCS) + fsel]);
+}
+
+/*
+ * type:
+ *   0 = no pull
+ *   1 = pull down
+ *   2 = pull up
+ */
+#define GPIO_NAME_STRLEN  (24U)
+static void gpio_get(const uint32_t pinnum, const rp1_gpio_pin_t * const state)
+{
+    char funcname[GPIO_NAME_STRLEN] = { 0 };
+    const int level = state->level;
+    const uint32_t fsel = state->func;
+    const uint32_t pull = state->pull;
+    const char* const gpio_pull_names[] = {"NONE", "DOWN", "UP", "?"};
+
+    if (gpio_fsel_to_namestr(pinnum, fsel, funcname) != -1) {
+        if (fsel < NUM_ALT_FUNCS) {
+            if (pull <= PULL_UP) {
+                (void)printf("GPIO %2u:level=%d pull=%s func=a%u %s\n", pinnum, level, gpio_pull_names[pull], fsel, funcname);
+            }
+            else {
+                (void)printf("GPIO %2u:level=%d pull=? fsel=a%u %s\n", pinnum, level, fsel, funcname);
+            }
+        } else {
+            if (pull <= PULL_UP) {
+                (void)printf("GPIO %2u:level=%d pull=%s func=%s\n", pinnum, level, gpio_pull_names[pull], funcname);
+            }
+            else {
+                (void)printf("GPIO %2u:level=%d pull=? func=%s\n", pinnum, level, funcname);
+            }
         }
     }
 }
 
-
-static uint32_t get_gpio_dir(const uint32_t gpio)
+/*
+ * Requests go to the resource manager when it is running (fd != -1),
+ * otherwise they are applied to the registers mapped by this process.
+ */
+static int gpio_open(rp1_gpio_t * const dev, const bool write, int * const fd)
 {
-    uint32_t bank, offset;
-    uint32_t sys_rio_oe_read;
-
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    sys_rio_oe_read = in32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET);
+    int ret;
 
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, read sys_rio oe register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE+ gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET, sys_rio_oe_read);
+    *fd = open(RP1_GPIO_DEV_NAME, write ? O_RDWR : O_RDONLY);
+    if (*fd != -1) {
+        return EOK;
     }
-    if (sys_rio_oe_read & (1U << offset)) {
-        return FUNC_OP;
+
+    /* The resource manager is running but refused the request, do not go around it */
+    if (errno != ENOENT) {
+        ret = errno;
+        (void)printf("Error: %s: %s\n", RP1_GPIO_DEV_NAME, strerror(ret));
+        return ret;
     }
-    else {
-        return FUNC_IP;
+
+    /* No resource manager, access the registers directly */
+    ret = rp1_gpio_init(dev);
+    if (ret != EOK) {
+        (void)printf("mmap (GPIO) failed: %s\n", strerror(ret));
     }
+    return ret;
 }
 
-static uint32_t get_gpio_fsel(const uint32_t gpio)
+static void gpio_close(rp1_gpio_t * const dev, const int fd)
 {
-    uint32_t bank, offset;
-    uint32_t io_val;
+    if (fd != -1) {
+        (void)close(fd);
+    } else {
+        rp1_gpio_deinit(dev);
+    }
+}
 
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    io_val = in32(gpio_base + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset));
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, io register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE+ gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), io_val);
+static int gpio_get_pins(const int fd, const rp1_gpio_t * const dev, rp1_gpio_get_t * const req)
+{
+    if (fd == -1) {
+        rp1_gpio_get(dev, req);
+        return EOK;
     }
-    io_val &= FUNC_SEL_MASK;
-    if (io_val == RP1_FSEL_SYS_RIO) {
-        return get_gpio_dir(gpio); /* will return FUNC_IP or FUNC_OP */
+    return devctl(fd, DCMD_GPIO_RP1_GET, req, sizeof(*req), NULL);
+}
+
+static int gpio_set_pins(const int fd, const rp1_gpio_t * const dev, rp1_gpio_set_t * const req)
+{
+    if (fd == -1) {
+        rp1_gpio_set(dev, req);
+        return EOK;
     }
-    return io_val;
+    return devctl(fd, DCMD_GPIO_RP1_SET, req, sizeof(*req), NULL);
 }
 
-static void set_gpio_fsel(const uint32_t gpio, uint32_t func_sel)
+static int gpio_setmask_pins(const int fd, const rp1_gpio_t * const dev, const rp1_gpio_mask_t * const req)
 {
-    uint32_t bank, offset;
-    uint32_t fsel;
-    uint32_t io_ctrl_val;
-    uint32_t orig_pad_val, pad_val;
+    if (fd == -1) {
+        rp1_gpio_setmask(dev, req);
+        return EOK;
+    }
+    return devctl(fd, DCMD_GPIO_RP1_SETMASK, (void *)req, sizeof(*req), NULL);
+}
 
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+static int gpio_levels(const int fd, const rp1_gpio_t * const dev, uint64_t * const levels)
+{
+    rp1_gpio_levels_t req = { 0 };
+    int ret = EOK;
 
-    if ((func_sel == FUNC_IP) || (func_sel == FUNC_OP)) {
-        set_gpio_dir(gpio, func_sel);
+    if (fd == -1) {
+        req.levels = rp1_gpio_levels(dev);
+    } else {
+        ret = devctl(fd, DCMD_GPIO_RP1_LEVELS, &req, sizeof(req), NULL);
     }
+    *levels = req.levels;
+    return ret;
+}
 
-    if ((func_sel == FUNC_IP) || (func_sel == FUNC_OP) || (func_sel == FUNC_GP)) {
-        fsel = RP1_FSEL_SYS_RIO;
-    }
-    else if (func_sel == FUNC_NO) {
-        fsel = FUNC_NULL;
-    }
-    else {
-        fsel = func_sel;
-    }
+/*
+ * setmask [oe] bank:set:clr[:toggle] ...   (masks in hex)
+ * levels
+ */
+static int gpio_bank_cmd(const int argc, char * const argv[], const bool setmask)
+{
+    rp1_gpio_t dev = { 0 };
+    rp1_gpio_mask_t req = { .reg = RP1_GPIO_MASK_OUT };
+    uint64_t levels = 0ULL;
+    int fd;
+    int ret;
 
-    io_ctrl_val = in32(gpio_base + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset));
-    io_ctrl_val &= ~(FUNC_SEL_MASK);
-    io_ctrl_val |= (fsel & FUNC_SEL_MASK);
-    out32(gpio_base + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), io_ctrl_val);
+    if (setmask) {
+        for (int arg_num = 2; arg_num < argc; arg_num++) {
+            uint32_t bank, set, clr, toggle = 0;
+            int n;
 
-    pad_val = in32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, read pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), pad_val);
-    }
-    orig_pad_val = pad_val;
-    if (fsel == FUNC_NULL) {
-        // Disable input
-        pad_val &= ~RP1_PADS_IE_SET;
-        // Disable peripheral func output
-        pad_val |= RP1_PADS_OD_SET;
+            if (strcmp(argv[arg_num], "oe") == 0) {
+                req.reg = RP1_GPIO_MASK_OE;
+                continue;
+            }
+            n = sscanf(argv[arg_num], "%u:%x:%x:%x", &bank, &set, &clr, &toggle);
+            if ((n < 3) || (bank >= RP1_GPIO_BANKS)) {
+                (void)printf("Error: Unknown bank mask \"%s\"\n", argv[arg_num]);
+                return EXIT_FAILURE;
+            }
+            req.bank[bank].set = set;
+            req.bank[bank].clr = clr;
+            req.bank[bank].toggle = toggle;
+        }
+        if (!rp1_gpio_setmask_valid(&req)) {
+            (void)printf("Error: Mask includes pins outside of the bank\n");
+            return EXIT_FAILURE;
+        }
+    } else if (argc > 2) {
+        (void)printf("Error: Too many arguments\n");
+        return EXIT_FAILURE;
     }
-    else {
-        // Enable input
-        pad_val |= RP1_PADS_IE_SET;
-        // Enable peripheral func output
-        pad_val &= ~RP1_PADS_OD_SET;
+
+    ret = gpio_open(&dev, setmask, &fd);
+    if (ret != EOK) {
+        return EXIT_FAILURE;
     }
 
-    if (pad_val != orig_pad_val) {
-        out32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset), pad_val);
-        if (debug > 0) {
-            (void)printf("%s gpio:%u bank-offset: %u-%u, write pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                    (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), pad_val);
+    if (setmask) {
+        ret = gpio_setmask_pins(fd, &dev, &req);
+    } else {
+        ret = gpio_levels(fd, &dev, &levels);
+        if (ret == EOK) {
+            (void)printf("0x%014lx\n", levels);
         }
     }
+
+    gpio_close(&dev, fd);
+
+    if (ret != EOK) {
+        (void)printf("Error: GPIO request failed: %s\n", strerror (ret));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
 }
 
-static int get_gpio_level(const uint32_t gpio)
+/*
+ * watch: print the interrupts of the pins until killed. Needs the resource
+ * manager, level triggers are re-armed once the queued events are printed.
+ */
+#define GPIO_WATCH_PULSE_CODE   (_PULSE_CODE_MINAVAIL)
+static int gpio_watch(const uint64_t pin_mask, const uint32_t trigger, const uint32_t debounce)
 {
-    uint32_t bank, offset;
-    uint32_t pad_val;
-    uint32_t sys_rio_sync_val;
-    int level;
+    rp1_gpio_notify_t req = { .mask = pin_mask, .trigger = trigger, .debounce = debounce };
+    rp1_gpio_events_t events;
+    struct _pulse pulse;
+    const uint64_t cycles_per_us = SYSPAGE_ENTRY(qtime)->cycles_per_sec / 1000000ULL;
+    int fd, chid, coid;
+    int ret = EOK;
+
+    fd = open(RP1_GPIO_DEV_NAME, O_RDWR);
+    if (fd == -1) {
+        (void)printf("Error: Can't open %s: %s\n", RP1_GPIO_DEV_NAME, strerror (errno));
+        return EXIT_FAILURE;
+    }
 
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    pad_val = in32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, read pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset), pad_val);
+    chid = ChannelCreate(_NTO_CHF_PRIVATE);
+    coid = (chid == -1) ? -1 : ConnectAttach(0, 0, chid, _NTO_SIDE_CHANNEL, 0);
+    if (coid == -1) {
+        ret = errno;
+    } else {
+        SIGEV_PULSE_INIT(&req.event, coid, SIGEV_PULSE_PRIO_INHERIT, GPIO_WATCH_PULSE_CODE, 0);
+        if (MsgRegisterEvent(&req.event, fd) == -1) {
+            ret = errno;
+        }
+    }
+    if (ret == EOK) {
+        ret = devctl(fd, DCMD_GPIO_RP1_NOTIFY, &req, sizeof(req), NULL);
     }
-    if (!(pad_val & RP1_PADS_IE_SET)) {
-        if (debug > 0) {
-            (void)printf("%s gpio:%u error RP1_PADS_IE_SET is not set\n", __func__, gpio);
+
+    while (ret == EOK) {
+        if (MsgReceivePulse(chid, &pulse, sizeof(pulse), NULL) == -1) {
+            ret = errno;
+            break;
         }
-        return -1;
+        do {
+            ret = devctl(fd, DCMD_GPIO_RP1_EVENTS, &events, sizeof(events), NULL);
+            if (ret != EOK) {
+                break;
+            }
+            if (events.dropped != 0U) {
+                (void)printf("%u events dropped\n", events.dropped);
+            }
+            for (uint32_t i = 0; i < events.nevents; i++) {
+                (void)printf("%" PRIu64 " us: GPIO %2u level=%d\n", events.event[i].timestamp / cycles_per_us,
+                        events.event[i].pin, events.event[i].level);
+            }
+        } while (events.nevents == RP1_GPIO_EVENTS_MAX);
+
+        if ((ret == EOK) && ((trigger & (RP1_GPIO_TRIG_LOW | RP1_GPIO_TRIG_HIGH)) != 0U)) {
+            ret = devctl(fd, DCMD_GPIO_RP1_NOTIFY, &req, sizeof(req), NULL);
+        }
+    }
+
+    if (coid != -1) {
+        (void)ConnectDetach(coid);
     }
-    sys_rio_sync_val = in32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET);
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, read sys_rio register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET, sys_rio_sync_val);
+    if (chid != -1) {
+        (void)ChannelDestroy(chid);
     }
-    level = (sys_rio_sync_val & (1U << offset)) ? 1 : 0;
+    (void)close(fd);
 
-    return level;
+    (void)printf("Error: GPIO watch failed: %s\n", strerror (ret));
+    return EXIT_FAILURE;
 }
 
-static void set_gpio_drive(const unsigned gpio, const uint32_t drive)
+/*
+ * capture: sample the pins from the resource manager's capture thread for
+ * duration_ms and write the changes to stdout as VCD.
+ */
+#define GPIO_CAPTURE_BATCH      1024U
+static uint64_t capture_ns(const uint64_t cycles, const uint64_t cps)
+{
+    return ((cycles / cps) * 1000000000ULL) + (((cycles % cps) * 1000000000ULL) / cps);
+}
+
+static void capture_vcd(const rp1_gpio_sample_t * const sample, const uint64_t t0, const uint64_t cps,
+                        const uint64_t pin_mask, uint64_t * const levels, const bool first)
 {
+    const uint64_t changed = first ? pin_mask : ((sample->levels ^ *levels) & pin_mask);
+    char id = '!';
 
-    uint32_t bank, offset;
-    uint32_t sys_rio_out_val;
+    (void)printf("#%" PRIu64 "\n", capture_ns(sample->timestamp - t0, cps));
+    for (uint32_t pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((pin_mask & (1ULL << pin)) == 0ULL) {
+            continue;
+        }
+        if ((changed & (1ULL << pin)) != 0ULL) {
+            (void)printf("%d%c\n", ((sample->levels >> pin) & 1ULL) != 0ULL, id);
+        }
+        id++;
+    }
+    *levels = sample->levels;
+}
+
+static int gpio_capture(rp1_gpio_capture_t * const req, const uint32_t duration_ms)
+{
+    static rp1_gpio_sample_t batch[GPIO_CAPTURE_BATCH];
+    const rp1_gpio_capture_ring_t *ring;
+    const uint64_t cps = SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+    const uint64_t end = ClockCycles() + ((cps / 1000ULL) * duration_ms);
+    uint64_t pos = 0ULL, t0 = 0ULL, levels = 0ULL, last_ts = 0ULL;
+    bool stopped = false;
+    bool started = false;
+    char id = '!';
+    int fd, shm_fd;
+    int ret;
 
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    sys_rio_out_val = in32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OUT_OFFSET);
-    if (drive == DRIVE_HIGH) {
-        sys_rio_out_val |= (1U << offset);
+    fd = open(RP1_GPIO_DEV_NAME, O_RDWR);
+    if (fd == -1) {
+        (void)printf("Error: Can't open %s: %s\n", RP1_GPIO_DEV_NAME, strerror (errno));
+        return EXIT_FAILURE;
+    }
+    shm_fd = shm_open(RP1_GPIO_CAPTURE_SHM, O_RDONLY, 0);
+    if (shm_fd == -1) {
+        (void)printf("Error: Can't open %s: %s\n", RP1_GPIO_CAPTURE_SHM, strerror (errno));
+        (void)close(fd);
+        return EXIT_FAILURE;
     }
-    else if (drive == DRIVE_LOW) {
-        sys_rio_out_val &= ~(1U << offset);
+    ring = mmap(NULL, sizeof(*ring), PROT_READ, MAP_SHARED, shm_fd, 0);
+    (void)close(shm_fd);
+    if ((ring == MAP_FAILED) || (ring->magic != RP1_GPIO_CAPTURE_MAGIC)) {
+        (void)printf("Error: Can't map %s\n", RP1_GPIO_CAPTURE_SHM);
+        (void)close(fd);
+        return EXIT_FAILURE;
     }
 
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, write sys_rio register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OUT_OFFSET, sys_rio_out_val);
+    ret = devctl(fd, DCMD_GPIO_RP1_CAPTURE_START, req, sizeof(*req), NULL);
+    if (ret != EOK) {
+        (void)printf("Error: GPIO capture failed: %s\n", strerror (ret));
+        (void)munmap((void *)ring, sizeof(*ring));
+        (void)close(fd);
+        return EXIT_FAILURE;
     }
-    out32(gpio_base + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OUT_OFFSET, sys_rio_out_val);
-}
 
-static int gpio_fsel_to_namestr(const uint32_t gpio, const uint32_t fsel, char * const name)
-{
-    if (gpio >= GPIO_MAX) {
-        return -1;
+    (void)printf("$timescale 1ns $end\n$scope module gpio_rp1 $end\n");
+    for (uint32_t pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((req->mask & (1ULL << pin)) != 0ULL) {
+            (void)printf("$var wire 1 %c gpio%u $end\n", id++, pin);
+        }
     }
+    (void)printf("$upscope $end\n$enddefinitions $end\n");
 
-    switch (fsel) {
-        case FUNC_GP:
-            return sprintf(name, "GPIO");
-        case FUNC_IP:
-            return sprintf(name, "INPUT");
-        case FUNC_OP:
-            return sprintf(name, "OUTPUT");
-        case FUNC_A0:
-        case FUNC_A1:
-        case FUNC_A2:
-        case FUNC_A3:
-        case FUNC_A4:
-        case FUNC_A5:
-        case FUNC_A6:
-        case FUNC_A7:
-        case FUNC_A8:
-            break;
-        case FUNC_NULL:
-            return sprintf(name, "none");
+    /* The last pass after the stop picks up the samples taken meanwhile */
+    while (true) {
+        const uint64_t seq = ring->seq;
+        uint64_t first, n, count;
+
+        __cpu_membarrier();
+        first = pos + 1ULL;
+        if ((seq - pos) > ring->nslots) {
+            first = (seq - ring->nslots) + 1ULL;
+        }
+        count = seq + 1ULL - first;
+        if (count > GPIO_CAPTURE_BATCH) {
+            count = GPIO_CAPTURE_BATCH;
+        }
+        for (n = 0; n < count; n++) {
+            batch[n] = ring->slot[(first + n - 1ULL) % ring->nslots];
+        }
+        __cpu_membarrier();
+
+        /*
+         * Sample k is overwritten by sample k + nslots, which may be in progress
+         * once seq is k + nslots - 1. Skip those, they could have changed during the copy.
+         */
+        n = 0;
+        if ((ring->seq + 1ULL) >= (first + ring->nslots)) {
+            n = (ring->seq + 2ULL) - (first + ring->nslots);
+            n = (n > count) ? count : n;
+        }
+        if ((first + n) > (pos + 1ULL)) {
+            (void)printf("$comment %" PRIu64 " samples lost $end\n", (first + n) - (pos + 1ULL));
+        }
+        for (; n < count; n++) {
+            if (!started) {
+                t0 = batch[n].timestamp;
+            }
+            capture_vcd(&batch[n], t0, cps, req->mask, &levels, !started);
+            last_ts = batch[n].timestamp;
+            started = true;
+        }
+        pos = first + count - 1ULL;
+
+        if (count == GPIO_CAPTURE_BATCH) {
+            continue;
+        }
+        if (stopped) {
             break;
-        default:
-            return -1;
+        }
+        if (ClockCycles() >= end) {
+            ret = devctl(fd, DCMD_GPIO_RP1_CAPTURE_STOP, NULL, 0, NULL);
+            stopped = true;
+            if (ret != EOK) {
+                break;
+            }
+        } else {
+            (void)delay(1);
+        }
     }
-    return sprintf(name, "%s", rp1_gpio_fsel_names[(gpio * NUM_ALT_FUNCS) + fsel]);
+    if (started) {
+        (void)printf("#%" PRIu64 "\n", capture_ns(last_ts - t0, cps));
+    }
+
+    (void)munmap((void *)ring, sizeof(*ring));
+    (void)close(fd);
+
+    if (ret != EOK) {
+        (void)printf("Error: GPIO capture failed: %s\n", strerror (ret));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
 }
 
 /*
- * type:
- *   0 = no pull
- *   1 = pull down
- *   2 = pull up
+ * [gpio number]: comma-separated pins or ranges. Returns NULL once the whole
+ * list is parsed, otherwise the part that could not be.
  */
-static void gpio_set_pull(const uint32_t gpio, const uint32_t type)
+static const char *parse_pins(const char *pin_opt, uint64_t * const pin_mask)
 {
-    uint32_t bank, offset;
-    uint32_t pad_val;
+    int ret;
 
-    if (type <= PULL_UP) {
-        rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-        pad_val = in32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
-        if (debug > 0) {
-            (void)printf("%s gpio:%u bank-offset: %u-%u, read pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                    (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), pad_val);
+    while (pin_opt) {
+        uint32_t pin, pin2;
+        int len;
+        ret = sscanf(pin_opt, "%u%n", &pin, &len);
+        if ((ret != 1) || (pin >= GPIO_MAX)) {
+            break;
         }
-        pad_val &= ~(RP1_PADS_PDE_SET | RP1_PADS_PUE_SET);
+        pin_opt += len;
 
-        if (type == PULL_UP) {
-            pad_val |= RP1_PADS_PUE_SET;
+        if (*pin_opt == '-') {
+            pin_opt++;
+            ret = sscanf(pin_opt, "%u%n", &pin2, &len);
+            if ((ret != 1) || (pin2 >= GPIO_MAX)) {
+                break;
+            }
+            if (pin2 < pin) {
+                const unsigned tmp = pin2;
+                pin2 = pin;
+                pin = tmp;
+            }
+            pin_opt += len;
+        } else {
+            pin2 = pin;
         }
-        else if (type == PULL_DOWN) {
-            pad_val |= RP1_PADS_PDE_SET;
+        while (pin <= pin2) {
+            *pin_mask |= (1UL << pin);
+            pin++;
         }
-
-        out32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset), pad_val);
-        if (debug > 0) {
-            (void)printf("%s gpio:%u bank-offset: %u-%u, write pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                    (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), pad_val);
+        if (*pin_opt == '\0') {
+            pin_opt = NULL;
+        } else {
+            if (*pin_opt != ',') {
+                break;
+            }
+            pin_opt++;
         }
     }
+
+    return pin_opt;
 }
 
-static uint32_t get_gpio_pull(const uint32_t gpio)
+/* [set options] from argv[first] on, returns -1 on an unknown option */
+static int parse_set_options(const int argc, char * const argv[], const int first, rp1_gpio_set_t * const req)
 {
-    uint32_t pull = PULL_NONE;
-    uint32_t bank, offset;
-    uint32_t pad_val;
-
-    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
-    pad_val = in32(gpio_base + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
-    if (debug > 0) {
-        (void)printf("%s gpio:%u bank-offset: %u-%u, read pad register:0x%lx=0x%x\n", __func__, gpio, bank, offset,
-                (uint64_t)RP1_GPIO_BASE + gpio_pads_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), pad_val);
-    }
-
-    if (pad_val & RP1_PADS_PUE_SET) {
-        pull = PULL_UP;
-    }
-    else if (pad_val & RP1_PADS_PDE_SET) {
-        pull = PULL_DOWN;
+    for (int arg_num = first; arg_num < argc; arg_num++) {
+        if (strcmp(argv[arg_num], "dh") == 0) {
+            req->drive = DRIVE_HIGH;
+        } else if (strcmp(argv[arg_num], "dl") == 0) {
+            req->drive = DRIVE_LOW;
+        } else if (strcmp(argv[arg_num], "gp") == 0) {
+            req->func = FUNC_GP;
+        } else if (strcmp(argv[arg_num], "ip") == 0) {
+            req->func = FUNC_IP;
+        } else if (strcmp(argv[arg_num], "op") == 0) {
+            req->func = FUNC_OP;
+        } else if (strcmp(argv[arg_num], "no") == 0) {
+            req->func = FUNC_NULL;
+        } else if (strcmp(argv[arg_num], "a0") == 0) {
+            req->func = FUNC_A0;
+        } else if (strcmp(argv[arg_num], "a1") == 0) {
+            req->func = FUNC_A1;
+        } else if (strcmp(argv[arg_num], "a2") == 0) {
+            req->func = FUNC_A2;
+        } else if (strcmp(argv[arg_num], "a3") == 0) {
+            req->func = FUNC_A3;
+        } else if (strcmp(argv[arg_num], "a4") == 0) {
+            req->func = FUNC_A4;
+        } else if (strcmp(argv[arg_num], "a5") == 0) {
+            req->func = FUNC_A5;
+        } else if (strcmp(argv[arg_num], "a6") == 0) {
+            req->func = FUNC_A6;
+        } else if (strcmp(argv[arg_num], "a7") == 0) {
+            req->func = FUNC_A7;
+        } else if (strcmp(argv[arg_num], "a8") == 0) {
+            req->func = FUNC_A8;
+        } else if (strcmp(argv[arg_num], "pu") == 0) {
+            req->pull = PULL_UP;
+        } else if (strcmp(argv[arg_num], "pd") == 0) {
+            req->pull = PULL_DOWN;
+        } else if (strcmp(argv[arg_num], "pn") == 0) {
+            req->pull = PULL_NONE;
+        } else {
+            (void)printf("Unknown argument \"%s\"\n", argv[arg_num]);
+            return EXIT_FAILURE;
+        }
     }
 
-    return pull;
+    return 0;
 }
 
-#define GPIO_NAME_STRLEN  (24U)
-static void gpio_get(const uint32_t pinnum)
+#define PINMUX_LINE_MAX   (256U)
+#define PINMUX_ARGS_MAX   (8)
+
+/*
+ * Pinmux table: one "[gpio number] [set options]" entry per line, as given
+ * to the set command, '#' starts a comment. Returns the number of entries or
+ * -1 when the table is not valid.
+ */
+static int pinmux_load(const char * const path, rp1_gpio_set_t * const table, const int max)
 {
-    char funcname[GPIO_NAME_STRLEN] = { 0 };
-    int level;
-    uint32_t fsel;
-    uint32_t pull;
-    const char* const gpio_pull_names[] = {"NONE", "DOWN", "UP", "?"};
+    char line[PINMUX_LINE_MAX];
+    uint32_t lineno = 0;
+    int n = 0;
+    FILE *fp;
+
+    fp = fopen(path, "r");
+    if (fp == NULL) {
+        (void)printf("Error: Can't open %s: %s\n", path, strerror (errno));
+        return -1;
+    }
 
-    level = get_gpio_level(pinnum);
-    pull = get_gpio_pull(pinnum);
-    fsel = get_gpio_fsel(pinnum);
-    if (gpio_fsel_to_namestr(pinnum, fsel, funcname) != -1) {
-        if (fsel < NUM_ALT_FUNCS) {
-            if (pull <= PULL_UP) {
-                (void)printf("GPIO %2u:level=%d pull=%s func=a%u %s\n", pinnum, level, gpio_pull_names[pull], fsel, funcname);
-            }
-            else {
-                (void)printf("GPIO %2u:level=%d pull=? fsel=a%u %s\n", pinnum, level, fsel, funcname);
+    while ((n >= 0) && (fgets(line, sizeof(line), fp) != NULL)) {
+        char *args[PINMUX_ARGS_MAX];
+        char *comment = strchr(line, '#');
+        char *save = NULL;
+        char *tok;
+        int nargs = 0;
+
+        lineno++;
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        for (tok = strtok_r(line, " \t\r\n", &save); tok != NULL; tok = strtok_r(NULL, " \t\r\n", &save)) {
+            if (nargs == PINMUX_ARGS_MAX) {
+                break;
             }
+            args[nargs++] = tok;
+        }
+        if (nargs == 0) {
+            continue;
+        }
+
+        if ((tok != NULL) || (nargs < 2) || (n == max)) {
+            n = -1;
         } else {
-            if (pull <= PULL_UP) {
-                (void)printf("GPIO %2u:level=%d pull=%s func=%s\n", pinnum, level, gpio_pull_names[pull], funcname);
-            }
-            else {
-                (void)printf("GPIO %2u:level=%d pull=? func=%s\n", pinnum, level, funcname);
+            rp1_gpio_set_t * const req = &table[n];
+
+            *req = (rp1_gpio_set_t){ .func = FUNC_UNSET, .pull = PULL_UNSET, .drive = DRIVE_UNSET };
+            if ((parse_pins(args[0], &req->mask) != NULL) || (parse_set_options(nargs, args, 1, req) != 0) ||
+                !rp1_gpio_set_valid(req)) {
+                n = -1;
+            } else {
+                n++;
             }
         }
+        if (n < 0) {
+            (void)printf("Error: %s line %u: invalid pinmux entry\n", path, lineno);
+        }
     }
+
+    (void)fclose(fp);
+    return n;
 }
 
-static void gpio_set(const uint32_t pinnum, const uint32_t func_sel, const uint32_t drive, const uint32_t pull)
+/* apply: set up all the pins of a pinmux table from one process */
+static int gpio_apply(const char * const path)
 {
-    /* set function */
-    if (func_sel != FUNC_UNSET) {
-        set_gpio_fsel(pinnum, func_sel);
+    rp1_gpio_set_t table[GPIO_MAX];
+    rp1_gpio_t dev = { 0 };
+    int fd;
+    int ret;
+    int n;
+
+    n = pinmux_load(path, table, GPIO_MAX);
+    if (n < 0) {
+        return EXIT_FAILURE;
     }
 
-    /* set output value (check pin is output first) */
-    if (drive != DRIVE_UNSET) {
-        if (get_gpio_fsel(pinnum) == FUNC_OP) {
-            set_gpio_drive(pinnum, drive);
-        } else {
-            (void)printf("Can't set pin value, not an output: %u\n", pinnum);
+    ret = gpio_open(&dev, true, &fd);
+    if (ret != EOK) {
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; (i < n) && (ret == EOK); i++) {
+        ret = gpio_set_pins(fd, &dev, &table[i]);
+    }
+
+    gpio_close(&dev, fd);
+
+    if (ret != EOK) {
+        (void)printf("Error: GPIO request failed: %s\n", strerror (ret));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Run as the /dev/gpio-rp1 resource manager. The pinmux table is applied
+ * before the path is attached, so the pins are set up once it appears.
+ */
+static int gpio_resmgr(const char * const pinmux)
+{
+    int status;
+    rp1_gpio_t dev = { 0 };
+    rp1_gpio_set_t table[GPIO_MAX];
+    int n = 0;
+
+    if (pinmux != NULL) {
+        n = pinmux_load(pinmux, table, GPIO_MAX);
+        if (n < 0) {
+            return EXIT_FAILURE;
         }
     }
 
-    /* set pulls */
-    if (pull != PULL_UNSET) {
-        gpio_set_pull(pinnum, pull);
+    status = rp1_gpio_init(&dev);
+    if (status != EOK) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "mmap (GPIO) failed: %s", strerror(status));
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < n; i++) {
+        rp1_gpio_set(&dev, &table[i]);
+    }
+
+    status = resmgr_init(&dev);
+    if (status != EOK) {
+        goto done;
     }
+
+    /* Detach process as a daemon */
+    if (procmgr_daemon(EXIT_SUCCESS, PROCMGR_DAEMON_NOCLOSE) == -1) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "Failed to detaching process as a daemon, errno: %d", errno);
+        status = errno;
+        goto done;
+    }
+
+    /*
+     * Drop the abilities now that the resource manager is set up. Capture
+     * threads may run above the unprivileged priorities, keep that one; the
+     * runmask of its own threads needs no ability.
+     */
+    status = procmgr_ability(0, PROCMGR_ADN_ROOT | PROCMGR_ADN_NONROOT | PROCMGR_AOP_ALLOW |
+                                PROCMGR_AOP_LOCK | PROCMGR_AID_PRIORITY,
+                                PROCMGR_ADN_ROOT | PROCMGR_ADN_NONROOT | PROCMGR_AOP_DENY |
+                                PROCMGR_AOP_LOCK | PROCMGR_AID_EOL);
+    if (status != EOK) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "Dropping procmgr abilities failed, status: %d", status);
+        goto done;
+    }
+
+    status = resmgr_loop_start();
+
+    if (verbose > 0) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_DEBUG1, "Exited resource manager loop");
+    }
+
+done:
+
+    resmgr_deinit();
+    rp1_gpio_deinit(&dev);
+    return ((status == EOK) ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
 int main(const int argc, char * const argv[])
@@ -630,9 +912,13 @@ int main(const int argc, char * const argv[])
     bool set = false;
     bool get = false;
     bool funcs = false;
-    uint32_t pull = PULL_UNSET;
-    uint32_t func_sel = FUNC_UNSET;
-    uint32_t drive = DRIVE_UNSET;
+    bool watch = false;
+    bool capture = false;
+    rp1_gpio_capture_t capture_req = { 0 };
+    uint32_t capture_ms = 1000U;
+    uint32_t trigger = 0U;
+    uint32_t debounce = 0U;
+    rp1_gpio_set_t set_req = { .func = FUNC_UNSET, .pull = PULL_UNSET, .drive = DRIVE_UNSET };
     uint64_t pin_mask = 0UL; /* Enough for 0-53 */
     bool all_pins = false;
 
@@ -641,11 +927,42 @@ int main(const int argc, char * const argv[])
         return EXIT_FAILURE;
     }
 
+    /* -d runs the resource manager, other commands are served by it once it is up */
+    if (strcmp(argv[1], "-d") == 0) {
+        const char *pinmux = NULL;
+
+        for (int arg_num = 2; arg_num < argc; arg_num++) {
+            if (strcmp(argv[arg_num], "-v") == 0) {
+                verbose++;
+            } else if ((strcmp(argv[arg_num], "-c") == 0) && ((arg_num + 1) < argc)) {
+                pinmux = argv[++arg_num];
+            } else {
+                (void)printf("Unknown argument \"%s\"\n", argv[arg_num]);
+                return EXIT_FAILURE;
+            }
+        }
+        return gpio_resmgr(pinmux);
+    }
+
+    if (strcmp(argv[1], "apply") == 0) {
+        if (argc != 3) {
+            (void)printf("Error: '%s apply' expects input in the form '%s apply [pinmux file]'\n", argv[0], argv[0]);
+            return EXIT_FAILURE;
+        }
+        return gpio_apply(argv[2]);
+    }
+
+    if ((strcmp(argv[1], "setmask") == 0) || (strcmp(argv[1], "levels") == 0)) {
+        return gpio_bank_cmd(argc, argv, strcmp(argv[1], "setmask") == 0);
+    }
+
     /* argc 2 or greater, next arg must be set, get or help */
     get = strcmp(argv[1], "get") == 0;
     set = strcmp(argv[1], "set") == 0;
     funcs = strcmp(argv[1], "funcs") == 0;
-    if (!set && !get && !funcs) {
+    watch = strcmp(argv[1], "watch") == 0;
+    capture = strcmp(argv[1], "capture") == 0;
+    if (!set && !get && !funcs && !watch && !capture) {
         (void)printf("Error: Invalid argument \"%s\" try \"use %s\"\n", argv[1], argv[0]);
         return EXIT_FAILURE;
     }
@@ -661,46 +978,15 @@ int main(const int argc, char * const argv[])
         return EXIT_FAILURE;
     }
 
+    if ((watch) && (argc < 3)) {
+        (void)printf("Error: '%s watch' expects input in the form '%s watch [gpio number] [trigger options]'\n",
+            argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
     /* expect pin number(s) next */
     if (argc > 2) {
-        const char * pin_opt = argv[2];
-        while (pin_opt) {
-            uint32_t pin, pin2;
-            int len;
-            ret = sscanf(pin_opt, "%u%n", &pin, &len);
-            if ((ret != 1) || (pin >= GPIO_MAX)) {
-                break;
-            }
-            pin_opt += len;
-
-            if (*pin_opt == '-') {
-                pin_opt++;
-                ret = sscanf(pin_opt, "%u%n", &pin2, &len);
-                if ((ret != 1) || (pin2 >= GPIO_MAX)) {
-                    break;
-                }
-                if (pin2 < pin) {
-                    const unsigned tmp = pin2;
-                    pin2 = pin;
-                    pin = tmp;
-                }
-                pin_opt += len;
-            } else {
-                pin2 = pin;
-            }
-            while (pin <= pin2) {
-                pin_mask |= (1UL << pin);
-                pin++;
-            }
-            if (*pin_opt == '\0') {
-                pin_opt = NULL;
-            } else {
-                if (*pin_opt != ',') {
-                    break;
-                }
-                pin_opt++;
-            }
-        }
+        const char * const pin_opt = parse_pins(argv[2], &pin_mask);
         if (pin_opt) {
             (void)printf("Error: Unknown GPIO \"%s\"\n", pin_opt);
             return EXIT_FAILURE;
@@ -709,86 +995,125 @@ int main(const int argc, char * const argv[])
 
     if (set) {
         /* parse set options */
+        if (parse_set_options(argc, argv, 3, &set_req) != 0) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (watch) {
+        /* parse watch options */
         for (int arg_num = 3; arg_num < argc; arg_num++) {
-            if (strcmp(argv[arg_num], "dh") == 0) {
-                drive = DRIVE_HIGH;
-            } else if (strcmp(argv[arg_num], "dl") == 0) {
-                drive = DRIVE_LOW;
-            } else if (strcmp(argv[arg_num], "gp") == 0) {
-                func_sel = FUNC_GP;
-            } else if (strcmp(argv[arg_num], "ip") == 0) {
-                func_sel = FUNC_IP;
-            } else if (strcmp(argv[arg_num], "op") == 0) {
-                func_sel = FUNC_OP;
-            } else if (strcmp(argv[arg_num], "no") == 0) {
-                func_sel = FUNC_NO;
-            } else if (strcmp(argv[arg_num], "a0") == 0) {
-                func_sel = FUNC_A0;
-            } else if (strcmp(argv[arg_num], "a1") == 0) {
-                func_sel = FUNC_A1;
-            } else if (strcmp(argv[arg_num], "a2") == 0) {
-                func_sel = FUNC_A2;
-            } else if (strcmp(argv[arg_num], "a3") == 0) {
-                func_sel = FUNC_A3;
-            } else if (strcmp(argv[arg_num], "a4") == 0) {
-                func_sel = FUNC_A4;
-            } else if (strcmp(argv[arg_num], "a5") == 0) {
-                func_sel = FUNC_A5;
-            } else if (strcmp(argv[arg_num], "a6") == 0) {
-                func_sel = FUNC_A6;
-            } else if (strcmp(argv[arg_num], "a7") == 0) {
-                func_sel = FUNC_A7;
-            } else if (strcmp(argv[arg_num], "a8") == 0) {
-                func_sel = FUNC_A8;
-            } else if (strcmp(argv[arg_num], "pu") == 0) {
-                pull = PULL_UP;
-            } else if (strcmp(argv[arg_num], "pd") == 0) {
-                pull = PULL_DOWN;
-            } else if (strcmp(argv[arg_num], "pn") == 0) {
-                pull = PULL_NONE;
+            if (strcmp(argv[arg_num], "rising") == 0) {
+                trigger |= RP1_GPIO_TRIG_RISING;
+            } else if (strcmp(argv[arg_num], "falling") == 0) {
+                trigger |= RP1_GPIO_TRIG_FALLING;
+            } else if (strcmp(argv[arg_num], "both") == 0) {
+                trigger |= RP1_GPIO_TRIG_BOTH;
+            } else if (strcmp(argv[arg_num], "high") == 0) {
+                trigger |= RP1_GPIO_TRIG_HIGH;
+            } else if (strcmp(argv[arg_num], "low") == 0) {
+                trigger |= RP1_GPIO_TRIG_LOW;
+            } else if ((sscanf(argv[arg_num], "db%u", &debounce) == 1) && (debounce <= RP1_GPIO_DEBOUNCE_MAX)) {
+                continue;
             } else {
                 (void)printf("Unknown argument \"%s\"\n", argv[arg_num]);
                 return EXIT_FAILURE;
             }
         }
+        if (trigger == 0U) {
+            trigger = RP1_GPIO_TRIG_BOTH;
+        }
     }
+    if (capture) {
+        /* parse capture options */
+        for (int arg_num = 3; arg_num < argc; arg_num++) {
+            uint32_t cpu;
 
+            if (sscanf(argv[arg_num], "period%u", &capture_req.period_ns) == 1) {
+                continue;
+            } else if (sscanf(argv[arg_num], "prio%u", &capture_req.prio) == 1) {
+                continue;
+            } else if ((sscanf(argv[arg_num], "cpu%u", &cpu) == 1) && (cpu < 32U)) {
+                capture_req.runmask |= 1U << cpu;
+            } else if ((sscanf(argv[arg_num], "ms%u", &capture_ms) == 1) && (capture_ms != 0U)) {
+                continue;
+            } else {
+                (void)printf("Unknown argument \"%s\"\n", argv[arg_num]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
     /* end arg parsing */
     if (pin_mask == 0UL) {
         all_pins = true;
+        pin_mask = RP1_GPIO_ALL_MASK;
+    }
+
+    if (watch) {
+        return gpio_watch(pin_mask, trigger, debounce);
+    }
+    if (capture) {
+        if ((capture_req.period_ns == 0U) && (capture_req.runmask == 0U)) {
+            (void)printf("Error: back to back capture needs cpu<n>, or give a period<n>\n");
+            return EXIT_FAILURE;
+        }
+        capture_req.mask = pin_mask;
+        return gpio_capture(&capture_req, capture_ms);
     }
 
     if (funcs) {
         print_funcs(all_pins, pin_mask);
     /* get or set */
     } else {
-        gpio_base = (uintptr_t) mmap_device_memory(NULL, BLOCK_SIZE, PROT_NOCACHE|PROT_READ|PROT_WRITE, 0, RP1_GPIO_BASE);
-        if (gpio_base == (uintptr_t) MAP_FAILED) {
-            (void)printf("mmap (GPIO) failed: %s\n", strerror (errno));
+        rp1_gpio_t dev = { 0 };
+        int fd;
+
+        ret = gpio_open(&dev, set, &fd);
+        if (ret != EOK) {
             return EXIT_FAILURE;
         }
 
-        uint32_t pin;
-        for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
-            if (all_pins == true) {
-                if (pin == rp1_bank_base[0]) {
-                    (void)printf("BANK0 (GPIO %u to %u):\n", rp1_bank_base[0], rp1_bank_base[1]-1U);
+        if (get) {
+            rp1_gpio_get_t req = { .mask = pin_mask };
+
+            ret = gpio_get_pins(fd, &dev, &req);
+            if (ret == EOK) {
+                uint32_t pin;
+                for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+                    if (all_pins == true) {
+                        if (pin == rp1_bank_base[0]) {
+                            (void)printf("BANK0 (GPIO %u to %u):\n", rp1_bank_base[0], rp1_bank_base[1]-1U);
+                        }
+                        if (pin == rp1_bank_base[1]) {
+                            (void)printf("BANK1 (GPIO %u to %u):\n", rp1_bank_base[1], rp1_bank_base[2]-1U);
+                        }
+                        if (pin == rp1_bank_base[2]) {
+                            (void)printf("BANK2 (GPIO %u to %u):\n", rp1_bank_base[2], GPIO_MAX);
+                        }
+                    } else if ((pin_mask & (1UL << pin)) == 0UL) {
+                        continue;
+                    }
+                    gpio_get(pin, &req.pin[pin]);
                 }
-                if (pin == rp1_bank_base[1]) {
-                    (void)printf("BANK1 (GPIO %u to %u):\n", rp1_bank_base[1], rp1_bank_base[2]-1U);
-                }
-                if (pin == rp1_bank_base[2]) {
-                    (void)printf("BANK2 (GPIO %u to %u):\n", rp1_bank_base[2], GPIO_MAX);
-                }
-            } else if ((pin_mask & (1UL << pin)) == 0UL) {
-                continue;
             }
-            if (get) {
-                gpio_get(pin);
-            } else {
-                gpio_set(pin, func_sel, drive, pull);
+        } else {
+            set_req.mask = pin_mask;
+            ret = gpio_set_pins(fd, &dev, &set_req);
+            if (ret == EOK) {
+                uint32_t pin;
+                for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+                    if ((set_req.nodrive & (1UL << pin)) != 0UL) {
+                        (void)printf("Can't set pin value, not an output: %u\n", pin);
+                    }
+                }
             }
         }
+
+        gpio_close(&dev, fd);
+
+        if (ret != EOK) {
+            (void)printf("Error: GPIO request failed: %s\n", strerror (ret));
+            return EXIT_FAILURE;
+        }
     }
 
     return EXIT_SUCCESS;
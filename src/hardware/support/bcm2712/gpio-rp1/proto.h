@@ -0,0 +1,196 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef _PROTO_H_INCLUDED
+#define _PROTO_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/slog.h>
+#include <sys/slogcodes.h>
+
+struct gpio_ocb_;
+#define IOFUNC_OCB_T      struct gpio_ocb_
+#include <sys/iofunc.h>
+#include <sys/dispatch.h>
+#include <hw/dcmd_gpio_rp1.h>
+
+extern int32_t verbose;
+
+#define RESMGR_NAME                "gpio-rp1"
+
+#define RP1_GPIO_BASE              (0x1f000d0000UL)
+#define RP1_IO_BANK0_OFFSET        (0x00000000U)
+#define RP1_IO_BANK1_OFFSET        (0x00004000U)
+#define RP1_IO_BANK2_OFFSET        (0x00008000U)
+#define RP1_SYS_RIO_BANK0_OFFSET   (0x00010000U)
+#define RP1_SYS_RIO_BANK1_OFFSET   (0x00014000U)
+#define RP1_SYS_RIO_BANK2_OFFSET   (0x00018000U)
+#define RP1_PADS_BANK0_OFFSET      (0x00020000U)
+#define RP1_PADS_BANK1_OFFSET      (0x00024000U)
+#define RP1_PADS_BANK2_OFFSET      (0x00028000U)
+
+#define BLOCK_SIZE                 (0x2c000)
+
+#define DRIVE_UNSET       (RP1_GPIO_UNSET)
+#define DRIVE_LOW         (RP1_GPIO_DRIVE_LOW)
+#define DRIVE_HIGH        (RP1_GPIO_DRIVE_HIGH)
+
+#define PULL_UNSET        (RP1_GPIO_UNSET)
+#define PULL_NONE         (RP1_GPIO_PULL_NONE)
+#define PULL_DOWN         (RP1_GPIO_PULL_DOWN)
+#define PULL_UP           (RP1_GPIO_PULL_UP)
+
+#define FUNC_UNSET        (RP1_GPIO_UNSET)
+#define FUNC_A0           (0U)
+#define FUNC_A1           (1U)
+#define FUNC_A2           (2U)
+#define FUNC_A3           (3U)
+#define FUNC_A4           (4U)
+#define FUNC_A5           (5U)
+#define RP1_FSEL_SYS_RIO  (FUNC_A5)
+#define FUNC_A6           (6U)
+#define FUNC_A7           (7U)
+#define FUNC_A8           (8U)
+#define NUM_ALT_FUNCS     (9U)
+#define FUNC_SEL_MASK     (0x1fU)
+#define FUNC_NULL         (RP1_GPIO_FUNC_NONE)
+
+#define FUNC_IP           (RP1_GPIO_FUNC_IP)
+#define FUNC_OP           (RP1_GPIO_FUNC_OP)
+#define FUNC_GP           (RP1_GPIO_FUNC_GP)
+
+#define GPIO_MIN          (0U)
+#define GPIO_MAX          (RP1_GPIO_NUM)
+
+#define RP1_PADS_OD_SET   (1U << 7)
+#define RP1_PADS_IE_SET   (1U << 6)
+#define RP1_PADS_PUE_SET  (1U << 3)
+#define RP1_PADS_PDE_SET  (1U << 2)
+
+/* RP1 GPIO io read*/
+#define RP1_GPIO_IO_REG_STATUS_OFFSET(offset) ((((offset) * 2U) + 0U) * sizeof(uint32_t))
+#define RP1_GPIO_IO_REG_CTRL_OFFSET(offset)   ((((offset) * 2U) + 1U) * sizeof(uint32_t))
+
+/* RP1 GPIO pads read*/
+#define RP1_GPIO_PADS_REG_OFFSET(offset)      (sizeof(uint32_t) + ((offset) * sizeof(uint32_t)))
+
+/* RP1 GPIO sys_io read*/
+#define RP1_GPIO_SYS_RIO_REG_OUT_OFFSET        (0x0U)
+#define RP1_GPIO_SYS_RIO_REG_OE_OFFSET         (0x4U)
+#define RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET    (0x8U)
+
+/* RP1 GPIO io interrupts */
+#define RP1_GPIO_IO_REG_INTE_OFFSET            (0x11cU)
+#define RP1_GPIO_IO_REG_INTS_OFFSET            (0x124U)
+#define RP1_GPIO_CTRL_F_M_SHIFT                (5U)
+#define RP1_GPIO_CTRL_F_M_MASK                 (0x7fU << RP1_GPIO_CTRL_F_M_SHIFT)
+#define RP1_GPIO_CTRL_IRQ_SHIFT                (20U)     /* edge low, edge high, level low, level high */
+#define RP1_GPIO_CTRL_IRQ_DB_SHIFT             (24U)     /* same, on the filtered input */
+#define RP1_GPIO_CTRL_IRQ_MASK                 (0xffU << RP1_GPIO_CTRL_IRQ_SHIFT)
+#define RP1_GPIO_CTRL_IRQRESET                 (1U << 28)
+
+/* RP1 PCIe MSI-X configuration, the GPIO banks use vectors 0 to 2 */
+#define RP1_PCIE_MSIX_CFG_BASE                 (0x1f00108000UL)
+#define RP1_PCIE_MSIX_CFG_SIZE                 (0x1000U)
+#define RP1_PCIE_MSIX_CFG(irq)                 (0x08U + ((irq) * 0x04U))
+#define RP1_PCIE_MSIX_CFG_SET_OFFSET           (0x800U)
+#define RP1_PCIE_MSIX_CFG_IACK                 (1U << 2)
+#define RP1_GPIO_GIC_IRQ(bank)                 (0xa0U + (bank))
+
+#define RP1_GPIO_EVENT_SLOTS                   (64U)
+
+#define RP1_RW_OFFSET     (0x0000U)
+#define RP1_XOR_OFFSET    (0x1000U)
+#define RP1_SET_OFFSET    (0x2000U)
+#define RP1_CLR_OFFSET    (0x3000U)
+
+#define _SLOGC_GPIO       _SLOG_SETCODE( _SLOG_SYSLOG, 0 )
+
+typedef struct rp1_gpio_ {
+    paddr_t       base;
+    uintptr_t     vbase;    /* IO, SYS_RIO and PADS banks */
+} rp1_gpio_t;
+
+typedef struct gpio_ocb_ {
+    iofunc_ocb_t        hdr;
+    uint64_t            pins;               /* pins watched through this ocb */
+    uint64_t            claimed;            /* pins reserved for this ocb */
+    int                 rcvid;              /* client to notify, -1 for none */
+    struct sigevent     event;
+    uint32_t            head;               /* next free slot */
+    uint32_t            cnt;
+    uint32_t            dropped;
+    rp1_gpio_event_t    slot[RP1_GPIO_EVENT_SLOTS];
+} gpio_ocb_t;
+
+extern const uint32_t rp1_bank_base[RP1_GPIO_BANKS];
+extern const uint32_t gpio_io_bank_offset[RP1_GPIO_BANKS];
+extern const uint32_t gpio_sys_rio_bank_offset[RP1_GPIO_BANKS];
+
+int rp1_gpio_init(rp1_gpio_t *dev);
+void rp1_gpio_deinit(rp1_gpio_t *dev);
+bool rp1_gpio_set_valid(const rp1_gpio_set_t *req);
+void rp1_gpio_get(const rp1_gpio_t *dev, rp1_gpio_get_t *req);
+void rp1_gpio_set(const rp1_gpio_t *dev, rp1_gpio_set_t *req);
+bool rp1_gpio_setmask_valid(const rp1_gpio_mask_t *req);
+uint64_t rp1_gpio_setmask_pins(const rp1_gpio_mask_t *req);
+void rp1_gpio_setmask(const rp1_gpio_t *dev, const rp1_gpio_mask_t *req);
+uint64_t rp1_gpio_levels(const rp1_gpio_t *dev);
+uint32_t rp1_bank_pins(const uint32_t bank);
+
+int rp1_gpio_event_init(rp1_gpio_t *dev, dispatch_t *dpp);
+void rp1_gpio_event_deinit(void);
+int rp1_gpio_notify(resmgr_context_t *ctp, gpio_ocb_t *ocb, const rp1_gpio_notify_t *req);
+void rp1_gpio_notify_release(gpio_ocb_t *ocb);
+void rp1_gpio_events_read(gpio_ocb_t *ocb, rp1_gpio_events_t *out);
+
+int rp1_gpio_capture_init(rp1_gpio_t *dev);
+void rp1_gpio_capture_deinit(void);
+int rp1_gpio_capture_start(gpio_ocb_t *ocb, const rp1_gpio_capture_t *req);
+int rp1_gpio_capture_stop(const gpio_ocb_t *ocb);
+
+int resmgr_loop_start(void);
+void resmgr_deinit(void);
+int resmgr_init(rp1_gpio_t *dev);
+
+#endif /* _PROTO_H_INCLUDED */
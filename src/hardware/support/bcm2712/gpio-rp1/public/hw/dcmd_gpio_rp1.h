@@ -0,0 +1,273 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+/*
+ *  dcmd_gpio_rp1.h   devctl definitions for the gpio-rp1 resource manager
+ *
+ */
+
+#ifndef __DCMD_GPIO_RP1_H_INCLUDED
+#define __DCMD_GPIO_RP1_H_INCLUDED
+
+#ifndef _DEVCTL_H_INCLUDED
+ #include <devctl.h>
+#endif
+
+#include <sys/siginfo.h>
+
+#include <_pack64.h>
+
+#define RP1_GPIO_DEV_NAME           "/dev/gpio-rp1"
+
+#define RP1_GPIO_NUM                54
+#define RP1_GPIO_ALL_MASK           ((1ULL << RP1_GPIO_NUM) - 1ULL)
+#define RP1_GPIO_BANKS              3       /* GPIO 0-27, 28-33 and 34-53 */
+
+#define RP1_GPIO_UNSET              0xffffffffU
+
+/* Pin functions */
+#define RP1_GPIO_FUNC_A0            0U      /* alternate functions 0 to 8 */
+#define RP1_GPIO_FUNC_A8            8U
+#define RP1_GPIO_FUNC_NONE          0x1fU   /* no function, input and output disabled */
+#define RP1_GPIO_FUNC_IP            20U     /* GPIO input */
+#define RP1_GPIO_FUNC_OP            21U     /* GPIO output */
+#define RP1_GPIO_FUNC_GP            22U     /* GPIO, direction unchanged */
+
+/* Pad pulls */
+#define RP1_GPIO_PULL_NONE          0U
+#define RP1_GPIO_PULL_DOWN          1U
+#define RP1_GPIO_PULL_UP            2U
+
+/* Output levels */
+#define RP1_GPIO_DRIVE_LOW          0U
+#define RP1_GPIO_DRIVE_HIGH         1U
+
+typedef struct _rp1_gpio_pin {
+    _Uint8t         func;                   /* RP1_GPIO_FUNC_*, GPIO pins report IP or OP */
+    _Uint8t         pull;                   /* RP1_GPIO_PULL_* */
+    _Int8t          level;                  /* 0 or 1, -1 if the pad input is disabled */
+    _Uint8t         rsvd;
+} rp1_gpio_pin_t;
+
+/*
+ * DCMD_GPIO_RP1_GET: state of the pins in mask, other entries are left as
+ * supplied.
+ */
+typedef struct _rp1_gpio_get {
+    _Uint64t        mask;                   /* bit n selects GPIO n */
+    rp1_gpio_pin_t  pin[RP1_GPIO_NUM];
+} rp1_gpio_get_t;
+
+/*
+ * DCMD_GPIO_RP1_SET: apply the function, then the output level, then the pull
+ * to every pin in mask. Fields set to RP1_GPIO_UNSET are left unchanged. The
+ * level is only applied to pins that are GPIO outputs, the others are
+ * returned in nodrive.
+ */
+typedef struct _rp1_gpio_set {
+    _Uint64t        mask;                   /* bit n selects GPIO n */
+    _Uint32t        func;                   /* RP1_GPIO_FUNC_* */
+    _Uint32t        pull;                   /* RP1_GPIO_PULL_* */
+    _Uint32t        drive;                  /* RP1_GPIO_DRIVE_* */
+    _Uint32t        rsvd;
+    _Uint64t        nodrive;                /* out: pins whose level was not set */
+} rp1_gpio_set_t;
+
+typedef struct _rp1_gpio_bank_mask {
+    _Uint32t        set;
+    _Uint32t        clr;
+    _Uint32t        toggle;
+    _Uint32t        rsvd;
+} rp1_gpio_bank_mask_t;
+
+/*
+ * DCMD_GPIO_RP1_SETMASK: update the SYS_RIO output or output enable register
+ * of each bank. The masks of a bank are applied as clear, set, then toggle,
+ * with a single store to the toggle alias of the register, so all the bits of
+ * the bank change together; bits outside the masks are not written. Bit n of
+ * a bank mask is the n-th GPIO of the bank.
+ * Only pins whose function is GPIO follow these registers.
+ */
+typedef struct _rp1_gpio_mask {
+#define RP1_GPIO_MASK_OUT           0U
+#define RP1_GPIO_MASK_OE            1U
+    _Uint32t                reg;            /* RP1_GPIO_MASK_* */
+    _Uint32t                rsvd;
+    rp1_gpio_bank_mask_t    bank[RP1_GPIO_BANKS];
+} rp1_gpio_mask_t;
+
+/*
+ * DCMD_GPIO_RP1_LEVELS: synchronised input level of all pins, read with one
+ * load per bank. Bit n is GPIO n, pins with the pad input disabled read 0.
+ */
+typedef struct _rp1_gpio_levels {
+    _Uint64t        levels;
+} rp1_gpio_levels_t;
+
+/* Interrupt triggers */
+#define RP1_GPIO_TRIG_FALLING       0x01U
+#define RP1_GPIO_TRIG_RISING        0x02U
+#define RP1_GPIO_TRIG_LOW           0x04U   /* level, one shot */
+#define RP1_GPIO_TRIG_HIGH          0x08U   /* level, one shot */
+#define RP1_GPIO_TRIG_BOTH          (RP1_GPIO_TRIG_FALLING | RP1_GPIO_TRIG_RISING)
+#define RP1_GPIO_TRIG_MASK          0x0fU
+
+#define RP1_GPIO_DEBOUNCE_MAX       127U
+
+/*
+ * DCMD_GPIO_RP1_NOTIFY: watch the pins in mask through this file descriptor,
+ * or stop watching them when trigger is 0. The pin triggers are reprogrammed,
+ * the file descriptor must be open for writing (EPERM otherwise). A pin is watched by one file
+ * descriptor at a time, EBUSY is returned for pins watched by another. A non
+ * zero debounce is the filter time constant of the pins, the triggers then
+ * act on the filtered input.
+ *
+ * Events are queued on the file descriptor and event is delivered when the
+ * queue stops being empty, read them with DCMD_GPIO_RP1_EVENTS until fewer
+ * than RP1_GPIO_EVENTS_MAX are returned. event replaces the one registered
+ * before, SIGEV_NONE stops the deliveries but keeps the pins watched. Level
+ * triggers disarm the pin when they fire, notify again to re-arm it once the
+ * level has been dealt with.
+ *
+ * The interrupts are handled on the resource manager thread, an event carries
+ * the time that thread dispatched it rather than the time of the edge. The
+ * difference is the interrupt to dispatch latency, it grows when the thread is
+ * busy with other messages or preempted.
+ */
+typedef struct _rp1_gpio_notify {
+    _Uint64t        mask;                   /* bit n selects GPIO n */
+    _Uint32t        trigger;                /* RP1_GPIO_TRIG_* */
+    _Uint32t        debounce;               /* 0 to RP1_GPIO_DEBOUNCE_MAX */
+    struct sigevent event;
+} rp1_gpio_notify_t;
+
+typedef struct _rp1_gpio_event {
+    _Uint64t        timestamp;              /* ClockCycles() when the interrupt was dispatched */
+    _Uint8t         pin;
+    _Int8t          level;                  /* input level when the interrupt was dispatched */
+    _Uint16t        rsvd[3];
+} rp1_gpio_event_t;
+
+#define RP1_GPIO_EVENTS_MAX         32
+
+/*
+ * DCMD_GPIO_RP1_EVENTS: take the oldest queued events. dropped counts the
+ * events lost to a full queue since the previous read.
+ */
+typedef struct _rp1_gpio_events {
+    _Uint32t            nevents;
+    _Uint32t            dropped;
+    rp1_gpio_event_t    event[RP1_GPIO_EVENTS_MAX];
+} rp1_gpio_events_t;
+
+/*
+ * DCMD_GPIO_RP1_CLAIM: reserve the pins in mask for this file descriptor,
+ * replacing its previous claim (0 releases it). The pins must be GPIO inputs
+ * or outputs. Claimed pins are refused to SET and SETMASK requests from other
+ * file descriptors, EBUSY is returned for pins claimed by another. Closing the
+ * file descriptor releases the claim. See <hw/rio_rp1.h> for the library
+ * driving claimed pins through their SYS_RIO registers.
+ */
+typedef struct _rp1_gpio_claim {
+    _Uint64t        mask;                   /* bit n selects GPIO n */
+} rp1_gpio_claim_t;
+
+#define RP1_GPIO_CAPTURE_SHM        "/gpio-rp1-capture"
+#define RP1_GPIO_CAPTURE_SLOTS      65536
+#define RP1_GPIO_CAPTURE_MAGIC      0x31504143  /* "CAP1" */
+
+/*
+ * DCMD_GPIO_RP1_CAPTURE_START: sample the SYS_RIO SYNC_IN registers of the
+ * banks holding the pins in mask from a dedicated thread, every period_ns or
+ * back to back when period_ns is 0. The thread spins between samples, give it
+ * a CPU of its own through runmask. A periodic capture may leave runmask 0 to
+ * run anywhere, a back to back one never yields and must have a runmask:
+ * EINVAL is returned without one or when runmask names CPUs that don't exist.
+ * prio 0 keeps the priority of the resource manager. Only the first sample
+ * and the samples where a pin of mask changed are stored, in the shared
+ * memory ring RP1_GPIO_CAPTURE_SHM which clients map read-only; it is kept
+ * after the capture ends. One capture runs at a time, EBUSY is returned while another
+ * file descriptor runs one. DCMD_GPIO_RP1_CAPTURE_STOP or closing the file
+ * descriptor ends it.
+ */
+typedef struct _rp1_gpio_capture {
+    _Uint64t        mask;                   /* bit n selects GPIO n */
+    _Uint32t        period_ns;
+    _Uint32t        prio;
+    _Uint32t        runmask;
+    _Uint32t        rsvd;
+} rp1_gpio_capture_t;
+
+typedef struct _rp1_gpio_sample {
+    _Uint64t        timestamp;              /* ClockCycles() when the registers were read */
+    _Uint64t        levels;                 /* bit n is GPIO n, pins outside of mask read 0 */
+} rp1_gpio_sample_t;
+
+/*
+ * Sample n (n >= 1) is stored in slot[(n - 1) % nslots]; seq is the number
+ * of the latest complete sample and is reset when a capture starts. Slots are
+ * not locked: a reader copies samples up to seq and then checks that seq has
+ * not moved nslots or more past the first one copied, otherwise it was
+ * overwritten during the copy.
+ */
+typedef struct _rp1_gpio_capture_ring {
+    _Uint32t            magic;
+    _Uint32t            nslots;
+    _Uint64t            mask;               /* pins of the current or last capture */
+    _Uint64t            cycles_per_sec;     /* ClockCycles() rate */
+    volatile _Uint64t   seq;
+    volatile _Uint32t   running;
+    _Uint32t            rsvd;
+    rp1_gpio_sample_t   slot[RP1_GPIO_CAPTURE_SLOTS];
+} rp1_gpio_capture_ring_t;
+
+#define DCMD_GPIO_RP1_GET           (__DIOTF(_DCMD_MISC, 0x01, struct _rp1_gpio_get))
+#define DCMD_GPIO_RP1_SET           (__DIOTF(_DCMD_MISC, 0x02, struct _rp1_gpio_set))
+#define DCMD_GPIO_RP1_SETMASK       (__DIOT(_DCMD_MISC, 0x03, struct _rp1_gpio_mask))
+#define DCMD_GPIO_RP1_LEVELS        (__DIOF(_DCMD_MISC, 0x04, struct _rp1_gpio_levels))
+#define DCMD_GPIO_RP1_NOTIFY        (__DIOT(_DCMD_MISC, 0x05, struct _rp1_gpio_notify))
+#define DCMD_GPIO_RP1_EVENTS        (__DIOF(_DCMD_MISC, 0x06, struct _rp1_gpio_events))
+#define DCMD_GPIO_RP1_CLAIM         (__DIOT(_DCMD_MISC, 0x07, struct _rp1_gpio_claim))
+#define DCMD_GPIO_RP1_CAPTURE_START (__DIOT(_DCMD_MISC, 0x08, struct _rp1_gpio_capture))
+#define DCMD_GPIO_RP1_CAPTURE_STOP  (__DION(_DCMD_MISC, 0x09))
+
+#include <_packpop.h>
+
+#endif
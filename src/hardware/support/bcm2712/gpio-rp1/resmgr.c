@@ -0,0 +1,428 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic.h>
+#include "proto.h"
+#include <sys/resmgr.h>
+
+struct resmgr_;
+
+typedef struct resmgr_ {
+    iofunc_attr_t           iofunc_attr;
+    dispatch_t             *dpp;
+    dispatch_context_t     *ctp;
+    resmgr_connect_funcs_t  connect_funcs;
+    resmgr_io_funcs_t       io_funcs;
+    iofunc_funcs_t          ocb_funcs;
+    iofunc_mount_t          mount;
+    int                     id;
+    rp1_gpio_t             *dev;
+    gpio_ocb_t             *claim[GPIO_MAX];
+    volatile unsigned       done;
+} resmgr_t;
+
+static resmgr_t resmgr = { .id = -1 };
+
+static void sig_handler(const int signo)
+{
+    (void) signo;
+    atomic_set(&resmgr.done, 1);
+    dispatch_unblock(resmgr.ctp);
+}
+
+static void sig_init(void)
+{
+    struct sigaction sa = { 0 };
+
+    /* Register exit handler */
+    (void)sigemptyset(&sa.sa_mask);
+    (void)sigaddset(&sa.sa_mask, SIGTERM);
+    sa.sa_handler = sig_handler;
+    sa.sa_flags = SA_SIGINFO;
+    (void)sigaction(SIGTERM, &sa, NULL);
+}
+
+static gpio_ocb_t *gpio_ocb_calloc(resmgr_context_t *ctp, iofunc_attr_t *attr)
+{
+    gpio_ocb_t  *ocb;
+
+    (void)ctp;
+    (void)attr;
+
+    ocb = calloc(1, sizeof(*ocb));
+    if (ocb != NULL) {
+        ocb->rcvid = -1;
+    }
+
+    return ocb;
+}
+
+/* Pins of mask claimed by another ocb */
+static bool gpio_claimed(const gpio_ocb_t *ocb, const uint64_t mask)
+{
+    uint32_t pin;
+
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if (((mask & (1ULL << pin)) != 0ULL) && (resmgr.claim[pin] != NULL) && (resmgr.claim[pin] != ocb)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int gpio_claim(gpio_ocb_t *ocb, const uint64_t mask)
+{
+    rp1_gpio_get_t state = { .mask = mask };
+    uint32_t pin;
+
+    if ((mask & ~RP1_GPIO_ALL_MASK) != 0ULL) {
+        return EINVAL;
+    }
+    if (gpio_claimed(ocb, mask)) {
+        return EBUSY;
+    }
+
+    /* Only GPIO pins follow the SYS_RIO registers */
+    rp1_gpio_get(resmgr.dev, &state);
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if (((mask & (1ULL << pin)) != 0ULL) && (state.pin[pin].func != FUNC_IP) && (state.pin[pin].func != FUNC_OP)) {
+            return EINVAL;
+        }
+    }
+
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((mask & (1ULL << pin)) != 0ULL) {
+            resmgr.claim[pin] = ocb;
+        } else if (resmgr.claim[pin] == ocb) {
+            resmgr.claim[pin] = NULL;
+        }
+    }
+    ocb->claimed = mask;
+
+    return EOK;
+}
+
+static void gpio_ocb_free(gpio_ocb_t *ocb)
+{
+    /* Closing the file descriptor stops watching its pins, its capture and releases its claim */
+    rp1_gpio_notify_release(ocb);
+    (void)rp1_gpio_capture_stop(ocb);
+    (void)gpio_claim(ocb, 0ULL);
+    free(ocb);
+}
+
+/*
+ * The devctl data must have arrived with the message, the requests are far
+ * smaller than the receive buffer.
+ */
+static int devctl_data_check(const resmgr_context_t *ctp, const io_devctl_t *msg, const size_t size)
+{
+    if (msg->i.nbytes < size) {
+        return EINVAL;
+    }
+    if ((size_t)ctp->info.msglen < (sizeof(msg->i) + size)) {
+        return EBADMSG;
+    }
+    return EOK;
+}
+
+static int io_devctl(resmgr_context_t *ctp, io_devctl_t *msg, RESMGR_OCB_T *ocb)
+{
+    int         status;
+    size_t      nbytes = 0;
+    void        *data;
+
+    status = iofunc_devctl_default(ctp, msg, ocb);
+    if (status != _RESMGR_DEFAULT) {
+        return status;
+    }
+
+    data = _DEVCTL_DATA(msg->i);
+
+    switch (msg->i.dcmd) {
+        case DCMD_GPIO_RP1_GET:
+        {
+            rp1_gpio_get_t *const get = data;
+
+            status = devctl_data_check(ctp, msg, sizeof(*get));
+            if (status != EOK) {
+                return status;
+            }
+            if ((get->mask & ~RP1_GPIO_ALL_MASK) != 0ULL) {
+                return EINVAL;
+            }
+            rp1_gpio_get(resmgr.dev, get);
+            nbytes = sizeof(*get);
+            break;
+        }
+        case DCMD_GPIO_RP1_SET:
+        {
+            rp1_gpio_set_t *const set = data;
+
+            if ((ocb->hdr.ioflag & _IO_FLAG_WR) == 0) {
+                return EPERM;
+            }
+            status = devctl_data_check(ctp, msg, sizeof(*set));
+            if (status != EOK) {
+                return status;
+            }
+            if (!rp1_gpio_set_valid(set)) {
+                return EINVAL;
+            }
+            if (gpio_claimed(ocb, set->mask)) {
+                return EBUSY;
+            }
+            if (verbose > 0) {
+                (void)slogf(_SLOGC_GPIO, _SLOG_DEBUG1, "%s set mask 0x%lx func %u pull %u drive %u", __func__,
+                        set->mask, set->func, set->pull, set->drive);
+            }
+            rp1_gpio_set(resmgr.dev, set);
+            nbytes = sizeof(*set);
+            break;
+        }
+        case DCMD_GPIO_RP1_SETMASK:
+        {
+            const rp1_gpio_mask_t *const mask = data;
+
+            if ((ocb->hdr.ioflag & _IO_FLAG_WR) == 0) {
+                return EPERM;
+            }
+            status = devctl_data_check(ctp, msg, sizeof(*mask));
+            if (status != EOK) {
+                return status;
+            }
+            if (!rp1_gpio_setmask_valid(mask)) {
+                return EINVAL;
+            }
+            if (gpio_claimed(ocb, rp1_gpio_setmask_pins(mask))) {
+                return EBUSY;
+            }
+            rp1_gpio_setmask(resmgr.dev, mask);
+            break;
+        }
+        case DCMD_GPIO_RP1_LEVELS:
+        {
+            rp1_gpio_levels_t *const levels = data;
+
+            if (msg->i.nbytes < sizeof(*levels)) {
+                return EINVAL;
+            }
+            levels->levels = rp1_gpio_levels(resmgr.dev);
+            nbytes = sizeof(*levels);
+            break;
+        }
+        case DCMD_GPIO_RP1_CLAIM:
+        {
+            const rp1_gpio_claim_t *const claim = data;
+
+            if ((ocb->hdr.ioflag & _IO_FLAG_WR) == 0) {
+                return EPERM;
+            }
+            status = devctl_data_check(ctp, msg, sizeof(*claim));
+            if (status != EOK) {
+                return status;
+            }
+            status = gpio_claim(ocb, claim->mask);
+            if (status != EOK) {
+                return status;
+            }
+            break;
+        }
+        case DCMD_GPIO_RP1_NOTIFY:
+        {
+            const rp1_gpio_notify_t *const notify = data;
+
+            if ((ocb->hdr.ioflag & _IO_FLAG_WR) == 0) {
+                return EPERM;
+            }
+            status = devctl_data_check(ctp, msg, sizeof(*notify));
+            if (status != EOK) {
+                return status;
+            }
+            status = rp1_gpio_notify(ctp, ocb, notify);
+            if (status != EOK) {
+                return status;
+            }
+            break;
+        }
+        case DCMD_GPIO_RP1_EVENTS:
+        {
+            rp1_gpio_events_t *const events = data;
+
+            if (msg->i.nbytes < sizeof(*events)) {
+                return EINVAL;
+            }
+            rp1_gpio_events_read(ocb, events);
+            nbytes = sizeof(*events);
+            break;
+        }
+        case DCMD_GPIO_RP1_CAPTURE_START:
+        {
+            const rp1_gpio_capture_t *const capture = data;
+
+            if ((ocb->hdr.ioflag & _IO_FLAG_WR) == 0) {
+                return EPERM;
+            }
+            status = devctl_data_check(ctp, msg, sizeof(*capture));
+            if (status != EOK) {
+                return status;
+            }
+            status = rp1_gpio_capture_start(ocb, capture);
+            if (status != EOK) {
+                return status;
+            }
+            break;
+        }
+        case DCMD_GPIO_RP1_CAPTURE_STOP:
+        {
+            status = rp1_gpio_capture_stop(ocb);
+            if (status != EOK) {
+                return status;
+            }
+            break;
+        }
+        default:
+            return ENOTTY;
+    }
+
+    (void)memset(&msg->o, 0, sizeof(msg->o));
+    msg->o.nbytes = nbytes;
+    return _RESMGR_PTR(ctp, &msg->o, sizeof(msg->o) + nbytes);
+}
+
+int resmgr_loop_start(void)
+{
+    /* allocate a context structure */
+    resmgr.ctp = dispatch_context_alloc(resmgr.dpp);
+    if (resmgr.ctp == NULL) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s Couldn't allocate dispatch context, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    /*
+     * Requests are handled one at a time by this thread, which serializes the
+     * read-modify-write sequences on the control and pad registers.
+     */
+    while (!resmgr.done) {
+        if (resmgr.ctp == dispatch_block(resmgr.ctp)) {
+            (void)dispatch_handler(resmgr.ctp);
+        }
+        else if (errno != EFAULT) {
+            atomic_set(&resmgr.done, 1);
+        }
+    }
+    return EOK;
+}
+
+void resmgr_deinit(void)
+{
+    rp1_gpio_event_deinit();
+    rp1_gpio_capture_deinit();
+    if (resmgr.id != -1) {
+        if (resmgr_detach(resmgr.dpp, resmgr.id, 0) == -1) {
+            (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s Failed to remove pathname from the pathname space", __func__);
+        }
+        resmgr.id = -1;
+    }
+}
+
+int resmgr_init(rp1_gpio_t *dev)
+{
+    resmgr.dev = dev;
+
+    /* Single_instance. Ensure that the resource manager is not already running */
+    if (name_attach(NULL, RESMGR_NAME, 0) == NULL) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s Is '%s' already started?", __func__, RESMGR_NAME);
+        return errno;
+    }
+
+    /* allocate and initialize a dispatch structure for use by our main loop */
+    resmgr.dpp = dispatch_create();
+    if (resmgr.dpp == NULL) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s Couldn't dispatch_create, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    /*
+     * Intialize the connect functions and I/O functions tables to their defaults and then
+     * override the defaults with the functions that we are providing.
+     */
+    iofunc_func_init(_RESMGR_CONNECT_NFUNCS, &resmgr.connect_funcs, _RESMGR_IO_NFUNCS,
+            &resmgr.io_funcs);
+
+    resmgr.io_funcs.devctl = io_devctl;
+
+    resmgr.ocb_funcs.nfuncs     = _IOFUNC_NFUNCS;
+    resmgr.ocb_funcs.ocb_calloc = gpio_ocb_calloc;
+    resmgr.ocb_funcs.ocb_free   = gpio_ocb_free;
+    resmgr.mount.funcs          = &resmgr.ocb_funcs;
+
+    iofunc_attr_init(&resmgr.iofunc_attr, S_IFCHR | 0660, NULL, NULL);
+    resmgr.iofunc_attr.mount = &resmgr.mount;
+    resmgr.id = resmgr_attach(resmgr.dpp,        /* dispatch handle        */
+                       NULL,                     /* resource manager attrs */
+                       RP1_GPIO_DEV_NAME,        /* device name            */
+                       _FTYPE_ANY,               /* open type              */
+                       0,                        /* flags                  */
+                       &resmgr.connect_funcs,    /* connect routines       */
+                       &resmgr.io_funcs,         /* I/O routines           */
+                       &resmgr.iofunc_attr);     /* handle                 */
+    if (resmgr.id == -1) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_ERROR, "%s Couldn't attach pathname, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    /* Pins can still be configured when the interrupts are not available */
+    if (rp1_gpio_event_init(dev, resmgr.dpp) != EOK) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_WARNING, "%s GPIO interrupts unavailable, pins can't be watched", __func__);
+    }
+    if (rp1_gpio_capture_init(dev) != EOK) {
+        (void)slogf(_SLOGC_GPIO, _SLOG_WARNING, "%s capture ring unavailable, pins can't be captured", __func__);
+    }
+
+    sig_init();
+
+    return EOK;
+}
@@ -0,0 +1,391 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <hw/inout.h>
+#include "proto.h"
+
+const uint32_t rp1_bank_base[RP1_GPIO_BANKS] = {0, 28, 34};
+
+const uint32_t gpio_io_bank_offset[RP1_GPIO_BANKS] = { RP1_IO_BANK0_OFFSET, RP1_IO_BANK1_OFFSET, RP1_IO_BANK2_OFFSET };
+static const uint32_t gpio_pads_bank_offset[] = { RP1_PADS_BANK0_OFFSET, RP1_PADS_BANK1_OFFSET, RP1_PADS_BANK2_OFFSET };
+const uint32_t gpio_sys_rio_bank_offset[RP1_GPIO_BANKS] = { RP1_SYS_RIO_BANK0_OFFSET, RP1_SYS_RIO_BANK1_OFFSET, RP1_SYS_RIO_BANK2_OFFSET };
+
+/* gpio must be below GPIO_MAX, requests are validated before they get here */
+static void rp1_gpio_get_bank_offset(const uint32_t gpio, uint32_t *bank, uint32_t *offset)
+{
+    if (gpio < rp1_bank_base[1]) {
+        *bank = 0;
+    }
+    else if (gpio < rp1_bank_base[2]) {
+        *bank = 1;
+    }
+    else {
+        *bank = 2;
+    }
+
+    *offset = gpio - rp1_bank_base[*bank];
+}
+
+static void set_gpio_dir(const rp1_gpio_t *dev, const uint32_t gpio, const uint32_t dir)
+{
+    uint32_t bank, offset;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    if (dir == FUNC_IP) {
+        out32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_CLR_OFFSET, (1u << offset));
+    }
+    else if (dir == FUNC_OP) {
+        out32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET + RP1_SET_OFFSET, (1u << offset));
+    }
+}
+
+static uint32_t get_gpio_dir(const rp1_gpio_t *dev, const uint32_t gpio)
+{
+    uint32_t bank, offset;
+    uint32_t sys_rio_oe_read;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    sys_rio_oe_read = in32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OE_OFFSET);
+
+    if (sys_rio_oe_read & (1U << offset)) {
+        return FUNC_OP;
+    }
+    else {
+        return FUNC_IP;
+    }
+}
+
+static uint32_t get_gpio_fsel(const rp1_gpio_t *dev, const uint32_t gpio)
+{
+    uint32_t bank, offset;
+    uint32_t io_val;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    io_val = in32(dev->vbase + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset));
+    io_val &= FUNC_SEL_MASK;
+    if (io_val == RP1_FSEL_SYS_RIO) {
+        return get_gpio_dir(dev, gpio); /* will return FUNC_IP or FUNC_OP */
+    }
+    return io_val;
+}
+
+static void set_gpio_fsel(const rp1_gpio_t *dev, const uint32_t gpio, uint32_t func_sel)
+{
+    uint32_t bank, offset;
+    uint32_t fsel;
+    uint32_t io_ctrl_val;
+    uint32_t orig_pad_val, pad_val;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+
+    if ((func_sel == FUNC_IP) || (func_sel == FUNC_OP)) {
+        set_gpio_dir(dev, gpio, func_sel);
+    }
+
+    if ((func_sel == FUNC_IP) || (func_sel == FUNC_OP) || (func_sel == FUNC_GP)) {
+        fsel = RP1_FSEL_SYS_RIO;
+    }
+    else {
+        fsel = func_sel;
+    }
+
+    io_ctrl_val = in32(dev->vbase + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset));
+    io_ctrl_val &= ~(FUNC_SEL_MASK);
+    io_ctrl_val |= (fsel & FUNC_SEL_MASK);
+    out32(dev->vbase + gpio_io_bank_offset[bank] + RP1_GPIO_IO_REG_CTRL_OFFSET(offset), io_ctrl_val);
+
+    pad_val = in32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
+    orig_pad_val = pad_val;
+    if (fsel == FUNC_NULL) {
+        // Disable input
+        pad_val &= ~RP1_PADS_IE_SET;
+        // Disable peripheral func output
+        pad_val |= RP1_PADS_OD_SET;
+    }
+    else {
+        // Enable input
+        pad_val |= RP1_PADS_IE_SET;
+        // Enable peripheral func output
+        pad_val &= ~RP1_PADS_OD_SET;
+    }
+
+    if (pad_val != orig_pad_val) {
+        out32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset), pad_val);
+    }
+}
+
+static int get_gpio_level(const rp1_gpio_t *dev, const uint32_t gpio)
+{
+    uint32_t bank, offset;
+    uint32_t pad_val;
+    uint32_t sys_rio_sync_val;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    pad_val = in32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
+    if (!(pad_val & RP1_PADS_IE_SET)) {
+        return -1;
+    }
+    sys_rio_sync_val = in32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET);
+
+    return (sys_rio_sync_val & (1U << offset)) ? 1 : 0;
+}
+
+static void set_gpio_drive(const rp1_gpio_t *dev, const uint32_t gpio, const uint32_t drive)
+{
+    uint32_t bank, offset;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    if (drive == DRIVE_HIGH) {
+        out32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OUT_OFFSET + RP1_SET_OFFSET, (1u << offset));
+    }
+    else if (drive == DRIVE_LOW) {
+        out32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_OUT_OFFSET + RP1_CLR_OFFSET, (1u << offset));
+    }
+}
+
+/*
+ * type:
+ *   0 = no pull
+ *   1 = pull down
+ *   2 = pull up
+ */
+static void set_gpio_pull(const rp1_gpio_t *dev, const uint32_t gpio, const uint32_t type)
+{
+    uint32_t bank, offset;
+    uint32_t pad_val;
+
+    if (type <= PULL_UP) {
+        rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+        pad_val = in32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
+        pad_val &= ~(RP1_PADS_PDE_SET | RP1_PADS_PUE_SET);
+
+        if (type == PULL_UP) {
+            pad_val |= RP1_PADS_PUE_SET;
+        }
+        else if (type == PULL_DOWN) {
+            pad_val |= RP1_PADS_PDE_SET;
+        }
+
+        out32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset), pad_val);
+    }
+}
+
+static uint32_t get_gpio_pull(const rp1_gpio_t *dev, const uint32_t gpio)
+{
+    uint32_t pull = PULL_NONE;
+    uint32_t bank, offset;
+    uint32_t pad_val;
+
+    rp1_gpio_get_bank_offset(gpio, &bank, &offset);
+    pad_val = in32(dev->vbase + gpio_pads_bank_offset[bank] + RP1_GPIO_PADS_REG_OFFSET(offset));
+
+    if (pad_val & RP1_PADS_PUE_SET) {
+        pull = PULL_UP;
+    }
+    else if (pad_val & RP1_PADS_PDE_SET) {
+        pull = PULL_DOWN;
+    }
+
+    return pull;
+}
+
+bool rp1_gpio_set_valid(const rp1_gpio_set_t *req)
+{
+    if ((req->mask & ~RP1_GPIO_ALL_MASK) != 0ULL) {
+        return false;
+    }
+    if ((req->func != FUNC_UNSET) && (req->func > FUNC_A8) && (req->func != FUNC_NULL) &&
+            (req->func != FUNC_IP) && (req->func != FUNC_OP) && (req->func != FUNC_GP)) {
+        return false;
+    }
+    if ((req->pull != PULL_UNSET) && (req->pull > PULL_UP)) {
+        return false;
+    }
+    if ((req->drive != DRIVE_UNSET) && (req->drive > DRIVE_HIGH)) {
+        return false;
+    }
+
+    return true;
+}
+
+void rp1_gpio_get(const rp1_gpio_t *dev, rp1_gpio_get_t *req)
+{
+    uint32_t pin;
+
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((req->mask & (1ULL << pin)) == 0ULL) {
+            continue;
+        }
+        req->pin[pin].level = (int8_t)get_gpio_level(dev, pin);
+        req->pin[pin].pull = (uint8_t)get_gpio_pull(dev, pin);
+        req->pin[pin].func = (uint8_t)get_gpio_fsel(dev, pin);
+        req->pin[pin].rsvd = 0;
+    }
+}
+
+void rp1_gpio_set(const rp1_gpio_t *dev, rp1_gpio_set_t *req)
+{
+    uint32_t pin;
+
+    req->nodrive = 0ULL;
+    for (pin = GPIO_MIN; pin < GPIO_MAX; pin++) {
+        if ((req->mask & (1ULL << pin)) == 0ULL) {
+            continue;
+        }
+
+        /* set function */
+        if (req->func != FUNC_UNSET) {
+            set_gpio_fsel(dev, pin, req->func);
+        }
+
+        /* set output value (check pin is output first) */
+        if (req->drive != DRIVE_UNSET) {
+            if (get_gpio_fsel(dev, pin) == FUNC_OP) {
+                set_gpio_drive(dev, pin, req->drive);
+            } else {
+                req->nodrive |= (1ULL << pin);
+            }
+        }
+
+        /* set pulls */
+        if (req->pull != PULL_UNSET) {
+            set_gpio_pull(dev, pin, req->pull);
+        }
+    }
+}
+
+/* Pins of a bank in its SYS_RIO registers */
+uint32_t rp1_bank_pins(const uint32_t bank)
+{
+    const uint32_t end = (bank < (RP1_GPIO_BANKS - 1U)) ? rp1_bank_base[bank + 1U] : GPIO_MAX;
+    const uint32_t npins = end - rp1_bank_base[bank];
+
+    return (uint32_t)((1ULL << npins) - 1ULL);
+}
+
+bool rp1_gpio_setmask_valid(const rp1_gpio_mask_t *req)
+{
+    uint32_t bank;
+
+    if ((req->reg != RP1_GPIO_MASK_OUT) && (req->reg != RP1_GPIO_MASK_OE)) {
+        return false;
+    }
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        const rp1_gpio_bank_mask_t *const m = &req->bank[bank];
+        if (((m->set | m->clr | m->toggle) & ~rp1_bank_pins(bank)) != 0U) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* GPIO numbers of the pins a SETMASK request changes */
+uint64_t rp1_gpio_setmask_pins(const rp1_gpio_mask_t *req)
+{
+    uint64_t pins = 0ULL;
+    uint32_t bank;
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        const rp1_gpio_bank_mask_t *const m = &req->bank[bank];
+        pins |= (uint64_t)(m->set | m->clr | m->toggle) << rp1_bank_base[bank];
+    }
+
+    return pins;
+}
+
+void rp1_gpio_setmask(const rp1_gpio_t *dev, const rp1_gpio_mask_t *req)
+{
+    const uint32_t reg = (req->reg == RP1_GPIO_MASK_OE) ? RP1_GPIO_SYS_RIO_REG_OE_OFFSET : RP1_GPIO_SYS_RIO_REG_OUT_OFFSET;
+    uint32_t bank;
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        const rp1_gpio_bank_mask_t *const m = &req->bank[bank];
+        const uintptr_t addr = dev->vbase + gpio_sys_rio_bank_offset[bank] + reg;
+
+        if ((m->set | m->clr | m->toggle) == 0U) {
+            continue;
+        }
+
+        /* Clear, set, then toggle, as one store: the bits that end up different are flipped */
+        const uint32_t out = in32(addr);
+        const uint32_t delta = (((out & ~m->clr) | m->set) ^ m->toggle) ^ out;
+        if (delta != 0U) {
+            out32(addr + RP1_XOR_OFFSET, delta);
+        }
+    }
+}
+
+uint64_t rp1_gpio_levels(const rp1_gpio_t *dev)
+{
+    uint64_t levels = 0ULL;
+    uint32_t bank;
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        const uint32_t sync_in = in32(dev->vbase + gpio_sys_rio_bank_offset[bank] + RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET);
+        levels |= (uint64_t)(sync_in & rp1_bank_pins(bank)) << rp1_bank_base[bank];
+    }
+
+    return levels;
+}
+
+int rp1_gpio_init(rp1_gpio_t *dev)
+{
+    dev->base = RP1_GPIO_BASE;
+    dev->vbase = (uintptr_t) mmap_device_memory(NULL, BLOCK_SIZE, PROT_NOCACHE|PROT_READ|PROT_WRITE, 0, dev->base);
+    if (dev->vbase == (uintptr_t) MAP_FAILED) {
+        dev->vbase = 0;
+        return errno;
+    }
+
+    return EOK;
+}
+
+void rp1_gpio_deinit(rp1_gpio_t *dev)
+{
+    if (dev->vbase != 0) {
+        (void)munmap_device_memory((void *)dev->vbase, BLOCK_SIZE);
+        dev->vbase = 0;
+    }
+}
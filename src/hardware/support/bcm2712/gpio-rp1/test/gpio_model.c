@@ -0,0 +1,129 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "gpio_model.h"
+
+gpio_model_t gpio_model;
+int32_t verbose;
+
+static struct syspage_entry gpio_model_syspage;
+struct syspage_entry *_syspage_ptr = &gpio_model_syspage;
+
+void gpio_model_reset(void)
+{
+    gpio_model_fini();
+    (void)memset(&gpio_model, 0, sizeof(gpio_model));
+    gpio_model.regs = calloc(1, BLOCK_SIZE);
+    if (gpio_model.regs == NULL) {
+        (void)fprintf(stderr, "gpio_model: out of memory\n");
+        exit(1);
+    }
+    gpio_model_syspage.num_cpu = GPIO_MODEL_NUM_CPU;
+    gpio_model_syspage.qtime.cycles_per_sec = 1000000000ULL;
+}
+
+void gpio_model_fini(void)
+{
+    free(gpio_model.regs);
+    gpio_model.regs = NULL;
+}
+
+volatile uint32_t *gpio_model_sync_in(const unsigned bank)
+{
+    return (volatile uint32_t *)((uintptr_t)gpio_model.regs + gpio_sys_rio_bank_offset[bank] +
+                                 RP1_GPIO_SYS_RIO_REG_SYNC_IN_OFFSET);
+}
+
+uint64_t ClockCycles(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+int ThreadCtl(int cmd, void *data)
+{
+    if (cmd != _NTO_TCTL_RUNMASK) {
+        errno = EINVAL;
+        return -1;
+    }
+    gpio_model.runmask = (uint32_t)(uintptr_t)data;
+    gpio_model.runmask_calls++;
+    if (gpio_model.runmask_errno != 0) {
+        errno = gpio_model.runmask_errno;
+        return -1;
+    }
+    return 0;
+}
+
+int slogf(int opcode, int severity, const char *fmt, ...)
+{
+    (void)opcode;
+    (void)fmt;
+    if (severity <= _SLOG_ERROR) {
+        gpio_model.errors++;
+    }
+    return 0;
+}
+
+void *mmap_device_memory(void *addr, size_t len, int prot, int flags, uint64_t physical)
+{
+    (void)addr;
+    (void)prot;
+    (void)flags;
+    if (len > BLOCK_SIZE) {
+        errno = ENXIO;
+        return MAP_FAILED;
+    }
+    gpio_model.paddr = physical;
+    return gpio_model.regs;
+}
+
+int munmap_device_memory(void *addr, size_t len)
+{
+    (void)len;
+    return (addr == gpio_model.regs) ? 0 : -1;
+}
@@ -0,0 +1,81 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef GPIO_MODEL_H_INCLUDED
+#define GPIO_MODEL_H_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#include "proto.h"
+
+/*
+ * Host model of what the gpio-rp1 sources talk to. The RP1 GPIO block is
+ * plain memory handed out by mmap_device_memory(), the tests set the input
+ * levels in the SYNC_IN words. ClockCycles() is the host monotonic clock in
+ * ns and the syspage reports GPIO_MODEL_NUM_CPU CPUs. ThreadCtl() records
+ * the runmask a thread asks for and fails with runmask_errno when set.
+ */
+
+#define GPIO_MODEL_NUM_CPU      4U
+
+typedef struct {
+    void            *regs;
+    uint64_t        paddr;
+    volatile uint32_t runmask;          /* last _NTO_TCTL_RUNMASK */
+    volatile uint32_t runmask_calls;
+    int             runmask_errno;
+    volatile uint32_t errors;           /* slogf() at _SLOG_ERROR or worse */
+} gpio_model_t;
+
+extern gpio_model_t gpio_model;
+
+void gpio_model_reset(void);
+void gpio_model_fini(void);
+
+/* The SYNC_IN register of a bank */
+volatile uint32_t *gpio_model_sync_in(unsigned bank);
+
+#endif /* GPIO_MODEL_H_INCLUDED */
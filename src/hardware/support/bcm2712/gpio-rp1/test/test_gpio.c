@@ -0,0 +1,267 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+/*
+ * Regression tests of the capture thread (capture.c) against the model of
+ * the RP1 GPIO block.
+ *
+ *   test_gpio              run the tests
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "gpio_model.h"
+
+static uint32_t failures;
+
+#define CHECK(__cond) \
+    do { \
+        if (!(__cond)) { \
+            (void)fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #__cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/* GPIO 4 and 5, 40 */
+#define GPIO_TEST_PINS      ((1ULL << 4) | (1ULL << 5) | (1ULL << 40))
+
+static rp1_gpio_t           dev;
+static rp1_gpio_capture_ring_t *ring;
+
+static bool setup(void)
+{
+    int fd;
+
+    gpio_model_reset();
+    if ((rp1_gpio_init(&dev) != EOK) || (rp1_gpio_capture_init(&dev) != EOK)) {
+        (void)fprintf(stderr, "driver init failed\n");
+        return false;
+    }
+    /* Mapped as a client does */
+    fd = shm_open(RP1_GPIO_CAPTURE_SHM, O_RDONLY, 0);
+    ring = mmap(NULL, sizeof(*ring), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    return ring != MAP_FAILED;
+}
+
+static void teardown(void)
+{
+    (void)munmap(ring, sizeof(*ring));
+    rp1_gpio_capture_deinit();
+    rp1_gpio_deinit(&dev);
+    gpio_model_fini();
+}
+
+/* Wait up to a second for the thread to store a sample or to stop */
+static bool wait_seq(const uint64_t seq)
+{
+    uint32_t n;
+
+    for (n = 0; n < 1000U; n++) {
+        if (*(volatile uint64_t *)&ring->seq >= seq) {
+            return true;
+        }
+        (void)usleep(1000);
+    }
+    return false;
+}
+
+static bool wait_stopped(void)
+{
+    uint32_t n;
+
+    for (n = 0; n < 1000U; n++) {
+        if (*(volatile uint32_t *)&ring->running == 0U) {
+            return true;
+        }
+        (void)usleep(1000);
+    }
+    return false;
+}
+
+/* Rejected requests start no thread */
+static void test_capture_args(void)
+{
+    gpio_ocb_t              ocb = { .hdr.ioflag = _IO_FLAG_WR };
+    rp1_gpio_capture_t      req = { .mask = GPIO_TEST_PINS, .period_ns = 1000 };
+
+    if (!setup()) {
+        failures++;
+        return;
+    }
+
+    req.mask = 0ULL;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+    req.mask = 1ULL << RP1_GPIO_NUM;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+    req.mask = GPIO_TEST_PINS;
+
+    req.prio = 1000U;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+    req.prio = 0U;
+
+    /* Back to back without a CPU of its own */
+    req.period_ns = 0U;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+
+    /* CPUs the system doesn't have */
+    req.runmask = 1U << GPIO_MODEL_NUM_CPU;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+    req.period_ns = 1000U;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EINVAL);
+
+    CHECK(ring->running == 0U);
+    CHECK(gpio_model.runmask_calls == 0U);
+    CHECK(rp1_gpio_capture_stop(&ocb) == EOK);
+
+    teardown();
+}
+
+/* A back to back capture runs on its CPUs and stores the level changes */
+static void test_capture_back_to_back(void)
+{
+    gpio_ocb_t              ocb = { .hdr.ioflag = _IO_FLAG_WR };
+    gpio_ocb_t              other = { .hdr.ioflag = _IO_FLAG_WR };
+    const rp1_gpio_capture_t req = { .mask = GPIO_TEST_PINS, .period_ns = 0U, .runmask = 0x2U };
+
+    if (!setup()) {
+        failures++;
+        return;
+    }
+
+    *gpio_model_sync_in(0) = 0xffff0010U;
+    *gpio_model_sync_in(2) = 0U;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EOK);
+    CHECK(ring->running == 1U);
+    CHECK(ring->mask == GPIO_TEST_PINS);
+    CHECK(wait_seq(1ULL));
+    CHECK(gpio_model.runmask == 0x2U);
+    CHECK(ring->slot[0].levels == (1ULL << 4));
+
+    /* GPIO 40 is bit 6 of bank 2 */
+    *gpio_model_sync_in(2) = 1U << 6;
+    CHECK(wait_seq(2ULL));
+    CHECK(ring->slot[1].levels == ((1ULL << 4) | (1ULL << 40)));
+    CHECK(ring->slot[1].timestamp >= ring->slot[0].timestamp);
+
+    /* Unwatched pins don't store samples */
+    *gpio_model_sync_in(0) = 0x0fff0010U;
+    (void)usleep(10000);
+    CHECK(ring->seq == 2ULL);
+
+    CHECK(rp1_gpio_capture_start(&other, &req) == EBUSY);
+    CHECK(rp1_gpio_capture_stop(&other) == EBUSY);
+    CHECK(rp1_gpio_capture_stop(&ocb) == EOK);
+    CHECK(ring->running == 0U);
+    CHECK(gpio_model.errors == 0U);
+
+    teardown();
+}
+
+/* A back to back capture ends rather than spin unpinned, a periodic one goes on */
+static void test_capture_runmask_fails(void)
+{
+    gpio_ocb_t              ocb = { .hdr.ioflag = _IO_FLAG_WR };
+    rp1_gpio_capture_t      req = { .mask = GPIO_TEST_PINS, .period_ns = 0U, .runmask = 0x1U };
+
+    if (!setup()) {
+        failures++;
+        return;
+    }
+
+    gpio_model.runmask_errno = EPERM;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EOK);
+    CHECK(wait_stopped());
+    CHECK(ring->seq == 0ULL);
+    CHECK(gpio_model.errors == 1U);
+    CHECK(rp1_gpio_capture_stop(&ocb) == EOK);
+
+    req.period_ns = 100000U;
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EOK);
+    CHECK(wait_seq(1ULL));
+    CHECK(ring->running == 1U);
+    CHECK(gpio_model.errors == 1U);
+    CHECK(rp1_gpio_capture_stop(&ocb) == EOK);
+
+    teardown();
+}
+
+/* A periodic capture may run anywhere */
+static void test_capture_periodic(void)
+{
+    gpio_ocb_t              ocb = { .hdr.ioflag = _IO_FLAG_WR };
+    const rp1_gpio_capture_t req = { .mask = GPIO_TEST_PINS, .period_ns = 100000U };
+
+    if (!setup()) {
+        failures++;
+        return;
+    }
+
+    CHECK(rp1_gpio_capture_start(&ocb, &req) == EOK);
+    CHECK(wait_seq(1ULL));
+    CHECK(gpio_model.runmask_calls == 0U);
+    CHECK(rp1_gpio_capture_stop(&ocb) == EOK);
+
+    teardown();
+}
+
+static int run_tests(void)
+{
+    test_capture_args();
+    test_capture_back_to_back();
+    test_capture_runmask_fails();
+    test_capture_periodic();
+
+    if (failures != 0U) {
+        (void)printf("FAILED: %u checks\n", failures);
+        return 1;
+    }
+
+    (void)printf("all tests passed\n");
+    return 0;
+}
+
+int main(void)
+{
+    return run_tests();
+}
@@ -0,0 +1,399 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <drvr/hwinfo.h>
+#include "proto.h"
+
+typedef struct mbox_cache_def_ {
+    uint32_t        tag;
+    uint32_t        id;
+    uint32_t        size;               /* bytes of the value buffer */
+    uint32_t        ttl_ms;
+} mbox_cache_def_t;
+
+static const mbox_cache_def_t mbox_cache_defs[] = {
+    { .tag = MBOX_TAG_GET_FIRMWAREREV,      .id = 0, .size = 4,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_FIRMWAREVAR,      .id = 0, .size = 4,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_FIRMWAREHASH,     .id = 0, .size = 20, .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_BOARDMODEL,       .id = 0, .size = 4,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_BOARDREVISION,    .id = 0, .size = 4,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_MACADDRESS,       .id = 0, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_BOARDSERIAL,      .id = 0, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_ARMMEMORY,        .id = 0, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_VCMEMORY,         .id = 0, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_MAX_TEMPERATURE,  .id = 0, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_MIN_VOLTAGE,      .id = 1, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_MAX_VOLTAGE,      .id = 1, .size = 8,  .ttl_ms = 0 },
+    { .tag = MBOX_TAG_GET_TEMPERATURE,      .id = 0, .size = 8,  .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_THROTTLED,        .id = 0, .size = 4,  .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_VOLTAGE,          .id = 1, .size = 8,  .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCKRATE,        .id = MBOX_TAG_ARM_CLK_ID,  .size = 8, .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCKRATE,        .id = MBOX_TAG_CORE_CLK_ID, .size = 8, .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCKRATE,        .id = MBOX_TAG_V3D_CLK_ID,  .size = 8, .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCK_MEASURED,   .id = MBOX_TAG_ARM_CLK_ID,  .size = 8, .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCK_MEASURED,   .id = MBOX_TAG_CORE_CLK_ID, .size = 8, .ttl_ms = 1000 },
+    { .tag = MBOX_TAG_GET_CLOCK_MEASURED,   .id = MBOX_TAG_V3D_CLK_ID,  .size = 8, .ttl_ms = 1000 },
+};
+
+/*
+ * Cache state, only touched from the resource manager thread. Expired
+ * entries are refreshed by the next request carrying them.
+ */
+typedef struct mbox_cache_ {
+    mbox_dev_t          *dev;
+    mbox_bcm_props_t    *props;
+    uint32_t            bufsize[MBOX_BCM_PROPS_MAX];    /* bytes of the value buffer of each entry */
+    uint32_t            npending;
+    int16_t             pending[MBOX_BCM_PROPERTY_MAX / sizeof(mbox_bcm_tag_t)];  /* entry of each tag in flight, -1 for none */
+} mbox_cache_t;
+
+static mbox_cache_t mbox_cache;
+
+static uint64_t mbox_cache_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec2nsec(&ts);
+}
+
+static void mbox_cache_begin(void)
+{
+    mbox_cache.props->seq++;
+    __cpu_membarrier();
+}
+
+static void mbox_cache_end(void)
+{
+    __cpu_membarrier();
+    mbox_cache.props->seq++;
+}
+
+static int mbox_cache_find(const uint32_t tag, const uint32_t id)
+{
+    for (uint32_t i = 0; i < mbox_cache.props->nprops; i++) {
+        if ((mbox_cache.props->prop[i].tag == tag) && (mbox_cache.props->prop[i].id == id)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Fetched, successfully or not, and not expired */
+static bool mbox_cache_fresh(const mbox_bcm_prop_t *prop, const uint64_t now)
+{
+    if (prop->timestamp == 0ULL) {
+        return false;
+    }
+    return (prop->ttl_ms == 0U) || ((now - prop->timestamp) < ((uint64_t)prop->ttl_ms * 1000000ULL));
+}
+
+/*
+ * Answer the tags from the cache when all of them are cached and fresh,
+ * otherwise note their entries for mbox_cache_update() once the firmware
+ * answered, which is how expired entries get refreshed. The tags have been
+ * through mbox_property_check().
+ */
+bool mbox_cache_lookup(volatile uint32_t *tags, const uint32_t size, uint32_t *code)
+{
+    const uint64_t now = mbox_cache_now();
+    bool hit = true;
+    uint32_t off, n;
+
+    mbox_cache.npending = 0;
+    if (mbox_cache.props == NULL) {
+        return false;
+    }
+
+    for (off = 0; off < size; off += (uint32_t)sizeof(mbox_bcm_tag_t) + tags[(off / sizeof(uint32_t)) + 1U]) {
+        const volatile uint32_t *const tag = &tags[off / sizeof(uint32_t)];
+        const int idx = mbox_cache_find(tag[0], (tag[1] >= sizeof(uint32_t)) ? tag[3] : 0U);
+
+        mbox_cache.pending[mbox_cache.npending++] = (int16_t)idx;
+        if ((idx < 0) || !mbox_cache_fresh(&mbox_cache.props->prop[idx], now) ||
+            (mbox_cache.props->prop[idx].size == 0U) || (tag[1] < mbox_cache.props->prop[idx].size)) {
+            hit = false;
+        }
+    }
+    if (!hit) {
+        return false;
+    }
+
+    for (off = 0, n = 0; off < size; off += (uint32_t)sizeof(mbox_bcm_tag_t) + tags[(off / sizeof(uint32_t)) + 1U], n++) {
+        volatile uint32_t *const tag = &tags[off / sizeof(uint32_t)];
+        const mbox_bcm_prop_t *const prop = &mbox_cache.props->prop[mbox_cache.pending[n]];
+
+        for (uint32_t i = 0; i < (prop->size / sizeof(uint32_t)); i++) {
+            tag[3U + i] = prop->value[i];
+        }
+        tag[2] = prop->code;
+    }
+    mbox_cache.npending = 0;
+    *code = MBOX_BCM_RESPONSE_SUCCESS;
+    return true;
+}
+
+/*
+ * A property changed by a set tag is fetched again by the next request for
+ * it. Setting a clock rate also changes the measured rate.
+ */
+static void mbox_cache_invalidate(const uint32_t tag, const uint32_t id)
+{
+    const uint32_t get = tag & ~MBOX_TAG_SET;
+    int idx = mbox_cache_find(get, id);
+
+    if (idx >= 0) {
+        mbox_cache.props->prop[idx].timestamp = 0;
+    }
+    if (get == MBOX_TAG_GET_CLOCKRATE) {
+        idx = mbox_cache_find(MBOX_TAG_GET_CLOCK_MEASURED, id);
+        if (idx >= 0) {
+            mbox_cache.props->prop[idx].timestamp = 0;
+        }
+    }
+}
+
+/* Store the firmware's answers to the tags noted by mbox_cache_lookup() */
+void mbox_cache_update(const volatile uint32_t *tags, const uint32_t size)
+{
+    const uint64_t now = mbox_cache_now();
+    uint32_t off, n = 0;
+
+    if ((mbox_cache.props == NULL) || (mbox_cache.npending == 0U)) {
+        return;
+    }
+
+    mbox_cache_begin();
+    for (off = 0; (off < size) && (n < mbox_cache.npending);
+         off += (uint32_t)sizeof(mbox_bcm_tag_t) + tags[(off / sizeof(uint32_t)) + 1U], n++) {
+        const volatile uint32_t *const tag = &tags[off / sizeof(uint32_t)];
+        const int idx = mbox_cache.pending[n];
+        mbox_bcm_prop_t *prop;
+
+        if (((tag[0] & MBOX_TAG_SET) != 0U) && ((tag[2] & MBOX_BCM_TAG_RESPONSE) != 0U)) {
+            mbox_cache_invalidate(tag[0], (tag[1] >= sizeof(uint32_t)) ? tag[3] : 0U);
+            continue;
+        }
+        if ((idx < 0) || (tag[1] < mbox_cache.bufsize[idx])) {
+            continue;
+        }
+        prop = &mbox_cache.props->prop[idx];
+        prop->size = 0;
+        prop->code = tag[2];
+        if ((tag[2] & MBOX_BCM_TAG_RESPONSE) != 0U) {
+            for (uint32_t i = 0; i < (mbox_cache.bufsize[idx] / sizeof(uint32_t)); i++) {
+                prop->value[i] = tag[3U + i];
+            }
+            prop->size = mbox_cache.bufsize[idx];
+        }
+        prop->timestamp = now;
+    }
+    mbox_cache_end();
+    mbox_cache.npending = 0;
+}
+
+/* Fetch the entries not fetched yet, in one round trip */
+static int mbox_cache_fetch(void)
+{
+    volatile uint32_t *const tags = &mbox_cache.dev->buf[MBOX_BUF_HDR_SIZE / sizeof(uint32_t)];
+    const uint64_t now = mbox_cache_now();
+    uint32_t size = 0;
+    uint32_t code;
+    int status;
+
+    mbox_cache.npending = 0;
+    for (uint32_t i = 0; i < mbox_cache.props->nprops; i++) {
+        const mbox_bcm_prop_t *const prop = &mbox_cache.props->prop[i];
+        volatile uint32_t *const tag = &tags[size / sizeof(uint32_t)];
+
+        if (mbox_cache_fresh(prop, now)) {
+            continue;
+        }
+        /* What doesn't fit is fetched by the first request for it */
+        if ((size + sizeof(mbox_bcm_tag_t) + mbox_cache.bufsize[i]) > MBOX_BCM_PROPERTY_MAX) {
+            break;
+        }
+        tag[0] = prop->tag;
+        tag[1] = mbox_cache.bufsize[i];
+        tag[2] = 0U;
+        for (uint32_t w = 0; w < (mbox_cache.bufsize[i] / sizeof(uint32_t)); w++) {
+            tag[3U + w] = 0U;
+        }
+        tag[3] = prop->id;
+        mbox_cache.pending[mbox_cache.npending++] = (int16_t)i;
+        size += (uint32_t)sizeof(mbox_bcm_tag_t) + mbox_cache.bufsize[i];
+    }
+    if (size == 0U) {
+        return EOK;
+    }
+
+    status = mbox_property(mbox_cache.dev, size, &code);
+    if (status == EOK) {
+        mbox_cache_update(tags, size);
+    }
+    mbox_cache.npending = 0;
+    return status;
+}
+
+/* Entries startup already read from the firmware and put in the syspage */
+static void mbox_cache_seed(const uint32_t tag, const uint32_t *value, const uint32_t size)
+{
+    const int idx = mbox_cache_find(tag, 0U);
+    mbox_bcm_prop_t *prop;
+
+    if (idx < 0) {
+        return;
+    }
+    prop = &mbox_cache.props->prop[idx];
+    (void)memcpy(prop->value, value, size);
+    prop->size = size;
+    prop->code = MBOX_BCM_TAG_RESPONSE | size;
+    prop->timestamp = mbox_cache_now();
+}
+
+static void mbox_cache_seed_syspage(void)
+{
+    char serial[32];
+    char *end;
+    unsigned tag_idx = 0;
+    hwi_tag *tag;
+    unsigned hwi_off;
+
+    /* Serial number as 16 hex digits */
+    if (confstr(_CS_HW_SERIAL, serial, sizeof(serial)) > 1U) {
+        const uint64_t val = strtoull(serial, &end, 16);
+
+        if ((*end == '\0') && (val != 0ULL)) {
+            const uint32_t value[2] = { (uint32_t)val, (uint32_t)(val >> 32) };
+
+            mbox_cache_seed(MBOX_TAG_GET_BOARDSERIAL, value, sizeof(value));
+        }
+    }
+
+    hwi_off = hwi_find_device("bcm2712,board", 0);
+    if (hwi_off == HWI_NULL_OFF) {
+        return;
+    }
+    while ((tag = hwi_tag_find(hwi_off, HWI_TAG_NAME_regname, &tag_idx)) != NULL) {
+        if (strcmp("revision", __hwi_find_string(tag->regname.regname)) == 0) {
+            const uint32_t value = (uint32_t)tag->regname.offset;
+
+            mbox_cache_seed(MBOX_TAG_GET_BOARDREVISION, &value, sizeof(value));
+        }
+    }
+}
+
+int mbox_cache_init(mbox_dev_t *dev)
+{
+    void *props;
+    uint32_t n = 0;
+    int fd, status;
+
+    mbox_cache.dev = dev;
+
+    /* Clients map the snapshot read-only */
+    fd = shm_open(MBOX_BCM_PROPS_SHM, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s shm_open %s failed, errno: %d", __func__, MBOX_BCM_PROPS_SHM, status);
+        return status;
+    }
+    if (ftruncate(fd, (off_t)sizeof(*mbox_cache.props)) == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s ftruncate failed, errno: %d", __func__, status);
+        (void)close(fd);
+        (void)shm_unlink(MBOX_BCM_PROPS_SHM);
+        return status;
+    }
+    props = mmap(NULL, sizeof(*mbox_cache.props), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (props == MAP_FAILED) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s mmap failed, errno: %d", __func__, status);
+        (void)shm_unlink(MBOX_BCM_PROPS_SHM);
+        return status;
+    }
+    mbox_cache.props = props;
+
+    /* Immutable clock limits for every clock, then the table */
+    for (uint32_t clk = MBOX_TAG_EMMC_CLK_ID; clk < MBOX_TAG_NUM_CLK_ID; clk++) {
+        mbox_cache.props->prop[n].tag = MBOX_TAG_GET_MIN_CLOCKRATE;
+        mbox_cache.props->prop[n].id = clk;
+        mbox_cache.bufsize[n++] = 8U;
+        mbox_cache.props->prop[n].tag = MBOX_TAG_GET_MAX_CLOCKRATE;
+        mbox_cache.props->prop[n].id = clk;
+        mbox_cache.bufsize[n++] = 8U;
+    }
+    for (uint32_t i = 0; i < (sizeof(mbox_cache_defs) / sizeof(mbox_cache_defs[0])); i++) {
+        mbox_cache.props->prop[n].tag = mbox_cache_defs[i].tag;
+        mbox_cache.props->prop[n].id = mbox_cache_defs[i].id;
+        mbox_cache.props->prop[n].ttl_ms = mbox_cache_defs[i].ttl_ms;
+        mbox_cache.bufsize[n++] = mbox_cache_defs[i].size;
+    }
+    mbox_cache.props->nprops = n;
+    mbox_cache_seed_syspage();
+    __cpu_membarrier();
+    mbox_cache.props->magic = MBOX_BCM_PROPS_MAGIC;
+
+    status = mbox_cache_fetch();
+    if (status != EOK) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_WARNING, "%s Initial fetch failed, status: %d", __func__, status);
+    }
+
+    return EOK;
+}
+
+void mbox_cache_deinit(void)
+{
+    if (mbox_cache.props != NULL) {
+        (void)munmap(mbox_cache.props, sizeof(*mbox_cache.props));
+        (void)shm_unlink(MBOX_BCM_PROPS_SHM);
+        mbox_cache.props = NULL;
+    }
+}
@@ -8,8 +8,13 @@ NAME = mbox-bcm
 EXTRA_SILENT_VARIANTS+=$(SECTION)
 USEFILE=$(PROJECT_ROOT)/$(NAME).use
 
+EXTRA_INCVPATH += $(PROJECT_ROOT)/public
+PUBLIC_INCVPATH += $(PROJECT_ROOT)/public
+
+LIBS+=drvr
+
 define PINFO
-PINFO DESCRIPTION=Raspberry pi5 Mailbox utility
+PINFO DESCRIPTION=Raspberry pi5 Mailbox utility and resource manager
 endef
 
 
@@ -39,213 +39,20 @@
  * $
  */
 
-#include <sys/mman.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <devctl.h>
+#include <sys/procmgr.h>
+#include "proto.h"
 
+int32_t verbose = 0;
 
-#define MBOX_TAG_GET_FIRMWAREREV        (0x00000001U)
-#define MBOX_TAG_GET_FIRMWAREVAR        (0x00000002U)
-#define MBOX_TAG_GET_FIRMWAREHASH       (0x00000003U)
-#define MBOX_TAG_GET_BOARDMODEL         (0x00010001U)
-#define MBOX_TAG_GET_BOARDREVISION      (0x00010002U)
-#define MBOX_TAG_GET_MACADDRESS         (0x00010003U)
-#define MBOX_TAG_GET_BOARDSERIAL        (0x00010004U)
-#define MBOX_TAG_GET_ARMMEMORY          (0x00010005U)
-#define MBOX_TAG_GET_VCMEMORY           (0x00010006U)
-#define MBOX_TAG_GET_CLOCKS             (0x00010007U)
-
-#define MBOX_TAG_GET_POWERSTATE         (0x00020001U)
-#define MBOX_TAG_GET_POWERTIMING        (0x00020002U)
-
-#define MBOX_TAG_GET_CLOCKSTATE         (0x00030001U)
-#define MBOX_TAG_GET_CLOCKRATE          (0x00030002U)
-#define MBOX_TAG_GET_VOLTAGE            (0x00030003U)
-#define MBOX_TAG_GET_MAX_CLOCKRATE      (0x00030004U)
-#define MBOX_TAG_GET_MAX_VOLTAGE        (0x00030005U)
-#define MBOX_TAG_GET_TEMPERATURE        (0x00030006U)
-#define MBOX_TAG_GET_MIN_CLOCKRATE      (0x00030007U)
-#define MBOX_TAG_GET_MIN_VOLTAGE        (0x00030008U)
-#define MBOX_TAG_GET_TURBO              (0x00030009U)
-#define MBOX_TAG_GET_MAX_TEMPERATURE    (0x0003000aU)
-#define MBOX_TAG_GET_STC                (0x0003000bU)
-#define MBOX_TAG_GET_DOMAIN_STATE       (0x00030030U)
-#define MBOX_TAG_GET_GPIO_STATE         (0x00030041U)
-#define MBOX_TAG_GET_GPIO_CONFIG        (0x00030043U)
-#define MBOX_TAG_PERIPH_REG             (0x00030045U)
-#define MBOX_TAG_GET_THROTTLED          (0x00030046U)
-#define MBOX_TAG_GET_CLOCK_MEASURED     (0x00030047U)
-#define MBOX_TAG_NOTIFY_REBOOT          (0x00030048U)
-#define MBOX_TAG_POE_HAT_VAL            (0x00030049U)
-#define MBOX_TAG_POE_HAT_VAL_OLD        (0x00030050U)
-#define MBOX_TAG_NOTIFY_XHCI_RESET      (0x00030058U)
-#define MBOX_TAG_NOTIFY_DISPLAY_DONE    (0x00030066U)
-#define MBOX_TAG_BUTTONS_PRESSED        (0x00030088U)
-
-#define MBOX_TAG_GET_CMDLINE            (0x00050001U)
-#define MBOX_TAG_GET_DMACHAN            (0x00060001U)
-
-/* clock ID */
-#define MBOX_TAG_EMMC_CLK_ID            1
-#define MBOX_TAG_UART_CLK_ID            2
-#define MBOX_TAG_ARM_CLK_ID             3
-#define MBOX_TAG_CORE_CLK_ID            4
-#define MBOX_TAG_V3D_CLK_ID             5
-#define MBOX_TAG_H264_CLK_ID            6
-#define MBOX_TAG_ISP_CLK_ID             7
-#define MBOX_TAG_SDRAM_CLK_ID           8
-#define MBOX_TAG_PIXEL_CLK_ID           9
-#define MBOX_TAG_PWM_CLK_ID             10
-#define MBOX_TAG_HEVC_CLK_ID            11
-#define MBOX_TAG_EMMC2_CLK_ID           12
-#define MBOX_TAG_M2MC_CLK_ID            13
-#define MBOX_TAG_PIXEL_BVB_CLK_ID       14
-#define MBOX_TAG_VEC_CLK_ID             15
-#define MBOX_TAG_DISP_CLK_ID            16
-#define MBOX_TAG_NUM_CLK_ID             17
-
-static int mbox_msg(const uint32_t tag, void *buf, const uint32_t bufsize) {
-    struct {
-        uint32_t hdrsize, hdrcode;
-#define MBOX_PROCESS_REQUEST      0
-        uint32_t tag, tagsize, tagcode;
-#define MBOX_TAG_REQUEST          (0U << 31)
-#define MBOX_TAG_RESPONSE         (1U << 31)
-#define MBOX_TAG_NULL             0
-        uint8_t buf[bufsize];
-        uint32_t tagend;
-    } *msg;
-    static void *out = NULL;
-
-    static uint32_t physaddr;
-
-    typedef struct {
-        uint32_t rdwr, _x04,   _x08,   _x0c;
-        uint32_t poll, send, status, config;
-#define MBOX_STATUS_FULL          (0x80000000U)
-#define MBOX_STATUS_EMPTY         (0x40000000U)
-#define MBOX_SEND_CHANNEL         (8U)
-#define MBOX_SEND_CHANNEL_MASK    (0xfU)
-    } mbox_t;
-    static volatile mbox_t *mbox = NULL; // [0]:fromvc [1]:tovc
-
-    if (out == NULL) {
-        int fd;
-        off_t offset;
-        fd = posix_typed_mem_open("/sysram&below1G", O_RDWR, POSIX_TYPED_MEM_ALLOCATE_CONTIG);
-        if (fd < 0) {
-            (void)printf("Failed to open typed memory(%s) \n", strerror( errno ));
-            exit(EXIT_FAILURE);
-        }
-        out = mmap(NULL, 0x1000, PROT_READ | PROT_WRITE | PROT_NOCACHE, MAP_SHARED, fd, 0);
-        if (out == MAP_FAILED) {
-            (void)printf("Failed to allocate buffer!\n");
-            (void)close(fd);
-            exit(EXIT_FAILURE);
-        }
-
-        if (mem_offset(out, NOFD, 1, &offset, NULL) != EOK) {
-            (void)munmap(out, 0x1000);
-            (void)close(fd);
-            (void)printf("Failed to obtain physical address\n");
-            exit(EXIT_FAILURE);
-        }
-
-        physaddr = (uint32_t)offset;
-        (void)close(fd);
-    }
-
-    msg = out;
-    msg->hdrsize = (uint32_t)sizeof(*msg);
-    msg->hdrcode = MBOX_PROCESS_REQUEST;
-    msg->tag = tag;
-    msg->tagsize = bufsize;
-    msg->tagcode = MBOX_TAG_REQUEST;
-    (void)memcpy((void*)msg->buf, buf, bufsize);
-    msg->tagend = MBOX_TAG_NULL;
-
-#define MBOX_REGS           (0x107c013880UL)
-    int wait_cnt = 0;
-    if (mbox == NULL) {
-        mbox = mmap_device_memory(NULL, (sizeof(mbox_t)*2U), PROT_NOCACHE|PROT_READ|PROT_WRITE, 0, MBOX_REGS);
-        if (mbox == MAP_FAILED) {
-            (void)printf("Failed to map mbox registers\n");
-            exit (EXIT_FAILURE);
-        }
-    }
-    if (mbox != NULL) {
-        // check for space on tovc channel to send with timeout
-        for (;;) {
-            if ((mbox[1].status & MBOX_STATUS_FULL) == 0U) {
-                break;
-            }
-            (void)usleep(100);
-            if (++wait_cnt > 5000) {
-                (void)printf("Check for tovc channel full timeout\n");
-                return -1;
-            }
-        }
-
-        // send
-        mbox[1].rdwr = (physaddr & ~MBOX_SEND_CHANNEL_MASK) | MBOX_SEND_CHANNEL;
-
-        // wait for tx done
-        for (;;) {
-            if ((mbox[1].status & MBOX_STATUS_FULL) == 0U) {
-                break;
-            }
-            (void)usleep(100);
-            if (++wait_cnt > 5000) {
-                (void)printf("Wait for tx done timeout\n");
-                return -1;
-            }
-        }
-
-        for (;;) {
-            wait_cnt = 0;
-            // wait for response on fromvc channel to receive with timeout
-            for (;;) {
-                if ((mbox[0].status & MBOX_STATUS_EMPTY) == 0U) {
-                    break;
-                }
-                (void)usleep(100);
-                if (++wait_cnt > 5000) {
-                    (void)printf("Wait for response timeout\n");
-                    return -2;
-                }
-            }
-
-            // is it the channel we're waiting for?
-            const uint32_t rd = mbox[0].rdwr;
-            if ((rd & MBOX_SEND_CHANNEL_MASK) == MBOX_SEND_CHANNEL) {
-                const uint32_t tagcode = msg->tagcode;
-                uint32_t len = tagcode & ~MBOX_TAG_RESPONSE;
-
-                if (tag != MBOX_TAG_GET_FIRMWAREHASH) {
-                    if (len > 0U) {
-                        if (len > bufsize) {
-                            // passed in bufsize is not big enough to hold return response
-                            len = bufsize;
-                        }
-                        (void)memcpy(buf, (void*)msg->buf, len);
-                    }
-                    return (int)len;
-                }
-                else {
-                    /* firmwware hash should return 20 bytes but return code indicates 8 only */
-                    (void)memcpy(buf, (void*)msg->buf, bufsize);
-                    return bufsize;
-                }
-            }
-        }
-        /*NOTREACHED*/
-    }
-    return 0;
-}
+#define MBOX_CMD_MAX        (32U)
 
 static void fmt_d(const void *const buf, const uint32_t len) {
     for (unsigned i = 0; i < (len / sizeof(int32_t)); i++) {
@@ -281,128 +88,260 @@ static void fmt_x_str(const void *const buf, const uint32_t len) {
     (void)printf("\n");
 }
 
-int main(const int argc, char **argv) {
-	typedef struct {
-        const char *str;
-        void (*fmt)(const void * const buf, const uint32_t len);
-        uint32_t tag;
-        uint32_t len;
-    } cmd_options_t;
-
-	static const cmd_options_t cmd_options[] = {
-        { .str="clockrate",         .fmt=&fmt_u,     .tag=MBOX_TAG_GET_CLOCKRATE,       .len=2 },
-        { .str="clockratemeasured", .fmt=&fmt_u,     .tag=MBOX_TAG_GET_CLOCK_MEASURED,  .len=2 },
-        { .str="clocks",            .fmt=&fmt_d,     .tag=MBOX_TAG_GET_CLOCKS,          .len=80 },
-        { .str="clockstate",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_CLOCKSTATE,      .len=2 },
-        { .str="cmdline",           .fmt=&fmt_s,     .tag=MBOX_TAG_GET_CMDLINE,         .len=256 },
-        { .str="dmachan",           .fmt=&fmt_x,     .tag=MBOX_TAG_GET_DMACHAN,         .len=2 },
-        { .str="firmwarerev",       .fmt=&fmt_x,     .tag=MBOX_TAG_GET_FIRMWAREREV,     .len=2 },
-        { .str="firmwarevar",       .fmt=&fmt_x,     .tag=MBOX_TAG_GET_FIRMWAREVAR,     .len=1 },
-        { .str="firmwarehash",      .fmt=&fmt_x_str, .tag=MBOX_TAG_GET_FIRMWAREHASH,    .len=5 },
-        { .str="gpioconfig",        .fmt=&fmt_x,     .tag=MBOX_TAG_GET_GPIO_CONFIG,     .len=2 },
-        { .str="gpiostate",         .fmt=&fmt_d,     .tag=MBOX_TAG_GET_GPIO_STATE,      .len=2 },
-        { .str="macaddress",        .fmt=&fmt_x,     .tag=MBOX_TAG_GET_MACADDRESS,      .len=2 },
-        { .str="maxclockrate",      .fmt=&fmt_u,     .tag=MBOX_TAG_GET_MAX_CLOCKRATE,   .len=2 },
-        { .str="maxtemperature",    .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MAX_TEMPERATURE, .len=2 },
-        { .str="maxvoltage",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MAX_VOLTAGE,     .len=2 },
-        { .str="memory",            .fmt=&fmt_x,     .tag=MBOX_TAG_GET_ARMMEMORY,       .len=2 },
-        { .str="minclockrate",      .fmt=&fmt_u,     .tag=MBOX_TAG_GET_MIN_CLOCKRATE,   .len=2 },
-        { .str="minvoltage",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MIN_VOLTAGE,     .len=2 },
-        { .str="model",             .fmt=&fmt_d,     .tag=MBOX_TAG_GET_BOARDMODEL,      .len=2 },
-        { .str="notifyxhcireset",   .fmt=&fmt_x,     .tag=MBOX_TAG_NOTIFY_XHCI_RESET,   .len=2 },
-        { .str="powerstate",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_POWERSTATE,      .len=2 },
-        { .str="powertiming",       .fmt=&fmt_d,     .tag=MBOX_TAG_GET_POWERTIMING,     .len=2 },
-        { .str="revision",          .fmt=&fmt_x,     .tag=MBOX_TAG_GET_BOARDREVISION,   .len=2 },
-        { .str="serial",            .fmt=&fmt_x,     .tag=MBOX_TAG_GET_BOARDSERIAL,     .len=2 },
-        { .str="temperature",       .fmt=&fmt_d,     .tag=MBOX_TAG_GET_TEMPERATURE,     .len=2 },
-        { .str="throttled",         .fmt=&fmt_x,     .tag=MBOX_TAG_GET_THROTTLED,       .len=1 },
-        { .str="turbo",             .fmt=&fmt_x,     .tag=MBOX_TAG_GET_TURBO,           .len=2 },
-        { .str="vcmemory",          .fmt=&fmt_x,     .tag=MBOX_TAG_GET_VCMEMORY,        .len=2 },
-        { .str="voltage",           .fmt=&fmt_d,     .tag=MBOX_TAG_GET_VOLTAGE,         .len=2 },
-    };
+typedef struct {
+    const char *str;
+    void (*fmt)(const void * const buf, const uint32_t len);
+    uint32_t tag;
+    uint32_t len;
+} cmd_options_t;
 
-    while (*++argv != NULL) {
-        uint32_t set = 0U;
-        char *opt;
-        const char *const str = *argv;
-        uint32_t i, num_arg = 0, opt_arg[256+1] = { };
-        uint32_t len = (uint32_t) strcspn(str, ":=");
-        uint64_t val = 0ULL;
-
-        switch (str[len]) {
-            case '=':
-                set = 1U;
-                /*FALLTHRU*/
-            case ':':
-                opt = (char *)str + len;
-                *opt++ = '\0';
-                while (num_arg < (sizeof(opt_arg) / sizeof(opt_arg[0]))) {
-                    errno = EOK;
-                    val = strtoul(str, &opt, 0);
-                    if (errno == EOK) {
-                        opt_arg[num_arg++] = (uint32_t)val;
-                    }
-                    else {
-                        // invalid arg, default to 0;
-                        opt_arg[num_arg++] = 0U;
-                    }
-                    if (*opt++ != ':') {
-                        break;
-                    }
-                }
+static const cmd_options_t cmd_options[] = {
+    { .str="clockrate",         .fmt=&fmt_u,     .tag=MBOX_TAG_GET_CLOCKRATE,       .len=2 },
+    { .str="clockratemeasured", .fmt=&fmt_u,     .tag=MBOX_TAG_GET_CLOCK_MEASURED,  .len=2 },
+    { .str="clocks",            .fmt=&fmt_d,     .tag=MBOX_TAG_GET_CLOCKS,          .len=80 },
+    { .str="clockstate",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_CLOCKSTATE,      .len=2 },
+    { .str="cmdline",           .fmt=&fmt_s,     .tag=MBOX_TAG_GET_CMDLINE,         .len=256 },
+    { .str="dmachan",           .fmt=&fmt_x,     .tag=MBOX_TAG_GET_DMACHAN,         .len=2 },
+    { .str="firmwarerev",       .fmt=&fmt_x,     .tag=MBOX_TAG_GET_FIRMWAREREV,     .len=2 },
+    { .str="firmwarevar",       .fmt=&fmt_x,     .tag=MBOX_TAG_GET_FIRMWAREVAR,     .len=1 },
+    { .str="firmwarehash",      .fmt=&fmt_x_str, .tag=MBOX_TAG_GET_FIRMWAREHASH,    .len=5 },
+    { .str="gpioconfig",        .fmt=&fmt_x,     .tag=MBOX_TAG_GET_GPIO_CONFIG,     .len=2 },
+    { .str="gpiostate",         .fmt=&fmt_d,     .tag=MBOX_TAG_GET_GPIO_STATE,      .len=2 },
+    { .str="macaddress",        .fmt=&fmt_x,     .tag=MBOX_TAG_GET_MACADDRESS,      .len=2 },
+    { .str="maxclockrate",      .fmt=&fmt_u,     .tag=MBOX_TAG_GET_MAX_CLOCKRATE,   .len=2 },
+    { .str="maxtemperature",    .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MAX_TEMPERATURE, .len=2 },
+    { .str="maxvoltage",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MAX_VOLTAGE,     .len=2 },
+    { .str="memory",            .fmt=&fmt_x,     .tag=MBOX_TAG_GET_ARMMEMORY,       .len=2 },
+    { .str="minclockrate",      .fmt=&fmt_u,     .tag=MBOX_TAG_GET_MIN_CLOCKRATE,   .len=2 },
+    { .str="minvoltage",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_MIN_VOLTAGE,     .len=2 },
+    { .str="model",             .fmt=&fmt_d,     .tag=MBOX_TAG_GET_BOARDMODEL,      .len=2 },
+    { .str="notifyxhcireset",   .fmt=&fmt_x,     .tag=MBOX_TAG_NOTIFY_XHCI_RESET,   .len=2 },
+    { .str="powerstate",        .fmt=&fmt_d,     .tag=MBOX_TAG_GET_POWERSTATE,      .len=2 },
+    { .str="powertiming",       .fmt=&fmt_d,     .tag=MBOX_TAG_GET_POWERTIMING,     .len=2 },
+    { .str="revision",          .fmt=&fmt_x,     .tag=MBOX_TAG_GET_BOARDREVISION,   .len=2 },
+    { .str="serial",            .fmt=&fmt_x,     .tag=MBOX_TAG_GET_BOARDSERIAL,     .len=2 },
+    { .str="temperature",       .fmt=&fmt_d,     .tag=MBOX_TAG_GET_TEMPERATURE,     .len=2 },
+    { .str="throttled",         .fmt=&fmt_x,     .tag=MBOX_TAG_GET_THROTTLED,       .len=1 },
+    { .str="turbo",             .fmt=&fmt_x,     .tag=MBOX_TAG_GET_TURBO,           .len=2 },
+    { .str="vcmemory",          .fmt=&fmt_x,     .tag=MBOX_TAG_GET_VCMEMORY,        .len=2 },
+    { .str="voltage",           .fmt=&fmt_d,     .tag=MBOX_TAG_GET_VOLTAGE,         .len=2 },
+};
+
+/* A property request followed by its tags, as sent with DCMD_MBOX_BCM_PROPERTY */
+typedef struct {
+    mbox_bcm_property_t hdr;
+    uint32_t            tags[MBOX_BCM_PROPERTY_MAX / sizeof(uint32_t)];
+} mbox_request_t;
+
+/* One command of the request and how to print its response */
+typedef struct {
+    void (*fmt)(const void * const buf, const uint32_t len);
+    uint32_t off;           /* offset of the tag in words */
+} mbox_cmd_t;
+
+/*
+ * Request sent through the resource manager when it is running, otherwise
+ * through the mailbox mapped by this process.
+ */
+static int mbox_request(mbox_request_t *const req, const bool write)
+{
+    mbox_dev_t dev;
+    int fd;
+    int status;
+
+    fd = open(MBOX_BCM_DEV_NAME, write ? O_RDWR : O_RDONLY);
+    if (fd != -1) {
+        status = devctl(fd, DCMD_MBOX_BCM_PROPERTY, req, sizeof(req->hdr) + req->hdr.size, NULL);
+        (void)close(fd);
+        return status;
+    }
+
+    status = mbox_init(&dev);
+    if (status != EOK) {
+        return status;
+    }
+    for (uint32_t i = 0; i < (req->hdr.size / sizeof(uint32_t)); i++) {
+        dev.buf[(MBOX_BUF_HDR_SIZE / sizeof(uint32_t)) + i] = req->tags[i];
+    }
+    status = mbox_property_check(&dev.buf[MBOX_BUF_HDR_SIZE / sizeof(uint32_t)], req->hdr.size, true);
+    if (status == EOK) {
+        status = mbox_property(&dev, req->hdr.size, &req->hdr.code);
+    }
+    for (uint32_t i = 0; i < (req->hdr.size / sizeof(uint32_t)); i++) {
+        req->tags[i] = dev.buf[(MBOX_BUF_HDR_SIZE / sizeof(uint32_t)) + i];
+    }
+    mbox_deinit(&dev);
+    return status;
+}
+
+static int mbox_resmgr(void)
+{
+    mbox_dev_t dev;
+    int status;
+
+    /* The mailbox interrupt is attached for this thread, the one serving the requests */
+    status = mbox_init(&dev);
+    if (status != EOK) {
+        return EXIT_FAILURE;
+    }
+
+    status = resmgr_init(&dev);
+    if (status != EOK) {
+        goto done;
+    }
+
+    /* Detach process as a daemon */
+    if (procmgr_daemon(EXIT_SUCCESS, PROCMGR_DAEMON_NOCLOSE) == -1) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "Failed to detaching process as a daemon, errno: %d", errno);
+        status = errno;
+        goto done;
+    }
+
+    /* Drop the abilities now that the resource manager is set up */
+    status = procmgr_ability(0, PROCMGR_ADN_ROOT | PROCMGR_ADN_NONROOT | PROCMGR_AOP_DENY |
+                                PROCMGR_AOP_LOCK | PROCMGR_AID_EOL);
+    if (status != EOK) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "Dropping procmgr abilities failed, status: %d", status);
+        goto done;
+    }
+
+    status = resmgr_loop_start();
+
+    if (verbose > 0) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_DEBUG1, "Exited resource manager loop");
+    }
+
+done:
+
+    resmgr_deinit();
+    mbox_deinit(&dev);
+    return ((status == EOK) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/*
+ * Add command[:|=]arg[:arg...] to the request. Returns the printer of its
+ * response, NULL when the command is not known or the request is full.
+ */
+static const cmd_options_t *mbox_add_cmd(mbox_request_t *const req, char *const str, bool *const write,
+                                          mbox_cmd_t *const cmd)
+{
+    static const cmd_options_t raw = { .str="", .fmt=&fmt_x, .tag=0, .len=2 };
+    const cmd_options_t *opt = NULL;
+    uint32_t args[256 + 1] = { 0 };
+    uint32_t num_arg = 0;
+    uint32_t tag, len, i;
+    bool set = false;
+    char *p = str + strcspn(str, ":=");
+    char *end;
+
+    if (*p != '\0') {
+        set = *p == '=';
+        *p++ = '\0';
+        while (num_arg < (sizeof(args) / sizeof(args[0]))) {
+            errno = EOK;
+            args[num_arg++] = (uint32_t)strtoul(p, &end, 0);
+            if (errno != EOK) {
+                // invalid arg, default to 0;
+                args[num_arg - 1U] = 0U;
+            }
+            if (*end != ':') {
                 break;
+            }
+            p = end + 1;
         }
-        for (i = 0; i < (sizeof(cmd_options) / sizeof(cmd_options[0])); i++) {
-            if (strcmp(str, cmd_options[i].str) == 0) {
-                int ret;
-                uint32_t tag = cmd_options[i].tag;
-                uint32_t len = cmd_options[i].len;
-                if (num_arg > len) {
-                    len = num_arg;
-                }
-                if ((set == 1U) && (tag != MBOX_TAG_NOTIFY_XHCI_RESET)) {
-                    tag |= 0x8000U;
-                }
-                ret = mbox_msg(tag, (void *)opt_arg, (uint32_t)(len * sizeof(opt_arg[0])));
-                if (ret > 0) {
-                    len = (uint32_t) ret;
-                    cmd_options[i].fmt(opt_arg, len);
-                }
-                else {
-                    (void)printf("Mbox does not return valid length\n");
-                }
-                break;
+    }
+
+    for (i = 0; i < (sizeof(cmd_options) / sizeof(cmd_options[0])); i++) {
+        if (strcmp(str, cmd_options[i].str) == 0) {
+            opt = &cmd_options[i];
+            break;
+        }
+    }
+    tag = (opt != NULL) ? opt->tag : 0U;
+    if (opt == NULL) {
+        errno = EOK;
+        tag = (uint32_t)strtoul(str, &end, 0);
+        if ((errno != EOK) || (*end != '\0') || (tag == 0U)) {
+            return NULL;
+        }
+        opt = &raw;
+    }
+    if (set && (tag != MBOX_TAG_NOTIFY_XHCI_RESET)) {
+        tag |= MBOX_TAG_SET;
+    }
+    *write = *write || set || (tag == MBOX_TAG_NOTIFY_XHCI_RESET);
+
+    len = (num_arg > opt->len) ? num_arg : opt->len;
+    cmd->off = req->hdr.size / sizeof(uint32_t);
+    if ((req->hdr.size + sizeof(mbox_bcm_tag_t) + (len * sizeof(uint32_t))) > MBOX_BCM_PROPERTY_MAX) {
+        return NULL;
+    }
+    req->tags[cmd->off]      = tag;
+    req->tags[cmd->off + 1U] = len * (uint32_t)sizeof(uint32_t);
+    req->tags[cmd->off + 2U] = 0U;
+    (void)memcpy(&req->tags[cmd->off + 3U], args, len * sizeof(uint32_t));
+    req->hdr.size += (uint32_t)sizeof(mbox_bcm_tag_t) + (len * (uint32_t)sizeof(uint32_t));
+    cmd->fmt = opt->fmt;
+
+    return opt;
+}
+
+int main(const int argc, char **argv) {
+    static mbox_request_t req;
+    mbox_cmd_t cmds[MBOX_CMD_MAX];
+    uint32_t ncmds = 0;
+    bool write = false;
+    int status;
+
+    /* -d runs the resource manager, commands are served by it once it is up */
+    if ((argc > 1) && (strcmp(argv[1], "-d") == 0)) {
+        for (int arg_num = 2; arg_num < argc; arg_num++) {
+            if (strcmp(argv[arg_num], "-v") == 0) {
+                verbose++;
             } else {
-                int ret;
-                errno = EOK;
-                val = strtoul(str, &opt, 0);
-                if (errno == EOK) {
-                    uint32_t tag = (uint32_t) val;
-                    uint32_t len = 2U;
-                    if (tag != 0U) {
-                        if (num_arg > len) {
-                            len = num_arg;
-                        }
-                        if (set == 1U) {
-                            tag |= 0x8000U;
-                        }
-                        ret = mbox_msg(tag, (void *)opt_arg,  (uint32_t)(len * sizeof(opt_arg[0])));
-                        if (ret > 0) {
-                            len = (uint32_t) ret;
-                            fmt_x(opt_arg, len);
-                        }
-                        else {
-                            (void)printf("Mailbox does not return valid length\n");
-                        }
-                        break;
-                    }
-                }
+                (void)printf("Unknown argument \"%s\"\n", argv[arg_num]);
+                return EXIT_FAILURE;
             }
         }
-        if (i >= (sizeof(cmd_options) / sizeof(cmd_options[0]))) {
-            (void)printf("%s not found?\n", str);
+        return mbox_resmgr();
+    }
+
+    /* All the commands go to the firmware in one request */
+    while (*++argv != NULL) {
+        if (ncmds == MBOX_CMD_MAX) {
+            (void)printf("Too many commands, at most %u\n", MBOX_CMD_MAX);
+            return EXIT_FAILURE;
+        }
+        if (mbox_add_cmd(&req, *argv, &write, &cmds[ncmds]) == NULL) {
+            (void)printf("%s not found?\n", *argv);
             return (EXIT_FAILURE);
         }
+        ncmds++;
+    }
+    if (ncmds == 0U) {
+        return EXIT_SUCCESS;
+    }
+
+    status = mbox_request(&req, write);
+    if (status != EOK) {
+        (void)printf("Mailbox request failed: %s\n", strerror(status));
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t i = 0; i < ncmds; i++) {
+        const mbox_bcm_tag_t *const tag = (const mbox_bcm_tag_t *)&req.tags[cmds[i].off];
+        const void *const value = &req.tags[cmds[i].off + 3U];
+        uint32_t len = tag->code & ~MBOX_BCM_TAG_RESPONSE;
+
+        if (((tag->code & MBOX_BCM_TAG_RESPONSE) == 0U) || (len == 0U)) {
+            (void)printf("Mbox does not return valid length\n");
+            continue;
+        }
+        if ((len > tag->size) || (tag->tag == MBOX_TAG_GET_FIRMWAREHASH)) {
+            /* firmwware hash should return 20 bytes but return code indicates 8 only */
+            len = tag->size;
+        }
+        cmds[i].fmt(value, len);
     }
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,110 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef _PROTO_H_INCLUDED
+#define _PROTO_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/slog.h>
+#include <sys/slogcodes.h>
+#include <hw/dcmd_mbox_bcm.h>
+
+extern int32_t verbose;
+
+#define RESMGR_NAME                 "mbox-bcm"
+
+/* Mailbox 0 (from VC) and mailbox 1 (to VC) */
+#define MBOX_REGS                   (0x107c013880UL)
+#define MBOX_REGS_SIZE              (0x40U)
+#define MBOX_IRQ                    (0x41U)     /* GIC SPI 0x21 */
+
+#define MBOX0_OFFSET                (0x00U)
+#define MBOX1_OFFSET                (0x20U)
+#define MBOX_RDWR                   (0x00U)
+#define MBOX_STATUS                 (0x18U)
+#define MBOX_STATUS_FULL            (0x80000000U)
+#define MBOX_STATUS_EMPTY           (0x40000000U)
+#define MBOX_CFG                    (0x1cU)
+#define MBOX_CFG_DATAIRQEN          (0x00000001U)
+#define MBOX_CFG_DATAPENDING        (0x00000010U)
+
+#define MBOX_SEND_CHANNEL           (8U)
+#define MBOX_SEND_CHANNEL_MASK      (0xfU)
+#define MBOX_PROCESS_REQUEST        (0U)
+#define MBOX_TAG_NULL               (0U)
+
+/* Message buffer: size, code, tags, end tag */
+#define MBOX_BUF_SIZE               (0x1000U)
+#define MBOX_BUF_HDR_SIZE           (8U)
+#define MBOX_BUFS                   (4U)        /* rotated through when the firmware keeps one */
+
+#define MBOX_RESPONSE_TIMEOUT_NS    (1000000000ULL)
+
+#define _SLOGC_MBOX                 _SLOG_SETCODE( _SLOG_SYSLOG, 0 )
+
+typedef struct mbox_dev_ {
+    uintptr_t           vbase;
+    volatile uint32_t   *buf;               /* buffer of the next request */
+    uint32_t            paddr;
+    volatile uint32_t   *bufs;              /* MBOX_BUFS buffers, uncached, below 1G for the VC */
+    uint32_t            bufs_paddr;
+    uint32_t            cur;                /* index of buf */
+    uint32_t            stale;              /* bit n: buffer n is held by a request left unanswered */
+    int                 iid;
+} mbox_dev_t;
+
+int mbox_init(mbox_dev_t *dev);
+void mbox_deinit(mbox_dev_t *dev);
+int mbox_property_check(volatile uint32_t *tags, const uint32_t size, const bool write);
+int mbox_property(mbox_dev_t *dev, const uint32_t size, uint32_t *code);
+
+int mbox_cache_init(mbox_dev_t *dev);
+void mbox_cache_deinit(void);
+bool mbox_cache_lookup(volatile uint32_t *tags, const uint32_t size, uint32_t *code);
+void mbox_cache_update(const volatile uint32_t *tags, const uint32_t size);
+
+int resmgr_loop_start(void);
+void resmgr_deinit(void);
+int resmgr_init(mbox_dev_t *dev);
+
+#endif /* _PROTO_H_INCLUDED */
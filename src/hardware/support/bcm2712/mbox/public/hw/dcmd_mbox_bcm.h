@@ -0,0 +1,209 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+/*
+ *  dcmd_mbox_bcm.h   devctl definitions for the mbox-bcm resource manager
+ *
+ */
+
+#ifndef __DCMD_MBOX_BCM_H_INCLUDED
+#define __DCMD_MBOX_BCM_H_INCLUDED
+
+#ifndef _DEVCTL_H_INCLUDED
+ #include <devctl.h>
+#endif
+
+#include <_pack64.h>
+
+#define MBOX_BCM_DEV_NAME           "/dev/mbox"
+
+/* Property tags, the set variant of a get tag has MBOX_TAG_SET added */
+#define MBOX_TAG_GET_FIRMWAREREV        (0x00000001U)
+#define MBOX_TAG_GET_FIRMWAREVAR        (0x00000002U)
+#define MBOX_TAG_GET_FIRMWAREHASH       (0x00000003U)
+#define MBOX_TAG_GET_BOARDMODEL         (0x00010001U)
+#define MBOX_TAG_GET_BOARDREVISION      (0x00010002U)
+#define MBOX_TAG_GET_MACADDRESS         (0x00010003U)
+#define MBOX_TAG_GET_BOARDSERIAL        (0x00010004U)
+#define MBOX_TAG_GET_ARMMEMORY          (0x00010005U)
+#define MBOX_TAG_GET_VCMEMORY           (0x00010006U)
+#define MBOX_TAG_GET_CLOCKS             (0x00010007U)
+
+#define MBOX_TAG_GET_POWERSTATE         (0x00020001U)
+#define MBOX_TAG_GET_POWERTIMING        (0x00020002U)
+
+#define MBOX_TAG_GET_CLOCKSTATE         (0x00030001U)
+#define MBOX_TAG_GET_CLOCKRATE          (0x00030002U)
+#define MBOX_TAG_GET_VOLTAGE            (0x00030003U)
+#define MBOX_TAG_GET_MAX_CLOCKRATE      (0x00030004U)
+#define MBOX_TAG_GET_MAX_VOLTAGE        (0x00030005U)
+#define MBOX_TAG_GET_TEMPERATURE        (0x00030006U)
+#define MBOX_TAG_GET_MIN_CLOCKRATE      (0x00030007U)
+#define MBOX_TAG_GET_MIN_VOLTAGE        (0x00030008U)
+#define MBOX_TAG_GET_TURBO              (0x00030009U)
+#define MBOX_TAG_GET_MAX_TEMPERATURE    (0x0003000aU)
+#define MBOX_TAG_GET_STC                (0x0003000bU)
+#define MBOX_TAG_GET_DOMAIN_STATE       (0x00030030U)
+#define MBOX_TAG_GET_GPIO_STATE         (0x00030041U)
+#define MBOX_TAG_GET_GPIO_CONFIG        (0x00030043U)
+#define MBOX_TAG_PERIPH_REG             (0x00030045U)
+#define MBOX_TAG_GET_THROTTLED          (0x00030046U)
+#define MBOX_TAG_GET_CLOCK_MEASURED     (0x00030047U)
+#define MBOX_TAG_NOTIFY_REBOOT          (0x00030048U)
+#define MBOX_TAG_POE_HAT_VAL            (0x00030049U)
+#define MBOX_TAG_POE_HAT_VAL_OLD        (0x00030050U)
+#define MBOX_TAG_NOTIFY_XHCI_RESET      (0x00030058U)
+#define MBOX_TAG_NOTIFY_DISPLAY_DONE    (0x00030066U)
+#define MBOX_TAG_BUTTONS_PRESSED        (0x00030088U)
+
+#define MBOX_TAG_GET_CMDLINE            (0x00050001U)
+#define MBOX_TAG_GET_DMACHAN            (0x00060001U)
+
+#define MBOX_TAG_SET                    (0x00008000U)
+
+/* Clock IDs */
+#define MBOX_TAG_EMMC_CLK_ID            1
+#define MBOX_TAG_UART_CLK_ID            2
+#define MBOX_TAG_ARM_CLK_ID             3
+#define MBOX_TAG_CORE_CLK_ID            4
+#define MBOX_TAG_V3D_CLK_ID             5
+#define MBOX_TAG_H264_CLK_ID            6
+#define MBOX_TAG_ISP_CLK_ID             7
+#define MBOX_TAG_SDRAM_CLK_ID           8
+#define MBOX_TAG_PIXEL_CLK_ID           9
+#define MBOX_TAG_PWM_CLK_ID             10
+#define MBOX_TAG_HEVC_CLK_ID            11
+#define MBOX_TAG_EMMC2_CLK_ID           12
+#define MBOX_TAG_M2MC_CLK_ID            13
+#define MBOX_TAG_PIXEL_BVB_CLK_ID       14
+#define MBOX_TAG_VEC_CLK_ID             15
+#define MBOX_TAG_DISP_CLK_ID            16
+#define MBOX_TAG_NUM_CLK_ID             17
+
+/*
+ * One property tag, followed by its value buffer of size bytes (a multiple
+ * of 4). The firmware writes the response into the value buffer and sets
+ * code to MBOX_BCM_TAG_RESPONSE plus the response length, which may be larger
+ * than size when the buffer is too small for the whole response.
+ */
+typedef struct _mbox_bcm_tag {
+    _Uint32t        tag;                    /* MBOX_TAG_* */
+    _Uint32t        size;                   /* bytes of the value buffer */
+    _Uint32t        code;                   /* 0 in the request */
+} mbox_bcm_tag_t;
+
+#define MBOX_BCM_TAG_RESPONSE       (0x80000000U)
+
+/*
+ * DCMD_MBOX_BCM_PROPERTY: run the property tags following the header in one
+ * firmware round trip, size being their total length (at most
+ * MBOX_BCM_PROPERTY_MAX). The tags are returned in place with the firmware's
+ * responses, code is the firmware's code for the whole buffer. EIO is
+ * returned when the firmware could not parse the buffer, ETIMEDOUT when it
+ * did not answer and EINTR when the wait for the answer was interrupted. The
+ * buffer of an unanswered request is set aside until the firmware answers it,
+ * EBUSY is returned while it holds all of them. Tags with MBOX_TAG_SET need
+ * the device open for writing. Requests from all clients are run one at a
+ * time.
+ */
+#define MBOX_BCM_PROPERTY_MAX       4080U
+#define MBOX_BCM_RESPONSE_SUCCESS   (0x80000000U)
+#define MBOX_BCM_RESPONSE_EPARSE    (0x80000001U)
+
+typedef struct _mbox_bcm_property {
+    _Uint32t        size;                   /* bytes of tags following the header */
+    _Uint32t        code;                   /* out: MBOX_BCM_RESPONSE_* */
+} mbox_bcm_property_t;
+
+#define DCMD_MBOX_BCM_PROPERTY      (__DIOTF(_DCMD_MISC, 0x01, struct _mbox_bcm_property))
+
+/*
+ * Property cache: the properties below are kept by the resource manager in
+ * the shared memory snapshot MBOX_BCM_PROPS_SHM, which clients map
+ * read-only. Those that never change (ttl_ms 0) are fetched once when it
+ * starts, the board serial number and revision being taken from the syspage;
+ * the others are fetched again by the first DCMD_MBOX_BCM_PROPERTY request
+ * for them once ttl_ms has passed, so a reader of the snapshot can find an
+ * entry older than its ttl_ms and should then make that request instead.
+ * An entry whose property was changed by a set tag has a timestamp of 0
+ * until it is fetched again.
+ * DCMD_MBOX_BCM_PROPERTY requests made only of cached, fresh tags with a
+ * large enough value buffer are answered from the snapshot.
+ *
+ *  immutable   firmware revision, variant and hash, board model, revision,
+ *              serial number and MAC address, ARM and VC memory, maximum
+ *              temperature, minimum and maximum core voltage, minimum and
+ *              maximum rate of each clock
+ *  1 s         temperature, throttled state, core voltage, rate and
+ *              measured rate of the ARM, core and V3D clocks
+ */
+#define MBOX_BCM_PROPS_SHM          "/mbox-bcm-props"
+#define MBOX_BCM_PROPS_MAGIC        0x504f5250  /* "PROP" */
+#define MBOX_BCM_PROPS_MAX          64
+#define MBOX_BCM_PROP_WORDS         8
+
+typedef struct _mbox_bcm_prop {
+    _Uint32t        tag;                    /* MBOX_TAG_* */
+    _Uint32t        id;                     /* first word of the request: clock, voltage or sensor ID, 0 otherwise */
+    _Uint32t        size;                   /* bytes of value, 0 until the firmware answered */
+    _Uint32t        code;                   /* tag response code */
+    _Uint32t        ttl_ms;                 /* 0 for properties that don't change */
+    _Uint32t        rsvd;
+    _Uint64t        timestamp;              /* CLOCK_MONOTONIC in ns of the last fetch */
+    _Uint32t        value[MBOX_BCM_PROP_WORDS];
+} mbox_bcm_prop_t;
+
+/*
+ * seq is odd while the snapshot is being updated. A reader copies the
+ * entries it needs and accepts them if seq was even and the same before and
+ * after the copy.
+ */
+typedef struct _mbox_bcm_props {
+    _Uint32t            magic;
+    _Uint32t            nprops;
+    volatile _Uint32t   seq;
+    _Uint32t            rsvd;
+    mbox_bcm_prop_t     prop[MBOX_BCM_PROPS_MAX];
+} mbox_bcm_props_t;
+
+#include <_packpop.h>
+
+#endif
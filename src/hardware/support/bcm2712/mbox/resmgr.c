@@ -0,0 +1,227 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic.h>
+#include <sys/iofunc.h>
+#include <sys/dispatch.h>
+#include <sys/resmgr.h>
+#include "proto.h"
+
+typedef struct resmgr_ {
+    iofunc_attr_t           iofunc_attr;
+    dispatch_t             *dpp;
+    dispatch_context_t     *ctp;
+    resmgr_connect_funcs_t  connect_funcs;
+    resmgr_io_funcs_t       io_funcs;
+    int                     id;
+    mbox_dev_t             *dev;
+    volatile unsigned       done;
+} resmgr_t;
+
+static resmgr_t resmgr = { .id = -1 };
+
+static void sig_handler(const int signo)
+{
+    (void) signo;
+    atomic_set(&resmgr.done, 1);
+    dispatch_unblock(resmgr.ctp);
+}
+
+static void sig_init(void)
+{
+    struct sigaction sa = { 0 };
+
+    /* Register exit handler */
+    (void)sigemptyset(&sa.sa_mask);
+    (void)sigaddset(&sa.sa_mask, SIGTERM);
+    sa.sa_handler = sig_handler;
+    sa.sa_flags = SA_SIGINFO;
+    (void)sigaction(SIGTERM, &sa, NULL);
+}
+
+/*
+ * The tags are read from the client straight into the message buffer and
+ * returned from there, the header comes back in the devctl data.
+ */
+static int mbox_devctl_property(resmgr_context_t *ctp, io_devctl_t *msg, iofunc_ocb_t *ocb,
+                                mbox_bcm_property_t *prop)
+{
+    volatile uint32_t *const tags = &resmgr.dev->buf[MBOX_BUF_HDR_SIZE / sizeof(uint32_t)];
+    int status;
+
+    if (msg->i.nbytes < sizeof(*prop)) {
+        return EINVAL;
+    }
+    if ((size_t)ctp->info.msglen < (sizeof(msg->i) + sizeof(*prop))) {
+        return EBADMSG;
+    }
+    if ((prop->size > MBOX_BCM_PROPERTY_MAX) || (prop->size > (msg->i.nbytes - sizeof(*prop)))) {
+        return EINVAL;
+    }
+    if (resmgr_msgread(ctp, (void *)tags, prop->size, sizeof(msg->i) + sizeof(*prop)) != (ssize_t)prop->size) {
+        return EBADMSG;
+    }
+
+    status = mbox_property_check(tags, prop->size, (ocb->ioflag & _IO_FLAG_WR) != 0);
+    if (status != EOK) {
+        return status;
+    }
+    if (!mbox_cache_lookup(tags, prop->size, &prop->code)) {
+        status = mbox_property(resmgr.dev, prop->size, &prop->code);
+        if (status != EOK) {
+            return status;
+        }
+        mbox_cache_update(tags, prop->size);
+    }
+
+    (void)memset(&msg->o, 0, sizeof(msg->o));
+    msg->o.nbytes = sizeof(*prop) + prop->size;
+    SETIOV(&ctp->iov[0], &msg->o, sizeof(msg->o) + sizeof(*prop));
+    SETIOV(&ctp->iov[1], (void *)tags, prop->size);
+    return _RESMGR_NPARTS(2);
+}
+
+static int io_devctl(resmgr_context_t *ctp, io_devctl_t *msg, RESMGR_OCB_T *ocb)
+{
+    int status;
+
+    status = iofunc_devctl_default(ctp, msg, ocb);
+    if (status != _RESMGR_DEFAULT) {
+        return status;
+    }
+
+    /*
+     * Requests are handled one at a time by this thread, which is also the
+     * one the mailbox interrupt was attached for.
+     */
+    switch (msg->i.dcmd) {
+        case DCMD_MBOX_BCM_PROPERTY:
+            return mbox_devctl_property(ctp, msg, ocb, _DEVCTL_DATA(msg->i));
+        default:
+            return ENOTTY;
+    }
+}
+
+int resmgr_loop_start(void)
+{
+    /* allocate a context structure */
+    resmgr.ctp = dispatch_context_alloc(resmgr.dpp);
+    if (resmgr.ctp == NULL) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Couldn't allocate dispatch context, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    while (!resmgr.done) {
+        if (resmgr.ctp == dispatch_block(resmgr.ctp)) {
+            (void)dispatch_handler(resmgr.ctp);
+        }
+        else if (errno != EFAULT) {
+            atomic_set(&resmgr.done, 1);
+        }
+    }
+    return EOK;
+}
+
+void resmgr_deinit(void)
+{
+    mbox_cache_deinit();
+    if (resmgr.id != -1) {
+        if (resmgr_detach(resmgr.dpp, resmgr.id, 0) == -1) {
+            (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Failed to remove pathname from the pathname space", __func__);
+        }
+        resmgr.id = -1;
+    }
+}
+
+int resmgr_init(mbox_dev_t *dev)
+{
+    resmgr_attr_t attr = { 0 };
+
+    resmgr.dev = dev;
+
+    /* Single_instance. Ensure that the resource manager is not already running */
+    if (name_attach(NULL, RESMGR_NAME, 0) == NULL) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Is '%s' already started?", __func__, RESMGR_NAME);
+        return errno;
+    }
+
+    /* allocate and initialize a dispatch structure for use by our main loop */
+    resmgr.dpp = dispatch_create();
+    if (resmgr.dpp == NULL) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Couldn't dispatch_create, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    /* The cache is filled before /dev/mbox appears, requests can still be made when it is not available */
+    if (mbox_cache_init(dev) != EOK) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_WARNING, "%s Property cache unavailable", __func__);
+    }
+
+    iofunc_func_init(_RESMGR_CONNECT_NFUNCS, &resmgr.connect_funcs, _RESMGR_IO_NFUNCS,
+            &resmgr.io_funcs);
+
+    resmgr.io_funcs.devctl = io_devctl;
+
+    /* Replies are the devctl header and the tags in the message buffer */
+    attr.nparts_max = 2;
+
+    iofunc_attr_init(&resmgr.iofunc_attr, S_IFCHR | 0660, NULL, NULL);
+    resmgr.id = resmgr_attach(resmgr.dpp,        /* dispatch handle        */
+                       &attr,                    /* resource manager attrs */
+                       MBOX_BCM_DEV_NAME,        /* device name            */
+                       _FTYPE_ANY,               /* open type              */
+                       0,                        /* flags                  */
+                       &resmgr.connect_funcs,    /* connect routines       */
+                       &resmgr.io_funcs,         /* I/O routines           */
+                       &resmgr.iofunc_attr);     /* handle                 */
+    if (resmgr.id == -1) {
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Couldn't attach pathname, errno: %d", __func__, errno);
+        return errno;
+    }
+
+    sig_init();
+
+    return EOK;
+}
@@ -0,0 +1,282 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <hw/inout.h>
+#include "proto.h"
+
+static bool mbox_tag_writes(const uint32_t tag)
+{
+    switch (tag) {
+        case MBOX_TAG_PERIPH_REG:
+        case MBOX_TAG_NOTIFY_REBOOT:
+        case MBOX_TAG_NOTIFY_XHCI_RESET:
+        case MBOX_TAG_NOTIFY_DISPLAY_DONE:
+            return true;
+        default:
+            return (tag & MBOX_TAG_SET) != 0U;
+    }
+}
+
+/*
+ * Check the tags laid out in the message buffer and clear their codes, the
+ * firmware expects 0 in the request.
+ */
+int mbox_property_check(volatile uint32_t *tags, const uint32_t size, const bool write)
+{
+    uint32_t off = 0;
+
+    if ((size == 0U) || (size > MBOX_BCM_PROPERTY_MAX) || ((size % sizeof(uint32_t)) != 0U)) {
+        return EINVAL;
+    }
+
+    while (off < size) {
+        volatile uint32_t *const tag = &tags[off / sizeof(uint32_t)];
+
+        if ((size - off) < sizeof(mbox_bcm_tag_t)) {
+            return EINVAL;
+        }
+        if ((tag[0] == MBOX_TAG_NULL) || ((tag[1] % sizeof(uint32_t)) != 0U) ||
+            (tag[1] > (size - off - sizeof(mbox_bcm_tag_t)))) {
+            return EINVAL;
+        }
+        if (!write && mbox_tag_writes(tag[0])) {
+            return EPERM;
+        }
+        tag[2] = 0U;
+        off += (uint32_t)sizeof(mbox_bcm_tag_t) + tag[1];
+    }
+
+    return EOK;
+}
+
+/*
+ * Empty mailbox 0, true when the response to the current buffer was among the
+ * messages. A late response gives its buffer back; other channels are not
+ * used, their messages are dropped.
+ */
+static bool mbox_drain(mbox_dev_t *dev)
+{
+    bool done = false;
+
+    while ((in32(dev->vbase + MBOX0_OFFSET + MBOX_STATUS) & MBOX_STATUS_EMPTY) == 0U) {
+        const uint32_t msg = in32(dev->vbase + MBOX0_OFFSET + MBOX_RDWR);
+        const uint32_t n = ((msg & ~MBOX_SEND_CHANNEL_MASK) - dev->bufs_paddr) / MBOX_BUF_SIZE;
+
+        if (((msg & MBOX_SEND_CHANNEL_MASK) != MBOX_SEND_CHANNEL) || (msg < dev->bufs_paddr) || (n >= MBOX_BUFS)) {
+            continue;
+        }
+        if (n == dev->cur) {
+            done = true;
+        } else {
+            dev->stale &= ~(1U << n);
+        }
+    }
+    return done;
+}
+
+/* Move on to a buffer the firmware doesn't hold, false when it holds them all */
+static bool mbox_rotate(mbox_dev_t *dev)
+{
+    uint32_t i;
+
+    for (i = 1; i <= MBOX_BUFS; i++) {
+        const uint32_t n = (dev->cur + i) % MBOX_BUFS;
+
+        if ((dev->stale & (1U << n)) == 0U) {
+            dev->cur = n;
+            dev->buf = &dev->bufs[(n * MBOX_BUF_SIZE) / sizeof(uint32_t)];
+            dev->paddr = dev->bufs_paddr + (n * MBOX_BUF_SIZE);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * One firmware round trip for the size bytes of tags in the message buffer.
+ * The response is signalled by the data pending interrupt of mailbox 0, the
+ * thread that attached it in mbox_init() must be the one calling.
+ *
+ * The firmware may still answer a request that timed out or was interrupted
+ * and write over its buffer, that buffer is set aside until the answer comes
+ * and the next request gets another one.
+ */
+int mbox_property(mbox_dev_t *dev, const uint32_t size, uint32_t *code)
+{
+    const uint32_t msg = (dev->paddr & ~MBOX_SEND_CHANNEL_MASK) | MBOX_SEND_CHANNEL;
+    const uint64_t timeout = MBOX_RESPONSE_TIMEOUT_NS;
+    const bool held = (dev->stale & (1U << dev->cur)) != 0U;
+    bool done = false;
+    int status;
+
+    (void)mbox_drain(dev);
+    /* Every buffer was held when this one was filled, the firmware may have written over it since */
+    if (held) {
+        (void)mbox_rotate(dev);
+        return EBUSY;
+    }
+    if ((in32(dev->vbase + MBOX1_OFFSET + MBOX_STATUS) & MBOX_STATUS_FULL) != 0U) {
+        return EBUSY;
+    }
+
+    dev->buf[0] = MBOX_BUF_HDR_SIZE + size + (uint32_t)sizeof(uint32_t);
+    dev->buf[1] = MBOX_PROCESS_REQUEST;
+    dev->buf[(MBOX_BUF_HDR_SIZE + size) / sizeof(uint32_t)] = MBOX_TAG_NULL;
+
+    __cpu_membarrier();
+    out32(dev->vbase + MBOX1_OFFSET + MBOX_RDWR, msg);
+
+    while (!done) {
+        (void)TimerTimeout(CLOCK_MONOTONIC, _NTO_TIMEOUT_INTR, NULL, &timeout, NULL);
+        if (InterruptWait(0, NULL) == -1) {
+            status = (errno == EINTR) ? EINTR : ETIMEDOUT;
+            if (status == ETIMEDOUT) {
+                (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s no response from the firmware, errno: %d", __func__, errno);
+            }
+            dev->stale |= 1U << dev->cur;
+            if (!mbox_rotate(dev)) {
+                (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s firmware holds all %u message buffers", __func__, MBOX_BUFS);
+            }
+            return status;
+        }
+        done = mbox_drain(dev);
+        (void)InterruptUnmask(MBOX_IRQ, dev->iid);
+    }
+    __cpu_membarrier();
+
+    *code = dev->buf[1];
+    return (*code == MBOX_BCM_RESPONSE_SUCCESS) ? EOK : EIO;
+}
+
+int mbox_init(mbox_dev_t *dev)
+{
+    struct sigevent event;
+    void *buf;
+    off_t offset;
+    int fd, status;
+
+    dev->iid = -1;
+    dev->buf = NULL;
+    dev->bufs = NULL;
+    dev->cur = 0;
+    dev->stale = 0;
+    dev->vbase = (uintptr_t)MAP_FAILED;
+
+    /* The firmware takes a 32 bit address, the buffers have to be below 1G */
+    fd = posix_typed_mem_open("/sysram&below1G", O_RDWR, POSIX_TYPED_MEM_ALLOCATE_CONTIG);
+    if (fd == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Failed to open typed memory, errno: %d", __func__, status);
+        return status;
+    }
+    buf = mmap(NULL, MBOX_BUFS * MBOX_BUF_SIZE, PROT_READ | PROT_WRITE | PROT_NOCACHE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (buf == MAP_FAILED) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Failed to allocate buffer, errno: %d", __func__, status);
+        return status;
+    }
+    dev->bufs = buf;
+    dev->buf = buf;
+    if (mem_offset(buf, NOFD, 1, &offset, NULL) != EOK) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Failed to obtain physical address, errno: %d", __func__, status);
+        mbox_deinit(dev);
+        return status;
+    }
+    dev->bufs_paddr = (uint32_t)offset;
+    dev->paddr = dev->bufs_paddr;
+
+    dev->vbase = (uintptr_t)mmap_device_memory(NULL, MBOX_REGS_SIZE, PROT_NOCACHE | PROT_READ | PROT_WRITE, 0, MBOX_REGS);
+    if (dev->vbase == (uintptr_t)MAP_FAILED) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s Failed to map mbox registers, errno: %d", __func__, status);
+        mbox_deinit(dev);
+        return status;
+    }
+
+    SIGEV_INTR_INIT(&event);
+    dev->iid = InterruptAttachEvent((int)MBOX_IRQ, &event, _NTO_INTR_FLAGS_TRK_MSK);
+    if (dev->iid == -1) {
+        status = errno;
+        (void)slogf(_SLOGC_MBOX, _SLOG_ERROR, "%s InterruptAttachEvent (irq 0x%x) failed, errno: %d", __func__,
+                MBOX_IRQ, status);
+        mbox_deinit(dev);
+        return status;
+    }
+
+    out32(dev->vbase + MBOX0_OFFSET + MBOX_CFG, in32(dev->vbase + MBOX0_OFFSET + MBOX_CFG) | MBOX_CFG_DATAIRQEN);
+
+    return EOK;
+}
+
+void mbox_deinit(mbox_dev_t *dev)
+{
+    /* Buffers the firmware may still write to are not given back */
+    if (dev->stale != 0U) {
+        (void)mbox_drain(dev);
+        if (dev->stale != 0U) {
+            (void)slogf(_SLOGC_MBOX, _SLOG_WARNING, "%s firmware still holds message buffers 0x%x", __func__, dev->stale);
+            dev->bufs = NULL;
+        }
+    }
+    if (dev->iid != -1) {
+        out32(dev->vbase + MBOX0_OFFSET + MBOX_CFG, in32(dev->vbase + MBOX0_OFFSET + MBOX_CFG) & ~MBOX_CFG_DATAIRQEN);
+        (void)InterruptDetach(dev->iid);
+        dev->iid = -1;
+    }
+    if (dev->vbase != (uintptr_t)MAP_FAILED) {
+        (void)munmap_device_memory((void *)dev->vbase, MBOX_REGS_SIZE);
+        dev->vbase = (uintptr_t)MAP_FAILED;
+    }
+    if (dev->bufs != NULL) {
+        (void)munmap((void *)dev->bufs, MBOX_BUFS * MBOX_BUF_SIZE);
+    }
+    dev->bufs = NULL;
+    dev->buf = NULL;
+}
@@ -45,6 +45,7 @@
 #include <unistd.h>
 #include <sys/neutrino.h>
 #include <errno.h>
+#include <sys/syspage.h>
 #include <hw/inout.h>
 
 #include <pci/pci.h>
@@ -136,11 +137,24 @@
 
 /* GIC Interrupt Configuration Registers */
 #define GICD_PADDR                        (0x107fff9000UL)
+#define GICD_ITARGETSR                    (0x800U)
 #define GICD_ICFGR                        (0xc00U)
+#define GICD_CPU_MAX                      (8U)
 #define RP1_PCIE_MSI_GIC_IRQ_BASE         (0xa0U)
 
 static int_t verbose = 0;
 static int_t end_loop = 0;
+
+/* GIC CPU target mask for each MSIX irq, 0 leaves the GIC default */
+static uint8_t irq_affinity[RP1_PCIE_MSIX_IRQ_SIZE];
+
+/* high-rate irqs spread over the CPUs by '-a auto' */
+static const uint_t irq_auto_affinity[] = {
+    RP1_PCIE_MSIX_IRQ_6_ETH,
+    RP1_PCIE_MSIX_IRQ_31_USB2,
+    RP1_PCIE_MSIX_IRQ_36_USB3,
+};
+
 static void gic_set_msi_irq_edge(const uint_t irq)
 {
     static uintptr_t gicd_icfg_base;
@@ -172,6 +186,57 @@ static void gic_set_msi_irq_edge(const uint_t irq)
     (void)munmap_device_memory((void*)gicd_icfg_base, RP1_PCIE_MSIX_IRQ_SIZE * sizeof(uint32_t));
 }
 
+static void gic_set_msi_irq_target(const uint_t irq, const uint8_t cpumask)
+{
+    static uintptr_t gicd_itargets_base;
+    const uint32_t target_shift = ((irq + RP1_PCIE_MSI_GIC_IRQ_BASE) % 4U) * 8U;
+    const uint32_t target_off = ((irq + RP1_PCIE_MSI_GIC_IRQ_BASE) / 4U) * 4U;
+    const size_t target_size = RP1_PCIE_MSI_GIC_IRQ_BASE + RP1_PCIE_MSIX_IRQ_SIZE;
+    uint32_t val, oldval;
+    if (irq >= RP1_PCIE_MSIX_IRQ_SIZE) {
+        (void)fprintf(stderr, "Invalid MSIX irq: %u\n", irq);
+        return;
+    }
+
+    gicd_itargets_base = (uintptr_t) mmap_device_memory(NULL,
+            target_size,
+            PROT_NOCACHE|PROT_READ|PROT_WRITE,
+            0,
+            (GICD_PADDR + GICD_ITARGETSR));
+    if (gicd_itargets_base == (uintptr_t) MAP_FAILED) {
+        (void)fprintf(stderr, "mmap GICD interrupt targets failed: %s\n", strerror (errno));
+        return;
+    }
+
+    oldval = in32(gicd_itargets_base + target_off);
+    val = (oldval & ~(0xffU << target_shift)) | ((uint32_t)cpumask << target_shift);
+    out32(gicd_itargets_base + target_off, val);
+    if (verbose > 0) {
+        (void)fprintf(stderr, "irq: %u (GIC 0x%x) targets cpumask 0x%x\n", irq, irq + RP1_PCIE_MSI_GIC_IRQ_BASE, cpumask);
+    }
+    if (verbose > 1) {
+        (void)fprintf(stderr, "write offset: 0x%x from 0x%x to 0x%x\n", target_off, oldval, val);
+    }
+
+    (void)munmap_device_memory((void*)gicd_itargets_base, target_size);
+}
+
+/* Leave CPU0 to the rest of the system and give each high-rate irq its own core where possible */
+static void set_auto_affinity(const uint_t num_cpu)
+{
+    uint_t i;
+
+    if (num_cpu < 2U) {
+        return;
+    }
+    for (i = 0; i < NUM_ELTS(irq_auto_affinity); i++) {
+        const uint_t irq = irq_auto_affinity[i];
+        if (irq_affinity[irq] == 0U) {
+            irq_affinity[irq] = (uint8_t)(1U << (1U + (i % (num_cpu - 1U))));
+        }
+    }
+}
+
 static void rp1_pcie_msix_cfg(const uint_t irq, const uint_t enable)
 {
     static uintptr_t rp1_pcie_base;
@@ -189,6 +254,9 @@ static void rp1_pcie_msix_cfg(const uint_t irq, const uint_t enable)
 
     if (enable) {
         switch (irq) {
+            case RP1_PCIE_MSIX_IRQ_0_IO_BANK0:  /* RP1 GPIO bank 0 irq */
+            case RP1_PCIE_MSIX_IRQ_1_IO_BANK1:  /* RP1 GPIO bank 1 irq */
+            case RP1_PCIE_MSIX_IRQ_2_IO_BANK2:  /* RP1 GPIO bank 2 irq */
             case RP1_PCIE_MSIX_IRQ_6_ETH:       /* RP1 ethernet irq */
             case RP1_PCIE_MSIX_IRQ_8_I2C1:      /* RP1 I2C1 irq */
             case RP1_PCIE_MSIX_IRQ_13_I2C6:     /* RP1 I2C6 irq */
@@ -219,6 +287,9 @@ static void rp1_pcie_msix_cfg(const uint_t irq, const uint_t enable)
     }
     else {
         switch (irq) {
+            case RP1_PCIE_MSIX_IRQ_0_IO_BANK0:  /* RP1 GPIO bank 0 irq */
+            case RP1_PCIE_MSIX_IRQ_1_IO_BANK1:  /* RP1 GPIO bank 1 irq */
+            case RP1_PCIE_MSIX_IRQ_2_IO_BANK2:  /* RP1 GPIO bank 2 irq */
             case RP1_PCIE_MSIX_IRQ_6_ETH:       /* RP1 ethernet irq */
             case RP1_PCIE_MSIX_IRQ_8_I2C1:      /* RP1 I2C1 irq */
             case RP1_PCIE_MSIX_IRQ_13_I2C6:     /* RP1 I2C6 irq */
@@ -251,8 +322,9 @@ static void rp1_pcie_msix_cfg(const uint_t irq, const uint_t enable)
     (void)munmap_device_memory((void*)rp1_pcie_base, RP1_PCIE_MSIX_SIZE);
 }
 
-static void bcm2712_mip_intc_cfg(void)
+static void bcm2712_mip_intc_cfg(const uint_t *const irq_list, const uint_t irq_num)
 {
+    uint_t i;
     static uintptr_t mip_intc_base;
 
     mip_intc_base = (uintptr_t) mmap_device_memory(NULL, BCM2712_MIP_INT_CONTROLLER_SIZE, PROT_NOCACHE|PROT_READ|PROT_WRITE, 0, BCM2712_MIP_INT_CONTROLLER_ADDR);
@@ -269,6 +341,13 @@ static void bcm2712_mip_intc_cfg(void)
     out32(mip_intc_base + MIP_INT_CFGH_HOST, 0x0001fc10U);
 
     (void)munmap_device_memory((void*)mip_intc_base, BCM2712_MIP_INT_CONTROLLER_SIZE);
+
+    /* steer the enabled irqs to their CPUs */
+    for (i = 0; i < irq_num; i++) {
+        if (irq_affinity[irq_list[i]] != 0U) {
+            gic_set_msi_irq_target(irq_list[i], irq_affinity[irq_list[i]]);
+        }
+    }
 }
 
 int main(const int argc, char *const argv[])
@@ -282,9 +361,42 @@ int main(const int argc, char *const argv[])
     uint_t cleanup = 0;
     uint_t irq_list[RP1_PCIE_MSIX_IRQ_SIZE] = { [0] = 6, [1] = 31, [2] = 36 };
     uint_t irq_num = 3;
+    uint_t auto_affinity = 0;
+    const uint_t num_cpu = (_syspage_ptr->num_cpu < GICD_CPU_MAX) ? _syspage_ptr->num_cpu : GICD_CPU_MAX;
 
-    while((opt = getopt(argc, argv, "ci:v")) != -1) {
+    while((opt = getopt(argc, argv, "a:ci:v")) != -1) {
         switch(opt) {
+            case 'a':
+                if (strcmp(optarg, "auto") == 0) {
+                    auto_affinity = 1;
+                }
+                else {
+                    char *str = optarg;
+                    while (*str != '\0') {
+                        char *end;
+                        const unsigned long irq = strtoul(str, &end, 0);
+                        unsigned long cpumask = 0;
+                        if ((end != str) && (*end == ':')) {
+                            str = end + 1;
+                            cpumask = strtoul(str, &end, 0);
+                        }
+                        if ((end == str) || ((*end != ',') && (*end != '\0'))) {
+                            (void)fprintf(stderr, "Invalid affinity '%s', use irq:cpumask\n", optarg);
+                            exit (EXIT_FAILURE);
+                        }
+                        if (irq >= RP1_PCIE_MSIX_IRQ_SIZE) {
+                            (void)fprintf(stderr, "Invalid IRQ: %lu, make sure IRQ is between 0 ~ %u\n", irq, RP1_PCIE_MSIX_IRQ_SIZE-1U);
+                            exit (EXIT_FAILURE);
+                        }
+                        if ((cpumask == 0U) || ((cpumask >> num_cpu) != 0U)) {
+                            (void)fprintf(stderr, "Invalid cpumask: 0x%lx, make sure it selects some of the %u CPUs\n", cpumask, num_cpu);
+                            exit (EXIT_FAILURE);
+                        }
+                        irq_affinity[irq] = (uint8_t)cpumask;
+                        str = (*end == ',') ? (end + 1) : end;
+                    }
+                }
+                break;
             case 'c':
                 cleanup = 1;
                 break;
@@ -323,6 +435,10 @@ int main(const int argc, char *const argv[])
         }
     }
 
+    if (auto_affinity > 0U) {
+        set_auto_affinity(num_cpu);
+    }
+
     idx = pci_device_find_capid(bdf, capid);
     if (idx < 0) {
         (void)fprintf(stderr, "Cannot find capid %x for B%.2u:D%.2u:F%.2u\n", capid, PCI_BUS(bdf), PCI_DEV(bdf), PCI_FUNC(bdf));
@@ -493,8 +609,8 @@ int main(const int argc, char *const argv[])
                             rp1_pcie_msix_cfg(irq_list[i], 1);
                         }
 
-                        /* config MIP_controller */
-                        bcm2712_mip_intc_cfg();
+                        /* config MIP_controller and irq CPU targets */
+                        bcm2712_mip_intc_cfg(irq_list, irq_num);
 
                         while (end_loop == 0) {
                             (void)sleep(1);
@@ -0,0 +1,84 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+/*
+ *  hwinfo_bcm2712.h   BCM2712 SoC description published by startup
+ *
+ *  Startup detects the SoC stepping from the FDT pinctrl node and records it
+ *  as the "stepping" register name of the "bcm2712,soc" hwinfo device. The
+ *  gpio utilities read it there instead of mapping and searching the FDT.
+ */
+
+#ifndef __HWINFO_BCM2712_H_INCLUDED
+#define __HWINFO_BCM2712_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <drvr/hwinfo.h>
+
+#define BCM2712_HWI_SOC             "bcm2712,soc"
+#define BCM2712_HWI_STEPPING        "stepping"
+
+/* pi5 revision 1.0 has a C1 stepping SoC, revision 1.1 a D0 */
+#define BCM2712_STEPPING_C1         (0U)
+#define BCM2712_STEPPING_D0         (1U)
+
+/* Returns false when startup published no stepping */
+static inline bool hwinfo_bcm2712_stepping(uint32_t *stepping)
+{
+    unsigned tag_idx = 0;
+    hwi_tag *tag;
+    const unsigned hwi_off = hwi_find_device(BCM2712_HWI_SOC, 0);
+
+    if (hwi_off == HWI_NULL_OFF) {
+        return false;
+    }
+    while ((tag = hwi_tag_find(hwi_off, HWI_TAG_NAME_regname, &tag_idx)) != NULL) {
+        if (strcmp(BCM2712_HWI_STEPPING, __hwi_find_string(tag->regname.regname)) == 0) {
+            *stepping = (tag->regname.offset == BCM2712_STEPPING_D0) ? BCM2712_STEPPING_D0 : BCM2712_STEPPING_C1;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,25 @@
+ifndef QCONFIG
+QCONFIG=qconfig.mk
+endif
+include $(QCONFIG)
+include $(MKFILES_ROOT)/qmacros.mk
+
+NAME = rio-rp1
+INSTALLDIR = usr/lib
+
+EXTRA_INCVPATH += $(PROJECT_ROOT)/public $(PROJECT_ROOT)/../gpio-rp1/public
+PUBLIC_INCVPATH += $(PROJECT_ROOT)/public
+
+define PINFO
+PINFO DESCRIPTION=Raspberry pi5 RP1 SYS_RIO direct GPIO access library
+endef
+
+
+#####AUTO-GENERATED by packaging script... do not checkin#####
+   INSTALL_ROOT_nto = $(PROJECT_ROOT)/../../../../../install
+   USE_INSTALL_ROOT=1
+##############################################################
+
+include $(MKFILES_ROOT)/qtargets.mk
+
+-include $(PROJECT_ROOT)/roots.mk
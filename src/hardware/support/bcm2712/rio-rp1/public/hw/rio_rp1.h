@@ -0,0 +1,122 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ */
+
+/*
+ *  rio_rp1.h   direct access to the RP1 SYS_RIO GPIO registers
+ *
+ *  rio_rp1_open() claims the pins from the gpio-rp1 resource manager and maps
+ *  the SYS_RIO banks into the caller, which needs the ability to map physical
+ *  memory. The helpers below are then single loads or stores with no kernel
+ *  call. They take a bank below RP1_GPIO_BANKS and a mask, bit n being the
+ *  n-th GPIO of the bank (bank 0: GPIO 0-27, 1: GPIO 28-33, 2: GPIO 34-53).
+ *  The stores are masked with the pins the handle claimed, bits of other
+ *  pins are dropped so a bad mask can't drive a pin owned by someone else.
+ */
+
+#ifndef __RIO_RP1_H_INCLUDED
+#define __RIO_RP1_H_INCLUDED
+
+#include <hw/dcmd_gpio_rp1.h>
+
+#define RIO_RP1_BASE                0x1f000e0000ULL  /* SYS_RIO bank 0 */
+#define RIO_RP1_SIZE                0xc000U
+#define RIO_RP1_BANK_STRIDE         0x4000U
+
+#define RIO_RP1_OUT                 0x0U
+#define RIO_RP1_OE                  0x4U
+#define RIO_RP1_SYNC_IN             0x8U
+
+/* Atomic aliases of the registers */
+#define RIO_RP1_XOR                 0x1000U
+#define RIO_RP1_SET                 0x2000U
+#define RIO_RP1_CLR                 0x3000U
+
+typedef struct _rio_rp1 {
+    int                 fd;                 /* holds the claim */
+    void                *vbase;
+    _Uint64t            pins;               /* claimed GPIOs, bit n is GPIO n */
+    _Uint32t            claimed[RP1_GPIO_BANKS];    /* pins split by bank */
+    volatile _Uint8t    *bank[RP1_GPIO_BANKS];
+} rio_rp1_t;
+
+static inline void rio_rp1_write(const rio_rp1_t *rio, const unsigned bank, const unsigned reg, const _Uint32t mask)
+{
+    *(volatile _Uint32t *)(rio->bank[bank] + reg) = mask & rio->claimed[bank];
+}
+
+static inline _Uint32t rio_rp1_read(const rio_rp1_t *rio, const unsigned bank)
+{
+    return *(volatile _Uint32t *)(rio->bank[bank] + RIO_RP1_SYNC_IN);
+}
+
+static inline void rio_rp1_set(const rio_rp1_t *rio, const unsigned bank, const _Uint32t mask)
+{
+    rio_rp1_write(rio, bank, RIO_RP1_SET + RIO_RP1_OUT, mask);
+}
+
+static inline void rio_rp1_clr(const rio_rp1_t *rio, const unsigned bank, const _Uint32t mask)
+{
+    rio_rp1_write(rio, bank, RIO_RP1_CLR + RIO_RP1_OUT, mask);
+}
+
+static inline void rio_rp1_toggle(const rio_rp1_t *rio, const unsigned bank, const _Uint32t mask)
+{
+    rio_rp1_write(rio, bank, RIO_RP1_XOR + RIO_RP1_OUT, mask);
+}
+
+static inline void rio_rp1_output(const rio_rp1_t *rio, const unsigned bank, const _Uint32t mask)
+{
+    rio_rp1_write(rio, bank, RIO_RP1_SET + RIO_RP1_OE, mask);
+}
+
+static inline void rio_rp1_input(const rio_rp1_t *rio, const unsigned bank, const _Uint32t mask)
+{
+    rio_rp1_write(rio, bank, RIO_RP1_CLR + RIO_RP1_OE, mask);
+}
+
+__BEGIN_DECLS
+
+/* Returns EOK or an errno value, the pins must be GPIO inputs or outputs */
+extern int rio_rp1_open(rio_rp1_t *rio, _Uint64t pins);
+extern void rio_rp1_close(rio_rp1_t *rio);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <devctl.h>
+#include <sys/mman.h>
+#include <hw/rio_rp1.h>
+
+static const unsigned rio_bank_base[RP1_GPIO_BANKS] = { 0, 28, 34 };
+static const unsigned rio_bank_pins[RP1_GPIO_BANKS] = { 28, 6, 20 };
+
+int rio_rp1_open(rio_rp1_t *rio, const uint64_t pins)
+{
+    rp1_gpio_claim_t claim = { .mask = pins };
+    uintptr_t vbase;
+    unsigned bank;
+    int ret;
+
+    (void)memset(rio, 0, sizeof(*rio));
+    rio->fd = -1;
+
+    if ((pins == 0ULL) || ((pins & ~RP1_GPIO_ALL_MASK) != 0ULL)) {
+        return EINVAL;
+    }
+
+    rio->fd = open(RP1_GPIO_DEV_NAME, O_RDWR);
+    if (rio->fd == -1) {
+        return errno;
+    }
+
+    ret = devctl(rio->fd, DCMD_GPIO_RP1_CLAIM, &claim, sizeof(claim), NULL);
+    if (ret != EOK) {
+        rio_rp1_close(rio);
+        return ret;
+    }
+
+    rio->vbase = mmap_device_memory(NULL, RIO_RP1_SIZE, PROT_NOCACHE|PROT_READ|PROT_WRITE, 0, RIO_RP1_BASE);
+    if (rio->vbase == MAP_FAILED) {
+        ret = errno;
+        rio->vbase = NULL;
+        rio_rp1_close(rio);
+        return ret;
+    }
+
+    vbase = (uintptr_t)rio->vbase;
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        rio->bank[bank] = (volatile uint8_t *)(vbase + (bank * RIO_RP1_BANK_STRIDE));
+        rio->claimed[bank] = (uint32_t)(pins >> rio_bank_base[bank]) & ((1U << rio_bank_pins[bank]) - 1U);
+    }
+    rio->pins = pins;
+
+    return EOK;
+}
+
+void rio_rp1_close(rio_rp1_t *rio)
+{
+    if (rio->vbase != NULL) {
+        (void)munmap_device_memory(rio->vbase, RIO_RP1_SIZE);
+        rio->vbase = NULL;
+    }
+    if (rio->fd != -1) {
+        (void)close(rio->fd);
+        rio->fd = -1;
+    }
+    (void)memset(rio->claimed, 0, sizeof(rio->claimed));
+    rio->pins = 0ULL;
+}
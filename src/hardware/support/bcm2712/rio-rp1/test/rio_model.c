@@ -0,0 +1,159 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#include <stdarg.h>
+#include <string.h>
+#include "rio_model.h"
+
+rio_model_t rio_model;
+
+void rio_model_reset(void)
+{
+    rio_model_fini();
+    (void)memset(&rio_model, 0, sizeof(rio_model));
+    rio_model.regs = calloc(RIO_MODEL_WORDS, sizeof(uint32_t));
+    if (rio_model.regs == NULL) {
+        (void)fprintf(stderr, "rio_model: out of memory\n");
+        exit(1);
+    }
+}
+
+void rio_model_fini(void)
+{
+    free(rio_model.regs);
+    rio_model.regs = NULL;
+}
+
+uint32_t *rio_model_reg(const unsigned bank, const unsigned reg)
+{
+    return &rio_model.regs[((bank * RIO_RP1_BANK_STRIDE) + reg) / sizeof(uint32_t)];
+}
+
+void rio_model_settle(void)
+{
+    static const unsigned regs[] = { RIO_RP1_OUT, RIO_RP1_OE };
+    unsigned bank, i;
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        for (i = 0; i < (sizeof(regs) / sizeof(regs[0])); i++) {
+            uint32_t *const reg = rio_model_reg(bank, regs[i]);
+            uint32_t *const flip = rio_model_reg(bank, RIO_RP1_XOR + regs[i]);
+            uint32_t *const set = rio_model_reg(bank, RIO_RP1_SET + regs[i]);
+            uint32_t *const clr = rio_model_reg(bank, RIO_RP1_CLR + regs[i]);
+
+            *reg = ((*reg ^ *flip) | *set) & ~*clr;
+            *flip = 0;
+            *set = 0;
+            *clr = 0;
+        }
+    }
+}
+
+int rio_model_open(const char *path, int oflag, ...)
+{
+    if ((strcmp(path, RP1_GPIO_DEV_NAME) != 0) || rio_model.opened) {
+        errno = ENOENT;
+        return -1;
+    }
+    rio_model.opened = true;
+    rio_model.oflag = oflag;
+    return RIO_MODEL_FD;
+}
+
+int rio_model_close(int fd)
+{
+    if ((fd != RIO_MODEL_FD) || !rio_model.opened) {
+        errno = EBADF;
+        return -1;
+    }
+    /* The resource manager releases the claim with the descriptor */
+    rio_model.opened = false;
+    rio_model.claimed = 0ULL;
+    return 0;
+}
+
+int devctl(int fd, int dcmd, void *data, size_t nbytes, int *info)
+{
+    const rp1_gpio_claim_t *const claim = data;
+
+    (void)info;
+    if ((fd != RIO_MODEL_FD) || !rio_model.opened) {
+        return EBADF;
+    }
+    if ((dcmd != (int)DCMD_GPIO_RP1_CLAIM) || (nbytes < sizeof(*claim))) {
+        return ENOTTY;
+    }
+    rio_model.claims++;
+    if ((rio_model.oflag & O_ACCMODE) == O_RDONLY) {
+        return EPERM;
+    }
+    if ((claim->mask & rio_model.busy) != 0ULL) {
+        return EBUSY;
+    }
+    rio_model.claimed = claim->mask;
+    return EOK;
+}
+
+void *mmap_device_memory(void *addr, size_t len, int prot, int flags, uint64_t physical)
+{
+    (void)addr;
+    (void)flags;
+    if (rio_model.map_errno != 0) {
+        errno = rio_model.map_errno;
+        return MAP_FAILED;
+    }
+    rio_model.mapped = true;
+    rio_model.paddr = physical;
+    rio_model.len = len;
+    rio_model.prot = prot;
+    return rio_model.regs;
+}
+
+int munmap_device_memory(void *addr, size_t len)
+{
+    if ((addr != rio_model.regs) || (len != rio_model.len) || !rio_model.mapped) {
+        errno = EINVAL;
+        return -1;
+    }
+    rio_model.mapped = false;
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef RIO_MODEL_H_INCLUDED
+#define RIO_MODEL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <hw/rio_rp1.h>
+
+/*
+ * Host model of what rio.c talks to: the gpio-rp1 resource manager behind
+ * RP1_GPIO_DEV_NAME, which answers DCMD_GPIO_RP1_CLAIM, and the SYS_RIO
+ * mapping, which is plain memory. A store to an atomic alias stays in the
+ * alias word until rio_model_settle() applies it to the register, so the
+ * tests can see the value of each store.
+ */
+
+#define RIO_MODEL_FD            100
+#define RIO_MODEL_WORDS         (RIO_RP1_SIZE / sizeof(uint32_t))
+
+typedef struct {
+    bool        opened;
+    int         oflag;
+    uint64_t    busy;                   /* pins claimed by other descriptors */
+    uint64_t    claimed;
+    uint32_t    claims;                 /* DCMD_GPIO_RP1_CLAIM received */
+    int         map_errno;              /* mmap_device_memory() fails with it */
+    bool        mapped;
+    uint64_t    paddr;
+    size_t      len;
+    int         prot;
+    uint32_t    *regs;
+} rio_model_t;
+
+extern rio_model_t rio_model;
+
+void rio_model_reset(void);
+void rio_model_fini(void);
+
+/* A register of a bank, before the alias stores are applied */
+uint32_t *rio_model_reg(unsigned bank, unsigned reg);
+
+/* Apply the stores left in the alias words and clear them */
+void rio_model_settle(void);
+
+#endif /* RIO_MODEL_H_INCLUDED */
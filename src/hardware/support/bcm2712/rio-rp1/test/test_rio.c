@@ -0,0 +1,294 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+/*
+ * Regression tests and benchmark of librio-rp1 against the model of the
+ * resource manager and of the SYS_RIO mapping.
+ *
+ *   test_rio               run the tests
+ *   test_rio -b [-n N]     time N toggles through rio_rp1_toggle(), an
+ *                          unmasked store and a kernel call per toggle
+ *
+ * The mapping is plain memory here, the store rates bound what the helpers
+ * can reach; on the RP1 each store also crosses PCIe.
+ */
+
+#include <string.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include "rio_model.h"
+
+static uint32_t failures;
+
+#define CHECK(__cond) \
+    do { \
+        if (!(__cond)) { \
+            (void)fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #__cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/* GPIO 4 and 5, 30, 40 */
+#define RIO_TEST_PINS       ((1ULL << 4) | (1ULL << 5) | (1ULL << 30) | (1ULL << 40))
+
+/* The claim is made once, the mapping is the uncached SYS_RIO block */
+static void test_open(void)
+{
+    rio_rp1_t   rio;
+
+    rio_model_reset();
+    CHECK(rio_rp1_open(&rio, RIO_TEST_PINS) == EOK);
+    CHECK(rio_model.claims == 1U);
+    CHECK(rio_model.claimed == RIO_TEST_PINS);
+    CHECK((rio_model.oflag & O_ACCMODE) == O_RDWR);
+    CHECK(rio_model.mapped);
+    CHECK(rio_model.paddr == RIO_RP1_BASE);
+    CHECK(rio_model.len == RIO_RP1_SIZE);
+    CHECK((rio_model.prot & PROT_NOCACHE) != 0);
+    CHECK(rio.pins == RIO_TEST_PINS);
+    CHECK(rio.claimed[0] == 0x30U);
+    CHECK(rio.claimed[1] == (1U << 2));
+    CHECK(rio.claimed[2] == (1U << 6));
+
+    rio_rp1_close(&rio);
+    CHECK(!rio_model.mapped);
+    CHECK(!rio_model.opened);
+    CHECK(rio.fd == -1);
+    CHECK(rio.pins == 0ULL);
+    CHECK((rio.claimed[0] | rio.claimed[1] | rio.claimed[2]) == 0U);
+    rio_model_fini();
+}
+
+/* Every helper stores the mask with the unclaimed bits dropped */
+static void test_masked_writes(void)
+{
+    static const unsigned   regs[] = { RIO_RP1_SET + RIO_RP1_OUT, RIO_RP1_CLR + RIO_RP1_OUT,
+                                       RIO_RP1_XOR + RIO_RP1_OUT, RIO_RP1_SET + RIO_RP1_OE,
+                                       RIO_RP1_CLR + RIO_RP1_OE };
+    rio_rp1_t               rio;
+    unsigned                bank, i;
+
+    rio_model_reset();
+    CHECK(rio_rp1_open(&rio, RIO_TEST_PINS) == EOK);
+
+    for (bank = 0; bank < RP1_GPIO_BANKS; bank++) {
+        for (i = 0; i < (sizeof(regs) / sizeof(regs[0])); i++) {
+            *rio_model_reg(bank, regs[i]) = 0xdeadbeefU;
+        }
+        rio_rp1_set(&rio, bank, 0xffffffffU);
+        rio_rp1_clr(&rio, bank, 0xffffffffU);
+        rio_rp1_toggle(&rio, bank, 0xffffffffU);
+        rio_rp1_output(&rio, bank, 0xffffffffU);
+        rio_rp1_input(&rio, bank, 0xffffffffU);
+        for (i = 0; i < (sizeof(regs) / sizeof(regs[0])); i++) {
+            CHECK(*rio_model_reg(bank, regs[i]) == rio.claimed[bank]);
+        }
+    }
+
+    /* Only unclaimed pins: the store carries no bit */
+    rio_rp1_set(&rio, 0, ~0x30U);
+    CHECK(*rio_model_reg(0, RIO_RP1_SET + RIO_RP1_OUT) == 0U);
+
+    rio_rp1_close(&rio);
+    rio_model_fini();
+}
+
+/* Toggling all pins flips the claimed ones only, the others keep their level */
+static void test_toggle(void)
+{
+    rio_rp1_t   rio;
+
+    rio_model_reset();
+    *rio_model_reg(0, RIO_RP1_OUT) = 0x0f000001U;
+    *rio_model_reg(0, RIO_RP1_SYNC_IN) = 0x12345678U;
+    CHECK(rio_rp1_open(&rio, RIO_TEST_PINS) == EOK);
+
+    rio_rp1_output(&rio, 0, 0xffffffffU);
+    rio_rp1_toggle(&rio, 0, 0xffffffffU);
+    rio_model_settle();
+    CHECK(*rio_model_reg(0, RIO_RP1_OE) == 0x30U);
+    CHECK(*rio_model_reg(0, RIO_RP1_OUT) == 0x0f000031U);
+
+    rio_rp1_clr(&rio, 0, 0x10U);
+    rio_model_settle();
+    CHECK(*rio_model_reg(0, RIO_RP1_OUT) == 0x0f000021U);
+
+    rio_rp1_set(&rio, 0, 0xffffffffU);
+    rio_rp1_input(&rio, 0, 0x20U);
+    rio_model_settle();
+    CHECK(*rio_model_reg(0, RIO_RP1_OUT) == 0x0f000031U);
+    CHECK(*rio_model_reg(0, RIO_RP1_OE) == 0x10U);
+
+    CHECK(rio_rp1_read(&rio, 0) == 0x12345678U);
+
+    rio_rp1_close(&rio);
+    rio_model_fini();
+}
+
+/* A failed open leaves nothing claimed, opened or mapped */
+static void test_open_errors(void)
+{
+    rio_rp1_t   rio;
+
+    rio_model_reset();
+    CHECK(rio_rp1_open(&rio, 0ULL) == EINVAL);
+    CHECK(rio_rp1_open(&rio, 1ULL << RP1_GPIO_NUM) == EINVAL);
+    CHECK(rio_model.claims == 0U);
+    CHECK(!rio_model.opened);
+
+    rio_model.busy = 1ULL << 30;
+    CHECK(rio_rp1_open(&rio, RIO_TEST_PINS) == EBUSY);
+    CHECK(!rio_model.opened);
+    CHECK(!rio_model.mapped);
+    CHECK(rio.fd == -1);
+    CHECK(rio.claimed[1] == 0U);
+
+    rio_model.busy = 0ULL;
+    rio_model.map_errno = EPERM;
+    CHECK(rio_rp1_open(&rio, RIO_TEST_PINS) == EPERM);
+    CHECK(!rio_model.opened);
+    CHECK(rio_model.claimed == 0ULL);
+    CHECK(rio.vbase == NULL);
+    CHECK(rio.pins == 0ULL);
+    CHECK(rio.claimed[0] == 0U);
+
+    rio_model_fini();
+}
+
+static int run_tests(void)
+{
+    test_open();
+    test_masked_writes();
+    test_toggle();
+    test_open_errors();
+
+    if (failures != 0U) {
+        (void)printf("FAILED: %u checks\n", failures);
+        return 1;
+    }
+
+    (void)printf("all tests passed\n");
+    return 0;
+}
+
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_report(const char *name, const uint32_t iterations, const uint64_t ns)
+{
+    const double per = (double)ns / iterations;
+
+    (void)printf("%-10s %12u %10.2f %12.3f\n", name, iterations, per, 1000.0 / per);
+}
+
+static int run_bench(const uint32_t iterations)
+{
+    rio_rp1_t               rio;
+    volatile uint32_t       *raw;
+    uint64_t                start;
+    uint32_t                n;
+
+    rio_model_reset();
+    if (rio_rp1_open(&rio, RIO_TEST_PINS) != EOK) {
+        (void)printf("open failed\n");
+        rio_model_fini();
+        return 1;
+    }
+    raw = (volatile uint32_t *)(rio.bank[0] + RIO_RP1_XOR + RIO_RP1_OUT);
+
+    (void)printf("%-10s %12s %10s %12s\n", "path", "toggles", "ns", "MHz");
+
+    start = bench_now();
+    for (n = 0; n < iterations; n++) {
+        rio_rp1_toggle(&rio, 0, 0x10U);
+    }
+    bench_report("rio", iterations, bench_now() - start);
+
+    start = bench_now();
+    for (n = 0; n < iterations; n++) {
+        *raw = 0x10U;
+    }
+    bench_report("unmasked", iterations, bench_now() - start);
+
+    /* The floor of any path that enters the kernel for each toggle */
+    start = bench_now();
+    for (n = 0; n < iterations; n++) {
+        (void)syscall(SYS_getppid);
+        rio_rp1_toggle(&rio, 0, 0x10U);
+    }
+    bench_report("syscall", iterations, bench_now() - start);
+
+    rio_rp1_close(&rio);
+    rio_model_fini();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    iterations = 10000000, bench = 0;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "bn:")) != -1) {
+        switch (opt) {
+            case 'b':
+                bench = 1;
+                break;
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-b [-n iterations]]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (bench != 0U) {
+        return run_bench((iterations != 0U) ? iterations : 1U);
+    }
+
+    return run_tests();
+}
@@ -0,0 +1,64 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef TEST_DEVCTL_H_INCLUDED
+#define TEST_DEVCTL_H_INCLUDED
+
+#include <sys/platform.h>
+
+#define _DCMD_MISC              0x05
+#define _DCMD_I2C               0x0f
+#define _DCMD_SPI               0x12
+
+#define _POSIX_DEVDIR_NONE      0
+#define _POSIX_DEVDIR_TO        0x80000000
+#define _POSIX_DEVDIR_FROM      0x40000000
+
+#define __DIOF(class, cmd, data)    ((sizeof(data) << 16) + ((class) << 8) + (cmd) + _POSIX_DEVDIR_FROM)
+#define __DIOT(class, cmd, data)    ((sizeof(data) << 16) + ((class) << 8) + (cmd) + _POSIX_DEVDIR_TO)
+#define __DIOTF(class, cmd, data)   ((sizeof(data) << 16) + ((class) << 8) + (cmd) + _POSIX_DEVDIR_TO + _POSIX_DEVDIR_FROM)
+#define __DION(class, cmd)          (((class) << 8) + (cmd) + _POSIX_DEVDIR_NONE)
+
+/* Provided by the models that serve devctl() */
+int devctl(int fd, int dcmd, void *data, size_t nbytes, int *info);
+
+#endif /* TEST_DEVCTL_H_INCLUDED */
@@ -0,0 +1,94 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef TEST_SYS_IOFUNC_H_INCLUDED
+#define TEST_SYS_IOFUNC_H_INCLUDED
+
+#include <sys/neutrino.h>
+#include <sys/dispatch.h>
+
+#ifndef IOFUNC_ATTR_T
+#define IOFUNC_ATTR_T   struct _iofunc_attr
+#endif
+
+struct _io_devctl {
+    _Uint16t    type;
+    _Uint16t    combine_len;
+    _Int32t     dcmd;
+    _Uint32t    nbytes;
+    _Int32t     zero;
+};
+
+struct _io_devctl_reply {
+    _Uint32t    zero;
+    _Int32t     ret_val;
+    _Uint32t    nbytes;
+    _Int32t     zero2;
+};
+
+typedef union {
+    struct _io_devctl       i;
+    struct _io_devctl_reply o;
+} io_devctl_t;
+
+#define _IO_INPUT_PAYLOAD(__msg)    ((void *)((__msg) + 1))
+
+#define _RESMGR_NPARTS(__n)         (-(__n))
+#define _RESMGR_PTR(__ctp, __p, __n) (SETIOV((__ctp)->iov, (__p), (__n)), _RESMGR_NPARTS(1))
+
+#define _IO_FLAG_RD         0x00000001
+#define _IO_FLAG_WR         0x00000002
+
+#define IOFUNC_ATTR_ATIME   0x00000002
+#define IOFUNC_ATTR_CTIME   0x00000004
+#define IOFUNC_ATTR_MTIME   0x00000008
+
+typedef struct _iofunc_attr {
+    unsigned    flags;
+} iofunc_attr_t;
+
+typedef struct _iofunc_ocb {
+    IOFUNC_ATTR_T   *attr;
+    _Int32t         ioflag;
+} iofunc_ocb_t;
+
+#endif /* TEST_SYS_IOFUNC_H_INCLUDED */
@@ -0,0 +1,88 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+#ifndef TEST_SYS_NEUTRINO_H_INCLUDED
+#define TEST_SYS_NEUTRINO_H_INCLUDED
+
+#include <sys/platform.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <time.h>
+
+#define _NTO_TIMEOUT_RECEIVE        (1 << 3)
+#define _NTO_CHF_PRIVATE            0x0080
+#define _NTO_SIDE_CHANNEL           0x40000000
+#define _NTO_INTR_FLAGS_TRK_MSK     0x0008
+#define _NTO_TCTL_RUNMASK           4
+#define _PULSE_CODE_MINAVAIL        0
+
+struct _pulse {
+    _Uint16t    type;
+    _Uint16t    subtype;
+    _Int8t      code;
+    _Uint8t     zero[3];
+    union sigval value;
+    _Int32t     scoid;
+};
+
+#define SIGEV_PULSE_INIT(__e, __f, __p, __c, __v) \
+    ((__e)->sigev_notify = SIGEV_SIGNAL, (__e)->sigev_signo = (__c), (void)(__f), (void)(__p), (void)(__v))
+
+#define __cpu_membarrier()  __sync_synchronize()
+
+/* Provided by the models, ClockCycles() counts nanoseconds */
+int InterruptAttachEvent(int intr, const struct sigevent *event, unsigned flags);
+int InterruptDetach(int id);
+int InterruptUnmask(int intr, int id);
+int TimerTimeout(clockid_t id, int flags, const struct sigevent *notify, const uint64_t *ntime, uint64_t *otime);
+int MsgReceivePulse(int chid, void *pulse, size_t bytes, void *info);
+int ThreadCtl(int cmd, void *data);
+uint64_t ClockCycles(void);
+int nanospin_ns(unsigned long nsec);
+uint64_t timespec2nsec(const struct timespec *ts);
+void nsec2timespec(struct timespec *ts, uint64_t nsec);
+
+/* QNX declares these in <time.h> and <semaphore.h> */
+uint64_t clock_gettime_mon_ns(void);
+int sem_timedwait_monotonic(sem_t *sem, const struct timespec *abs_timeout);
+
+#endif /* TEST_SYS_NEUTRINO_H_INCLUDED */
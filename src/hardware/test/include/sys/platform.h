@@ -0,0 +1,87 @@
+/*
+ * Notice on Software Maturity and Quality
+ *
+ * The software included in this repository is classified under our Software Maturity Standard as Experimental Software - Software Quality and Maturity Level (SQML) 1.
+ *
+ * As defined in the QNX Development License Agreement, Experimental Software represents early-stage deliverables intended for evaluation or proof-of-concept purposes.
+ *
+ * SQML 1 indicates that this software is provided without one or more of the following:
+ *     - Formal requirements
+ *     - Formal design or architecture
+ *     - Formal testing
+ *     - Formal support
+ *     - Formal documentation
+ *     - Certifications of any type
+ *     - End-of-Life or End-of-Support policy
+ *
+ * Additionally, this software is not monitored or scanned under our Cybersecurity Management Standard.
+ *
+ * No warranties, guarantees, or claims are offered at this SQML level.
+ */
+
+/*
+ * Copyright (c) 2026, BlackBerry Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You
+ * may not reproduce, modify or distribute this software except in
+ * compliance with the License. You may obtain a copy of the License
+ * at: http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTIES OF ANY KIND, either express or implied.
+ *
+ * This file may contain contributions from others, either as
+ * contributors under the License or as licensors under other terms.
+ * Please review this entire file for other proprietary rights or license
+ * notices, as well as the QNX Development Suite License Guide at
+ * http://licensing.qnx.com/license-guide/ for other information.
+ * $
+ */
+
+
+/*
+ * Host stand-ins for the QNX headers used by the driver sources built into
+ * the host test harnesses under src/hardware (the test directories of the
+ * drivers). Only what those sources need is declared; stand-ins for headers
+ * of a single driver class stay in that driver's test/include.
+ */
+
+#ifndef TEST_SYS_PLATFORM_H_INCLUDED
+#define TEST_SYS_PLATFORM_H_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+typedef int8_t      _Int8t;
+typedef uint8_t     _Uint8t;
+typedef int16_t     _Int16t;
+typedef uint16_t    _Uint16t;
+typedef int32_t     _Int32t;
+typedef uint32_t    _Uint32t;
+typedef int64_t     _Int64t;
+typedef uint64_t    _Uint64t;
+
+typedef uint64_t    paddr_t;
+
+typedef struct iovec iov_t;
+
+#define SETIOV(_iov, _addr, _len)   ((_iov)->iov_base = (void *)(_addr), (_iov)->iov_len = (_len))
+
+#ifndef EOK
+#define EOK     0
+#endif
+
+/* QNX <stdlib.h> provides these */
+#ifndef max
+#define max(a, b)   (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef min
+#define min(a, b)   (((a) < (b)) ? (a) : (b))
+#endif
+
+#endif /* TEST_SYS_PLATFORM_H_INCLUDED */